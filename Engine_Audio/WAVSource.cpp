@@ -7,12 +7,34 @@
 
 #include "WAVSource.h"
 
+#include <cstdlib>
+#include <memory>
+
 #include <alut.h>
 
+using namespace Engine::ResourceManagment;
+
 namespace Engine
 {
 namespace Audio
 {
+  /**
+   * @brief Creates empty audio data.
+   */
+  WAVData::WAVData()
+      : samples(nullptr)
+      , format(0)
+      , size(0)
+      , frequency(0.0f)
+  {
+  }
+
+  WAVData::~WAVData()
+  {
+    if (samples != nullptr)
+      free(samples);
+  }
+
   /**
    * @copydoc Source::Source()
    */
@@ -32,6 +54,40 @@ namespace Audio
    */
   bool WAVSource::load(const std::string &filename)
   {
+    WAVData data;
+    if (!Decode(filename, data))
+      return false;
+
+    return upload(data);
+  }
+
+  /**
+   * @brief Reads and decodes a WAV file into memory.
+   * @param filename File to load
+   * @param data Audio data to populate
+   * @return True if the file was decoded
+   *
+   * Does not create any AL objects so may be called from any thread.
+   */
+  bool WAVSource::Decode(const std::string &filename, WAVData &data)
+  {
+    if (data.samples != nullptr)
+      free(data.samples);
+
+    data.samples = alutLoadMemoryFromFile(filename.c_str(), &data.format, &data.size, &data.frequency);
+    return (data.samples != nullptr);
+  }
+
+  /**
+   * @brief Creates the buffer used by this source from decoded audio data.
+   * @param data Audio data
+   * @return True if the buffer was created
+   */
+  bool WAVSource::upload(const WAVData &data)
+  {
+    if (data.samples == nullptr)
+      return false;
+
     // Delete the buffer created by the constructor
     if (m_buffer)
     {
@@ -39,11 +95,32 @@ namespace Audio
       alDeleteBuffers(1, &m_buffer);
     }
 
-    // Create a new buffer form the audio file
-    m_buffer = alutCreateBufferFromFile(filename.c_str());
+    // Create a new buffer from the samples
+    alGenBuffers(1, &m_buffer);
+    alBufferData(m_buffer, data.format, data.samples, data.size, (ALsizei)data.frequency);
     alSourcei(m_sourceID, AL_BUFFER, m_buffer);
 
-    return (alutGetError() == ALUT_ERROR_NO_ERROR);
+    return (alGetError() == AL_NO_ERROR);
+  }
+
+  /**
+   * @brief Queues a WAV file to be decoded on a worker thread and uploaded
+   *        into this source.
+   * @param loader Loader to queue with
+   * @param filename File to load
+   * @param callback Function called once the load has completed (may be
+   *                 empty)
+   * @return Future holding the result of the load
+   *
+   * The source must not be deleted before the load completes.
+   */
+  std::shared_future<bool> WAVSource::queueLoad(ResourceLoader &loader, const std::string &filename,
+                                                ResourceLoader::CompletionCallback callback)
+  {
+    std::shared_ptr<WAVData> data = std::make_shared<WAVData>();
+
+    return loader.queue(filename, [filename, data]() { return Decode(filename, *data); },
+                        [this, data]() { return upload(*data); }, callback);
   }
 }
 }
@@ -8,12 +8,41 @@
 #ifndef _ENGINE_AUDIO_WAVSOURCE_H_
 #define _ENGINE_AUDIO_WAVSOURCE_H_
 
+#include <future>
+
+#include <Engine_ResourceManagment/ResourceLoader.h>
+
 #include "Source.h"
 
 namespace Engine
 {
 namespace Audio
 {
+  /**
+   * @struct WAVData
+   * @brief Decoded audio samples, as produced by WAVSource::Decode.
+   */
+  struct WAVData
+  {
+    WAVData();
+    ~WAVData();
+
+    /**
+     * @brief No copy constructor
+     */
+    WAVData(WAVData const &) = delete;
+
+    /**
+     * @brief No assign copy constructor
+     */
+    WAVData &operator=(WAVData const &) = delete;
+
+    ALvoid *samples;   //!< Sample data
+    ALenum format;     //!< Sample format
+    ALsizei size;      //!< Size of sample data (bytes)
+    ALfloat frequency; //!< Sample rate
+  };
+
   /**
    * @class WAVSource
    * @brief An audio source that loads WAV files.
@@ -25,7 +54,13 @@ namespace Audio
     WAVSource(const std::string &name, Listener *listener);
     virtual ~WAVSource();
 
+    static bool Decode(const std::string &filename, WAVData &data);
+
     bool load(const std::string &filename);
+    bool upload(const WAVData &data);
+    std::shared_future<bool> queueLoad(Engine::ResourceManagment::ResourceLoader &loader, const std::string &filename,
+                                       Engine::ResourceManagment::ResourceLoader::CompletionCallback callback =
+                                           nullptr);
   };
 }
 }
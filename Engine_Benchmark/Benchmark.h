@@ -0,0 +1,85 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#ifndef _ENGINE_BENCHMARK_BENCHMARK_H_
+#define _ENGINE_BENCHMARK_BENCHMARK_H_
+
+#define NOMINMAX
+
+#include <iostream>
+#include <string>
+
+#include <Windows.h>
+
+namespace Engine
+{
+namespace Benchmark
+{
+  /**
+   * @class Benchmark
+   * @brief Utilities for timing and reporting micro-benchmarks.
+   * @author Dan Nixon
+   */
+  class Benchmark
+  {
+  public:
+    /**
+     * @brief Times a function.
+     * @param fn Function to time
+     * @return Elapsed time in milliseconds
+     */
+    template <typename T> static double Time(T fn)
+    {
+      LARGE_INTEGER freq, start, end;
+      QueryPerformanceFrequency(&freq);
+
+      QueryPerformanceCounter(&start);
+      fn();
+      QueryPerformanceCounter(&end);
+
+      return (double)(end.QuadPart - start.QuadPart) * 1000.0 / (double)freq.QuadPart;
+    }
+
+    /**
+     * @brief Outputs the result of a benchmark.
+     * @param o Stream to output to
+     * @param name Name of the benchmark
+     * @param operations Number of operations performed
+     * @param milliSec Total time taken in milliseconds
+     */
+    static void Report(std::ostream &o, const std::string &name, size_t operations, double milliSec)
+    {
+      std::streamsize p = o.precision();
+      o.precision(4);
+
+      o << name << ": " << operations << " ops in " << milliSec << "ms ("
+        << (milliSec * 1000000.0 / (double)operations) << "ns/op)" << std::endl;
+
+      o.precision(p);
+    }
+
+    /**
+     * @brief Prevents the optimiser from discarding a result.
+     * @param value Value to consume
+     */
+    template <typename T> static void Consume(const T &value)
+    {
+      static volatile char sink;
+      sink = *(reinterpret_cast<const volatile char *>(&value));
+    }
+  };
+
+  void MathsBenchmark(std::ostream &o);
+  void TransformBenchmark(std::ostream &o);
+  void SceneBenchmark(std::ostream &o);
+  void MessageQueueBenchmark(std::ostream &o);
+  void FrameArenaBenchmark(std::ostream &o);
+  void MeshCacheBenchmark(std::ostream &o);
+}
+}
+
+#endif
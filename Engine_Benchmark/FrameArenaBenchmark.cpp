@@ -0,0 +1,165 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Engine_ResourceManagment/FrameAllocator.h>
+
+using namespace Engine::ResourceManagment;
+
+namespace
+{
+/**
+ * @var g_heapAllocations
+ * @brief Number of calls made to the global operator new.
+ */
+std::atomic<size_t> g_heapAllocations(0);
+
+/**
+ * @typedef HeapVector
+ * @brief Vector using the default (heap) allocator.
+ */
+template <typename T> using HeapVector = std::vector<T>;
+
+/**
+ * @typedef HeapString
+ * @brief String using the default (heap) allocator.
+ */
+typedef std::string HeapString;
+
+/**
+ * @brief Performs the per-frame temporary allocations typical of a game loop
+ *        tick: a broadphase candidate list filtered by a narrowphase, a list
+ *        of objects deferred for rendering and a formatted log message.
+ * @param entities Entity data
+ * @return Checksum of the results
+ */
+template <template <typename> class V, typename S> size_t Frame(const std::vector<int> &entities)
+{
+  // Broadphase candidates, filtered to interfaces
+  V<std::pair<int, int>> interfaces;
+  for (size_t i = 0; i < entities.size(); i++)
+  {
+    for (size_t j = i + 1; j < entities.size() && j < i + 4; j++)
+      interfaces.push_back(std::make_pair(entities[i], entities[j]));
+  }
+
+  interfaces.erase(std::remove_if(interfaces.begin(), interfaces.end(),
+                                  [](const std::pair<int, int> &p) { return ((p.first + p.second) & 1) == 1; }),
+                   interfaces.end());
+
+  // Objects deferred to be rendered last
+  V<const int *> deferred;
+  for (size_t i = 0; i < entities.size(); i += 4)
+    deferred.push_back(&entities[i]);
+
+  // Log message
+  S message("TRACE [PhysicsSimulation] Detected interfaces this step: ");
+  message += (char)('0' + interfaces.size() % 10);
+  message += ", deferred renderables: ";
+  message += (char)('0' + deferred.size() % 10);
+
+  return interfaces.size() + deferred.size() + message.size();
+}
+}
+
+/**
+ * @brief Counts heap allocations made by the benchmarks.
+ * @param size Number of bytes
+ * @return Pointer to memory
+ */
+void *operator new(size_t size)
+{
+  g_heapAllocations++;
+
+  void *ptr = std::malloc(size > 0 ? size : 1);
+  if (ptr == nullptr)
+    throw std::bad_alloc();
+
+  return ptr;
+}
+
+/**
+ * @brief Frees memory allocated by operator new.
+ * @param ptr Pointer to memory
+ */
+void operator delete(void *ptr) throw()
+{
+  std::free(ptr);
+}
+
+namespace Engine
+{
+namespace Benchmark
+{
+  /**
+   * @brief Counts heap allocations per frame and times a frame of typical
+   *        per-frame temporaries allocated from the heap (baseline) and from
+   *        the FrameArena.
+   * @param o Stream to output results to
+   */
+  void FrameArenaBenchmark(std::ostream &o)
+  {
+    const size_t numFrames = 20000;
+    const size_t numEntities = 200;
+
+    std::vector<int> entities(numEntities);
+    for (size_t i = 0; i < numEntities; i++)
+      entities[i] = (int)i;
+
+    // Warm up the arena so that its first block is not counted
+    FrameArena::Instance().reset();
+
+    // Baseline: temporaries allocated from the heap
+    {
+      size_t checksum = 0;
+      size_t allocations = g_heapAllocations;
+
+      double t = Benchmark::Time([&]() {
+        for (size_t i = 0; i < numFrames; i++)
+          checksum += Frame<HeapVector, HeapString>(entities);
+      });
+
+      allocations = g_heapAllocations - allocations;
+
+      Benchmark::Consume(checksum);
+      Benchmark::Report(o, "heap temporaries (frames)", numFrames, t);
+      o << "heap temporaries: " << ((double)allocations / (double)numFrames) << " heap allocations per frame"
+        << std::endl;
+    }
+
+    // Temporaries allocated from the arena, reset after each frame
+    {
+      size_t checksum = 0;
+      size_t allocations = g_heapAllocations;
+
+      double t = Benchmark::Time([&]() {
+        for (size_t i = 0; i < numFrames; i++)
+        {
+          checksum += Frame<FrameVector, FrameString>(entities);
+          FrameArena::Instance().reset();
+        }
+      });
+
+      allocations = g_heapAllocations - allocations;
+
+      Benchmark::Consume(checksum);
+      Benchmark::Report(o, "arena temporaries (frames)", numFrames, t);
+      o << "arena temporaries: " << ((double)allocations / (double)numFrames) << " heap allocations per frame (peak "
+        << FrameArena::Instance().peakBytesUsed() << " bytes used)" << std::endl;
+    }
+  }
+}
+}
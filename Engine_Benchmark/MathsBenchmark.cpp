@@ -0,0 +1,147 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include "Benchmark.h"
+
+#include <vector>
+
+#include <Engine_Maths/Matrix4.h>
+#include <Engine_Maths/SIMD.h>
+
+using namespace Engine::Maths;
+
+namespace Engine
+{
+namespace Benchmark
+{
+  /**
+   * @brief Compares the scalar and compile time selected SIMD kernels.
+   * @param o Stream to output results to
+   */
+  void MathsBenchmark(std::ostream &o)
+  {
+    const size_t n = 4096;
+    const size_t repeats = 1000;
+
+#if defined(ENGINE_MATHS_AVX)
+    o << "Kernels: AVX" << std::endl;
+#elif defined(ENGINE_MATHS_SSE)
+    o << "Kernels: SSE" << std::endl;
+#else
+    o << "Kernels: scalar" << std::endl;
+#endif
+
+    std::vector<float> a(n * 16);
+    std::vector<float> b(n * 16);
+    std::vector<float> out(n * 16);
+
+    for (size_t i = 0; i < a.size(); i++)
+    {
+      a[i] = (float)(i % 17) * 0.25f - 2.0f;
+      b[i] = (float)(i % 13) * 0.5f - 3.0f;
+    }
+
+    double t;
+
+    // Matrix x matrix
+    t = Benchmark::Time([&]() {
+      for (size_t r = 0; r < repeats; r++)
+        for (size_t i = 0; i < n; i++)
+          ScalarKernels::Mat4Mul(&a[i * 16], &b[i * 16], &out[i * 16]);
+    });
+    Benchmark::Consume(out[0]);
+    Benchmark::Report(o, "Mat4Mul (scalar)", n * repeats, t);
+
+    t = Benchmark::Time([&]() {
+      for (size_t r = 0; r < repeats; r++)
+        for (size_t i = 0; i < n; i++)
+          Kernels::Mat4Mul(&a[i * 16], &b[i * 16], &out[i * 16]);
+    });
+    Benchmark::Consume(out[0]);
+    Benchmark::Report(o, "Mat4Mul (selected)", n * repeats, t);
+
+    // Matrix x vector
+    t = Benchmark::Time([&]() {
+      for (size_t r = 0; r < repeats; r++)
+        for (size_t i = 0; i < n; i++)
+          ScalarKernels::Mat4MulVec4(&a[i * 16], &b[i * 4], &out[i * 4]);
+    });
+    Benchmark::Consume(out[0]);
+    Benchmark::Report(o, "Mat4MulVec4 (scalar)", n * repeats, t);
+
+    t = Benchmark::Time([&]() {
+      for (size_t r = 0; r < repeats; r++)
+        for (size_t i = 0; i < n; i++)
+          Kernels::Mat4MulVec4(&a[i * 16], &b[i * 4], &out[i * 4]);
+    });
+    Benchmark::Consume(out[0]);
+    Benchmark::Report(o, "Mat4MulVec4 (selected)", n * repeats, t);
+
+    // Dot product
+    float sum = 0.0f;
+    t = Benchmark::Time([&]() {
+      for (size_t r = 0; r < repeats; r++)
+        for (size_t i = 0; i < n; i++)
+          sum += ScalarKernels::Dot4(&a[i * 4], &b[i * 4]);
+    });
+    Benchmark::Consume(sum);
+    Benchmark::Report(o, "Dot4 (scalar)", n * repeats, t);
+
+    t = Benchmark::Time([&]() {
+      for (size_t r = 0; r < repeats; r++)
+        for (size_t i = 0; i < n; i++)
+          sum += Kernels::Dot4(&a[i * 4], &b[i * 4]);
+    });
+    Benchmark::Consume(sum);
+    Benchmark::Report(o, "Dot4 (selected)", n * repeats, t);
+
+    // Cross product
+    t = Benchmark::Time([&]() {
+      for (size_t r = 0; r < repeats; r++)
+        for (size_t i = 0; i < n; i++)
+          ScalarKernels::Cross3(&a[i * 3], &b[i * 3], &out[i * 3]);
+    });
+    Benchmark::Consume(out[0]);
+    Benchmark::Report(o, "Cross3 (scalar)", n * repeats, t);
+
+    t = Benchmark::Time([&]() {
+      for (size_t r = 0; r < repeats; r++)
+        for (size_t i = 0; i < n; i++)
+          Kernels::Cross3(&a[i * 3], &b[i * 3], &out[i * 3]);
+    });
+    Benchmark::Consume(out[0]);
+    Benchmark::Report(o, "Cross3 (selected)", n * repeats, t);
+
+    // Normalise
+    t = Benchmark::Time([&]() {
+      for (size_t r = 0; r < repeats; r++)
+        for (size_t i = 0; i < n; i++)
+          ScalarKernels::Normalise3(&a[i * 3]);
+    });
+    Benchmark::Consume(a[0]);
+    Benchmark::Report(o, "Normalise3 (scalar)", n * repeats, t);
+
+    t = Benchmark::Time([&]() {
+      for (size_t r = 0; r < repeats; r++)
+        for (size_t i = 0; i < n; i++)
+          Kernels::Normalise3(&a[i * 3]);
+    });
+    Benchmark::Consume(a[0]);
+    Benchmark::Report(o, "Normalise3 (selected)", n * repeats, t);
+
+    // Matrix4 operator (as used by scene graph)
+    Matrix4 acc;
+    Matrix4 step = Matrix4::Rotation(0.01f, Vector3(0.0f, 1.0f, 0.0f));
+    t = Benchmark::Time([&]() {
+      for (size_t i = 0; i < n * repeats; i++)
+        acc = acc * step;
+    });
+    Benchmark::Consume(acc);
+    Benchmark::Report(o, "Matrix4::operator*", n * repeats, t);
+  }
+}
+}
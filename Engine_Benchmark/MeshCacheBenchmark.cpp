@@ -0,0 +1,155 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include "Benchmark.h"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include <Engine_Graphics/ModelLoader.h>
+#include <Engine_IO/DiskUtils.h>
+
+using namespace Engine::Graphics;
+using namespace Engine::IO;
+
+namespace
+{
+/**
+ * @brief Writes a UV sphere with normals and texture coordinates as a
+ *        Wavefront OBJ file.
+ * @param filename File to write
+ * @param rings Number of rings
+ * @param segments Number of segments
+ * @return True if the file was written
+ */
+bool WriteSphereOBJ(const std::string &filename, size_t rings, size_t segments)
+{
+  std::ofstream file(filename);
+  if (!file.is_open())
+    return false;
+
+  const float pi = 3.14159265f;
+
+  for (size_t r = 0; r <= rings; r++)
+  {
+    const float theta = pi * (float)r / (float)rings;
+
+    for (size_t s = 0; s <= segments; s++)
+    {
+      const float phi = 2.0f * pi * (float)s / (float)segments;
+      const float x = std::sin(theta) * std::cos(phi);
+      const float y = std::cos(theta);
+      const float z = std::sin(theta) * std::sin(phi);
+
+      file << "v " << x << " " << y << " " << z << "\n";
+      file << "vn " << x << " " << y << " " << z << "\n";
+      file << "vt " << ((float)s / (float)segments) << " " << ((float)r / (float)rings) << "\n";
+    }
+  }
+
+  for (size_t r = 0; r < rings; r++)
+  {
+    for (size_t s = 0; s < segments; s++)
+    {
+      const size_t a = r * (segments + 1) + s + 1;
+      const size_t b = a + segments + 1;
+
+      file << "f " << a << "/" << a << "/" << a << " " << b << "/" << b << "/" << b << " " << (a + 1) << "/"
+           << (a + 1) << "/" << (a + 1) << "\n";
+      file << "f " << (a + 1) << "/" << (a + 1) << "/" << (a + 1) << " " << b << "/" << b << "/" << b << " "
+           << (b + 1) << "/" << (b + 1) << "/" << (b + 1) << "\n";
+    }
+  }
+
+  return file.good();
+}
+}
+
+namespace Engine
+{
+namespace Benchmark
+{
+  /**
+   * @brief Times importing a model with Assimp (cold) and from the mesh
+   *        cache (warm).
+   * @param o Stream to output results to
+   */
+  void MeshCacheBenchmark(std::ostream &o)
+  {
+    const size_t numLoads = 20;
+    const std::string modelFile = "meshcache_benchmark.obj";
+    const std::string cacheDir = "meshcache_benchmark";
+
+    if (!WriteSphereOBJ(modelFile, 128, 256))
+    {
+      o << "Cannot write model file " << modelFile << std::endl;
+      return;
+    }
+
+    if (!DiskUtils::Exists(cacheDir) && !DiskUtils::MakeDirectories(cacheDir))
+    {
+      o << "Cannot create cache directory " << cacheDir << std::endl;
+      std::remove(modelFile.c_str());
+      return;
+    }
+
+    const std::string previousCacheDir = ModelLoader::CacheDirectory();
+
+    // Cold: every load is imported by Assimp
+    {
+      ModelLoader::SetCacheDirectory("");
+      size_t loaded = 0;
+
+      double t = Benchmark::Time([&]() {
+        for (size_t i = 0; i < numLoads; i++)
+        {
+          ModelLoader loader;
+          if (loader.import(modelFile))
+            loaded++;
+        }
+      });
+
+      Benchmark::Consume(loaded);
+      Benchmark::Report(o, "cold import (loads)", numLoads, t);
+    }
+
+    // Warm: the first load creates the cache, the rest map it
+    {
+      ModelLoader::SetCacheDirectory(cacheDir);
+
+      {
+        ModelLoader loader;
+        loader.import(modelFile);
+      }
+
+      size_t hits = 0;
+
+      double t = Benchmark::Time([&]() {
+        for (size_t i = 0; i < numLoads; i++)
+        {
+          ModelLoader loader;
+          if (loader.import(modelFile) && loader.cacheHit())
+            hits++;
+        }
+      });
+
+      Benchmark::Consume(hits);
+      Benchmark::Report(o, "warm cache import (loads)", numLoads, t);
+      o << "warm cache import: " << hits << "/" << numLoads << " loads read from cache" << std::endl;
+
+      std::remove(ModelLoader::CacheFilename(modelFile).c_str());
+    }
+
+    ModelLoader::SetCacheDirectory(previousCacheDir);
+
+    RemoveDirectoryA(cacheDir.c_str());
+    std::remove(modelFile.c_str());
+  }
+}
+}
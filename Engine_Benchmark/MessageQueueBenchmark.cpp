@@ -0,0 +1,141 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include "Benchmark.h"
+
+#include <atomic>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <Engine_Common/MessageQueue.h>
+
+using namespace Engine::Common;
+
+namespace
+{
+/**
+ * @brief Runs producer threads that each send a number of messages while the
+ *        calling thread receives them.
+ * @param numProducers Number of producer threads
+ * @param numMessages Number of messages sent by each producer
+ * @param send Function called by producers to send a message, returns false
+ *             if the message should be retried
+ * @param receive Function called by the consumer to receive messages, returns
+ *                the number received
+ */
+template <typename S, typename R> void RunProducers(size_t numProducers, size_t numMessages, S send, R receive)
+{
+  std::atomic<bool> start(false);
+
+  std::vector<std::thread> producers;
+  for (size_t p = 0; p < numProducers; p++)
+  {
+    producers.push_back(std::thread([&start, &send, p, numMessages]() {
+      while (!start)
+        std::this_thread::yield();
+
+      Message msg(Subsystem::PHYSICS, (MessageID)(p + 1));
+      for (size_t i = 0; i < numMessages; i++)
+      {
+        while (!send(msg))
+          std::this_thread::yield();
+      }
+    }));
+  }
+
+  start = true;
+
+  size_t received = 0;
+  while (received < numProducers * numMessages)
+  {
+    size_t n = receive();
+    if (n == 0)
+      std::this_thread::yield();
+
+    received += n;
+  }
+
+  for (auto it = producers.begin(); it != producers.end(); ++it)
+    it->join();
+}
+}
+
+namespace Engine
+{
+namespace Benchmark
+{
+  /**
+   * @brief Times sending messages from 1 to N producer threads to a consumer
+   *        via the lock-free MessageQueue::post and via a mutex guarded
+   *        MessageQueue::push (baseline).
+   * @param o Stream to output results to
+   */
+  void MessageQueueBenchmark(std::ostream &o)
+  {
+    const size_t numMessages = 200000;
+
+    unsigned int maxProducers = std::thread::hardware_concurrency();
+    if (maxProducers < 2)
+      maxProducers = 2;
+
+    for (unsigned int p = 1; p < maxProducers; p++)
+    {
+      const size_t total = numMessages * p;
+
+      // Baseline: all access to the queue is serialised with a mutex
+      {
+        MessageQueue q;
+        std::mutex mutex;
+        Message msg;
+
+        double t = Benchmark::Time([&]() {
+          RunProducers(p, numMessages,
+                       [&](const Message &m) {
+                         std::lock_guard<std::mutex> lock(mutex);
+                         q.push(m);
+                         return true;
+                       },
+                       [&]() {
+                         size_t n = 0;
+                         std::lock_guard<std::mutex> lock(mutex);
+                         while (q.popMessage(Subsystem::PHYSICS, msg))
+                           n++;
+                         return n;
+                       });
+        });
+
+        std::stringstream name;
+        name << "mutex push (" << p << " producers)";
+        Benchmark::Report(o, name.str(), total, t);
+      }
+
+      // Lock-free posting, received by the consumer
+      {
+        MessageQueue q(1024);
+        Message msg;
+
+        double t = Benchmark::Time([&]() {
+          RunProducers(p, numMessages, [&](const Message &m) { return q.post(m); },
+                       [&]() {
+                         size_t n = 0;
+                         q.receivePosted();
+                         while (q.popMessage(Subsystem::PHYSICS, msg))
+                           n++;
+                         return n;
+                       });
+        });
+
+        std::stringstream name;
+        name << "lock-free post (" << p << " producers)";
+        Benchmark::Report(o, name.str(), total, t);
+      }
+    }
+  }
+}
+}
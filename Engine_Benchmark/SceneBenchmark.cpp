@@ -0,0 +1,105 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include "Benchmark.h"
+
+#include <sstream>
+#include <thread>
+
+#include <Engine_Common/JobSystem.h>
+#include <Engine_Common/Scene.h>
+#include <Engine_Common/SceneObject.h>
+
+using namespace Engine::Common;
+using namespace Engine::Maths;
+
+namespace Engine
+{
+namespace Benchmark
+{
+  /**
+   * @brief Times updates of a synthetic 100k node scene with no job system and
+   *        with 1 to N worker threads.
+   * @param o Stream to output results to
+   *
+   * The model matrix of the root is changed before every update so that every
+   * world transform in the scene must be recomputed. The no job system case is
+   * also timed with only a single leaf moving.
+   */
+  void SceneBenchmark(std::ostream &o)
+  {
+    const size_t numNodes = 100000;
+    const size_t branching = 8;
+    const size_t repeats = 20;
+
+    // Build a breadth first tree with eight children per node
+    std::vector<SceneObject *> nodes;
+    nodes.reserve(numNodes);
+    nodes.push_back(new SceneObject("root"));
+    for (size_t i = 1; i < numNodes; i++)
+    {
+      SceneObject *obj = new SceneObject("node", nodes[(i - 1) / branching]);
+      float f = (float)(i % 100);
+      obj->setModelMatrix(Matrix4::Translation(Vector3(f, f * 0.5f, -f)) *
+                          Matrix4::Rotation(f * 3.6f, Vector3(0.0f, 1.0f, 0.0f)));
+      nodes.push_back(obj);
+    }
+
+    Scene scene(nodes[0]);
+    scene.setFlattened(true);
+
+    size_t frame = 0;
+    auto updateScene = [&]() {
+      for (size_t r = 0; r < repeats; r++)
+      {
+        nodes[0]->setModelMatrix(Matrix4::Translation(Vector3(0.0f, 0.0f, (float)frame++)));
+        scene.update(16.0f, Subsystem::PHYSICS);
+      }
+    };
+
+    // Warm up (builds flattened graph)
+    scene.update(16.0f, Subsystem::PHYSICS);
+
+    double t = Benchmark::Time(updateScene);
+    Benchmark::Consume(nodes[numNodes - 1]->worldTransform());
+    Benchmark::Report(o, "100000 nodes (no job system)", numNodes * repeats, t);
+
+    // Only a single leaf moves, so almost every node is unchanged
+    auto updateLeaf = [&]() {
+      for (size_t r = 0; r < repeats; r++)
+      {
+        nodes[numNodes - 1]->setModelMatrix(Matrix4::Translation(Vector3(0.0f, 0.0f, (float)frame++)));
+        scene.update(16.0f, Subsystem::PHYSICS);
+      }
+    };
+
+    t = Benchmark::Time(updateLeaf);
+    Benchmark::Consume(nodes[numNodes - 1]->worldTransform());
+    Benchmark::Report(o, "100000 nodes, one leaf moved (no job system)", numNodes * repeats, t);
+
+    unsigned int maxWorkers = std::thread::hardware_concurrency();
+    if (maxWorkers < 2)
+      maxWorkers = 2;
+
+    for (unsigned int w = 1; w < maxWorkers; w++)
+    {
+      JobSystem jobs(w);
+      scene.setJobSystem(&jobs);
+      scene.setParallelUpdates(Subsystem::PHYSICS, true);
+
+      t = Benchmark::Time(updateScene);
+      Benchmark::Consume(nodes[numNodes - 1]->worldTransform());
+
+      std::stringstream name;
+      name << "100000 nodes (" << w << " workers)";
+      Benchmark::Report(o, name.str(), numNodes * repeats, t);
+
+      scene.setJobSystem(nullptr);
+    }
+  }
+}
+}
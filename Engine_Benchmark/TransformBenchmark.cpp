@@ -0,0 +1,89 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include "Benchmark.h"
+
+#include <sstream>
+#include <vector>
+
+#include <Engine_Maths/TransformBatch.h>
+
+using namespace Engine::Maths;
+
+namespace Engine
+{
+namespace Benchmark
+{
+  /**
+   * @brief Compares computing world matrices one object at a time with
+   *        Matrix4 temporaries against TransformBatch.
+   * @param o Stream to output results to
+   */
+  void TransformBenchmark(std::ostream &o)
+  {
+    const size_t counts[] = {10000, 100000, 1000000};
+    const size_t repeats = 10;
+
+    for (size_t c = 0; c < 3; c++)
+    {
+      const size_t n = counts[c];
+
+      std::vector<Vector3> positions(n);
+      std::vector<Quaternion> rotations(n);
+      std::vector<Vector3> scales(n);
+      std::vector<size_t> parents(n);
+
+      TransformBatch batch;
+      batch.reserve(n);
+
+      for (size_t i = 0; i < n; i++)
+      {
+        float f = (float)(i % 100);
+        positions[i] = Vector3(f, f * 0.5f, -f);
+        rotations[i] = Quaternion(f * 3.6f, Vector3(0.0f, 1.0f, 0.0f));
+        scales[i] = Vector3(1.0f, 1.0f, 1.0f);
+
+        // Eight children per node, parents always precede their children
+        parents[i] = (i == 0) ? TransformBatch::NO_PARENT : (i - 1) / 8;
+
+        batch.add(positions[i], rotations[i], scales[i], parents[i]);
+      }
+
+      std::stringstream name;
+      name << n << " transforms";
+
+      // One object at a time
+      std::vector<Matrix4> world(n);
+      double t = Benchmark::Time([&]() {
+        for (size_t r = 0; r < repeats; r++)
+        {
+          for (size_t i = 0; i < n; i++)
+          {
+            Matrix4 local = Matrix4::Translation(positions[i]) * rotations[i].rotationMatrix() *
+                            Matrix4::Scale(scales[i]);
+
+            if (parents[i] == TransformBatch::NO_PARENT)
+              world[i] = local;
+            else
+              world[i] = world[parents[i]] * local;
+          }
+        }
+      });
+      Benchmark::Consume(world[n - 1]);
+      Benchmark::Report(o, name.str() + " (per object)", n * repeats, t);
+
+      // Batched
+      t = Benchmark::Time([&]() {
+        for (size_t r = 0; r < repeats; r++)
+          batch.update();
+      });
+      Benchmark::Consume(batch.worldMatrix(n - 1));
+      Benchmark::Report(o, name.str() + " (TransformBatch)", n * repeats, t);
+    }
+  }
+}
+}
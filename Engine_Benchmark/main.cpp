@@ -0,0 +1,60 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include <iostream>
+#include <map>
+#include <string>
+
+#include "Benchmark.h"
+
+using namespace Engine::Benchmark;
+
+/**
+ * @brief Entry point of the engine benchmarks.
+ *
+ * Runs the benchmark suites named on the command line, or all suites if none
+ * are given.
+ */
+int main(int argc, char *argv[])
+{
+  std::map<std::string, void (*)(std::ostream &)> suites;
+  suites["maths"] = &MathsBenchmark;
+  suites["transform"] = &TransformBenchmark;
+  suites["scene"] = &SceneBenchmark;
+  suites["queue"] = &MessageQueueBenchmark;
+  suites["arena"] = &FrameArenaBenchmark;
+  suites["meshcache"] = &MeshCacheBenchmark;
+
+  int result = 0;
+
+  if (argc < 2)
+  {
+    for (auto it = suites.begin(); it != suites.end(); ++it)
+    {
+      std::cout << "=== " << it->first << " ===" << std::endl;
+      it->second(std::cout);
+    }
+  }
+  else
+  {
+    for (int i = 1; i < argc; i++)
+    {
+      auto it = suites.find(argv[i]);
+      if (it == suites.end())
+      {
+        std::cerr << "Unknown benchmark suite: " << argv[i] << std::endl;
+        result = 1;
+        continue;
+      }
+
+      std::cout << "=== " << it->first << " ===" << std::endl;
+      it->second(std::cout);
+    }
+  }
+
+  return result;
+}
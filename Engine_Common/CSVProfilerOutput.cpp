@@ -0,0 +1,98 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include "CSVProfilerOutput.h"
+
+using namespace Engine::Utility;
+
+namespace Engine
+{
+namespace Common
+{
+  /**
+   * @brief Creates a new CSV output that writes to a file.
+   * @param filename Output filename
+   */
+  CSVProfilerOutput::CSVProfilerOutput(const std::string &filename)
+      : m_filename(filename)
+      , m_file()
+      , m_stream(nullptr)
+  {
+  }
+
+  /**
+   * @brief Creates a new CSV output that writes to an existing stream.
+   * @param stream Output stream (must outlive this output)
+   */
+  CSVProfilerOutput::CSVProfilerOutput(std::ostream &stream)
+      : m_filename()
+      , m_file()
+      , m_stream(&stream)
+  {
+  }
+
+  CSVProfilerOutput::~CSVProfilerOutput()
+  {
+  }
+
+  /**
+   * @copydoc IProfilerOutput::open
+   *
+   * Writes the column headings.
+   */
+  bool CSVProfilerOutput::open()
+  {
+    if (!m_filename.empty())
+    {
+      m_file.open(m_filename);
+      if (!m_file.is_open())
+        return false;
+
+      m_stream = &m_file;
+    }
+
+    // Times are output in milliseconds to microsecond resolution
+    m_stream->setf(std::ios::fixed, std::ios::floatfield);
+    m_stream->precision(3);
+
+    *m_stream << "time_ms,profile,rate,avg_ms,p50_ms,p90_ms,p99_ms,max_ms,missed" << std::endl;
+    return true;
+  }
+
+  /**
+   * @copydoc IProfilerOutput::close
+   */
+  bool CSVProfilerOutput::close()
+  {
+    if (m_filename.empty())
+      return true;
+
+    m_file.close();
+    m_stream = nullptr;
+    return !m_file.is_open();
+  }
+
+  /**
+   * @copydoc IProfilerOutput::write
+   */
+  void CSVProfilerOutput::write(Clock::Nanoseconds time, const std::vector<ProfileStats> &stats)
+  {
+    if (m_stream == nullptr)
+      return;
+
+    const double timeMilliSec = Clock::ToMilliSec(time);
+    for (auto it = stats.begin(); it != stats.end(); ++it)
+    {
+      *m_stream << timeMilliSec << ",\"" << it->name << "\"," << it->frameRate << "," << it->avgDuration << ","
+                << it->p50Duration << "," << it->p90Duration << "," << it->p99Duration << "," << it->maxDuration
+                << "," << it->missed << "\n";
+    }
+
+    m_stream->flush();
+  }
+}
+}
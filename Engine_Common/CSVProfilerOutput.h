@@ -0,0 +1,44 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#ifndef _ENGINE_COMMON_CSVPROFILEROUTPUT_H_
+#define _ENGINE_COMMON_CSVPROFILEROUTPUT_H_
+
+#include "IProfilerOutput.h"
+
+#include <fstream>
+#include <ostream>
+
+namespace Engine
+{
+namespace Common
+{
+  /**
+   * @class CSVProfilerOutput
+   * @brief Profiler output that records statistics as comma separated values, one row per profile per time frame.
+   * @author Dan Nixon
+   */
+  class CSVProfilerOutput : public IProfilerOutput
+  {
+  public:
+    CSVProfilerOutput(const std::string &filename);
+    CSVProfilerOutput(std::ostream &stream);
+    virtual ~CSVProfilerOutput();
+
+    virtual bool open();
+    virtual bool close();
+    virtual void write(Engine::Utility::Clock::Nanoseconds time, const std::vector<ProfileStats> &stats);
+
+  private:
+    const std::string m_filename; //!< Output filename (empty if writing to a given stream)
+    std::ofstream m_file;         //!< Output file stream
+    std::ostream *m_stream;       //!< Stream statistics are written to
+  };
+}
+}
+
+#endif
@@ -0,0 +1,216 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include "FlatSceneGraph.h"
+
+#include <limits>
+
+#include <Engine_Maths/TransformBatch.h>
+
+#include "SceneObject.h"
+
+using namespace Engine::Maths;
+
+namespace Engine
+{
+namespace Common
+{
+  const size_t FlatSceneGraph::NO_PARENT = std::numeric_limits<size_t>::max();
+  const size_t FlatSceneGraph::NO_INDEX = std::numeric_limits<size_t>::max();
+
+  /**
+   * @brief Creates a new, empty graph.
+   */
+  FlatSceneGraph::FlatSceneGraph()
+      : m_valid(false)
+  {
+  }
+
+  FlatSceneGraph::~FlatSceneGraph()
+  {
+  }
+
+  /**
+   * @brief Rebuilds the arrays from a tree.
+   * @param root Root node of the tree
+   */
+  void FlatSceneGraph::rebuild(SceneObject *root)
+  {
+    m_nodes.clear();
+    m_parents.clear();
+    m_subtreeEnd.clear();
+    m_local.clear();
+    m_world.clear();
+    m_active.clear();
+    m_dirty.clear();
+    m_versions.clear();
+    m_parentVersions.clear();
+
+    if (root != nullptr)
+      addRecursive(root, NO_PARENT);
+
+    m_valid = true;
+  }
+
+  /**
+   * @brief Propagates world transforms through the graph.
+   * @return Number of world transforms that were recomputed
+   *
+   * Only nodes whose model matrix has changed, or whose parent's world
+   * transform has been recomputed, are updated. Results are written back to
+   * each recomputed SceneObject.
+   */
+  size_t FlatSceneGraph::updateTransforms()
+  {
+    return updateTransforms(0, m_nodes.size());
+  }
+
+  /**
+   * @brief Propagates world transforms through a range of nodes.
+   * @param begin First node
+   * @param end Node after the last node (exclusive)
+   * @return Number of world transforms that were recomputed
+   *
+   * The parent of the first node must already be up to date. Ranges that do
+   * not overlap and whose parents are up to date (e.g. disjoint subtrees) may
+   * be updated concurrently.
+   */
+  size_t FlatSceneGraph::updateTransforms(size_t begin, size_t end)
+  {
+    size_t updates = 0;
+
+    for (size_t i = begin; i < end; i++)
+    {
+      // Skip inactive subtrees, they are updated once active again
+      if (!m_active[i])
+      {
+        i = m_subtreeEnd[i] - 1;
+        continue;
+      }
+
+      const size_t p = m_parents[i];
+
+      bool recompute = m_dirty[i] != 0;
+      if (p != NO_PARENT)
+        recompute |= m_parentVersions[i] != m_versions[p];
+
+      if (!recompute)
+        continue;
+
+      if (p == NO_PARENT)
+      {
+        m_world[i] = m_local[i];
+      }
+      else
+      {
+        TransformBatch::Concatenate(m_world[p], 1, &m_local[i], &m_world[i]);
+        m_parentVersions[i] = m_versions[p];
+      }
+
+      m_dirty[i] = 0;
+      m_versions[i]++;
+
+      SceneObject *node = m_nodes[i];
+      node->m_worldTransform = m_world[i];
+      node->m_transformDirty = false;
+      node->m_transformVersion = m_versions[i];
+      node->m_parentTransformVersion = m_parentVersions[i];
+
+      updates++;
+    }
+
+    SceneObject::s_transformUpdates += updates;
+
+    return updates;
+  }
+
+  /**
+   * @brief Marks the model matrix of an object as changed (called
+   *        automatically).
+   * @param node Object whose model matrix has changed
+   */
+  void FlatSceneGraph::setLocalMatrix(SceneObject *node)
+  {
+    if (!contains(node))
+      return;
+
+    const size_t i = node->m_flatIndex;
+    m_local[i] = node->m_modelMatrix;
+    m_dirty[i] = 1;
+  }
+
+  /**
+   * @brief Updates the active state of an object (called automatically).
+   * @param node Object whose active state has changed
+   */
+  void FlatSceneGraph::setActive(SceneObject *node)
+  {
+    if (contains(node))
+      m_active[node->m_flatIndex] = node->m_active;
+  }
+
+  /**
+   * @brief Recomputes the world transform of a single object if it has
+   *        changed since the last transform update.
+   * @param node Object to update
+   *
+   * Used when objects are updated so that changes made by objects updated
+   * earlier in the same pass are picked up. Objects added since the graph was
+   * last rebuilt are updated directly.
+   */
+  void FlatSceneGraph::updateTransform(SceneObject *node)
+  {
+    // The object is already being updated, so check its own state first
+    if (!node->m_transformDirty &&
+        (node->m_parent == nullptr || node->m_parentTransformVersion == node->m_parent->m_transformVersion))
+      return;
+
+    if (contains(node))
+      updateTransforms(node->m_flatIndex, node->m_flatIndex + 1);
+    else
+      node->updateWorldTransform();
+  }
+
+  /**
+   * @brief Checks if an object is in the graph.
+   * @param node Object
+   * @return True if node has an index in the current arrays
+   */
+  bool FlatSceneGraph::contains(const SceneObject *node) const
+  {
+    const size_t i = node->m_flatIndex;
+    return m_valid && i < m_nodes.size() && m_nodes[i] == node;
+  }
+
+  /**
+   * @brief Adds a node and its children to the arrays in depth first order.
+   * @param node Node to add
+   * @param parent Index of the parent node
+   */
+  void FlatSceneGraph::addRecursive(SceneObject *node, size_t parent)
+  {
+    const size_t idx = m_nodes.size();
+
+    node->m_flatIndex = idx;
+
+    m_nodes.push_back(node);
+    m_parents.push_back(parent);
+    m_subtreeEnd.push_back(idx + 1);
+    m_local.push_back(node->m_modelMatrix);
+    m_world.push_back(node->m_worldTransform);
+    m_active.push_back(node->m_active);
+    m_dirty.push_back(node->m_transformDirty);
+    m_versions.push_back(node->m_transformVersion);
+    m_parentVersions.push_back(node->m_parentTransformVersion);
+
+    for (auto it = node->m_children.begin(); it != node->m_children.end(); ++it)
+      addRecursive(*it, idx);
+
+    m_subtreeEnd[idx] = m_nodes.size();
+  }
+}
+}
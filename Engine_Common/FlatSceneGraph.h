@@ -0,0 +1,161 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#ifndef _ENGINE_COMMON_FLATSCENEGRAPH_H_
+#define _ENGINE_COMMON_FLATSCENEGRAPH_H_
+
+#include <vector>
+
+#include <Engine_Maths/Matrix4.h>
+
+namespace Engine
+{
+namespace Common
+{
+  class SceneObject;
+
+  /**
+   * @class FlatSceneGraph
+   * @brief Stores a SceneObject tree in depth first order in contiguous
+   *        arrays so that transforms can be propagated with a linear pass.
+   * @author Dan Nixon
+   *
+   * The parent of every node appears before the node itself. The arrays must
+   * be rebuilt whenever the topology of the tree changes.
+   *
+   * Once built, the arrays hold the transform state of the tree. Objects mark
+   * changes to their model matrix and active state in them, and world
+   * transforms are only written back to the objects that are recomputed.
+   * Transforms in subtrees under an inactive node are not propagated until
+   * it is active again.
+   */
+  class FlatSceneGraph
+  {
+  public:
+    static const size_t NO_PARENT; //!< Parent index of the root node
+    static const size_t NO_INDEX;  //!< Index of objects that are not in a graph
+
+    FlatSceneGraph();
+    virtual ~FlatSceneGraph();
+
+    /**
+     * @brief Marks the graph as requiring a rebuild.
+     */
+    inline void invalidate()
+    {
+      m_valid = false;
+    }
+
+    /**
+     * @brief Checks if the graph reflects the current tree topology.
+     * @return True if the graph is valid
+     */
+    inline bool valid() const
+    {
+      return m_valid;
+    }
+
+    void rebuild(SceneObject *root);
+    size_t updateTransforms();
+    size_t updateTransforms(size_t begin, size_t end);
+
+    void setLocalMatrix(SceneObject *node);
+    void setActive(SceneObject *node);
+    void updateTransform(SceneObject *node);
+
+    /**
+     * @brief Gets the number of nodes in the graph.
+     * @return Number of nodes
+     */
+    inline size_t size() const
+    {
+      return m_nodes.size();
+    }
+
+    /**
+     * @brief Gets a node.
+     * @param idx Node index
+     * @return Node
+     */
+    inline SceneObject *node(size_t idx) const
+    {
+      return m_nodes[idx];
+    }
+
+    /**
+     * @brief Gets the index of the parent of a node.
+     * @param idx Node index
+     * @return Parent index, FlatSceneGraph::NO_PARENT for the root node
+     */
+    inline size_t parent(size_t idx) const
+    {
+      return m_parents[idx];
+    }
+
+    /**
+     * @brief Gets the index one past the last descendant of a node.
+     * @param idx Node index
+     * @return End of subtree (exclusive)
+     *
+     * Nodes in [idx, subtreeEnd(idx)) form the subtree rooted at idx.
+     */
+    inline size_t subtreeEnd(size_t idx) const
+    {
+      return m_subtreeEnd[idx];
+    }
+
+    /**
+     * @brief Gets the local matrix of a node.
+     * @param idx Node index
+     * @return Local matrix
+     */
+    inline const Engine::Maths::Matrix4 &localMatrix(size_t idx) const
+    {
+      return m_local[idx];
+    }
+
+    /**
+     * @brief Gets the world matrix of a node (as of the last transform
+     *        update).
+     * @param idx Node index
+     * @return World matrix
+     */
+    inline const Engine::Maths::Matrix4 &worldMatrix(size_t idx) const
+    {
+      return m_world[idx];
+    }
+
+    /**
+     * @brief Gets the active state of a node.
+     * @param idx Node index
+     * @return Active
+     */
+    inline bool active(size_t idx) const
+    {
+      return m_active[idx] != 0;
+    }
+
+  private:
+    bool contains(const SceneObject *node) const;
+    void addRecursive(SceneObject *node, size_t parent);
+
+    bool m_valid; //!< Flag indicating the arrays match the tree topology
+
+    std::vector<SceneObject *> m_nodes;          //!< Nodes in depth first order
+    std::vector<size_t> m_parents;               //!< Parent index of each node
+    std::vector<size_t> m_subtreeEnd;            //!< Index one past the last descendant of each node
+    std::vector<Engine::Maths::Matrix4> m_local; //!< Local matrix of each node
+    std::vector<Engine::Maths::Matrix4> m_world; //!< World matrix of each node
+    std::vector<char> m_active;                  //!< Active flag of each node
+    std::vector<char> m_dirty;                   //!< Flag indicating the local matrix of each node has changed
+    std::vector<unsigned long> m_versions;       //!< Incremented each time the world matrix of a node is recomputed
+    std::vector<unsigned long> m_parentVersions; //!< Version of the parent world matrix each node last used
+  };
+}
+}
+
+#endif
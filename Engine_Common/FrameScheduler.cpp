@@ -0,0 +1,162 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include "FrameScheduler.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace Engine::Utility;
+
+namespace
+{
+/**
+ * @brief Orders scheduled loops by descending priority.
+ */
+struct PriorityOrder
+{
+  PriorityOrder(Engine::Common::GameLoopConfiguration **loops)
+      : m_loops(loops)
+  {
+  }
+
+  bool operator()(const Engine::Common::ScheduledLoop &a, const Engine::Common::ScheduledLoop &b) const
+  {
+    return m_loops[a.id]->priority > m_loops[b.id]->priority;
+  }
+
+  Engine::Common::GameLoopConfiguration **m_loops;
+};
+}
+
+namespace Engine
+{
+namespace Common
+{
+  const Clock::Nanoseconds FrameScheduler::NO_DEADLINE = std::numeric_limits<Clock::Nanoseconds>::max();
+
+  /**
+   * @brief Creates a new scheduler.
+   * @param loops Array of loop configurations (entries may be nullptr)
+   * @param numLoops Number of entries in loops
+   */
+  FrameScheduler::FrameScheduler(GameLoopConfiguration **loops, size_t numLoops)
+      : m_loops(loops)
+      , m_numLoops(numLoops)
+  {
+  }
+
+  FrameScheduler::~FrameScheduler()
+  {
+  }
+
+  /**
+   * @brief Resets the timing of all loops.
+   * @param now Current time
+   */
+  void FrameScheduler::start(Clock::Nanoseconds now)
+  {
+    for (size_t i = 0; i < m_numLoops; i++)
+    {
+      if (m_loops[i] != nullptr)
+        reset(i, now);
+    }
+  }
+
+  /**
+   * @brief Resets the timing of a single loop.
+   * @param id Loop ID
+   * @param now Current time
+   */
+  void FrameScheduler::reset(size_t id, Clock::Nanoseconds now)
+  {
+    m_loops[id]->lastFired = now;
+    m_loops[id]->nextDue = now + Clock::FromMilliSec(m_loops[id]->interval);
+  }
+
+  /**
+   * @brief Gets the time at which the next loop is due.
+   * @return Deadline, FrameScheduler::NO_DEADLINE if there are no loops
+   */
+  Clock::Nanoseconds FrameScheduler::nextDeadline() const
+  {
+    Clock::Nanoseconds deadline = NO_DEADLINE;
+
+    for (size_t i = 0; i < m_numLoops; i++)
+    {
+      if (m_loops[i] != nullptr)
+        deadline = std::min(deadline, m_loops[i]->nextDue);
+    }
+
+    return deadline;
+  }
+
+  /**
+   * @brief Determines which loops are due and advances their timing.
+   * @param now Current time
+   * @param due Vector the due loops are written to, in the order they should
+   *            be run
+   *
+   * Loops are ordered by descending priority, loops of equal priority are
+   * ordered by ID.
+   */
+  void FrameScheduler::poll(Clock::Nanoseconds now, std::vector<ScheduledLoop> &due)
+  {
+    due.clear();
+
+    for (size_t i = 0; i < m_numLoops; i++)
+    {
+      GameLoopConfiguration *loop = m_loops[i];
+      if (loop == nullptr || now < loop->nextDue)
+        continue;
+
+      const size_t first = due.size();
+      // An interval of 0 runs every frame, clamped so that it (or any interval
+      // under 1ns) does not divide by zero
+      const Clock::Nanoseconds interval = std::max(Clock::FromMilliSec(loop->interval), (Clock::Nanoseconds)1);
+
+      if (loop->fixedStep)
+      {
+        const unsigned int maxSteps = std::max(loop->maxCatchUpSteps, 1u);
+
+        // One step for each elapsed interval
+        for (unsigned int step = 0; step < maxSteps && loop->nextDue <= now; step++)
+        {
+          ScheduledLoop s = {i, loop->interval, loop->nextDue, step > 0, 0};
+          due.push_back(s);
+          loop->nextDue += interval;
+        }
+
+        // Drop any steps beyond the catch up limit
+        if (loop->nextDue <= now)
+        {
+          unsigned int skip = (unsigned int)((now - loop->nextDue) / interval) + 1;
+          loop->nextDue += skip * interval;
+
+          if (loop->interval > 0.0f)
+            due[first].missed = skip;
+        }
+      }
+      else
+      {
+        ScheduledLoop s = {i, Clock::ToMilliSecF(now - loop->lastFired), loop->nextDue, false, 0};
+
+        // Deadlines that passed entirely while waiting for this one
+        if (loop->interval > 0.0f)
+          s.missed = (unsigned int)((now - loop->nextDue) / interval);
+
+        due.push_back(s);
+        loop->nextDue = now + interval;
+      }
+
+      loop->lastFired = now;
+    }
+
+    std::stable_sort(due.begin(), due.end(), PriorityOrder(m_loops));
+  }
+}
+}
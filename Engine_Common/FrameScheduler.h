@@ -0,0 +1,70 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#ifndef _ENGINE_COMMON_FRAMESCHEDULER_H_
+#define _ENGINE_COMMON_FRAMESCHEDULER_H_
+
+#include <vector>
+
+#include <Engine_Utility/Clock.h>
+
+#include "GameLoopConfiguration.h"
+
+namespace Engine
+{
+namespace Common
+{
+  /**
+   * @struct ScheduledLoop
+   * @brief Describes a single due execution of a timed loop.
+   */
+  struct ScheduledLoop
+  {
+    size_t id;                                    //!< Loop ID
+    float dt;                                     //!< Time step to pass to the loop (in milliseconds)
+    Engine::Utility::Clock::Nanoseconds deadline; //!< Time at which the loop was due
+    bool catchUp;                                 //!< Flag indicating this is an additional fixed step run to catch up
+    unsigned int missed;                          //!< Number of deadlines dropped before this execution
+  };
+
+  /**
+   * @class FrameScheduler
+   * @brief Determines which timed loops are due and when the next one is due.
+   * @author Dan Nixon
+   *
+   * Variable timestep loops are run once when due and are passed the time
+   * since they last ran. Fixed timestep loops are run once for each interval
+   * that has elapsed (up to GameLoopConfiguration::maxCatchUpSteps, further
+   * steps are dropped and counted as missed) and are always passed their
+   * interval.
+   *
+   * All times are integer nanoseconds (see Engine::Utility::Clock) so that
+   * deadlines remain exact regardless of uptime. The scheduler only computes
+   * timings, waiting is left to the caller.
+   */
+  class FrameScheduler
+  {
+  public:
+    static const Engine::Utility::Clock::Nanoseconds NO_DEADLINE; //!< Deadline returned when no loops are configured
+
+    FrameScheduler(GameLoopConfiguration **loops, size_t numLoops);
+    virtual ~FrameScheduler();
+
+    void start(Engine::Utility::Clock::Nanoseconds now);
+    void reset(size_t id, Engine::Utility::Clock::Nanoseconds now);
+
+    Engine::Utility::Clock::Nanoseconds nextDeadline() const;
+    void poll(Engine::Utility::Clock::Nanoseconds now, std::vector<ScheduledLoop> &due);
+
+  private:
+    GameLoopConfiguration **m_loops; //!< Loop configurations (entries may be nullptr)
+    size_t m_numLoops;               //!< Number of entries in m_loops
+  };
+}
+}
+
+#endif
@@ -11,6 +11,7 @@
 
 #include "Game.h"
 
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 
@@ -26,13 +27,16 @@
 #include <Engine_Logging/Logger.h>
 #include <Engine_Logging/LoggingService.h>
 #include <Engine_Logging/ConsoleOutputChannel.h>
+#include <Engine_ResourceManagment/FrameArena.h>
 #include <Engine_ResourceManagment/MemoryManager.h>
 #include <Engine_Utility/StringUtils.h>
+#include <Engine_Utility/TraceProfiler.h>
 #include <Engine_IO/DiskUtils.h>
 
 #include "Profiler.h"
 
 using namespace Engine::Logging;
+using namespace Engine::ResourceManagment;
 using namespace Engine::IO;
 using namespace Engine::Utility;
 
@@ -45,18 +49,28 @@ namespace Engine
 {
 namespace Common
 {
+  const float Game::SPIN_THRESHOLD = 2.0f;
+  const float Game::UPLOAD_BUDGET = 2.0f;
+
   /**
    * @brief Creates a new game instance.
    * @param name Name of the game (as displayed in window title)
    * @param resolution Window resolution
    */
   Game::Game(const std::string &name, std::pair<int, int> resolution)
-      : m_name(name)
+      : m_headless(false)
+      , m_virtualClock(true)
+      , m_virtualTime(0)
+      , m_runDuration(0)
+      , m_uploadBudget(Clock::FromMilliSec(UPLOAD_BUDGET))
+      , m_firstRun(false)
+      , m_saveOnExit(true)
+      , m_name(name)
       , m_windowWidth(resolution.first)
       , m_windowHeight(resolution.second)
+      , m_run(false)
       , m_profiler(nullptr)
-      , m_firstRun(false)
-      , m_saveOnExit(true)
+      , m_scheduler(m_loops, MAX_TIMED_LOOPS)
   {
     // Default logging configuration
     ConsoleOutputChannel * console = new ConsoleOutputChannel();
@@ -71,9 +85,6 @@ namespace Common
     for (Uint8 i = 0; i < MAX_TIMED_LOOPS; i++)
       m_loops[i] = nullptr;
 
-    // Queue timer frequency
-    QueryPerformanceFrequency(&m_freq);
-
     // Set the config file name
     WCHAR path[MAX_PATH];
     char charPath[MAX_PATH];
@@ -127,7 +138,8 @@ namespace Common
       return status;
 
     // Show game specific startup screen
-    this->gameLoadScreen();
+    if (!m_headless)
+      this->gameLoadScreen();
 
     // Check for configuration file
     if (!DiskUtils::Exists(configFilePath()))
@@ -155,30 +167,47 @@ namespace Common
       return status;
 
     // Set time on loops
-    QueryPerformanceCounter(&m_start);
-    for (Uint8 i = 0; i < MAX_TIMED_LOOPS; i++)
+    m_clock.reset();
+    m_virtualTime = 0;
+    m_scheduler.start(timeNanoSec());
+    if (m_profiler != nullptr)
+      m_profiler->m_lastStats = timeNanoSec();
+
+    // Start tracing
+    if (!m_traceFilename.empty())
     {
-      if (m_loops[i] != nullptr)
-        m_loops[i]->lastFired = time();
+      TraceProfiler::SetThreadName("Main");
+      TraceProfiler::Instance().clear();
+      TraceProfiler::Instance().setEnabled(true);
     }
 
     m_run = true;
 
     SDL_Event e;
-    float startTime;
+    Clock::Nanoseconds startTime;
+    std::vector<ScheduledLoop> due;
     while (m_run)
     {
       if (m_profiler)
         m_profiler->m_loopUpdates[Profiler::MAIN_LOOP]++;
 
-      // Handle SDL events
-      while (SDL_PollEvent(&e) == 1)
+      // Receive messages posted from other threads
+      m_msgQueue.receivePosted();
+
+      // Upload resources that have finished loading
+      {
+        PROFILE_SCOPE("Game::processUploads");
+        m_resourceLoader.processUploads(m_uploadBudget);
+      }
+
+      // Handle SDL events (there is no window to receive them when headless)
+      while (!m_headless && SDL_PollEvent(&e) == 1)
       {
         // Start event profiling
         if (m_profiler != nullptr)
         {
           m_profiler->m_loopUpdates[Profiler::EVENTS]++;
-          startTime = time();
+          startTime = m_clock.elapsed();
         }
 
         // Handle quit
@@ -188,44 +217,98 @@ namespace Common
           break;
         }
 
-        // Dispatch event
-        for (IEventHandler::HandlerListIter it = m_eventHandlers.begin();
-             it != m_eventHandlers.end(); ++it)
-          (*it)->handleEvent(e);
+        PROFILE_SCOPE("Game::handleEvent");
+
+        if (m_profiler != nullptr)
+          m_profiler->m_eventCounts[e.type]++;
+
+        // Dispatch event to handlers of its type
+        auto typeIt = m_typeHandlers.find(e.type);
+        if (typeIt != m_typeHandlers.end())
+        {
+          for (IEventHandler::HandlerListIter it = typeIt->second.begin(); it != typeIt->second.end(); ++it)
+          {
+            if ((*it)->enabled())
+              (*it)->handleEvent(e);
+          }
+        }
+
+        // Dispatch event to handlers of all types
+        for (IEventHandler::HandlerListIter it = m_eventHandlers.begin(); it != m_eventHandlers.end(); ++it)
+        {
+          if ((*it)->enabled())
+            (*it)->handleEvent(e);
+        }
 
         // End event profiling
         if (m_profiler != nullptr)
-          m_profiler->m_duration[Profiler::EVENTS] += time() - startTime;
+          m_profiler->recordDuration(Profiler::EVENTS, m_clock.elapsed() - startTime);
       }
 
-      // Poll timed loops
-      for (Uint8 i = 0; i < MAX_TIMED_LOOPS; i++)
+      // Run due timed loops
+      m_scheduler.poll(timeNanoSec(), due);
+      for (auto it = due.begin(); it != due.end(); ++it)
       {
+        Uint8 i = (Uint8)it->id;
+
+        // Loop may have been removed by a previous loop
         if (m_loops[i] == nullptr)
           continue;
 
-        float t = time();
-        float deltaT = t - m_loops[i]->lastFired;
+        // Skip loops that need a window or GL context
+        if (m_headless && !m_loops[i]->runHeadless)
+          continue;
 
-        // If interval has elapsed
-        if (deltaT >= m_loops[i]->interval)
+        // Start loop profiling (durations always use real time)
+        if (m_profiler != nullptr)
         {
-          // Start loop profiling
-          if (m_profiler != nullptr)
+          startTime = m_clock.elapsed();
+          m_profiler->m_loopUpdates[i]++;
+          m_profiler->m_missedDeadlines[i] += it->missed;
+
+          if (!it->catchUp)
           {
-            m_profiler->m_loopUpdates[i]++;
-            startTime = time();
+            Clock::Nanoseconds lateness = timeNanoSec() - it->deadline;
+            m_profiler->m_jitter[i] += lateness;
+            m_profiler->m_maxJitter[i] = std::max(m_profiler->m_maxJitter[i], lateness);
           }
+        }
 
-          // Dispatch handler
-          m_loops[i]->lastFired = t;
-          this->gameLoop(i, deltaT);
-
-          // End loop profiling
-          if (m_profiler != nullptr)
-            m_profiler->m_duration[i] += time() - startTime;
+        // Dispatch handler
+        {
+          PROFILE_SCOPE(m_loops[i]->traceName);
+          this->gameLoop(i, it->dt);
         }
+
+        // Release temporaries allocated during this tick
+        FrameArena::Instance().reset();
+
+        // End loop profiling
+        if (m_profiler != nullptr)
+          m_profiler->recordDuration(i, m_clock.elapsed() - startTime);
       }
+
+      // Wait until the next loop is due
+      if (m_run)
+        waitUntil(m_scheduler.nextDeadline());
+
+      // Stop after the configured run duration
+      if (m_runDuration > 0 && timeNanoSec() >= m_runDuration)
+        m_run = false;
+    }
+
+    if (m_headless)
+      outputHeadlessSummary();
+
+    // Output trace
+    if (!m_traceFilename.empty())
+    {
+      TraceProfiler::Instance().setEnabled(false);
+
+      if (TraceProfiler::Instance().writeChromeTrace(m_traceFilename))
+        g_log.info("Profiling trace written to " + m_traceFilename);
+      else
+        g_log.error("Failed to write profiling trace to " + m_traceFilename);
     }
 
     // Run game specific shutdown routine
@@ -235,8 +318,21 @@ namespace Common
     if (m_saveOnExit)
       saveConfig();
 
+    // Report managed memory still in use
+    {
+      std::vector<ManagedTypeStats> memStats;
+      MemoryManager::Instance().typeStats(memStats);
+
+      std::stringstream str;
+      str << "Managed memory at exit (" << MemoryManager::Instance().numBytes() << " bytes):";
+      for (auto it = memStats.begin(); it != memStats.end(); ++it)
+        str << std::endl << "  " << it->name << ": " << it->count << " items, " << it->bytes << " bytes";
+
+      g_log.debug(str.str());
+    }
+
     // Free ALL the memory
-    Engine::ResourceManagment::MemoryManager::Instance().releaseAll();
+    MemoryManager::Instance().releaseAll();
 
     return status;
   }
@@ -249,24 +345,170 @@ namespace Common
     m_run = false;
   }
 
+  /**
+   * @brief Configures the game from command line arguments.
+   * @param argc Argument count
+   * @param argv Arguments
+   * @return True if all arguments were recognised
+   *
+   * Supported arguments:
+   *  - --headless: run without a window, GL context or audio
+   *  - --duration <seconds>: exit after a given (simulated) time
+   *  - --realtime: use the real clock when headless
+   *  - --trace <file>: write a trace of profiled scopes to a file on exit
+   */
+  bool Game::parseArguments(int argc, char *argv[])
+  {
+    bool result = true;
+
+    for (int i = 1; i < argc; i++)
+    {
+      std::string arg(argv[i]);
+
+      if (arg == "--headless")
+      {
+        m_headless = true;
+      }
+      else if (arg == "--realtime")
+      {
+        m_virtualClock = false;
+      }
+      else if (arg == "--duration" && i + 1 < argc)
+      {
+        setRunDuration(std::stof(argv[++i]));
+      }
+      else if (arg == "--trace" && i + 1 < argc)
+      {
+        m_traceFilename = argv[++i];
+      }
+      else
+      {
+        g_log.warn("Unrecognised argument: " + arg);
+        result = false;
+      }
+    }
+
+    return result;
+  }
+
+  /**
+   * @brief Sets the time after which the game loop exits.
+   * @param seconds Run duration (in seconds, 0 for no limit)
+   *
+   * When headless with a virtual clock this is simulated time.
+   */
+  void Game::setRunDuration(float seconds)
+  {
+    m_runDuration = (Clock::Nanoseconds)(seconds * 1000.0) * Clock::NS_PER_MS;
+  }
+
   /**
    * @brief Gets the time since startup in milliseconds.
    * @return Time in ms
+   *
+   * Precision degrades with uptime, use Game::timeNanoSec when computing
+   * durations.
    */
   float Game::time() const
   {
-    LARGE_INTEGER t;
-    QueryPerformanceCounter(&t);
-    return (float)((t.QuadPart - m_start.QuadPart) * 1000.0f / m_freq.QuadPart);
+    return Clock::ToMilliSecF(timeNanoSec());
+  }
+
+  /**
+   * @brief Waits until a given time.
+   * @param deadline Time to wait until (as returned by Game::timeNanoSec)
+   *
+   * Sleeps until Game::SPIN_THRESHOLD before the deadline (to account for
+   * scheduler granularity), then spins until the deadline. Returns early if an
+   * SDL event is pending so that input is handled without delay.
+   *
+   * When headless with a virtual clock the simulated time is advanced to the
+   * deadline immediately.
+   */
+  void Game::waitUntil(Clock::Nanoseconds deadline)
+  {
+    if (m_headless && m_virtualClock)
+    {
+      // Nothing would ever advance the clock with no loops configured
+      if (deadline == FrameScheduler::NO_DEADLINE)
+        m_run = false;
+      else
+        m_virtualTime = std::max(m_virtualTime, deadline);
+      return;
+    }
+
+    const Clock::Nanoseconds spinThreshold = Clock::FromMilliSec(SPIN_THRESHOLD);
+    Clock::Nanoseconds remaining = deadline - timeNanoSec();
+
+    while (remaining > spinThreshold)
+    {
+      if (!m_headless && SDL_HasEvents(SDL_FIRSTEVENT, SDL_LASTEVENT))
+        return;
+
+      SDL_Delay(std::max((Uint32)((remaining - spinThreshold) / (2 * Clock::NS_PER_MS)), (Uint32)1));
+
+      if (!m_headless)
+        SDL_PumpEvents();
+
+      remaining = deadline - timeNanoSec();
+    }
+
+    while (timeNanoSec() < deadline)
+      YieldProcessor();
+  }
+
+  /**
+   * @brief Logs a summary of a headless run, including the final profiler
+   *        statistics.
+   */
+  void Game::outputHeadlessSummary()
+  {
+    std::stringstream str;
+    str.precision(3);
+    str << std::fixed << "Headless run complete: " << Clock::ToMilliSec(timeNanoSec()) / 1000.0 << "s simulated in "
+        << m_clock.elapsedMilliSec() / 1000.0 << "s real time";
+    g_log.info(str.str());
+
+    if (m_profiler != nullptr)
+    {
+      m_profiler->computeStats();
+      g_log.info("Profile:\n" + m_profiler->outputAsString());
+    }
   }
 
   /**
    * @brief Adds an event handler to be updated in the game loop.
    * @param handler Event hander to add
+   *
+   * The handler receives events of the types returned by its eventTypes()
+   * function.
    */
   void Game::addEventHandler(IEventHandler *handler)
   {
-    m_eventHandlers.push_back(handler);
+    addEventHandler(handler, handler->eventTypes());
+  }
+
+  /**
+   * @brief Adds an event handler to be updated in the game loop for a given
+   *        set of event types.
+   * @param handler Event hander to add
+   * @param types SDL event types to dispatch to the handler (empty for all
+   *              events)
+   */
+  void Game::addEventHandler(IEventHandler *handler, const IEventHandler::EventTypeList &types)
+  {
+    if (types.empty())
+    {
+      m_eventHandlers.push_back(handler);
+      return;
+    }
+
+    for (auto it = types.begin(); it != types.end(); ++it)
+    {
+      IEventHandler::HandlerList &handlers = m_typeHandlers[*it];
+      if (std::find(handlers.begin(), handlers.end(), handler) == handlers.end())
+        handlers.push_back(handler);
+    }
   }
 
   /**
@@ -278,6 +520,17 @@ namespace Common
     auto it = std::find(m_eventHandlers.begin(), m_eventHandlers.end(), handler);
     if (it != m_eventHandlers.end())
       m_eventHandlers.erase(it);
+
+    for (auto typeIt = m_typeHandlers.begin(); typeIt != m_typeHandlers.end();)
+    {
+      IEventHandler::HandlerList &handlers = typeIt->second;
+      handlers.erase(std::remove(handlers.begin(), handlers.end(), handler), handlers.end());
+
+      if (handlers.empty())
+        typeIt = m_typeHandlers.erase(typeIt);
+      else
+        ++typeIt;
+    }
   }
 
   /**
@@ -333,8 +586,15 @@ namespace Common
     return ((float)m_windowWidth / (float)m_windowHeight);
   }
 
+  /**
+   * @brief Swaps the window buffers and clears the back buffer (does nothing
+   *        when headless).
+   */
   void Game::swapBuffers()
   {
+    if (m_headless)
+      return;
+
     SDL_GL_SwapWindow(m_window);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
   }
@@ -364,6 +624,28 @@ namespace Common
 
     int result = 0;
 
+    m_window = nullptr;
+    m_context = nullptr;
+
+    /* Headless mode only needs timers and TTF (for text layout) */
+    if (m_headless)
+    {
+      g_log.info("Running headless");
+
+      if (SDL_Init(SDL_INIT_TIMER) < 0)
+      {
+        g_log.critical("SDL failed to initialize! SDL Error: " + std::string(SDL_GetError()));
+        result = 1;
+      }
+      else if (TTF_Init() < 0)
+      {
+        g_log.critical("TTF extension failed to initialize! Error: " + std::string(TTF_GetError()));
+        result = 10;
+      }
+
+      return result;
+    }
+
     /* Initialize SDL */
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER | SDL_INIT_JOYSTICK) < 0)
     {
@@ -434,15 +716,25 @@ namespace Common
    */
   void Game::close()
   {
-    SDL_DestroyWindow(m_window);
+    if (m_window != nullptr)
+      SDL_DestroyWindow(m_window);
     m_window = nullptr;
     TTF_Quit();
-    alutExit();
+    if (!m_headless)
+      alutExit();
     SDL_Quit();
     LoggingService::Instance().shutdown();
   }
 
-  Uint8 Game::addTimedLoop(float interval, const std::string &name)
+  /**
+   * @brief Adds a new timed loop.
+   * @param interval Interval between executions (in milliseconds)
+   * @param name Name of the loop
+   * @param priority Priority (loops with higher priority are executed first
+   *                 when due at the same time)
+   * @return Loop ID
+   */
+  Uint8 Game::addTimedLoop(float interval, const std::string &name, int priority)
   {
     Uint8 idx = 0;
     while (m_loops[idx] != nullptr && idx < MAX_TIMED_LOOPS)
@@ -452,13 +744,27 @@ namespace Common
 
     config->interval = interval;
     config->loopName = name;
-    config->lastFired = 0.0f;
+    config->traceName = TraceProfiler::Intern(name);
+    config->lastFired = 0;
+    config->nextDue = Clock::FromMilliSec(interval);
+    config->priority = priority;
+    config->fixedStep = false;
+    config->maxCatchUpSteps = 1;
+    config->runHeadless = true;
 
     m_loops[idx] = config;
 
+    // Loops added while running start from the current time
+    if (m_run)
+      m_scheduler.reset(idx, timeNanoSec());
+
     return idx;
   }
 
+  /**
+   * @brief Removes a timed loop.
+   * @param id Loop ID
+   */
   void Game::removeTimedLoop(Uint8 id)
   {
     if (m_loops[id] != nullptr)
@@ -466,5 +772,42 @@ namespace Common
 
     m_loops[id] = nullptr;
   }
+
+  /**
+   * @brief Sets if a timed loop is executed with a fixed timestep.
+   * @param id Loop ID
+   * @param fixedStep True for a fixed timestep
+   * @param maxCatchUpSteps Max number of steps executed in a single frame when
+   *                        behind, further steps are dropped and counted as
+   *                        missed deadlines
+   *
+   * A fixed timestep loop is always passed its interval as the time step and
+   * is executed once for every interval that has elapsed, this is suitable
+   * for physics simulation.
+   */
+  void Game::setLoopFixedTimestep(Uint8 id, bool fixedStep, unsigned int maxCatchUpSteps)
+  {
+    if (m_loops[id] == nullptr)
+      return;
+
+    m_loops[id]->fixedStep = fixedStep;
+    m_loops[id]->maxCatchUpSteps = maxCatchUpSteps;
+  }
+
+  /**
+   * @brief Sets if a timed loop is executed when running headless.
+   * @param id Loop ID
+   * @param runHeadless True if the loop runs headless
+   *
+   * Loops that render or otherwise need a window or GL context (e.g. the
+   * graphics loop) should be excluded from headless runs.
+   */
+  void Game::setLoopRunsHeadless(Uint8 id, bool runHeadless)
+  {
+    if (m_loops[id] == nullptr)
+      return;
+
+    m_loops[id]->runHeadless = runHeadless;
+  }
 }
 }
@@ -10,16 +10,21 @@
 
 #define NOMINMAX
 
+#include <map>
 #include <string>
 #include <vector>
 
 #include <SDL/SDL.h>
 #include <Windows.h>
 
+#include "FrameScheduler.h"
+#include "GameLoopConfiguration.h"
 #include "IEventHandler.h"
 #include "MessageQueue.h"
 
 #include <Engine_IO/INIKeyValueStore.h>
+#include <Engine_ResourceManagment/ResourceLoader.h>
+#include <Engine_Utility/Clock.h>
 
 namespace Engine
 {
@@ -27,19 +32,6 @@ namespace Common
 {
   class Profiler;
 
-  /**
-   * @struct GameLoopConfiguration
-   * @brief Holds configuration and state for loop timers.
-   */
-  struct GameLoopConfiguration
-  {
-    float lastFired;        //!< Last time the timer fired (in milliseconds)
-    float interval;         //!< Timer interval (in milliseconds)
-    float profileStartTime; //!< Time at which loop began (in milliseconds, for
-                            //! profiling)
-    std::string loopName;   //!< Name of loop
-  };
-
   /**
    * @class Game
    * @author Dan Nixon
@@ -55,14 +47,39 @@ namespace Common
      */
     static const int MAX_TIMED_LOOPS = 8;
 
+    static const float SPIN_THRESHOLD; //!< Time before a deadline at which waiting stops sleeping (in milliseconds)
+    static const float UPLOAD_BUDGET;  //!< Default time spent uploading resources per main loop (in milliseconds)
+
     Game(const std::string &name, std::pair<int, int> resolution);
     virtual ~Game();
 
     int run();
     void exit();
 
+    bool parseArguments(int argc, char *argv[]);
+
     float time() const;
 
+    /**
+     * @brief Gets the time since startup in nanoseconds.
+     * @return Time in ns
+     *
+     * When running headless with a virtual clock this is simulated time.
+     */
+    inline Engine::Utility::Clock::Nanoseconds timeNanoSec() const
+    {
+      return (m_headless && m_virtualClock) ? m_virtualTime : m_clock.elapsed();
+    }
+
+    /**
+     * @brief Gets the engine clock (started when the game loop starts).
+     * @return Engine clock
+     */
+    inline const Engine::Utility::Clock &clock() const
+    {
+      return m_clock;
+    }
+
     /**
      * @brief Returns the name of the game.
      * @return Game name
@@ -100,16 +117,78 @@ namespace Common
 
     /** @} */
 
+    /** @name Headless functions
+     *  @{
+     */
+
+    /**
+     * @brief Sets if the game runs without a window, GL context or audio
+     *        (must be set before Game::run).
+     * @param headless True for headless mode
+     */
+    inline void setHeadless(bool headless)
+    {
+      m_headless = headless;
+    }
+
+    /**
+     * @brief Checks if the game is running without a window, GL context or
+     *        audio.
+     * @return True if headless
+     */
+    inline bool headless() const
+    {
+      return m_headless;
+    }
+
+    /**
+     * @brief Sets if headless mode uses a virtual clock.
+     * @param virtualClock True for a virtual clock
+     *
+     * With a virtual clock time advances directly to the next loop deadline
+     * instead of waiting, so simulated time runs as fast as the loops allow.
+     */
+    inline void setVirtualClock(bool virtualClock)
+    {
+      m_virtualClock = virtualClock;
+    }
+
+    /**
+     * @brief Checks if headless mode uses a virtual clock.
+     * @return True if using a virtual clock
+     */
+    inline bool virtualClock() const
+    {
+      return m_virtualClock;
+    }
+
+    void setRunDuration(float seconds);
+
+    /** @} */
+
+    /**
+     * @brief Sets a file to which a trace of profiled scopes is written when
+     *        the game exits (see Engine::Utility::TraceProfiler).
+     * @param filename Trace filename (empty to disable tracing)
+     */
+    inline void setTraceFilename(const std::string &filename)
+    {
+      m_traceFilename = filename;
+    }
+
     /** @name Timer/loop functions
      *  @{
      */
 
-    Uint8 addTimedLoop(float interval, const std::string &name);
+    Uint8 addTimedLoop(float interval, const std::string &name, int priority = 0);
     void removeTimedLoop(Uint8 id);
+    void setLoopFixedTimestep(Uint8 id, bool fixedStep, unsigned int maxCatchUpSteps = 5);
+    void setLoopRunsHeadless(Uint8 id, bool runHeadless);
 
     /** @} */
 
     void addEventHandler(IEventHandler *handler);
+    void addEventHandler(IEventHandler *handler, const IEventHandler::EventTypeList &types);
     void removeEventHandler(IEventHandler *handler);
 
     /**
@@ -121,6 +200,28 @@ namespace Common
       return m_msgQueue;
     }
 
+    /**
+     * @brief Gets a reference to the resource loader.
+     * @return Reference to resource loader
+     *
+     * Loaded resources are uploaded by the main loop, see
+     * Game::setResourceUploadBudget.
+     */
+    inline Engine::ResourceManagment::ResourceLoader &resourceLoader()
+    {
+      return m_resourceLoader;
+    }
+
+    /**
+     * @brief Sets the time spent uploading loaded resources in each iteration
+     *        of the main loop.
+     * @param milliSec Upload time budget (0 for no limit)
+     */
+    inline void setResourceUploadBudget(float milliSec)
+    {
+      m_uploadBudget = Engine::Utility::Clock::FromMilliSec(milliSec);
+    }
+
     /** @name Configuration functions
      *  @{
      */
@@ -208,12 +309,22 @@ namespace Common
   private:
     int init();
     void close();
+    void waitUntil(Engine::Utility::Clock::Nanoseconds deadline);
+    void outputHeadlessSummary();
 
     SDL_Window *m_window;    //!< SDL window
     SDL_GLContext m_context; //!< GL context
 
-    LARGE_INTEGER m_freq;  //!< Performance counter frequency
-    LARGE_INTEGER m_start; //!< Performance timer start time
+    Engine::Utility::Clock m_clock; //!< Engine clock
+
+    bool m_headless;                                   //!< Flag indicating no window, GL context or audio is created
+    bool m_virtualClock;                               //!< Flag indicating headless mode uses simulated time
+    Engine::Utility::Clock::Nanoseconds m_virtualTime; //!< Current simulated time
+    Engine::Utility::Clock::Nanoseconds m_runDuration; //!< Time after which the game exits (0 for no limit)
+
+    Engine::Utility::Clock::Nanoseconds m_uploadBudget; //!< Time spent uploading resources per main loop iteration
+
+    std::string m_traceFilename; //!< File the profiling trace is written to on exit
 
     std::string m_gameDirectory;  //!< Path to the game save directory
     std::string m_configFilename; //!< Name of the configuration file
@@ -232,10 +343,13 @@ namespace Common
 
     Profiler *m_profiler; //!< Profiler instance
 
-    IEventHandler::HandlerList m_eventHandlers;      //!< List of event handlers
-    GameLoopConfiguration *m_loops[MAX_TIMED_LOOPS]; //!< Configs for timed loops
+    IEventHandler::HandlerList m_eventHandlers;                  //!< List of handlers for all event types
+    std::map<Uint32, IEventHandler::HandlerList> m_typeHandlers; //!< Lists of handlers for specific event types
+    GameLoopConfiguration *m_loops[MAX_TIMED_LOOPS];             //!< Configs for timed loops
 
-    MessageQueue m_msgQueue; //!< Message queue used within this game
+    MessageQueue m_msgQueue;                                    //!< Message queue used within this game
+    FrameScheduler m_scheduler;                                 //!< Scheduler for timed loops
+    Engine::ResourceManagment::ResourceLoader m_resourceLoader; //!< Loader for resources used within this game
   };
 }
 }
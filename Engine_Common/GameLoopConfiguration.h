@@ -0,0 +1,40 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#ifndef _ENGINE_COMMON_GAMELOOPCONFIGURATION_H_
+#define _ENGINE_COMMON_GAMELOOPCONFIGURATION_H_
+
+#include <string>
+
+#include <Engine_Utility/Clock.h>
+
+namespace Engine
+{
+namespace Common
+{
+  /**
+   * @struct GameLoopConfiguration
+   * @brief Holds configuration and state for loop timers.
+   */
+  struct GameLoopConfiguration
+  {
+    Engine::Utility::Clock::Nanoseconds lastFired; //!< Last time the timer fired
+    float interval;                                //!< Timer interval (in milliseconds)
+    Engine::Utility::Clock::Nanoseconds nextDue;   //!< Time at which the loop is next due
+    int priority;                                  //!< Priority (higher priority loops run first when due together)
+    bool fixedStep;                                //!< Flag indicating the loop is run with a fixed timestep
+    unsigned int maxCatchUpSteps;                  //!< Max fixed steps run in one frame when behind
+    bool runHeadless;                              //!< Flag indicating the loop is run in headless mode
+    float profileStartTime;                        //!< Time at which loop began (in milliseconds, for
+                                                   //! profiling)
+    std::string loopName;                          //!< Name of loop
+    const char *traceName;                         //!< Loop name used for trace profiling
+  };
+}
+}
+
+#endif
@@ -37,6 +37,12 @@ namespace Common
      */
     typedef HandlerList::iterator HandlerListIter;
 
+    /**
+     * @typedef EventTypeList
+     * @brief A list of SDL event types.
+     */
+    typedef std::vector<Uint32> EventTypeList;
+
     /**
      * @brief Creates a new event handler that is enabled by default.
      */
@@ -81,12 +87,25 @@ namespace Common
       m_enabled = false;
     }
 
+    /**
+     * @brief Gets the SDL event types this handler processes.
+     * @return List of event types, empty if the handler processes all events
+     *
+     * Used when the handler is added to a Game to select which events are
+     * dispatched to it.
+     */
+    virtual EventTypeList eventTypes() const
+    {
+      return EventTypeList();
+    }
+
     /**
      * @brief Handle an event.
      * @param e Event to handle
      *
      * Implementations must check that m_enabled is true and that the event of
-     * of the correct type.
+     * of the correct type (Game only dispatches events of the types given by
+     * eventTypes() to enabled handlers, but handlers may be called directly).
      */
     virtual void handleEvent(const SDL_Event &e) = 0;
 
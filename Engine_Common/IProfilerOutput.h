@@ -0,0 +1,81 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#ifndef _ENGINE_COMMON_IPROFILEROUTPUT_H_
+#define _ENGINE_COMMON_IPROFILEROUTPUT_H_
+
+#include <string>
+#include <vector>
+
+#include <Engine_Utility/Clock.h>
+
+namespace Engine
+{
+namespace Common
+{
+  /**
+   * @struct ProfileStats
+   * @brief Statistics of a single profile over one Profiler time frame.
+   */
+  struct ProfileStats
+  {
+    std::string name;     //!< Profile name
+    float frameRate;      //!< Iterations per second
+    float avgDuration;    //!< Average duration (milliseconds)
+    float p50Duration;    //!< Median duration (milliseconds)
+    float p90Duration;    //!< 90th percentile duration (milliseconds)
+    float p99Duration;    //!< 99th percentile duration (milliseconds)
+    float maxDuration;    //!< Max duration (milliseconds)
+    unsigned long missed; //!< Missed deadlines
+  };
+
+  /**
+   * @class IProfilerOutput
+   * @brief Interface for outputs that periodically record Profiler
+   *        statistics.
+   * @author Dan Nixon
+   */
+  class IProfilerOutput
+  {
+  public:
+    IProfilerOutput()
+    {
+    }
+
+    virtual ~IProfilerOutput()
+    {
+    }
+
+    /**
+     * @brief Opens the output.
+     * @return True if the output was successfully opened.
+     */
+    virtual bool open()
+    {
+      return true;
+    }
+
+    /**
+     * @brief Closes the output.
+     * @return True if the output was successfully closed.
+     */
+    virtual bool close()
+    {
+      return true;
+    }
+
+    /**
+     * @brief Records the statistics of one time frame.
+     * @param time Game time at which the statistics were computed
+     * @param stats Statistics of each active profile
+     */
+    virtual void write(Engine::Utility::Clock::Nanoseconds time, const std::vector<ProfileStats> &stats) = 0;
+  };
+}
+}
+
+#endif
@@ -0,0 +1,101 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include "JSONProfilerOutput.h"
+
+#include <Engine_Utility/StringUtils.h>
+
+using namespace Engine::Utility;
+
+namespace Engine
+{
+namespace Common
+{
+  /**
+   * @brief Creates a new JSON output that writes to a file.
+   * @param filename Output filename
+   */
+  JSONProfilerOutput::JSONProfilerOutput(const std::string &filename)
+      : m_filename(filename)
+      , m_file()
+      , m_stream(nullptr)
+  {
+  }
+
+  /**
+   * @brief Creates a new JSON output that writes to an existing stream.
+   * @param stream Output stream (must outlive this output)
+   */
+  JSONProfilerOutput::JSONProfilerOutput(std::ostream &stream)
+      : m_filename()
+      , m_file()
+      , m_stream(&stream)
+  {
+  }
+
+  JSONProfilerOutput::~JSONProfilerOutput()
+  {
+  }
+
+  /**
+   * @copydoc IProfilerOutput::open
+   */
+  bool JSONProfilerOutput::open()
+  {
+    if (!m_filename.empty())
+    {
+      m_file.open(m_filename);
+      if (!m_file.is_open())
+        return false;
+
+      m_stream = &m_file;
+    }
+
+    // Times are output in milliseconds to microsecond resolution
+    m_stream->setf(std::ios::fixed, std::ios::floatfield);
+    m_stream->precision(3);
+
+    return true;
+  }
+
+  /**
+   * @copydoc IProfilerOutput::close
+   */
+  bool JSONProfilerOutput::close()
+  {
+    if (m_filename.empty())
+      return true;
+
+    m_file.close();
+    m_stream = nullptr;
+    return !m_file.is_open();
+  }
+
+  /**
+   * @copydoc IProfilerOutput::write
+   */
+  void JSONProfilerOutput::write(Clock::Nanoseconds time, const std::vector<ProfileStats> &stats)
+  {
+    if (m_stream == nullptr)
+      return;
+
+    *m_stream << "{\"time_ms\":" << Clock::ToMilliSec(time) << ",\"profiles\":[";
+
+    for (auto it = stats.begin(); it != stats.end(); ++it)
+    {
+      *m_stream << (it == stats.begin() ? "" : ",") << "{\"name\":\"" << StringUtils::EscapeJSON(it->name)
+                << "\",\"rate\":" << it->frameRate << ",\"avg_ms\":" << it->avgDuration
+                << ",\"p50_ms\":" << it->p50Duration << ",\"p90_ms\":" << it->p90Duration
+                << ",\"p99_ms\":" << it->p99Duration << ",\"max_ms\":" << it->maxDuration
+                << ",\"missed\":" << it->missed << "}";
+    }
+
+    *m_stream << "]}\n";
+    m_stream->flush();
+  }
+}
+}
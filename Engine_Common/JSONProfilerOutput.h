@@ -0,0 +1,44 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#ifndef _ENGINE_COMMON_JSONPROFILEROUTPUT_H_
+#define _ENGINE_COMMON_JSONPROFILEROUTPUT_H_
+
+#include "IProfilerOutput.h"
+
+#include <fstream>
+#include <ostream>
+
+namespace Engine
+{
+namespace Common
+{
+  /**
+   * @class JSONProfilerOutput
+   * @brief Profiler output that records statistics as JSON lines, one object per time frame.
+   * @author Dan Nixon
+   */
+  class JSONProfilerOutput : public IProfilerOutput
+  {
+  public:
+    JSONProfilerOutput(const std::string &filename);
+    JSONProfilerOutput(std::ostream &stream);
+    virtual ~JSONProfilerOutput();
+
+    virtual bool open();
+    virtual bool close();
+    virtual void write(Engine::Utility::Clock::Nanoseconds time, const std::vector<ProfileStats> &stats);
+
+  private:
+    const std::string m_filename; //!< Output filename (empty if writing to a given stream)
+    std::ofstream m_file;         //!< Output file stream
+    std::ostream *m_stream;       //!< Stream statistics are written to
+  };
+}
+}
+
+#endif
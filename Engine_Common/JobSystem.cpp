@@ -0,0 +1,290 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <string>
+
+#include <Engine_Utility/TraceProfiler.h>
+
+namespace Engine
+{
+namespace Common
+{
+  /**
+   * @brief Creates a new job system and starts its worker threads.
+   * @param numWorkers Number of worker threads (if zero, one less than the
+   *                   number of hardware threads is used)
+   *
+   * The thread creating the JobSystem is considered its owner and also
+   * executes jobs while waiting.
+   */
+  JobSystem::JobSystem(size_t numWorkers)
+      : m_running(true)
+      , m_queued(0)
+  {
+    if (numWorkers == 0)
+    {
+      unsigned int hw = std::thread::hardware_concurrency();
+      numWorkers = hw > 1 ? hw - 1 : 1;
+    }
+
+    for (size_t i = 0; i <= numWorkers; i++)
+      m_queues.push_back(new WorkQueue());
+
+    m_threadIds.resize(numWorkers + 1);
+    m_threadIds[numWorkers] = std::this_thread::get_id();
+
+    for (size_t i = 0; i < numWorkers; i++)
+    {
+      m_workers.push_back(std::thread(&JobSystem::workerMain, this, i));
+      m_threadIds[i] = m_workers.back().get_id();
+    }
+  }
+
+  /**
+   * @brief Stops and joins all worker threads.
+   *
+   * Jobs still queued are not executed.
+   */
+  JobSystem::~JobSystem()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_wakeMutex);
+      m_running = false;
+    }
+    m_wake.notify_all();
+
+    for (auto it = m_workers.begin(); it != m_workers.end(); ++it)
+      it->join();
+
+    for (auto it = m_queues.begin(); it != m_queues.end(); ++it)
+    {
+      for (auto jIt = (*it)->jobs.begin(); jIt != (*it)->jobs.end(); ++jIt)
+        delete *jIt;
+
+      delete *it;
+    }
+  }
+
+  /**
+   * @brief Creates a new job.
+   * @param function Function to execute
+   * @param parent Parent job (must not have completed)
+   * @return New job
+   * @see JobSystem::run
+   */
+  JobSystem::Job *JobSystem::create(JobFunction function, Job *parent)
+  {
+    Job *job = new Job();
+    job->function = function;
+    job->parent = parent;
+    job->unfinished = 1;
+
+    if (parent != nullptr)
+      parent->unfinished++;
+
+    return job;
+  }
+
+  /**
+   * @brief Queues a job for execution on the queue of the calling thread.
+   * @param job Job to run
+   */
+  void JobSystem::run(Job *job)
+  {
+    WorkQueue *queue = m_queues[queueIndex()];
+
+    {
+      std::lock_guard<std::mutex> lock(m_wakeMutex);
+      m_queued++;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(queue->mutex);
+      queue->jobs.push_back(job);
+    }
+
+    m_wake.notify_one();
+  }
+
+  /**
+   * @brief Waits for a job (and all of its children) to complete, executing
+   *        other jobs while waiting, then frees it.
+   * @param job Job to wait for (must not have a parent)
+   */
+  void JobSystem::wait(Job *job)
+  {
+    const size_t idx = queueIndex();
+
+    while (job->unfinished > 0)
+    {
+      Job *j = next(idx);
+
+      if (j != nullptr)
+        execute(j);
+      else
+        std::this_thread::yield();
+    }
+
+    delete job;
+  }
+
+  /**
+   * @brief Splits a range of indices into jobs.
+   * @param count Number of indices
+   * @param grain Maximum number of indices per job
+   * @param function Function called with the begin and end (exclusive) of
+   *                 each range
+   * @param parent Parent job, if nullptr a new root job is created
+   * @return Parent job (already running)
+   *
+   * If no parent is given the returned job must be passed to JobSystem::wait.
+   */
+  JobSystem::Job *JobSystem::parallelFor(size_t count, size_t grain, std::function<void(size_t, size_t)> function,
+                                         Job *parent)
+  {
+    if (grain == 0)
+      grain = 1;
+
+    Job *root = parent;
+    if (root == nullptr)
+      root = create(JobFunction());
+
+    for (size_t begin = 0; begin < count; begin += grain)
+    {
+      size_t end = std::min(begin + grain, count);
+      run(create([function, begin, end]() { function(begin, end); }, root));
+    }
+
+    if (parent == nullptr)
+      run(root);
+
+    return root;
+  }
+
+  /**
+   * @brief Main loop of a worker thread.
+   * @param idx Index of the queue owned by the worker
+   */
+  void JobSystem::workerMain(size_t idx)
+  {
+    Engine::Utility::TraceProfiler::SetThreadName("Worker " + std::to_string(idx));
+
+    while (m_running)
+    {
+      Job *job = next(idx);
+
+      if (job != nullptr)
+      {
+        execute(job);
+      }
+      else
+      {
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_wake.wait(lock, [this]() { return !m_running || m_queued > 0; });
+      }
+    }
+  }
+
+  /**
+   * @brief Gets the index of the queue owned by the calling thread.
+   * @return Queue index
+   *
+   * Threads not known to the JobSystem use the queue of the owning thread.
+   */
+  size_t JobSystem::queueIndex() const
+  {
+    const std::thread::id id = std::this_thread::get_id();
+
+    for (size_t i = 0; i < m_threadIds.size(); i++)
+    {
+      if (m_threadIds[i] == id)
+        return i;
+    }
+
+    return m_workers.size();
+  }
+
+  /**
+   * @brief Gets the next job to execute, from the back of the given queue or
+   *        stolen from the front of another queue.
+   * @param idx Index of the queue owned by the calling thread
+   * @return Job, nullptr if there are no queued jobs
+   */
+  JobSystem::Job *JobSystem::next(size_t idx)
+  {
+    if (m_queued == 0)
+      return nullptr;
+
+    // Own queue (most recently queued job first)
+    {
+      WorkQueue *queue = m_queues[idx];
+      std::lock_guard<std::mutex> lock(queue->mutex);
+
+      if (!queue->jobs.empty())
+      {
+        Job *job = queue->jobs.back();
+        queue->jobs.pop_back();
+        m_queued--;
+        return job;
+      }
+    }
+
+    // Steal from other queues (oldest job first)
+    const size_t n = m_queues.size();
+    for (size_t i = 1; i < n; i++)
+    {
+      WorkQueue *queue = m_queues[(idx + i) % n];
+      std::lock_guard<std::mutex> lock(queue->mutex);
+
+      if (!queue->jobs.empty())
+      {
+        Job *job = queue->jobs.front();
+        queue->jobs.pop_front();
+        m_queued--;
+        return job;
+      }
+    }
+
+    return nullptr;
+  }
+
+  /**
+   * @brief Executes a job.
+   * @param job Job to execute
+   */
+  void JobSystem::execute(Job *job)
+  {
+    if (job->function)
+      job->function();
+
+    finish(job);
+  }
+
+  /**
+   * @brief Marks a job (or one of its children) as complete.
+   * @param job Job
+   */
+  void JobSystem::finish(Job *job)
+  {
+    // Read before decrementing, a job without a parent may be freed by wait()
+    // as soon as it is complete
+    Job *parent = job->parent;
+
+    if (--job->unfinished > 0)
+      return;
+
+    if (parent != nullptr)
+    {
+      delete job;
+      finish(parent);
+    }
+  }
+}
+}
@@ -0,0 +1,107 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#ifndef _ENGINE_COMMON_JOBSYSTEM_H_
+#define _ENGINE_COMMON_JOBSYSTEM_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Engine
+{
+namespace Common
+{
+  /**
+   * @class JobSystem
+   * @brief Executes jobs on a fixed pool of worker threads using work
+   *        stealing.
+   * @author Dan Nixon
+   *
+   * Each thread (the workers and the thread that owns the JobSystem) has its
+   * own queue. Threads take jobs from the back of their own queue and, when
+   * it is empty, steal from the front of other queues.
+   *
+   * A job may have a parent; a parent is not complete until all of its
+   * children are complete. Jobs without a parent must be passed to
+   * JobSystem::wait, which frees them. Jobs with a parent are freed
+   * automatically when they complete.
+   */
+  class JobSystem
+  {
+  public:
+    /**
+     * @typedef JobFunction
+     * @brief Function executed by a job.
+     */
+    typedef std::function<void()> JobFunction;
+
+    /**
+     * @struct Job
+     * @brief A unit of work.
+     */
+    struct Job
+    {
+      JobFunction function;        //!< Function to execute (may be empty)
+      Job *parent;                 //!< Parent job
+      std::atomic<int> unfinished; //!< Number of unfinished jobs (self and children)
+    };
+
+    JobSystem(size_t numWorkers = 0);
+    virtual ~JobSystem();
+
+    /**
+     * @brief Gets the number of worker threads (excluding the owning
+     *        thread).
+     * @return Number of workers
+     */
+    inline size_t numWorkers() const
+    {
+      return m_workers.size();
+    }
+
+    Job *create(JobFunction function, Job *parent = nullptr);
+    void run(Job *job);
+    void wait(Job *job);
+
+    Job *parallelFor(size_t count, size_t grain, std::function<void(size_t, size_t)> function,
+                     Job *parent = nullptr);
+
+  private:
+    /**
+     * @struct WorkQueue
+     * @brief Queue of jobs owned by a single thread.
+     */
+    struct WorkQueue
+    {
+      std::mutex mutex;       //!< Mutex protecting the queue
+      std::deque<Job *> jobs; //!< Queued jobs
+    };
+
+    void workerMain(size_t idx);
+    size_t queueIndex() const;
+    Job *next(size_t idx);
+    void execute(Job *job);
+    void finish(Job *job);
+
+    std::vector<std::thread> m_workers;       //!< Worker threads
+    std::vector<std::thread::id> m_threadIds; //!< IDs of all threads with a queue
+    std::vector<WorkQueue *> m_queues;        //!< Queues (one per worker plus owning thread)
+
+    std::atomic<bool> m_running;    //!< Flag indicating workers should keep running
+    std::atomic<size_t> m_queued;   //!< Number of jobs in all queues
+    std::mutex m_wakeMutex;         //!< Mutex for m_wake
+    std::condition_variable m_wake; //!< Signalled when jobs are queued
+  };
+}
+}
+
+#endif
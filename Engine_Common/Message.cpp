@@ -0,0 +1,175 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 2.
+ */
+
+#include "Message.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+/**
+ * @struct MessageRegistry
+ * @brief Storage of interned message names.
+ */
+struct MessageRegistry
+{
+  /**
+   * @brief Creates the registry with the untyped message name reserved.
+   */
+  MessageRegistry()
+      : names(1, std::string())
+  {
+  }
+
+  std::mutex mutex;                                               //!< Mutex guarding the registry
+  std::vector<std::string> names;                                 //!< Names indexed by ID
+  std::unordered_map<std::string, Engine::Common::MessageID> ids; //!< IDs indexed by name
+};
+
+/**
+ * @brief Gets the message registry (constructed on first use so that IDs may
+ *        be interned during static initialisation).
+ * @return Registry
+ */
+MessageRegistry &Registry()
+{
+  static MessageRegistry registry;
+  return registry;
+}
+}
+
+namespace Engine
+{
+namespace Common
+{
+  /**
+   * @brief Gets the ID of a message name, assigning a new ID if the name has
+   *        not been seen before.
+   * @param name Message name
+   * @return Message ID
+   */
+  MessageID Message::Intern(const std::string &name)
+  {
+    if (name.empty())
+      return STRING;
+
+    MessageRegistry &r = Registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    auto it = r.ids.find(name);
+    if (it != r.ids.end())
+      return it->second;
+
+    MessageID id = (MessageID)r.names.size();
+    r.names.push_back(name);
+    r.ids[name] = id;
+    return id;
+  }
+
+  /**
+   * @brief Gets the ID of a message name that has already been interned.
+   * @param name Message name
+   * @param id Reference to store ID in
+   * @return True if the name has been interned
+   */
+  bool Message::Find(const std::string &name, MessageID &id)
+  {
+    MessageRegistry &r = Registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    auto it = r.ids.find(name);
+    if (it == r.ids.end())
+      return false;
+
+    id = it->second;
+    return true;
+  }
+
+  /**
+   * @brief Gets the name of a message ID.
+   * @param id Message ID
+   * @return Message name (empty for unknown or untyped messages)
+   */
+  std::string Message::Name(MessageID id)
+  {
+    MessageRegistry &r = Registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    if (id >= r.names.size())
+      return std::string();
+
+    return r.names[id];
+  }
+
+  /**
+   * @brief Converts a message string (of the form "name[:argument]") to a
+   *        typed message.
+   * @param destination Target subsystem
+   * @param str Message string
+   * @return Message
+   *
+   * The name is the shortest prefix of the string (ending at a ':') that has
+   * been interned, the remainder is the argument. If no prefix is interned
+   * the message is untyped (Message::STRING) and the argument is the entire
+   * string.
+   */
+  Message Message::FromString(Subsystem destination, const std::string &str)
+  {
+    MessageID id;
+    for (size_t pos = str.find(':'); pos != std::string::npos; pos = str.find(':', pos + 1))
+    {
+      if (Find(str.substr(0, pos), id))
+        return Message(destination, id, str.substr(pos + 1));
+    }
+
+    if (Find(str, id))
+      return Message(destination, id);
+
+    return Message(destination, STRING, str);
+  }
+
+  /**
+   * @brief Creates an empty message.
+   */
+  Message::Message()
+      : destination(Subsystem::NONE)
+      , id(STRING)
+  {
+  }
+
+  /**
+   * @brief Creates a new message.
+   * @param destination Target subsystem
+   * @param id Message ID
+   * @param argument Message argument
+   */
+  Message::Message(Subsystem destination, MessageID id, const std::string &argument)
+      : destination(destination)
+      , id(id)
+      , argument(argument)
+  {
+  }
+
+  /**
+   * @brief Gets the message as a string (of the form "name[:argument]").
+   * @return Message string
+   * @see Message::FromString
+   */
+  std::string Message::toString() const
+  {
+    if (id == STRING)
+      return argument;
+
+    if (argument.empty())
+      return Name(id);
+
+    return Name(id) + ":" + argument;
+  }
+}
+}
@@ -0,0 +1,62 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 2.
+ */
+
+#ifndef _ENGINE_COMMON_MESSAGE_H_
+#define _ENGINE_COMMON_MESSAGE_H_
+
+#include <cstdint>
+#include <string>
+
+#include "Subsystem.h"
+
+namespace Engine
+{
+namespace Common
+{
+  /**
+   * @typedef MessageID
+   * @brief Interned message name.
+   */
+  typedef uint32_t MessageID;
+
+  /**
+   * @struct Message
+   * @brief A typed message passed between subsystems via a MessageQueue.
+   *
+   * Message names (e.g. "camera:mode") are interned once with Message::Intern
+   * so that handlers compare integer IDs rather than parsing strings. The
+   * argument holds any data that accompanies the message (e.g. the name of
+   * the selected camera mode).
+   */
+  struct Message
+  {
+    /**
+     * @var STRING
+     * @brief ID of untyped messages, whose argument holds the entire message
+     *        string.
+     */
+    static const MessageID STRING = 0;
+
+    static MessageID Intern(const std::string &name);
+    static bool Find(const std::string &name, MessageID &id);
+    static std::string Name(MessageID id);
+
+    static Message FromString(Subsystem destination, const std::string &str);
+
+    Message();
+    Message(Subsystem destination, MessageID id, const std::string &argument = std::string());
+
+    std::string toString() const;
+
+    Subsystem destination; //!< Subsystem the message is sent to
+    MessageID id;          //!< Message ID
+    std::string argument;  //!< Message argument
+  };
+}
+}
+
+#endif
@@ -7,7 +7,7 @@
 
 #include "MessageQueue.h"
 
-#include <algorithm>
+#include <stdexcept>
 
 namespace Engine
 {
@@ -15,29 +15,212 @@ namespace Common
 {
   /**
    * @brief Create a new message queue.
+   * @param postCapacity Number of posted messages held per subsystem before
+   *                     they are received
    */
-  MessageQueue::MessageQueue()
+  MessageQueue::MessageQueue(size_t postCapacity)
+      : m_nextSequence(0)
+      , m_numMessages(0)
   {
+    for (size_t i = 0; i < NUM_QUEUES; i++)
+    {
+      Subsystem sys = (Subsystem)i;
+      if (sys == Subsystem::NONE || sys == Subsystem::ALL)
+        m_posted[i] = nullptr;
+      else
+        m_posted[i] = new PostedMessageList(postCapacity);
+    }
   }
 
   MessageQueue::~MessageQueue()
   {
+    for (size_t i = 0; i < NUM_QUEUES; i++)
+      delete m_posted[i];
+  }
+
+  /**
+   * @brief Posts a message from any thread, without locking or (for short
+   *        arguments) allocating.
+   * @param msg New message
+   * @return False if too many messages have been posted to the destination
+   *         subsystem since posted messages were last received (the message
+   *         is dropped)
+   *
+   * Posted messages are added to the queue by MessageQueue::receivePosted.
+   */
+  bool MessageQueue::post(const Message &msg)
+  {
+    if (msg.destination == Subsystem::NONE || msg.destination == Subsystem::ALL)
+      throw std::runtime_error("Message must be sent to a single subsystem");
+
+    return m_posted[(size_t)msg.destination]->push(msg);
+  }
+
+  /**
+   * @brief Adds all messages posted from other threads to the queue.
+   * @return Number of messages added
+   *
+   * Must be called from the thread that owns the queue. Messages posted by a
+   * single thread to the same subsystem keep their order.
+   */
+  size_t MessageQueue::receivePosted()
+  {
+    size_t count = 0;
+    Message msg;
+
+    for (size_t i = 0; i < NUM_QUEUES; i++)
+    {
+      if (m_posted[i] == nullptr)
+        continue;
+
+      while (m_posted[i]->pop(msg))
+      {
+        if (push(msg))
+          count++;
+      }
+    }
+
+    return count;
+  }
+
+  /**
+   * @brief Sets if messages with a given ID are coalesced.
+   * @param id Message ID
+   * @param coalesce True to coalesce
+   *
+   * A coalesced message is dropped when it is pushed if an identical message
+   * (same destination, ID and argument) is already queued, e.g. so that
+   * repeated requests to reset something are handled once.
+   */
+  void MessageQueue::setCoalesce(MessageID id, bool coalesce)
+  {
+    if (coalesce)
+    {
+      m_coalesceIDs.insert(id);
+      return;
+    }
+
+    m_coalesceIDs.erase(id);
+
+    // Forget queued messages with this ID
+    for (auto it = m_pendingCoalesce.begin(); it != m_pendingCoalesce.end();)
+    {
+      if (it->id == id)
+        it = m_pendingCoalesce.erase(it);
+      else
+        ++it;
+    }
+  }
+
+  /**
+   * @brief Checks if messages with a given ID are coalesced.
+   * @param id Message ID
+   * @return True if coalesced
+   * @see MessageQueue::setCoalesce
+   */
+  bool MessageQueue::coalesce(MessageID id) const
+  {
+    return m_coalesceIDs.find(id) != m_coalesceIDs.end();
+  }
+
+  /**
+   * @brief Pushes a new message to the queue of its destination subsystem.
+   * @param msg New message
+   * @return False if the message was coalesced with an identical queued
+   *         message
+   */
+  bool MessageQueue::push(const Message &msg)
+  {
+    if (msg.destination == Subsystem::NONE || msg.destination == Subsystem::ALL)
+      throw std::runtime_error("Message must be sent to a single subsystem");
+
+    if (!m_coalesceIDs.empty() && coalesce(msg.id) && !m_pendingCoalesce.insert(CoalesceKey(msg)).second)
+      return false;
+
+    QueuedMessage qm = {m_nextSequence++, msg};
+    m_queues[(size_t)msg.destination].push(std::move(qm));
+    m_numMessages++;
+
+    return true;
+  }
+
+  /**
+   * @brief Pushes a new message to the queue.
+   * @param sys Target subsystem
+   * @param id Message ID
+   * @param argument Message argument
+   * @return False if the message was coalesced with an identical queued
+   *         message
+   */
+  bool MessageQueue::push(Subsystem sys, MessageID id, const std::string &argument)
+  {
+    return push(Message(sys, id, argument));
+  }
+
+  /**
+   * @brief Pushes a new message to the queue.
+   * @param msg New message
+   * @return False if the message was coalesced with an identical queued
+   *         message
+   * @see Message::FromString
+   */
+  bool MessageQueue::push(MessageType msg)
+  {
+    return push(Message::FromString(msg.first, msg.second));
+  }
+
+  /**
+   * @brief Gets the next message on the queue for a given subsystem.
+   * @param sys Target subsystem (Subsystem::ALL for the oldest message)
+   * @return Pointer to next message, nullptr if there are no messages (valid
+   *         until the queue is next modified)
+   */
+  const Message *MessageQueue::peekMessage(Subsystem sys) const
+  {
+    size_t idx = queueIndex(sys);
+    if (idx == NUM_QUEUES)
+      return nullptr;
+
+    return &(m_queues[idx].front().message);
+  }
+
+  /**
+   * @brief Removes the next message on the queue for a given subsystem.
+   * @param sys Target subsystem (Subsystem::ALL for the oldest message)
+   * @param msg Reference to store message in
+   * @return True if a message was removed
+   */
+  bool MessageQueue::popMessage(Subsystem sys, Message &msg)
+  {
+    size_t idx = queueIndex(sys);
+    if (idx == NUM_QUEUES)
+      return false;
+
+    msg = std::move(m_queues[idx].front().message);
+    m_queues[idx].pop();
+    m_numMessages--;
+
+    if (!m_pendingCoalesce.empty() && coalesce(msg.id))
+      m_pendingCoalesce.erase(CoalesceKey(msg));
+
+    return true;
   }
 
   /**
    * @brief Returns the next message on the queue for a given subsystem.
    * @param sys Target subsystem
    * @return Next message
+   * @see Message::toString
    */
   MessageQueue::MessageType MessageQueue::peek(Subsystem sys) const
   {
-    auto it = cfirst(sys);
+    const Message *msg = peekMessage(sys);
 
     // Return empty message if not found
-    if (it == m_queue.end())
+    if (msg == nullptr)
       return MessageQueue::MessageType();
 
-    return *it;
+    return MessageQueue::MessageType(msg->destination, msg->toString());
   }
 
   /**
@@ -45,22 +228,17 @@ namespace Common
    *        removes it from the queue.
    * @param sys Target subsystem
    * @return Next message
+   * @see Message::toString
    */
   MessageQueue::MessageType MessageQueue::pop(Subsystem sys)
   {
-    auto it = first(sys);
+    Message msg;
 
     // Return empty message if not found
-    if (it == m_queue.end())
+    if (!popMessage(sys, msg))
       return MessageQueue::MessageType();
 
-    // Record the messgae
-    MessageQueue::MessageType msg = *it;
-
-    // Remove message from queue
-    m_queue.erase(it);
-
-    return msg;
+    return MessageQueue::MessageType(msg.destination, msg.toString());
   }
 
   /**
@@ -75,10 +253,9 @@ namespace Common
     case Subsystem::NONE:
       return 0;
     case Subsystem::ALL:
-      return m_queue.size();
+      return m_numMessages;
     default:
-      return std::count_if(m_queue.begin(), m_queue.end(),
-                           [sys](MessageQueue::MessageType m) { return m.first == sys; });
+      return m_queues[(size_t)sys].size();
     }
   }
 
@@ -89,29 +266,103 @@ namespace Common
    */
   bool MessageQueue::hasMessage(Subsystem sys) const
   {
-    return cfirst(sys) != m_queue.end();
+    return numMessages(sys) > 0;
   }
 
-  MessageQueue::MessageList::iterator MessageQueue::first(Subsystem sys)
+  /**
+   * @brief Removes and handles the messages queued for a given subsystem.
+   * @param sys Target subsystem (Subsystem::ALL for all, oldest first)
+   * @param handler Function called for each message
+   * @param maxCount Max number of messages to handle (0 for no limit)
+   * @param maxTime Time after which no further messages are handled (0 for
+   *                no limit)
+   * @return Number of messages handled
+   *
+   * Only messages queued when drain is called are handled, messages pushed
+   * by the handler are left for the next drain. Messages left due to the
+   * limits remain queued in order.
+   */
+  size_t MessageQueue::drain(Subsystem sys, MessageHandler handler, size_t maxCount,
+                             Engine::Utility::Clock::Nanoseconds maxTime)
   {
-    if (sys == Subsystem::NONE)
-      return m_queue.end();
+    size_t count = numMessages(sys);
+    if (maxCount > 0 && maxCount < count)
+      count = maxCount;
+
+    const Engine::Utility::Clock::Nanoseconds start = (maxTime > 0) ? Engine::Utility::Clock::Now() : 0;
 
-    if (sys == Subsystem::ALL)
-      return m_queue.begin();
+    Message msg;
+    size_t handled = 0;
+    while (handled < count && popMessage(sys, msg))
+    {
+      handler(msg);
+      handled++;
+
+      if (maxTime > 0 && Engine::Utility::Clock::Now() - start >= maxTime)
+        break;
+    }
+
+    return handled;
+  }
+
+  /**
+   * @brief Creates the key identifying a coalesced message.
+   * @param msg Message
+   */
+  MessageQueue::CoalesceKey::CoalesceKey(const Message &msg)
+      : destination(msg.destination)
+      , id(msg.id)
+      , argument(msg.argument)
+  {
+  }
+
+  /**
+   * @brief Tests if two keys identify identical messages.
+   * @param other Other key
+   * @return True if destination, ID and argument are equal
+   */
+  bool MessageQueue::CoalesceKey::operator==(const CoalesceKey &other) const
+  {
+    return destination == other.destination && id == other.id && argument == other.argument;
+  }
 
-    return std::find_if(m_queue.begin(), m_queue.end(), [sys](MessageQueue::MessageType m) { return m.first == sys; });
+  /**
+   * @brief Hashes a coalesce key.
+   * @param key Key
+   * @return Hash
+   */
+  size_t MessageQueue::CoalesceKeyHash::operator()(const CoalesceKey &key) const
+  {
+    size_t h = std::hash<std::string>()(key.argument);
+    h ^= ((size_t)key.id * 31 + (size_t)key.destination) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    return h;
   }
 
-  MessageQueue::MessageList::const_iterator MessageQueue::cfirst(Subsystem sys) const
+  /**
+   * @brief Gets the index of the queue holding the next message for a given
+   *        subsystem.
+   * @param sys Target subsystem
+   * @return Queue index, NUM_QUEUES if there are no messages
+   *
+   * For Subsystem::ALL this is the queue holding the oldest message.
+   */
+  size_t MessageQueue::queueIndex(Subsystem sys) const
   {
     if (sys == Subsystem::NONE)
-      return m_queue.cend();
+      return NUM_QUEUES;
 
-    if (sys == Subsystem::ALL)
-      return m_queue.cbegin();
+    if (sys != Subsystem::ALL)
+      return m_queues[(size_t)sys].empty() ? NUM_QUEUES : (size_t)sys;
+
+    size_t idx = NUM_QUEUES;
+    for (size_t i = 0; i < NUM_QUEUES; i++)
+    {
+      if (!m_queues[i].empty() &&
+          (idx == NUM_QUEUES || m_queues[i].front().sequence < m_queues[idx].front().sequence))
+        idx = i;
+    }
 
-    return std::find_if(m_queue.begin(), m_queue.end(), [sys](MessageQueue::MessageType m) { return m.first == sys; });
+    return idx;
   }
 }
 }
@@ -8,8 +8,16 @@
 #ifndef _ENGINE_COMMON_MESSAGEQUEUE_H_
 #define _ENGINE_COMMON_MESSAGEQUEUE_H_
 
-#include <vector>
+#include <functional>
+#include <string>
+#include <unordered_set>
+#include <utility>
 
+#include <Engine_Utility/Clock.h>
+#include <Engine_Utility/MPSCRingBuffer.h>
+#include <Engine_Utility/RingBuffer.h>
+
+#include "Message.h"
 #include "Subsystem.h"
 
 namespace Engine
@@ -20,6 +28,15 @@ namespace Common
    * @class MessageQueue
    * @brief Used for queueing messages to be passeed between subsystems.
    * @author Dan Nixon
+   *
+   * Each subsystem has its own FIFO queue so pushing and popping are O(1).
+   * Messages are typed (see Message), the string based MessageType functions
+   * convert to and from typed messages for existing callers.
+   *
+   * Only MessageQueue::post may be called from threads other than the one
+   * that owns the queue (the main loop). Posted messages are held in a bounded
+   * lock-free ring per subsystem until the owner calls
+   * MessageQueue::receivePosted.
    */
   class MessageQueue
   {
@@ -32,23 +49,51 @@ namespace Common
     typedef std::pair<Subsystem, std::string> MessageType;
 
     /**
-     * @typedef MessageList
-     * @brief Underlying storage type for MessageQueue.
+     * @typedef MessageHandler
+     * @brief Function called for each message processed by
+     *        MessageQueue::drain.
+     */
+    typedef std::function<void(const Message &)> MessageHandler;
+
+    /**
+     * @var NUM_QUEUES
+     * @brief Number of subsystem queues (one per Subsystem value).
      */
-    typedef std::vector<MessageType> MessageList;
+    static const size_t NUM_QUEUES = (size_t)Subsystem::USER5 + 1;
+
+    /**
+     * @var DEFAULT_POST_CAPACITY
+     * @brief Default number of posted messages held per subsystem before
+     *        they are received.
+     */
+    static const size_t DEFAULT_POST_CAPACITY = 256;
 
   public:
-    MessageQueue();
+    MessageQueue(size_t postCapacity = DEFAULT_POST_CAPACITY);
     virtual ~MessageQueue();
 
     /**
-     * @brief Pushes a new message to the queue.
-     * @param msg New message
+     * @brief No copy constructor
      */
-    inline void push(MessageType msg)
-    {
-      m_queue.push_back(msg);
-    }
+    MessageQueue(MessageQueue const &) = delete;
+
+    /**
+     * @brief No assign copy constructor
+     */
+    MessageQueue &operator=(MessageQueue const &) = delete;
+
+    bool post(const Message &msg);
+    size_t receivePosted();
+
+    void setCoalesce(MessageID id, bool coalesce);
+    bool coalesce(MessageID id) const;
+
+    bool push(const Message &msg);
+    bool push(Subsystem sys, MessageID id, const std::string &argument = std::string());
+    bool push(MessageType msg);
+
+    const Message *peekMessage(Subsystem sys) const;
+    bool popMessage(Subsystem sys, Message &msg);
 
     MessageType peek(Subsystem sys) const;
     MessageType pop(Subsystem sys);
@@ -56,12 +101,66 @@ namespace Common
     size_t numMessages(Subsystem sys = Subsystem::ALL) const;
     bool hasMessage(Subsystem sys = Subsystem::ALL) const;
 
+    size_t drain(Subsystem sys, MessageHandler handler, size_t maxCount = 0,
+                 Engine::Utility::Clock::Nanoseconds maxTime = 0);
+
   private:
-    MessageList::iterator first(Subsystem sys);
-    MessageList::const_iterator cfirst(Subsystem sys) const;
+    /**
+     * @struct QueuedMessage
+     * @brief A message with the order in which it was pushed.
+     */
+    struct QueuedMessage
+    {
+      uint64_t sequence; //!< Push order (used to find the oldest message across all queues)
+      Message message;   //!< Message
+    };
+
+    /**
+     * @typedef MessageList
+     * @brief Underlying storage type for each subsystem queue.
+     */
+    typedef Engine::Utility::RingBuffer<QueuedMessage> MessageList;
+
+    /**
+     * @typedef PostedMessageList
+     * @brief Storage type for messages posted from other threads.
+     */
+    typedef Engine::Utility::MPSCRingBuffer<Message> PostedMessageList;
+
+    /**
+     * @struct CoalesceKey
+     * @brief Identifies identical coalesced messages.
+     */
+    struct CoalesceKey
+    {
+      CoalesceKey(const Message &msg);
+
+      bool operator==(const CoalesceKey &other) const;
+
+      Subsystem destination; //!< Destination subsystem
+      MessageID id;          //!< Message ID
+      std::string argument;  //!< Message argument
+    };
+
+    /**
+     * @struct CoalesceKeyHash
+     * @brief Hash function for CoalesceKey.
+     */
+    struct CoalesceKeyHash
+    {
+      size_t operator()(const CoalesceKey &key) const;
+    };
+
+    size_t queueIndex(Subsystem sys) const;
 
   private:
-    MessageList m_queue; //!< Queued messages
+    MessageList m_queues[NUM_QUEUES];        //!< Queued messages for each subsystem
+    PostedMessageList *m_posted[NUM_QUEUES]; //!< Posted messages for each subsystem (not yet received)
+    uint64_t m_nextSequence;                 //!< Sequence number of the next message pushed
+    size_t m_numMessages;                    //!< Total number of queued messages
+
+    std::unordered_set<MessageID> m_coalesceIDs;                        //!< IDs of messages that are coalesced
+    std::unordered_set<CoalesceKey, CoalesceKeyHash> m_pendingCoalesce; //!< Keys of queued messages that are coalesced
   };
 }
 }
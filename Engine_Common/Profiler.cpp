@@ -9,21 +9,98 @@
 
 #include <sstream>
 
+#include "SceneObject.h"
+
+using namespace Engine::Utility;
+
 namespace Engine
 {
 namespace Common
 {
+  /**
+   * @brief Gets a readable name for an SDL event type.
+   * @param type Event type
+   * @return Event type name
+   */
+  std::string Profiler::EventTypeName(Uint32 type)
+  {
+    switch (type)
+    {
+    case SDL_QUIT:
+      return "quit";
+    case SDL_WINDOWEVENT:
+      return "window";
+    case SDL_KEYDOWN:
+      return "key down";
+    case SDL_KEYUP:
+      return "key up";
+    case SDL_TEXTINPUT:
+      return "text input";
+    case SDL_MOUSEMOTION:
+      return "mouse motion";
+    case SDL_MOUSEBUTTONDOWN:
+      return "mouse button down";
+    case SDL_MOUSEBUTTONUP:
+      return "mouse button up";
+    case SDL_MOUSEWHEEL:
+      return "mouse wheel";
+    case SDL_JOYAXISMOTION:
+      return "joystick axis";
+    case SDL_JOYBUTTONDOWN:
+      return "joystick button down";
+    case SDL_JOYBUTTONUP:
+      return "joystick button up";
+    default:
+    {
+      std::stringstream str;
+      str << "0x" << std::hex << type;
+      return str.str();
+    }
+    }
+  }
+
   /**
    * @brief Creates a new profiler for a given Game.
    * @param target Game to profile
    */
   Profiler::Profiler(Game *target)
       : m_target(target)
+      , m_lastStats(target->timeNanoSec())
+      , m_lastTransformUpdates(SceneObject::TransformUpdates())
+      , m_transformUpdateRate(0.0f)
   {
+    for (int i = 0; i < NUM_PROFILES; i++)
+    {
+      m_loopUpdates[i] = 0;
+      m_duration[i] = 0;
+      m_jitter[i] = 0;
+      m_maxJitter[i] = 0;
+      m_missedDeadlines[i] = 0;
+
+      m_avgFrameRate[i] = 0.0f;
+      m_avgDuration[i] = 0.0f;
+      m_avgJitter[i] = 0.0f;
+      m_lastMaxJitter[i] = 0.0f;
+      m_lastMissed[i] = 0;
+    }
   }
 
   Profiler::~Profiler()
   {
+    for (auto it = m_outputs.begin(); it != m_outputs.end(); ++it)
+    {
+      (*it)->close();
+      delete *it;
+    }
+  }
+
+  /**
+   * @brief Compute statistics on data accumulated since the last call to
+   *        computeStats, measuring the elapsed time with the engine clock.
+   */
+  void Profiler::computeStats()
+  {
+    computeStats(Clock::ToMilliSecF(m_target->timeNanoSec() - m_lastStats));
   }
 
   /**
@@ -32,17 +109,59 @@ namespace Common
    */
   void Profiler::computeStats(float dtMilliSec)
   {
+    m_lastStats = m_target->timeNanoSec();
+
     for (int i = 0; i < NUM_PROFILES; i++)
     {
       m_avgFrameRate[i] = ((float)m_loopUpdates[i] / dtMilliSec) * 1000.0f;
 
       if (m_loopUpdates[i] > 0)
-        m_avgDuration[i] = m_duration[i] / (float)m_loopUpdates[i];
+      {
+        m_avgDuration[i] = Clock::ToMilliSecF(m_duration[i]) / (float)m_loopUpdates[i];
+        m_avgJitter[i] = Clock::ToMilliSecF(m_jitter[i]) / (float)m_loopUpdates[i];
+      }
       else
+      {
         m_avgDuration[i] = 0.0f;
+        m_avgJitter[i] = 0.0f;
+      }
+
+      m_lastMaxJitter[i] = Clock::ToMilliSecF(m_maxJitter[i]);
+      m_lastMissed[i] = m_missedDeadlines[i];
+      m_lastHistogram[i] = m_histogram[i];
 
       m_loopUpdates[i] = 0;
       m_duration[i] = 0;
+      m_jitter[i] = 0;
+      m_maxJitter[i] = 0;
+      m_missedDeadlines[i] = 0;
+      m_histogram[i].reset();
+    }
+
+    // Counts are reset rather than cleared so no allocation is made in the event loop once each type has been seen
+    m_lastEventCounts = m_eventCounts;
+    for (auto it = m_eventCounts.begin(); it != m_eventCounts.end(); ++it)
+      it->second = 0;
+
+    unsigned long transformUpdates = SceneObject::TransformUpdates();
+    m_transformUpdateRate = ((float)(transformUpdates - m_lastTransformUpdates) / dtMilliSec) * 1000.0f;
+    m_lastTransformUpdates = transformUpdates;
+
+    for (auto it = m_counters.begin(); it != m_counters.end(); ++it)
+    {
+      uint64_t value = it->read();
+      it->rate = ((float)(value - it->last) / dtMilliSec) * 1000.0f;
+      it->last = value;
+    }
+
+    // Record statistics
+    if (!m_outputs.empty())
+    {
+      std::vector<ProfileStats> frameStats;
+      stats(frameStats);
+
+      for (auto it = m_outputs.begin(); it != m_outputs.end(); ++it)
+        (*it)->write(m_lastStats, frameStats);
     }
   }
 
@@ -66,6 +185,149 @@ namespace Common
     return m_avgDuration[idx];
   }
 
+  /**
+   * @brief Gets the average time by which a timed loop started after it was
+   *        due.
+   * @param idx Profile ID
+   * @return Average jitter (milliseconds)
+   */
+  float Profiler::averageJitter(int idx) const
+  {
+    return m_avgJitter[idx];
+  }
+
+  /**
+   * @brief Gets the longest time by which a timed loop started after it was
+   *        due.
+   * @param idx Profile ID
+   * @return Max jitter (milliseconds)
+   */
+  float Profiler::maxJitter(int idx) const
+  {
+    return m_lastMaxJitter[idx];
+  }
+
+  /**
+   * @brief Gets the number of deadlines of a timed loop that were missed
+   *        entirely (or dropped by a fixed timestep loop) in the last time
+   *        frame.
+   * @param idx Profile ID
+   * @return Number of missed deadlines
+   */
+  unsigned long Profiler::missedDeadlines(int idx) const
+  {
+    return m_lastMissed[idx];
+  }
+
+  /**
+   * @brief Gets the execution duration of a profiled loop below which a
+   *        given percentage of iterations completed in the last time frame.
+   * @param idx Profile ID
+   * @param percent Percentile (e.g. 99.0)
+   * @return Duration at percentile (milliseconds)
+   */
+  float Profiler::durationPercentile(int idx, double percent) const
+  {
+    return Clock::ToMilliSecF(m_lastHistogram[idx].percentile(percent));
+  }
+
+  /**
+   * @brief Gets the longest execution duration of a profiled loop in the last
+   *        time frame.
+   * @param idx Profile ID
+   * @return Max execution duration (milliseconds)
+   */
+  float Profiler::maxDuration(int idx) const
+  {
+    return Clock::ToMilliSecF(m_lastHistogram[idx].max());
+  }
+
+  /**
+   * @brief Gets the average number of SceneObject world transforms
+   *        recomputed per second.
+   * @return Transform update rate
+   */
+  float Profiler::transformUpdateRate() const
+  {
+    return m_transformUpdateRate;
+  }
+
+  /**
+   * @brief Gets the average number of SceneObject world transforms
+   *        recomputed per iteration of a profiled loop.
+   * @param idx Profile ID (typically the graphics loop)
+   * @return Transform updates per frame
+   */
+  float Profiler::transformUpdatesPerFrame(int idx) const
+  {
+    if (m_avgFrameRate[idx] <= 0.0f)
+      return 0.0f;
+
+    return m_transformUpdateRate / m_avgFrameRate[idx];
+  }
+
+  /**
+   * @brief Gets the number of events of a given type handled in the last
+   *        time frame.
+   * @param type SDL event type
+   * @return Number of events
+   */
+  unsigned long Profiler::eventCount(Uint32 type) const
+  {
+    auto it = m_lastEventCounts.find(type);
+    if (it == m_lastEventCounts.end())
+      return 0;
+
+    return it->second;
+  }
+
+  /**
+   * @brief Adds a counter whose rate of increase is reported with the
+   *        performance statistics.
+   * @param name Counter name
+   * @param read Function returning the current value of the counter
+   */
+  void Profiler::addCounter(const std::string &name, CounterFunction read)
+  {
+    Counter c;
+    c.name = name;
+    c.read = read;
+    c.last = read();
+    c.rate = 0.0f;
+    m_counters.push_back(c);
+  }
+
+  /**
+   * @brief Gets the average increase per second of a counter.
+   * @param name Counter name
+   * @return Counter rate (zero if no counter has the given name)
+   */
+  float Profiler::counterRate(const std::string &name) const
+  {
+    for (auto it = m_counters.begin(); it != m_counters.end(); ++it)
+    {
+      if (it->name == name)
+        return it->rate;
+    }
+
+    return 0.0f;
+  }
+
+  /**
+   * @brief Gets the average increase of a counter per iteration of a
+   *        profiled loop.
+   * @param name Counter name
+   * @param idx Profile ID (typically the graphics loop)
+   * @return Counter increase per frame
+   */
+  float Profiler::counterPerFrame(const std::string &name, int idx) const
+  {
+    if (m_avgFrameRate[idx] <= 0.0f)
+      return 0.0f;
+
+    return counterRate(name) / m_avgFrameRate[idx];
+  }
+
   /**
    * @brief Outputs friendly formatted performance statistics to a stream.
    * @param o Stream
@@ -94,9 +356,36 @@ namespace Common
       else
         continue;
 
-      o << ": " << m_avgFrameRate[i] << " " << quantity << ", average duration: " << m_avgDuration[i] << "ms"
-        << std::endl;
+      o << ": " << m_avgFrameRate[i] << " " << quantity << ", average duration: " << m_avgDuration[i] << "ms";
+
+      if (i != MAIN_LOOP)
+        o << ", p50/p90/p99/max: " << durationPercentile(i, 50.0) << "/" << durationPercentile(i, 90.0) << "/"
+          << durationPercentile(i, 99.0) << "/" << maxDuration(i) << "ms";
+
+      if (i < Game::MAX_TIMED_LOOPS)
+        o << ", jitter: " << m_avgJitter[i] << "ms (max " << m_lastMaxJitter[i] << "ms), missed: " << m_lastMissed[i];
+
+      o << std::endl;
+    }
+
+    o << "Events by type:";
+    bool first = true;
+    for (auto it = m_lastEventCounts.begin(); it != m_lastEventCounts.end(); ++it)
+    {
+      if (it->second == 0)
+        continue;
+
+      o << (first ? " " : ", ") << EventTypeName(it->first) << ": " << it->second;
+      first = false;
     }
+    if (first)
+      o << " none";
+    o << std::endl;
+
+    o << "Transform updates: " << m_transformUpdateRate << " per second" << std::endl;
+
+    for (auto it = m_counters.begin(); it != m_counters.end(); ++it)
+      o << it->name << ": " << it->rate << " per second" << std::endl;
 
     o.precision(p);
   }
@@ -112,5 +401,77 @@ namespace Common
     str << *this;
     return str.str();
   }
+
+  /**
+   * @brief Gets the statistics of all active profiles for the last time
+   *        frame.
+   * @param out Vector statistics are appended to
+   */
+  void Profiler::stats(std::vector<ProfileStats> &out) const
+  {
+    for (int i = 0; i < NUM_PROFILES; i++)
+    {
+      if (i < Game::MAX_TIMED_LOOPS && m_target->m_loops[i] == nullptr)
+        continue;
+
+      ProfileStats s;
+      s.name = profileName(i);
+      s.frameRate = m_avgFrameRate[i];
+      s.avgDuration = m_avgDuration[i];
+      s.p50Duration = durationPercentile(i, 50.0);
+      s.p90Duration = durationPercentile(i, 90.0);
+      s.p99Duration = durationPercentile(i, 99.0);
+      s.maxDuration = maxDuration(i);
+      s.missed = m_lastMissed[i];
+      out.push_back(s);
+    }
+  }
+
+  /**
+   * @brief Adds an output that statistics are written to each time they are
+   *        computed.
+   * @param output Output (ownership is taken by the profiler)
+   * @return True if the output was opened successfully
+   *
+   * Outputs that fail to open are deleted.
+   */
+  bool Profiler::addOutput(IProfilerOutput *output)
+  {
+    if (!output->open())
+    {
+      delete output;
+      return false;
+    }
+
+    m_outputs.push_back(output);
+    return true;
+  }
+
+  /**
+   * @brief Records the execution duration of one iteration of a profiled
+   *        loop.
+   * @param idx Profile ID
+   * @param duration Execution duration
+   */
+  void Profiler::recordDuration(int idx, Clock::Nanoseconds duration)
+  {
+    m_duration[idx] += duration;
+    m_histogram[idx].record(duration);
+  }
+
+  /**
+   * @brief Gets the name of a profile as used in recorded statistics.
+   * @param idx Profile ID
+   * @return Profile name
+   */
+  std::string Profiler::profileName(int idx) const
+  {
+    if (idx == MAIN_LOOP)
+      return "main";
+    else if (idx == EVENTS)
+      return "events";
+    else
+      return m_target->m_loops[idx]->loopName;
+  }
 }
 }
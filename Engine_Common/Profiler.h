@@ -10,6 +10,15 @@
 
 #include "Game.h"
 
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <vector>
+
+#include <Engine_Utility/LatencyHistogram.h>
+
+#include "IProfilerOutput.h"
+
 namespace Engine
 {
 namespace Common
@@ -19,6 +28,9 @@ namespace Common
    * @brief Utility class for measuring the performance of subsystems in timed
    *        loops of a Game.
    * @author Dan Nixon
+   *
+   * Durations of each profile are recorded in a LatencyHistogram so that tail
+   * latencies (e.g. single slow frames) are reported alongside the average.
    */
   class Profiler
   {
@@ -43,17 +55,57 @@ namespace Common
      */
     static const int EVENTS = Game::MAX_TIMED_LOOPS + 1;
 
+    /**
+     * @typedef EventCountMap
+     * @brief Number of events handled of each SDL event type.
+     */
+    typedef std::map<Uint32, unsigned long> EventCountMap;
+
+    /**
+     * @typedef CounterFunction
+     * @brief Function returning the current value of an increasing counter.
+     */
+    typedef std::function<uint64_t()> CounterFunction;
+
+    static std::string EventTypeName(Uint32 type);
+
     Profiler(Engine::Common::Game *target);
     virtual ~Profiler();
 
     void computeStats(float dtMilliSec);
+    void computeStats();
 
     float frameRate(int idx) const;
     float averageDuration(int idx) const;
+    float averageJitter(int idx) const;
+    float maxJitter(int idx) const;
+    unsigned long missedDeadlines(int idx) const;
+    float durationPercentile(int idx, double percent) const;
+    float maxDuration(int idx) const;
+    float transformUpdateRate() const;
+    float transformUpdatesPerFrame(int idx) const;
+    unsigned long eventCount(Uint32 type) const;
+
+    void addCounter(const std::string &name, CounterFunction read);
+    float counterRate(const std::string &name) const;
+    float counterPerFrame(const std::string &name, int idx) const;
+
+    /**
+     * @brief Gets the number of events handled of each type in the last time
+     *        frame.
+     * @return Event counts (may contain types with a count of zero)
+     */
+    inline const EventCountMap &eventCounts() const
+    {
+      return m_lastEventCounts;
+    }
 
     void outputToStream(std::ostream &o) const;
     std::string outputAsString() const;
 
+    void stats(std::vector<ProfileStats> &out) const;
+    bool addOutput(IProfilerOutput *output);
+
     /**
      * @brief Outputs friendly formatted performance statistics to a stream.
      * @param o Stream
@@ -69,14 +121,51 @@ namespace Common
   private:
     friend class Engine::Common::Game;
 
+    /**
+     * @struct Counter
+     * @brief A counter sampled on each computeStats.
+     */
+    struct Counter
+    {
+      std::string name;     //!< Counter name
+      CounterFunction read; //!< Function returning the current value
+      uint64_t last;        //!< Value at last computeStats
+      float rate;           //!< Average increase per second
+    };
+
+    void recordDuration(int idx, Engine::Utility::Clock::Nanoseconds duration);
+    std::string profileName(int idx) const;
+
     Game *m_target; //!< Game being profiled
 
-    unsigned long m_loopUpdates[NUM_PROFILES]; //!< Counter of updates per time frame
-    float m_duration[NUM_PROFILES];            //!< Cumulative duration of each loop per
-                                               //! time frame
+    Engine::Utility::Clock::Nanoseconds m_lastStats; //!< Time at which statistics were last computed
+
+    unsigned long m_loopUpdates[NUM_PROFILES];                     //!< Counter of updates per time frame
+    Engine::Utility::Clock::Nanoseconds m_duration[NUM_PROFILES];  //!< Cumulative duration of each loop per
+                                                                   //! time frame
+
+    Engine::Utility::Clock::Nanoseconds m_jitter[NUM_PROFILES];    //!< Cumulative lateness of each loop per time frame
+    Engine::Utility::Clock::Nanoseconds m_maxJitter[NUM_PROFILES]; //!< Max lateness of each loop per time frame
+    unsigned long m_missedDeadlines[NUM_PROFILES];                 //!< Counter of missed deadlines per time frame
+    Engine::Utility::LatencyHistogram m_histogram[NUM_PROFILES];   //!< Durations of each loop per time frame
+
+    float m_avgFrameRate[NUM_PROFILES];       //!< Average frame rate for each profile
+    float m_avgDuration[NUM_PROFILES];        //!< Average duration for each profile
+    float m_avgJitter[NUM_PROFILES];          //!< Average lateness for each profile
+    float m_lastMaxJitter[NUM_PROFILES];      //!< Max lateness for each profile
+    unsigned long m_lastMissed[NUM_PROFILES]; //!< Missed deadlines for each profile
+
+    Engine::Utility::LatencyHistogram m_lastHistogram[NUM_PROFILES]; //!< Durations for each profile
+
+    EventCountMap m_eventCounts;     //!< Number of events of each type per time frame
+    EventCountMap m_lastEventCounts; //!< Number of events of each type
+
+    unsigned long m_lastTransformUpdates; //!< SceneObject transform update count at last computeStats
+    float m_transformUpdateRate;          //!< Average SceneObject transform updates per second
+
+    std::vector<Counter> m_counters; //!< Counters sampled on each computeStats
 
-    float m_avgFrameRate[NUM_PROFILES]; //!< Average frame rate for each profile
-    float m_avgDuration[NUM_PROFILES];  //!< Average duration for each profile
+    std::vector<IProfilerOutput *> m_outputs; //!< Outputs statistics are written to on each computeStats
   };
 }
 }
@@ -7,6 +7,11 @@
 
 #include "Scene.h"
 
+#include <algorithm>
+
+#include <Engine_Utility/TraceProfiler.h>
+
+#include "JobSystem.h"
 #include "SceneObject.h"
 
 using namespace Engine::Maths;
@@ -25,14 +30,28 @@ namespace Common
       : m_root(root)
       , m_viewMatrix(view)
       , m_projectionMatrix(projection)
+      , m_flattened(false)
+      , m_jobSystem(nullptr)
+      , m_parallelSubsystems(0)
   {
-    root->addToScene(this);
+    addRootToScene();
   }
 
   Scene::~Scene()
   {
   }
 
+  /**
+   * @brief Adds the tree under the root node to this scene.
+   *
+   * Subclasses call this again once constructed as objects may check the type
+   * of the scene they are added to.
+   */
+  void Scene::addRootToScene()
+  {
+    m_root->addToScene(this);
+  }
+
   /**
    * @brief Sets the view matrix.
    * @param view View matrix
@@ -76,7 +95,156 @@ namespace Common
    */
   void Scene::update(float msec, Subsystem sys)
   {
-    m_root->update(msec, sys);
+    PROFILE_SCOPE("Scene::update");
+
+    if (m_flattened)
+    {
+      if (!m_flatGraph.valid())
+        m_flatGraph.rebuild(m_root);
+
+      if (m_jobSystem != nullptr)
+      {
+        updateParallel(msec, sys);
+        return;
+      }
+
+      // Propagate transforms in a single linear pass
+      m_flatGraph.updateTransforms();
+
+      // Then update each object (SceneObject::update does not recurse)
+      const size_t n = m_flatGraph.size();
+      for (size_t i = 0; i < n; i++)
+        m_flatGraph.node(i)->update(msec, sys);
+    }
+    else
+    {
+      m_root->update(msec, sys);
+    }
+  }
+
+  /**
+   * @brief Sets if the scene is updated using a flattened graph.
+   * @param flattened True to use the flattened graph
+   *
+   * When flattened, transforms are propagated through a depth first ordered
+   * array of nodes before each object is updated in the same order. This is
+   * faster for large trees (e.g. loaded models) and ensures every world
+   * transform is up to date before any object is updated. World transforms
+   * under an inactive object are not updated until it is active again.
+   */
+  void Scene::setFlattened(bool flattened)
+  {
+    m_flattened = flattened;
+    m_flatGraph.invalidate();
+  }
+
+  /**
+   * @brief Sets if objects are updated from worker threads for a given
+   *        subsystem.
+   * @param sys Subsystem
+   * @param parallel True to call SceneObject::update in parallel
+   *
+   * Off by default, in which case only transforms are propagated in parallel
+   * and objects are updated in order on the calling thread. Only enable this
+   * if every SceneObject::update override in the scene is thread safe for the
+   * subsystem (e.g. not FlightSim Aircraft, which uses Bullet, or Audio
+   * Source, which uses OpenAL).
+   *
+   * Has no effect for graphics, which always updates on the calling thread as
+   * it uses the GL context.
+   */
+  void Scene::setParallelUpdates(Subsystem sys, bool parallel)
+  {
+    const uint32_t bit = 1u << static_cast<uint32_t>(sys);
+
+    if (parallel)
+      m_parallelSubsystems |= bit;
+    else
+      m_parallelSubsystems &= ~bit;
+  }
+
+  /**
+   * @brief Checks if objects are updated from worker threads for a given
+   *        subsystem.
+   * @param sys Subsystem
+   * @return True if SceneObject::update is called in parallel
+   * @see Scene::setParallelUpdates
+   */
+  bool Scene::parallelUpdates(Subsystem sys) const
+  {
+    if (sys == Subsystem::GRAPHICS)
+      return false;
+
+    return (m_parallelSubsystems & (1u << static_cast<uint32_t>(sys))) != 0;
+  }
+
+  /**
+   * @brief Updates the flattened graph using the job system.
+   * @param msec Time since last update (in milliseconds)
+   * @param sys Subsystem being updated
+   *
+   * Subtrees small enough to form a single job are updated by workers, nodes
+   * above them (typically the few nodes near the root) are updated on the
+   * calling thread first so that the parent of every job is up to date before
+   * the job can run. Object updates for subsystems that are not parallel
+   * (the default) are performed in depth first order on the calling thread
+   * once all transforms have been propagated.
+   */
+  void Scene::updateParallel(float msec, Subsystem sys)
+  {
+    const size_t n = m_flatGraph.size();
+    const bool parallelObjects = parallelUpdates(sys);
+    const size_t grain = std::max((size_t)64, n / ((m_jobSystem->numWorkers() + 1) * 4));
+
+    FlatSceneGraph &graph = m_flatGraph;
+    JobSystem::Job *root = m_jobSystem->create(JobSystem::JobFunction());
+
+    size_t i = 0;
+    while (i < n)
+    {
+      const size_t end = graph.subtreeEnd(i);
+
+      // Inactive subtrees are skipped by the transform update, so are cheap
+      if (end - i <= grain || !graph.active(i))
+      {
+        // Whole subtree as a single job
+        m_jobSystem->run(m_jobSystem->create(
+            [&graph, i, end, msec, sys, parallelObjects]()
+            {
+              PROFILE_SCOPE("Scene::updateSubtree");
+
+              graph.updateTransforms(i, end);
+
+              if (parallelObjects)
+              {
+                for (size_t j = i; j < end; j++)
+                  graph.node(j)->update(msec, sys);
+              }
+            },
+            root));
+
+        i = end;
+      }
+      else
+      {
+        // Node too large to be a single job, descend into its children
+        graph.updateTransforms(i, i + 1);
+
+        if (parallelObjects)
+          graph.node(i)->update(msec, sys);
+
+        i++;
+      }
+    }
+
+    m_jobSystem->run(root);
+    m_jobSystem->wait(root);
+
+    if (!parallelObjects)
+    {
+      for (size_t j = 0; j < n; j++)
+        graph.node(j)->update(msec, sys);
+    }
   }
 }
 }
@@ -8,15 +8,19 @@
 #ifndef _ENGINE_COMMON_SCENE_H_
 #define _ENGINE_COMMON_SCENE_H_
 
+#include <cstdint>
+
 #include <Engine_Maths/Matrix4.h>
 #include <Engine_ResourceManagment/IMemoryManaged.h>
 
+#include "FlatSceneGraph.h"
 #include "Subsystem.h"
 
 namespace Engine
 {
 namespace Common
 {
+  class JobSystem;
   class SceneObject;
 
   /**
@@ -38,6 +42,61 @@ namespace Common
 
     virtual void update(float msec, Subsystem sys);
 
+    void setFlattened(bool flattened);
+
+    /**
+     * @brief Checks if this scene is updated using a flattened graph.
+     * @return True if flattened
+     * @see Scene::setFlattened
+     */
+    inline bool flattened() const
+    {
+      return m_flattened;
+    }
+
+    /**
+     * @brief Sets the job system used to update the flattened graph in
+     *        parallel.
+     * @param jobs Job system, nullptr to update on the calling thread
+     *
+     * Only used when the scene is flattened.
+     */
+    inline void setJobSystem(JobSystem *jobs)
+    {
+      m_jobSystem = jobs;
+    }
+
+    /**
+     * @brief Gets the job system used to update the flattened graph.
+     * @return Job system, nullptr if updates are not parallel
+     */
+    inline JobSystem *jobSystem() const
+    {
+      return m_jobSystem;
+    }
+
+    void setParallelUpdates(Subsystem sys, bool parallel);
+    bool parallelUpdates(Subsystem sys) const;
+
+    /**
+     * @brief Gets the flattened graph of the scene (only valid after an
+     *        update of a flattened scene).
+     * @return Flattened graph
+     */
+    inline const FlatSceneGraph &flatGraph() const
+    {
+      return m_flatGraph;
+    }
+
+    /**
+     * @brief Marks the flattened graph as requiring a rebuild (called
+     *        automatically when the topology of the scene tree changes).
+     */
+    inline void invalidateGraph()
+    {
+      m_flatGraph.invalidate();
+    }
+
     /**
      * @brief Gets the root node of the scene.
      * @return Root node
@@ -48,9 +107,19 @@ namespace Common
     }
 
   protected:
+    friend class SceneObject;
+
+    void addRootToScene();
+    void updateParallel(float msec, Subsystem sys);
+
     SceneObject *m_root;                       //!< Root node in the scene tree
     Engine::Maths::Matrix4 m_viewMatrix;       //!< View matrix
     Engine::Maths::Matrix4 m_projectionMatrix; //!< Projection matrix
+
+    bool m_flattened;              //!< Flag indicating the flattened graph is used for updates
+    FlatSceneGraph m_flatGraph;    //!< Depth first ordered copy of the scene tree
+    JobSystem *m_jobSystem;        //!< Job system used for parallel updates
+    uint32_t m_parallelSubsystems; //!< Bit mask of subsystems for which objects are updated in parallel
   };
 }
 }
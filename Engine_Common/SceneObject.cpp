@@ -10,12 +10,48 @@
 #include <algorithm>
 #include <string>
 
+#include <Engine_Maths/TransformBatch.h>
+#include <Engine_ResourceManagment/MemoryManager.h>
+
 using namespace Engine::Maths;
 
 namespace Engine
 {
 namespace Common
 {
+  std::atomic<unsigned long> SceneObject::s_transformUpdates(0);
+
+  /**
+   * @brief Gets the pool SceneObject instances are allocated from.
+   * @return Object pool
+   */
+  Engine::ResourceManagment::ObjectPool &SceneObject::Pool()
+  {
+    static Engine::ResourceManagment::ObjectPool pool(sizeof(SceneObject));
+    return pool;
+  }
+
+  /**
+   * @brief Allocates memory for SceneObject from its pool (derived types of a
+   *        different size are allocated from the heap).
+   * @param size Size of object
+   * @return Pointer to memory
+   */
+  void *SceneObject::operator new(size_t size)
+  {
+    return Engine::ResourceManagment::MemoryManager::Instance().allocate(size, &Pool());
+  }
+
+  /**
+   * @brief Frees memory used by a SceneObject.
+   * @param ptr Pointer to memory
+   * @param size Size of object
+   */
+  void SceneObject::operator delete(void *ptr, size_t size)
+  {
+    Engine::ResourceManagment::MemoryManager::Instance().deallocate(ptr, size, &Pool());
+  }
+
   /**
    * @brief Creates a new, empty scene object.
    * @param name Name of the object
@@ -26,7 +62,12 @@ namespace Common
       , m_active(true)
       , m_modelMatrix(Matrix4())
       , m_worldTransform(Matrix4())
+      , m_transformDirty(true)
+      , m_transformVersion(0)
+      , m_parentTransformVersion(0)
       , m_parent(nullptr)
+      , m_scene(nullptr)
+      , m_flatIndex(FlatSceneGraph::NO_INDEX)
   {
     if (parent != nullptr)
       parent->addChild(this);
@@ -46,6 +87,9 @@ namespace Common
   {
     m_active = active;
 
+    if (m_scene != nullptr)
+      m_scene->m_flatGraph.setActive(this);
+
     if (currentLevel < recursionLevels)
     {
       for (auto it = m_children.begin(); it != m_children.end(); ++it)
@@ -57,13 +101,21 @@ namespace Common
    * @brief Updates the state of the object.
    * @param msec Elapsed time since last update in milliseconds
    * @param sys The subsystem being updated
+   *
+   * Overrides must be thread safe for any subsystem the scene updates in
+   * parallel.
+   * @see Scene::setParallelUpdates
    */
   void SceneObject::update(float msec, Subsystem sys)
   {
-    if (m_parent)
-      m_worldTransform = m_parent->m_worldTransform * m_modelMatrix;
-    else
-      m_worldTransform = m_modelMatrix;
+    // Children are updated by the Scene when using a flattened graph
+    if (m_scene != nullptr && m_scene->flattened())
+    {
+      m_scene->m_flatGraph.updateTransform(this);
+      return;
+    }
+
+    updateWorldTransform();
 
     for (SceneObjectListIter i = m_children.begin(); i != m_children.end(); ++i)
       (*i)->update(msec, sys);
@@ -119,14 +171,53 @@ namespace Common
     }
   }
 
+  /**
+   * @brief Recomputes the world transform if the model matrix of this object
+   *        or the world transform of its parent has changed since it was last
+   *        computed.
+   * @return True if the world transform was recomputed
+   *
+   * Assumes the parent world transform is already up to date.
+   */
+  bool SceneObject::updateWorldTransform()
+  {
+    if (m_parent)
+    {
+      if (!m_transformDirty && m_parentTransformVersion == m_parent->m_transformVersion)
+        return false;
+
+      TransformBatch::Concatenate(m_parent->m_worldTransform, 1, &m_modelMatrix, &m_worldTransform);
+      m_parentTransformVersion = m_parent->m_transformVersion;
+    }
+    else
+    {
+      if (!m_transformDirty)
+        return false;
+
+      m_worldTransform = m_modelMatrix;
+    }
+
+    m_transformDirty = false;
+    m_transformVersion++;
+    s_transformUpdates++;
+
+    return true;
+  }
+
   /**
    * @brief Adds this object to a Scene (called automatically).
    * @param scene The scene to add the object to
    */
   void SceneObject::addToScene(Scene *scene)
   {
+    if (m_scene != nullptr)
+      m_scene->invalidateGraph();
+
     m_scene = scene;
 
+    if (m_scene != nullptr)
+      m_scene->invalidateGraph();
+
     for (SceneObjectListIter i = m_children.begin(); i != m_children.end(); ++i)
       (*i)->addToScene(scene);
   }
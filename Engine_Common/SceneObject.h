@@ -8,10 +8,12 @@
 #ifndef _ENGINE_COMMON_SCENEOBJECT_H_
 #define _ENGINE_COMMON_SCENEOBJECT_H_
 
+#include <atomic>
 #include <vector>
 
 #include <Engine_Maths/Matrix4.h>
 #include <Engine_ResourceManagment/IMemoryManaged.h>
+#include <Engine_ResourceManagment/ObjectPool.h>
 
 #include "Scene.h"
 #include "Subsystem.h"
@@ -39,6 +41,21 @@ namespace Common
      */
     typedef SceneObjectList::const_iterator SceneObjectListIter;
 
+    /**
+     * @brief Gets the total number of world transforms that have been
+     *        recomputed by all SceneObject.
+     * @return Number of world transform updates
+     * @see Profiler::transformUpdatesPerFrame
+     */
+    static unsigned long TransformUpdates()
+    {
+      return s_transformUpdates;
+    }
+
+    static Engine::ResourceManagment::ObjectPool &Pool();
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr, size_t size);
+
     SceneObject(const std::string &name, SceneObject *parent = nullptr);
     ~SceneObject();
 
@@ -79,6 +96,7 @@ namespace Common
     {
       m_children.push_back(child);
       child->m_parent = this;
+      child->m_transformDirty = true;
       child->addToScene(m_scene);
     }
 
@@ -93,6 +111,7 @@ namespace Common
       {
         m_children.erase(it);
         child->m_parent = nullptr;
+        child->m_transformDirty = true;
         child->addToScene(nullptr);
       }
     }
@@ -124,6 +143,10 @@ namespace Common
     void setModelMatrix(Engine::Maths::Matrix4 mat)
     {
       m_modelMatrix = mat;
+      m_transformDirty = true;
+
+      if (m_scene != nullptr)
+        m_scene->m_flatGraph.setLocalMatrix(this);
     }
 
     /**
@@ -138,6 +161,9 @@ namespace Common
     /**
      * @brief Gets the position in world space (absolute position)
      * @return World position
+     *
+     * This is updated on the next call to SceneObject::update after the model
+     * matrix of this object or any of its ancestors changes.
      */
     inline Engine::Maths::Matrix4 worldTransform() const
     {
@@ -151,18 +177,29 @@ namespace Common
 
   protected:
     friend class Scene;
+    friend class FlatSceneGraph;
 
     virtual void addToScene(Scene *scene);
 
+    bool updateWorldTransform();
+
     const std::string m_name; //!< Name of the object
     bool m_active;            //!< Flag indicating if this object is active in the scene
 
     Engine::Maths::Matrix4 m_modelMatrix;    //!< Local model matrix (relative to parent)
     Engine::Maths::Matrix4 m_worldTransform; //!< World matrix (relative to world origin)
 
+    bool m_transformDirty;                  //!< Flag indicating the model matrix or parent has changed
+    unsigned long m_transformVersion;       //!< Incremented each time the world matrix is recomputed
+    unsigned long m_parentTransformVersion; //!< Version of the parent world matrix last used
+
     SceneObject *m_parent;      //!< Parent SceneObject
     Scene *m_scene;             //!< Scene this object belongs to
+    size_t m_flatIndex;         //!< Index of this object in the flattened graph of the scene
     SceneObjectList m_children; //!< Children
+
+  private:
+    static std::atomic<unsigned long> s_transformUpdates; //!< Total number of world transform updates
   };
 }
 }
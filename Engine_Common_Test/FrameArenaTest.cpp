@@ -0,0 +1,135 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 2.
+ */
+
+#include "CppUnitTest.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include <Engine_ResourceManagment/FrameAllocator.h>
+#include <Engine_ResourceManagment/FrameArena.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+// clang-format off
+namespace Engine
+{
+namespace ResourceManagment
+{
+namespace Test
+{
+#ifndef DOXYGEN_SKIP
+TEST_CLASS(FrameArenaTest)
+{
+public:
+  TEST_METHOD(FrameArena_Allocate)
+  {
+    FrameArena arena(1024);
+
+    char *a = static_cast<char *>(arena.allocate(10));
+    char *b = static_cast<char *>(arena.allocate(10));
+
+    Assert::IsTrue(a != nullptr);
+    Assert::IsTrue(b >= a + 10);
+    Assert::AreEqual((uintptr_t)0, (uintptr_t)b % 16);
+    Assert::AreEqual((uintptr_t)0, (uintptr_t)arena.allocate(1, 64) % 64);
+    Assert::IsTrue(arena.bytesUsed() >= 21);
+    Assert::AreEqual((size_t)1, arena.numBlocks());
+
+    Assert::ExpectException<std::runtime_error>([&arena]() { arena.allocate(8, 3); });
+  }
+
+  TEST_METHOD(FrameArena_Reset)
+  {
+    FrameArena arena(1024);
+
+    void *a = arena.allocate(100);
+    arena.allocate(100);
+    arena.reset();
+
+    Assert::AreEqual((size_t)0, arena.bytesUsed());
+    Assert::IsTrue(arena.peakBytesUsed() >= 200);
+
+    // Memory is reused after a reset
+    Assert::IsTrue(a == arena.allocate(100));
+  }
+
+  TEST_METHOD(FrameArena_Overflow)
+  {
+    FrameArena arena(256);
+
+    // Overflow the first block and allocate something larger than a block
+    for (int i = 0; i < 8; i++)
+      arena.allocate(100);
+    arena.allocate(1000);
+
+    Assert::IsTrue(arena.numBlocks() > 1);
+    size_t capacity = arena.capacity();
+    Assert::IsTrue(capacity >= 1800);
+
+    // Blocks are merged on reset so the same frame fits in one block
+    arena.reset();
+    Assert::AreEqual((size_t)1, arena.numBlocks());
+    Assert::AreEqual(capacity, arena.capacity());
+
+    for (int i = 0; i < 8; i++)
+      arena.allocate(100);
+    arena.allocate(1000);
+    Assert::AreEqual((size_t)1, arena.numBlocks());
+  }
+
+  TEST_METHOD(FrameArena_DeallocateLast)
+  {
+    FrameArena arena(1024);
+
+    void *a = arena.allocate(32);
+    void *b = arena.allocate(32);
+    size_t used = arena.bytesUsed();
+
+    // Only the most recent allocation is reclaimed
+    arena.deallocate(a, 32);
+    Assert::AreEqual(used, arena.bytesUsed());
+
+    arena.deallocate(b, 32);
+    Assert::AreEqual(used - 32, arena.bytesUsed());
+    Assert::IsTrue(b == arena.allocate(32));
+  }
+
+  TEST_METHOD(FrameArena_Vector)
+  {
+    FrameArena arena(4096);
+    FrameAllocator<int> alloc(arena);
+
+    {
+      FrameVector<int> v(alloc);
+      for (int i = 0; i < 100; i++)
+        v.push_back(i);
+
+      Assert::AreEqual((size_t)100, v.size());
+      for (int i = 0; i < 100; i++)
+        Assert::AreEqual(i, v[i]);
+
+      Assert::IsTrue(arena.bytesUsed() >= 100 * sizeof(int));
+    }
+
+    arena.reset();
+
+    FrameAllocator<char> charAlloc(arena);
+    FrameString str(charAlloc);
+    str += "a string long enough to not fit in the small string buffer";
+    Assert::AreEqual(std::string("a string long enough to not fit in the small string buffer"), std::string(str.c_str()));
+    Assert::IsTrue(arena.bytesUsed() > 0);
+
+    Assert::IsTrue(FrameAllocator<int>(arena) == FrameAllocator<char>(arena));
+    Assert::IsTrue(FrameAllocator<int>(arena) != FrameAllocator<int>());
+  }
+};
+#endif /* DOXYGEN_SKIP */
+}
+}
+}
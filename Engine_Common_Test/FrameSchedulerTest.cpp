@@ -0,0 +1,233 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 2.
+ */
+
+#include "CppUnitTest.h"
+
+#include <Engine_Common/FrameScheduler.h>
+
+/**
+ * @def FP_ACC
+ * @brief Accuracy for floating point comparison.
+ */
+#define FP_ACC 0.0001f
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Engine::Utility;
+
+namespace
+{
+/**
+ * @brief Converts milliseconds to nanoseconds.
+ * @param milliSec Time in milliseconds
+ * @return Time in nanoseconds
+ */
+Clock::Nanoseconds MS(double milliSec)
+{
+  return Clock::FromMilliSec(milliSec);
+}
+
+/**
+ * @brief Creates a loop configuration.
+ * @param interval Loop interval
+ * @param priority Loop priority
+ * @param fixedStep Fixed timestep flag
+ * @param maxCatchUpSteps Max catch up steps
+ * @return New configuration
+ */
+Engine::Common::GameLoopConfiguration *MakeLoop(float interval, int priority = 0, bool fixedStep = false,
+                                                unsigned int maxCatchUpSteps = 1)
+{
+  Engine::Common::GameLoopConfiguration *loop = new Engine::Common::GameLoopConfiguration();
+  loop->interval = interval;
+  loop->priority = priority;
+  loop->fixedStep = fixedStep;
+  loop->maxCatchUpSteps = maxCatchUpSteps;
+  return loop;
+}
+}
+
+// clang-format off
+namespace Engine
+{
+namespace Common
+{
+namespace Test
+{
+#ifndef DOXYGEN_SKIP
+TEST_CLASS(FrameSchedulerTest)
+{
+public:
+  TEST_METHOD(FrameScheduler_NextDeadline)
+  {
+    GameLoopConfiguration *loops[3] = {MakeLoop(16.0f), nullptr, MakeLoop(10.0f)};
+    FrameScheduler s(loops, 3);
+    s.start(MS(100));
+
+    Assert::AreEqual(MS(110), s.nextDeadline());
+
+    std::vector<ScheduledLoop> due;
+    s.poll(MS(105), due);
+    Assert::AreEqual((size_t)0, due.size());
+
+    s.poll(MS(111), due);
+    Assert::AreEqual((size_t)1, due.size());
+    Assert::AreEqual((size_t)2, due[0].id);
+    Assert::AreEqual(11.0f, due[0].dt, FP_ACC);
+    Assert::AreEqual(MS(110), due[0].deadline);
+    Assert::AreEqual(MS(116), s.nextDeadline());
+
+    delete loops[0];
+    delete loops[2];
+  }
+
+  TEST_METHOD(FrameScheduler_NoLoops)
+  {
+    GameLoopConfiguration *loops[2] = {nullptr, nullptr};
+    FrameScheduler s(loops, 2);
+    s.start(0);
+
+    Assert::AreEqual(FrameScheduler::NO_DEADLINE, s.nextDeadline());
+  }
+
+  TEST_METHOD(FrameScheduler_Priority)
+  {
+    GameLoopConfiguration *loops[3] = {MakeLoop(10.0f, 0), MakeLoop(10.0f, 5), MakeLoop(10.0f, 0)};
+    FrameScheduler s(loops, 3);
+    s.start(0);
+
+    std::vector<ScheduledLoop> due;
+    s.poll(MS(10), due);
+
+    // Highest priority first, then by ID
+    Assert::AreEqual((size_t)3, due.size());
+    Assert::AreEqual((size_t)1, due[0].id);
+    Assert::AreEqual((size_t)0, due[1].id);
+    Assert::AreEqual((size_t)2, due[2].id);
+
+    for (size_t i = 0; i < 3; i++)
+      delete loops[i];
+  }
+
+  TEST_METHOD(FrameScheduler_MissedDeadlines)
+  {
+    GameLoopConfiguration *loops[1] = {MakeLoop(10.0f)};
+    FrameScheduler s(loops, 1);
+    s.start(0);
+
+    // Due at 10, polled at 35 so deadlines at 20 and 30 were missed
+    std::vector<ScheduledLoop> due;
+    s.poll(MS(35), due);
+    Assert::AreEqual((size_t)1, due.size());
+    Assert::AreEqual(35.0f, due[0].dt, FP_ACC);
+    Assert::AreEqual(2u, due[0].missed);
+    Assert::AreEqual(MS(45), s.nextDeadline());
+
+    delete loops[0];
+  }
+
+  TEST_METHOD(FrameScheduler_ZeroInterval)
+  {
+    GameLoopConfiguration *loops[2] = {MakeLoop(0.0f), MakeLoop(0.0f, 0, true)};
+    FrameScheduler s(loops, 2);
+    s.start(MS(100));
+
+    Assert::AreEqual(MS(100), s.nextDeadline());
+
+    // Both loops run on every poll
+    std::vector<ScheduledLoop> due;
+    s.poll(MS(100), due);
+    Assert::AreEqual((size_t)2, due.size());
+
+    s.poll(MS(116), due);
+    Assert::AreEqual((size_t)2, due.size());
+    Assert::AreEqual((size_t)0, due[0].id);
+    Assert::AreEqual(16.0f, due[0].dt, FP_ACC);
+    Assert::AreEqual(0u, due[0].missed);
+    Assert::AreEqual((size_t)1, due[1].id);
+    Assert::AreEqual(0u, due[1].missed);
+    Assert::IsTrue(s.nextDeadline() <= MS(117));
+
+    delete loops[0];
+    delete loops[1];
+  }
+
+  TEST_METHOD(FrameScheduler_FixedStep)
+  {
+    GameLoopConfiguration *loops[1] = {MakeLoop(8.0f, 0, true, 3)};
+    FrameScheduler s(loops, 1);
+    s.start(0);
+
+    // Two intervals elapsed
+    std::vector<ScheduledLoop> due;
+    s.poll(MS(17), due);
+    Assert::AreEqual((size_t)2, due.size());
+    Assert::AreEqual(8.0f, due[0].dt, FP_ACC);
+    Assert::AreEqual(8.0f, due[1].dt, FP_ACC);
+    Assert::IsFalse(due[0].catchUp);
+    Assert::IsTrue(due[1].catchUp);
+    Assert::AreEqual(0u, due[0].missed);
+
+    // Next step keeps the fixed phase
+    Assert::AreEqual(MS(24), s.nextDeadline());
+
+    // Six intervals elapsed, only three are run
+    s.poll(MS(65), due);
+    Assert::AreEqual((size_t)3, due.size());
+    Assert::AreEqual(3u, due[0].missed);
+    Assert::AreEqual(MS(72), s.nextDeadline());
+
+    delete loops[0];
+  }
+
+  TEST_METHOD(FrameScheduler_LongUptime)
+  {
+    // 72 hours after startup
+    const Clock::Nanoseconds start = 72LL * 60 * 60 * Clock::NS_PER_S;
+
+    GameLoopConfiguration *loops[2] = {MakeLoop(8.33f, 0, true, 4), MakeLoop(16.66f)};
+    FrameScheduler s(loops, 2);
+    s.start(start);
+
+    std::vector<ScheduledLoop> due;
+    Clock::Nanoseconds now = start;
+    Clock::Nanoseconds lastVariable = start;
+    size_t fixedSteps = 0;
+
+    // One second of frames at slightly irregular times
+    for (int frame = 1; frame <= 60; frame++)
+    {
+      now = start + MS(frame * 16.66 + (frame % 3) * 0.1);
+      s.poll(now, due);
+
+      for (auto it = due.begin(); it != due.end(); ++it)
+      {
+        if (it->id == 0)
+        {
+          Assert::AreEqual(8.33f, it->dt, FP_ACC);
+          fixedSteps++;
+        }
+        else
+        {
+          // Variable step is the exact time since it last ran
+          Assert::AreEqual(Clock::ToMilliSecF(now - lastVariable), it->dt, FP_ACC);
+          Assert::IsTrue(it->dt >= 16.66f);
+          lastVariable = now;
+        }
+      }
+    }
+
+    // Fixed step loop ran once for every elapsed interval
+    Assert::AreEqual((size_t)((now - start) / MS(8.33)), fixedSteps);
+
+    delete loops[0];
+    delete loops[1];
+  }
+};
+#endif /* DOXYGEN_SKIP */
+}
+}
+}
@@ -0,0 +1,203 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 2.
+ */
+
+#include "CppUnitTest.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <Engine_Common/JobSystem.h>
+#include <Engine_Common/Scene.h>
+#include <Engine_Common/SceneObject.h>
+
+/**
+ * @def FP_ACC
+ * @brief Accuracy for floating point comparison.
+ */
+#define FP_ACC 0.0001f
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Engine::Maths;
+
+namespace
+{
+/**
+ * @brief Builds a tree of SceneObjects with a given branching factor.
+ * @param parent Parent node
+ * @param depth Remaining depth
+ * @param branching Number of children per node
+ * @param nodes Vector to add all created nodes to
+ */
+void BuildTree(Engine::Common::SceneObject *parent, size_t depth, size_t branching,
+               std::vector<Engine::Common::SceneObject *> &nodes)
+{
+  if (depth == 0)
+    return;
+
+  for (size_t i = 0; i < branching; i++)
+  {
+    Engine::Common::SceneObject *o = new Engine::Common::SceneObject("n", parent);
+    o->setModelMatrix(Matrix4::Translation(Vector3((float)i, 1.0f, 0.0f)));
+    nodes.push_back(o);
+    BuildTree(o, depth - 1, branching, nodes);
+  }
+}
+
+/**
+ * @brief SceneObject that counts updates made off the main thread.
+ */
+class ThreadCheckObject : public Engine::Common::SceneObject
+{
+public:
+  ThreadCheckObject(Engine::Common::SceneObject *parent, std::atomic<int> &offThread)
+      : Engine::Common::SceneObject("t", parent)
+      , m_mainThread(std::this_thread::get_id())
+      , m_offThread(offThread)
+  {
+  }
+
+  virtual void update(float msec, Engine::Common::Subsystem sys)
+  {
+    if (std::this_thread::get_id() != m_mainThread)
+      m_offThread++;
+
+    Engine::Common::SceneObject::update(msec, sys);
+  }
+
+private:
+  std::thread::id m_mainThread;
+  std::atomic<int> &m_offThread;
+};
+}
+
+// clang-format off
+namespace Engine
+{
+namespace Common
+{
+namespace Test
+{
+#ifndef DOXYGEN_SKIP
+TEST_CLASS(JobSystemTest)
+{
+public:
+  TEST_METHOD(JobSystem_ParallelFor)
+  {
+    JobSystem jobs(3);
+    Assert::AreEqual((size_t)3, jobs.numWorkers());
+
+    std::vector<int> values(10000, 0);
+    JobSystem::Job *root = jobs.parallelFor(values.size(), 100, [&values](size_t begin, size_t end)
+    {
+      for (size_t i = begin; i < end; i++)
+        values[i] = (int)i;
+    });
+    jobs.wait(root);
+
+    for (size_t i = 0; i < values.size(); i++)
+      Assert::AreEqual((int)i, values[i]);
+  }
+
+  TEST_METHOD(JobSystem_ParentChild)
+  {
+    JobSystem jobs(2);
+    std::atomic<int> count(0);
+
+    // Children (and their children) complete before the parent
+    JobSystem::Job *root = jobs.create(JobSystem::JobFunction());
+    for (int i = 0; i < 10; i++)
+    {
+      JobSystem::Job *child = jobs.create([&count]() { count++; }, root);
+      for (int j = 0; j < 10; j++)
+        jobs.run(jobs.create([&count]() { count++; }, child));
+      jobs.run(child);
+    }
+    jobs.run(root);
+    jobs.wait(root);
+
+    Assert::AreEqual(110, count.load());
+  }
+
+  TEST_METHOD(JobSystem_ParallelSceneUpdate)
+  {
+    std::vector<SceneObject *> seqNodes;
+    SceneObject *seqRoot = new SceneObject("root");
+    BuildTree(seqRoot, 4, 6, seqNodes);
+    Scene sequential(seqRoot);
+    sequential.setFlattened(true);
+
+    std::vector<SceneObject *> parNodes;
+    SceneObject *parRoot = new SceneObject("root");
+    BuildTree(parRoot, 4, 6, parNodes);
+    Scene parallel(parRoot);
+    parallel.setFlattened(true);
+
+    JobSystem jobs(3);
+    parallel.setJobSystem(&jobs);
+    parallel.setParallelUpdates(Subsystem::PHYSICS, true);
+
+    for (int frame = 0; frame < 3; frame++)
+    {
+      Matrix4 m = Matrix4::Translation(Vector3(0.0f, 0.0f, (float)frame));
+      seqRoot->setModelMatrix(m);
+      parRoot->setModelMatrix(m);
+
+      sequential.update(0.0f, Subsystem::PHYSICS);
+      parallel.update(0.0f, Subsystem::PHYSICS);
+
+      Assert::AreEqual(seqNodes.size(), parNodes.size());
+      for (size_t i = 0; i < seqNodes.size(); i++)
+      {
+        Vector3 a = seqNodes[i]->worldTransform().positionVector();
+        Vector3 b = parNodes[i]->worldTransform().positionVector();
+        Assert::AreEqual(a.x(), b.x(), FP_ACC);
+        Assert::AreEqual(a.y(), b.y(), FP_ACC);
+        Assert::AreEqual(a.z(), b.z(), FP_ACC);
+      }
+    }
+
+    // Deepest nodes are four levels below the root
+    Assert::AreEqual(4.0f, parNodes.back()->worldTransform().positionVector().y(), FP_ACC);
+  }
+
+  TEST_METHOD(JobSystem_ParallelSceneUpdate_OptIn)
+  {
+    std::atomic<int> offThread(0);
+
+    SceneObject *root = new SceneObject("root");
+    for (size_t i = 0; i < 500; i++)
+      new ThreadCheckObject(root, offThread);
+
+    Scene scene(root);
+    scene.setFlattened(true);
+
+    JobSystem jobs(3);
+    scene.setJobSystem(&jobs);
+
+    // Objects are updated on the calling thread unless enabled
+    Assert::IsFalse(scene.parallelUpdates(Subsystem::PHYSICS));
+    scene.update(0.0f, Subsystem::PHYSICS);
+    scene.update(0.0f, Subsystem::AUDIO);
+    Assert::AreEqual(0, offThread.load());
+
+    // Never parallel for graphics
+    scene.setParallelUpdates(Subsystem::GRAPHICS, true);
+    Assert::IsFalse(scene.parallelUpdates(Subsystem::GRAPHICS));
+
+    scene.setParallelUpdates(Subsystem::PHYSICS, true);
+    Assert::IsTrue(scene.parallelUpdates(Subsystem::PHYSICS));
+    Assert::IsFalse(scene.parallelUpdates(Subsystem::AUDIO));
+
+    scene.setParallelUpdates(Subsystem::PHYSICS, false);
+    Assert::IsFalse(scene.parallelUpdates(Subsystem::PHYSICS));
+  }
+};
+#endif /* DOXYGEN_SKIP */
+}
+}
+}
@@ -0,0 +1,195 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 2.
+ */
+
+#include "CppUnitTest.h"
+
+#include <string>
+#include <vector>
+
+#include <Engine_Common/SceneObject.h>
+#include <Engine_ResourceManagment/MemoryManager.h>
+#include <Engine_ResourceManagment/ObjectPool.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+/**
+ * @brief Managed item used for testing.
+ */
+class TestManagedItem : public Engine::ResourceManagment::IMemoryManaged
+{
+public:
+  int value[8];
+};
+
+/**
+ * @brief Managed item that allocates another managed item when constructed.
+ */
+class TestNestingItem : public Engine::ResourceManagment::IMemoryManaged
+{
+public:
+  TestNestingItem()
+      : child(new TestManagedItem())
+  {
+  }
+
+  TestManagedItem *child;
+  int value[32];
+};
+
+/**
+ * @brief Finds the statistics for TestManagedItem.
+ * @return Statistics (zero count if not found)
+ */
+Engine::ResourceManagment::ManagedTypeStats FindTestItemStats()
+{
+  std::vector<Engine::ResourceManagment::ManagedTypeStats> stats;
+  Engine::ResourceManagment::MemoryManager::Instance().typeStats(stats);
+
+  for (auto it = stats.begin(); it != stats.end(); ++it)
+  {
+    if (it->name.find("TestManagedItem") != std::string::npos)
+      return *it;
+  }
+
+  Engine::ResourceManagment::ManagedTypeStats none = {"", 0, 0};
+  return none;
+}
+}
+
+// clang-format off
+namespace Engine
+{
+namespace ResourceManagment
+{
+namespace Test
+{
+#ifndef DOXYGEN_SKIP
+TEST_CLASS(MemoryManagerTest)
+{
+public:
+  TEST_METHOD(MemoryManager_Release)
+  {
+    MemoryManager &mm = MemoryManager::Instance();
+    const size_t start = mm.numAllocations();
+
+    TestManagedItem *a = new TestManagedItem();
+    TestManagedItem *b = new TestManagedItem();
+    TestManagedItem *c = new TestManagedItem();
+    Assert::AreEqual(start + 3, mm.numAllocations());
+
+    // Release from the middle, then the ends
+    mm.release(b);
+    Assert::AreEqual(start + 2, mm.numAllocations());
+    mm.release(a);
+    mm.release(c);
+    Assert::AreEqual(start, mm.numAllocations());
+  }
+
+  TEST_METHOD(MemoryManager_Forget)
+  {
+    MemoryManager &mm = MemoryManager::Instance();
+    const size_t start = mm.numAllocations();
+
+    // Items that are deleted directly or go out of scope are forgotten
+    TestManagedItem *a = new TestManagedItem();
+    {
+      TestManagedItem b;
+      Assert::AreEqual(start + 2, mm.numAllocations());
+    }
+    Assert::AreEqual(start + 1, mm.numAllocations());
+
+    delete a;
+    Assert::AreEqual(start, mm.numAllocations());
+  }
+
+  TEST_METHOD(MemoryManager_TypeStats)
+  {
+    MemoryManager &mm = MemoryManager::Instance();
+    const size_t startBytes = mm.numBytes();
+
+    TestManagedItem *a = new TestManagedItem();
+    TestManagedItem *b = new TestManagedItem();
+    TestManagedItem c;
+
+    Assert::AreEqual(startBytes + 2 * sizeof(TestManagedItem), mm.numBytes());
+
+    // Items not on the heap are counted but use no managed bytes
+    ManagedTypeStats stats = FindTestItemStats();
+    Assert::AreEqual((size_t)3, stats.count);
+    Assert::AreEqual(2 * sizeof(TestManagedItem), stats.bytes);
+
+    mm.release(a);
+    mm.release(b);
+
+    Assert::AreEqual(startBytes, mm.numBytes());
+    Assert::AreEqual((size_t)1, FindTestItemStats().count);
+  }
+
+  TEST_METHOD(MemoryManager_TypeStats_Nested)
+  {
+    MemoryManager &mm = MemoryManager::Instance();
+    const size_t startBytes = mm.numBytes();
+
+    // Each item gets the size of its own allocation
+    TestNestingItem *a = new TestNestingItem();
+    Assert::AreEqual(startBytes + sizeof(TestNestingItem) + sizeof(TestManagedItem), mm.numBytes());
+    Assert::AreEqual(sizeof(TestManagedItem), FindTestItemStats().bytes);
+
+    mm.release(a->child);
+    mm.release(a);
+    Assert::AreEqual(startBytes, mm.numBytes());
+  }
+
+  TEST_METHOD(ObjectPool_Reuse)
+  {
+    ObjectPool pool(24, 4);
+
+    std::vector<void *> items;
+    for (size_t i = 0; i < 5; i++)
+      items.push_back(pool.allocate(24));
+
+    Assert::AreEqual((size_t)5, pool.liveCount());
+    Assert::AreEqual((size_t)8, pool.capacity());
+
+    for (size_t i = 1; i < items.size(); i++)
+      Assert::IsTrue(items[i] != items[i - 1]);
+
+    // Freed objects are reused
+    pool.deallocate(items[2], 24);
+    Assert::AreEqual((size_t)4, pool.liveCount());
+    Assert::IsTrue(items[2] == pool.allocate(24));
+
+    // Other sizes are not pooled
+    void *other = pool.allocate(100);
+    Assert::AreEqual((size_t)5, pool.liveCount());
+    pool.deallocate(other, 100);
+
+    for (size_t i = 0; i < items.size(); i++)
+      pool.deallocate(items[i], 24);
+    Assert::AreEqual((size_t)0, pool.liveCount());
+    Assert::AreEqual((size_t)8, pool.capacity());
+  }
+
+  TEST_METHOD(ObjectPool_SceneObject)
+  {
+    const size_t start = Engine::Common::SceneObject::Pool().liveCount();
+
+    Engine::Common::SceneObject *a = new Engine::Common::SceneObject("a");
+    Engine::Common::SceneObject *b = new Engine::Common::SceneObject("b", a);
+    Assert::AreEqual(start + 2, Engine::Common::SceneObject::Pool().liveCount());
+
+    MemoryManager::Instance().release(b);
+    MemoryManager::Instance().release(a);
+    Assert::AreEqual(start, Engine::Common::SceneObject::Pool().liveCount());
+  }
+};
+#endif /* DOXYGEN_SKIP */
+}
+}
+}
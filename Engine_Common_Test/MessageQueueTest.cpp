@@ -7,6 +7,10 @@
 
 #include "CppUnitTest.h"
 
+#include <sstream>
+#include <thread>
+#include <vector>
+
 #include <Engine_Common/MessageQueue.h>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
@@ -102,6 +106,246 @@ public:
     Assert::AreEqual(std::string(""), q.peek(Subsystem::GAME_LOGIC).second);
     Assert::AreEqual(std::string("m3"), q.peek(Subsystem::AI).second);
   }
+
+  TEST_METHOD(MessageQueue_Typed)
+  {
+    const MessageID reset = Message::Intern("test:reset");
+    const MessageID mode = Message::Intern("test:mode");
+
+    Assert::AreNotEqual(reset, mode);
+    Assert::AreEqual(reset, Message::Intern("test:reset"));
+    Assert::AreEqual(std::string("test:mode"), Message::Name(mode));
+
+    MessageQueue q;
+    q.push(Subsystem::GAME_LOGIC, reset);
+    q.push(Subsystem::GAME_LOGIC, mode, "chase");
+
+    Assert::AreEqual((size_t)2, q.numMessages(Subsystem::GAME_LOGIC));
+    Assert::AreEqual(reset, q.peekMessage(Subsystem::GAME_LOGIC)->id);
+    Assert::IsTrue(q.peekMessage(Subsystem::AI) == nullptr);
+
+    Message msg;
+    Assert::IsTrue(q.popMessage(Subsystem::GAME_LOGIC, msg));
+    Assert::AreEqual(reset, msg.id);
+    Assert::AreEqual(std::string(""), msg.argument);
+
+    // Typed messages appear as strings to string based callers
+    Assert::AreEqual(std::string("test:mode:chase"), q.pop(Subsystem::GAME_LOGIC).second);
+
+    Assert::IsFalse(q.popMessage(Subsystem::GAME_LOGIC, msg));
+    Assert::AreEqual((size_t)0, q.numMessages());
+  }
+
+  TEST_METHOD(MessageQueue_StringAdapter)
+  {
+    const MessageID mode = Message::Intern("test:mode");
+    const MessageID reset = Message::Intern("test:reset");
+
+    MessageQueue q;
+    q.push(std::make_pair(Subsystem::UI_MENU, "test:mode:follow:far"));
+    q.push(std::make_pair(Subsystem::UI_MENU, "test:reset"));
+    q.push(std::make_pair(Subsystem::UI_MENU, "unknown:message"));
+
+    // Strings are converted to typed messages by their interned prefix
+    Message msg;
+    Assert::IsTrue(q.popMessage(Subsystem::UI_MENU, msg));
+    Assert::AreEqual(mode, msg.id);
+    Assert::AreEqual(std::string("follow:far"), msg.argument);
+
+    Assert::IsTrue(q.popMessage(Subsystem::UI_MENU, msg));
+    Assert::AreEqual(reset, msg.id);
+    Assert::AreEqual(std::string(""), msg.argument);
+
+    Assert::IsTrue(q.popMessage(Subsystem::UI_MENU, msg));
+    Assert::AreEqual((MessageID)Message::STRING, msg.id);
+    Assert::AreEqual(std::string("unknown:message"), msg.toString());
+  }
+
+  TEST_METHOD(MessageQueue_Order)
+  {
+    MessageQueue q;
+
+    // Enough messages for the subsystem queues to grow
+    for (int i = 0; i < 100; i++)
+    {
+      std::stringstream str;
+      str << i;
+      q.push(std::make_pair((i % 3 == 0) ? Subsystem::AI : Subsystem::PHYSICS, str.str()));
+    }
+
+    Assert::AreEqual((size_t)100, q.numMessages());
+    Assert::AreEqual((size_t)34, q.numMessages(Subsystem::AI));
+    Assert::AreEqual((size_t)66, q.numMessages(Subsystem::PHYSICS));
+
+    // Each subsystem is FIFO
+    Assert::AreEqual(std::string("0"), q.pop(Subsystem::AI).second);
+    Assert::AreEqual(std::string("3"), q.pop(Subsystem::AI).second);
+    Assert::AreEqual(std::string("1"), q.pop(Subsystem::PHYSICS).second);
+
+    // All subsystems gives the oldest message overall
+    Assert::AreEqual(std::string("2"), q.peek(Subsystem::ALL).second);
+    for (int i = 2; i < 100; i++)
+    {
+      if (i == 3)
+        continue;
+
+      std::stringstream str;
+      str << i;
+      Assert::AreEqual(str.str(), q.pop(Subsystem::ALL).second);
+    }
+
+    Assert::IsFalse(q.hasMessage());
+    Assert::AreEqual(std::string(""), q.pop(Subsystem::ALL).second);
+  }
+
+  TEST_METHOD(MessageQueue_Post)
+  {
+    MessageQueue q(4);
+    const MessageID id = Message::Intern("test:posted");
+
+    // Posted messages are only queued once received
+    Assert::IsTrue(q.post(Message(Subsystem::AI, id, "a")));
+    Assert::IsTrue(q.post(Message(Subsystem::AI, id, "b")));
+    Assert::IsFalse(q.hasMessage());
+
+    Assert::AreEqual((size_t)2, q.receivePosted());
+    Assert::AreEqual((size_t)2, q.numMessages(Subsystem::AI));
+    Assert::AreEqual(std::string("test:posted:a"), q.pop(Subsystem::AI).second);
+
+    // Bounded between receives
+    for (int i = 0; i < 4; i++)
+      Assert::IsTrue(q.post(Message(Subsystem::PHYSICS, id)));
+    Assert::IsFalse(q.post(Message(Subsystem::PHYSICS, id)));
+    Assert::IsTrue(q.post(Message(Subsystem::AUDIO, id)));
+
+    Assert::AreEqual((size_t)5, q.receivePosted());
+    Assert::AreEqual((size_t)0, q.receivePosted());
+    Assert::AreEqual((size_t)6, q.numMessages());
+
+    Assert::ExpectException<std::runtime_error>([&q, id]() { q.post(Message(Subsystem::ALL, id)); });
+  }
+
+  TEST_METHOD(MessageQueue_PostStress)
+  {
+    const int numProducers = 8;
+    const int numMessages = 5000;
+
+    MessageQueue q(128);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < numProducers; p++)
+    {
+      producers.push_back(std::thread([&q, p, numMessages]() {
+        Subsystem sys = (p % 2 == 0) ? Subsystem::PHYSICS : Subsystem::AI;
+        for (int i = 0; i < numMessages; i++)
+        {
+          while (!q.post(Message(sys, (MessageID)(p + 1), std::to_string(i))))
+            std::this_thread::yield();
+        }
+      }));
+    }
+
+    // Drain and consume concurrently with producers
+    std::vector<int> next(numProducers, 0);
+    int received = 0;
+    Message msg;
+    while (received < numProducers * numMessages)
+    {
+      q.receivePosted();
+
+      while (q.popMessage(Subsystem::ALL, msg))
+      {
+        int p = (int)msg.id - 1;
+        Assert::AreEqual(next[p], std::stoi(msg.argument));
+        Assert::IsTrue(msg.destination == ((p % 2 == 0) ? Subsystem::PHYSICS : Subsystem::AI));
+        next[p]++;
+        received++;
+      }
+    }
+
+    for (auto it = producers.begin(); it != producers.end(); ++it)
+      it->join();
+
+    Assert::AreEqual((size_t)0, q.receivePosted());
+    for (int p = 0; p < numProducers; p++)
+      Assert::AreEqual(numMessages, next[p]);
+  }
+
+  TEST_METHOD(MessageQueue_Drain)
+  {
+    const MessageID id = Message::Intern("test:drain");
+
+    MessageQueue q;
+    for (int i = 0; i < 10; i++)
+      q.push(Subsystem::GAME_LOGIC, id, std::to_string(i));
+    q.push(Subsystem::AI, id, "ai");
+
+    // Limited by count, in order
+    std::vector<std::string> handled;
+    auto record = [&handled](const Message &m) { handled.push_back(m.argument); };
+    Assert::AreEqual((size_t)4, q.drain(Subsystem::GAME_LOGIC, record, 4));
+    Assert::AreEqual((size_t)4, handled.size());
+    Assert::AreEqual(std::string("3"), handled.back());
+    Assert::AreEqual((size_t)6, q.numMessages(Subsystem::GAME_LOGIC));
+
+    // Messages pushed by the handler are left for the next drain
+    handled.clear();
+    Assert::AreEqual((size_t)6, q.drain(Subsystem::GAME_LOGIC, [&](const Message &m) {
+      handled.push_back(m.argument);
+      q.push(Subsystem::GAME_LOGIC, id, "again");
+    }));
+    Assert::AreEqual(std::string("4"), handled.front());
+    Assert::AreEqual(std::string("9"), handled.back());
+    Assert::AreEqual((size_t)6, q.numMessages(Subsystem::GAME_LOGIC));
+    Assert::AreEqual((size_t)1, q.numMessages(Subsystem::AI));
+
+    // Limited by time, at least one message is handled
+    Assert::AreEqual((size_t)1, q.drain(Subsystem::GAME_LOGIC, [](const Message &) {}, 0, 1));
+    Assert::AreEqual((size_t)5, q.numMessages(Subsystem::GAME_LOGIC));
+
+    // Everything
+    Assert::AreEqual((size_t)6, q.drain(Subsystem::ALL, [](const Message &) {}));
+    Assert::IsFalse(q.hasMessage());
+  }
+
+  TEST_METHOD(MessageQueue_Coalesce)
+  {
+    const MessageID reset = Message::Intern("test:coalesced");
+    const MessageID other = Message::Intern("test:other");
+
+    MessageQueue q;
+    q.setCoalesce(reset, true);
+    Assert::IsTrue(q.coalesce(reset));
+    Assert::IsFalse(q.coalesce(other));
+
+    Assert::IsTrue(q.push(Subsystem::GAME_LOGIC, reset));
+    Assert::IsFalse(q.push(Subsystem::GAME_LOGIC, reset));
+    Assert::IsTrue(q.push(Subsystem::GAME_LOGIC, reset, "arg"));
+    Assert::IsTrue(q.push(Subsystem::AI, reset));
+    Assert::IsTrue(q.push(Subsystem::GAME_LOGIC, other));
+    Assert::IsTrue(q.push(Subsystem::GAME_LOGIC, other));
+
+    // Posted messages are coalesced when received
+    Assert::IsTrue(q.post(Message(Subsystem::GAME_LOGIC, reset)));
+    Assert::AreEqual((size_t)0, q.receivePosted());
+
+    Assert::AreEqual((size_t)4, q.numMessages(Subsystem::GAME_LOGIC));
+
+    // Can be queued again once handled
+    Message msg;
+    Assert::IsTrue(q.popMessage(Subsystem::GAME_LOGIC, msg));
+    Assert::AreEqual(reset, msg.id);
+    Assert::IsTrue(q.push(Subsystem::GAME_LOGIC, reset));
+
+    q.setCoalesce(reset, false);
+    Assert::IsTrue(q.push(Subsystem::GAME_LOGIC, reset));
+    Assert::AreEqual((size_t)5, q.numMessages(Subsystem::GAME_LOGIC));
+
+    // Messages queued while not coalescing are not considered
+    q.setCoalesce(reset, true);
+    Assert::IsTrue(q.push(Subsystem::AI, reset));
+    Assert::IsFalse(q.push(Subsystem::AI, reset));
+  }
 };
 #endif /* DOXYGEN_SKIP */
 }
@@ -0,0 +1,112 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 2.
+ */
+
+#include "CppUnitTest.h"
+
+#include <sstream>
+
+#include <Engine_Common/CSVProfilerOutput.h>
+#include <Engine_Common/JSONProfilerOutput.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Engine::Utility;
+
+namespace
+{
+/**
+ * @brief Creates statistics for a single profile.
+ * @param name Profile name
+ * @param p99 99th percentile duration
+ * @return Statistics
+ */
+Engine::Common::ProfileStats MakeStats(const std::string &name, float p99)
+{
+  Engine::Common::ProfileStats s;
+  s.name = name;
+  s.frameRate = 60.0f;
+  s.avgDuration = 1.5f;
+  s.p50Duration = 1.25f;
+  s.p90Duration = 2.0f;
+  s.p99Duration = p99;
+  s.maxDuration = 12.0f;
+  s.missed = 2;
+  return s;
+}
+}
+
+// clang-format off
+namespace Engine
+{
+namespace Common
+{
+namespace Test
+{
+#ifndef DOXYGEN_SKIP
+TEST_CLASS(ProfilerOutputTest)
+{
+public:
+  TEST_METHOD(ProfilerOutput_CSV)
+  {
+    std::stringstream str;
+    CSVProfilerOutput output(str);
+    Assert::IsTrue(output.open());
+
+    std::vector<ProfileStats> stats;
+    stats.push_back(MakeStats("graphics", 8.5f));
+    stats.push_back(MakeStats("events", 0.5f));
+    output.write(Clock::FromMilliSec(1000.0), stats);
+    output.write(Clock::FromMilliSec(2000.0), std::vector<ProfileStats>());
+    Assert::IsTrue(output.close());
+
+    std::string line;
+    std::getline(str, line);
+    Assert::AreEqual(std::string("time_ms,profile,rate,avg_ms,p50_ms,p90_ms,p99_ms,max_ms,missed"), line);
+    std::getline(str, line);
+    Assert::AreEqual(std::string("1000.000,\"graphics\",60.000,1.500,1.250,2.000,8.500,12.000,2"), line);
+    std::getline(str, line);
+    Assert::AreEqual(std::string("1000.000,\"events\",60.000,1.500,1.250,2.000,0.500,12.000,2"), line);
+    Assert::IsFalse((bool)std::getline(str, line));
+  }
+
+  TEST_METHOD(ProfilerOutput_JSON)
+  {
+    std::stringstream str;
+    JSONProfilerOutput output(str);
+    Assert::IsTrue(output.open());
+
+    std::vector<ProfileStats> stats;
+    stats.push_back(MakeStats("graphics", 8.5f));
+    output.write(Clock::FromMilliSec(1000.0), stats);
+    stats.push_back(MakeStats("a \"quoted\" loop", 0.5f));
+    output.write(Clock::FromMilliSec(2000.0), stats);
+    Assert::IsTrue(output.close());
+
+    std::string line;
+    std::getline(str, line);
+    Assert::AreEqual(std::string("{\"time_ms\":1000.000,\"profiles\":[{\"name\":\"graphics\",\"rate\":60.000,"
+                                 "\"avg_ms\":1.500,\"p50_ms\":1.250,\"p90_ms\":2.000,\"p99_ms\":8.500,"
+                                 "\"max_ms\":12.000,\"missed\":2}]}"),
+                     line);
+    std::getline(str, line);
+    Assert::AreEqual((size_t)0, line.find("{\"time_ms\":2000.000,\"profiles\":[{\"name\":\"graphics\""));
+    Assert::AreNotEqual(std::string::npos, line.find("},{\"name\":\"a \\\"quoted\\\" loop\",\"rate\":60.000"));
+    Assert::IsFalse((bool)std::getline(str, line));
+  }
+
+  TEST_METHOD(ProfilerOutput_BadFile)
+  {
+    CSVProfilerOutput output("no_such_directory/profile.csv");
+    Assert::IsFalse(output.open());
+
+    // Writing to an output that failed to open is ignored
+    output.write(0, std::vector<ProfileStats>(1, MakeStats("graphics", 1.0f)));
+  }
+};
+#endif /* DOXYGEN_SKIP */
+}
+}
+}
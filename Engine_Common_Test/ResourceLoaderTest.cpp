@@ -0,0 +1,142 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 2.
+ */
+
+#include "CppUnitTest.h"
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <Engine_ResourceManagment/ResourceLoader.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+// clang-format off
+namespace Engine
+{
+namespace ResourceManagment
+{
+namespace Test
+{
+#ifndef DOXYGEN_SKIP
+TEST_CLASS(ResourceLoaderTest)
+{
+public:
+  TEST_METHOD(ResourceLoader_Finish)
+  {
+    ResourceLoader loader(2);
+    Assert::AreEqual((size_t)2, loader.numWorkers());
+
+    const std::thread::id owner = std::this_thread::get_id();
+    std::atomic<int> loadedOnWorker(0);
+    int uploadedOnOwner = 0;
+    int callbacks = 0;
+
+    auto load = [&]() {
+      if (std::this_thread::get_id() != owner)
+        loadedOnWorker++;
+      return true;
+    };
+
+    auto upload = [&]() {
+      if (std::this_thread::get_id() == owner)
+        uploadedOnOwner++;
+      return true;
+    };
+
+    auto callback = [&](bool result) {
+      if (result)
+        callbacks++;
+    };
+
+    std::vector<std::shared_future<bool>> results;
+    for (int i = 0; i < 8; i++)
+      results.push_back(loader.queue("resource_" + std::to_string(i), load, upload, callback));
+
+    loader.finish();
+
+    Assert::AreEqual(8, (int)loadedOnWorker);
+    Assert::AreEqual(8, uploadedOnOwner);
+    Assert::AreEqual(8, callbacks);
+    Assert::AreEqual((size_t)0, loader.numPending());
+    Assert::AreEqual(1.0f, loader.progress());
+
+    for (auto it = results.begin(); it != results.end(); ++it)
+      Assert::IsTrue(it->get());
+  }
+
+  TEST_METHOD(ResourceLoader_Failure)
+  {
+    ResourceLoader loader(1);
+
+    bool uploaded = false;
+    bool callbackResult = true;
+
+    auto upload = [&]() {
+      uploaded = true;
+      return true;
+    };
+
+    std::shared_future<bool> failedLoad = loader.queue("failed_load", []() { return false; }, upload,
+                                                       [&](bool result) { callbackResult = result; });
+    std::shared_future<bool> failedUpload = loader.queue("failed_upload", []() { return true; },
+                                                         []() { return false; });
+    std::shared_future<bool> thrown = loader.queue("thrown", []() -> bool { throw std::runtime_error("load"); },
+                                                   nullptr);
+    std::shared_future<bool> thrownCallback =
+        loader.queue("thrown_callback", []() { return true; }, nullptr,
+                     [](bool) { throw std::runtime_error("callback"); });
+
+    loader.finish();
+
+    Assert::IsFalse(failedLoad.get());
+    Assert::IsFalse(uploaded);
+    Assert::IsFalse(callbackResult);
+    Assert::IsFalse(failedUpload.get());
+    Assert::IsFalse(thrown.get());
+    Assert::IsFalse(thrownCallback.get());
+    Assert::AreEqual((size_t)0, loader.numPending());
+  }
+
+  TEST_METHOD(ResourceLoader_UploadLimit)
+  {
+    ResourceLoader loader(2);
+
+    for (int i = 0; i < 4; i++)
+      loader.queue("limited", []() { return true; }, []() { return true; });
+
+    Assert::AreEqual((size_t)4, loader.numRequested());
+
+    // At most one upload per call
+    size_t calls = 0;
+    while (loader.numPending() > 0)
+    {
+      size_t completed = loader.processUploads(0, 1);
+      Assert::IsTrue(completed <= 1);
+
+      calls += completed;
+      Assert::AreEqual(calls, loader.numCompleted());
+
+      std::this_thread::yield();
+    }
+
+    Assert::AreEqual((size_t)4, calls);
+
+    // A new batch starts once all requests have completed
+    loader.queue("next", []() { return true; }, nullptr);
+    Assert::AreEqual((size_t)1, loader.numRequested());
+    Assert::AreEqual(0.0f, loader.progress());
+    loader.finish();
+  }
+};
+#endif /* DOXYGEN_SKIP */
+}
+}
+}
@@ -0,0 +1,120 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 2.
+ */
+
+#include "CppUnitTest.h"
+
+#include <stdexcept>
+#include <string>
+
+#include <Engine_ResourceManagment/ResourceLookup.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+/**
+ * @brief Resource type used for testing (so the lookup is not shared with
+ *        other tests).
+ */
+struct TestResource
+{
+  TestResource(int v = 0)
+      : value(v)
+  {
+  }
+
+  int value;
+};
+
+typedef Engine::ResourceManagment::ResourceLookup<TestResource> TestLookup;
+}
+
+// clang-format off
+namespace Engine
+{
+namespace ResourceManagment
+{
+namespace Test
+{
+#ifndef DOXYGEN_SKIP
+TEST_CLASS(ResourceLookupTest)
+{
+public:
+  TEST_METHOD(ResourceLookup_Handles)
+  {
+    TestLookup &lookup = TestLookup::Instance();
+
+    TestLookup::Handle a = lookup.add("handles_a", TestResource(1));
+    TestLookup::Handle b = lookup.add("handles_b", TestResource(2));
+    Assert::IsTrue(a != b);
+    Assert::IsTrue(a == lookup.handle("handles_a"));
+    Assert::AreEqual(std::string("handles_b"), lookup.name(b));
+
+    Assert::AreEqual(1, lookup.get(a).value);
+    Assert::AreEqual(2, lookup.get("handles_b").value);
+
+    // Handle remains the same after removal and re-adding
+    Assert::IsTrue(lookup.remove("handles_a"));
+    Assert::IsFalse(lookup.has(a));
+    Assert::IsTrue(a == lookup.add("handles_a", TestResource(3)));
+    Assert::AreEqual(3, lookup.get(a).value);
+  }
+
+  TEST_METHOD(ResourceLookup_Miss)
+  {
+    TestLookup &lookup = TestLookup::Instance();
+    const size_t size = lookup.size();
+
+    // Lookups of missing names do not add entries
+    Assert::IsTrue(lookup.find("miss_none") == nullptr);
+    Assert::AreEqual(0, lookup.get("miss_none").value);
+    Assert::IsTrue(lookup.handle("miss_none") == TestLookup::INVALID_HANDLE);
+    Assert::IsFalse(lookup.has(TestLookup::INVALID_HANDLE));
+    Assert::AreEqual(size, lookup.size());
+
+    bool thrown = false;
+    try
+    {
+      lookup.reference("miss_none");
+    }
+    catch (std::runtime_error &)
+    {
+      thrown = true;
+    }
+    Assert::IsTrue(thrown);
+  }
+
+  TEST_METHOD(ResourceLookup_RefCount)
+  {
+    TestLookup &lookup = TestLookup::Instance();
+
+    TestLookup::Handle counted = lookup.add("ref_counted", TestResource(4), true);
+    TestLookup::Handle fixed = lookup.add("ref_fixed", TestResource(5));
+
+    Assert::AreEqual(4, lookup.acquire(counted).value);
+    lookup.acquire(counted);
+    Assert::AreEqual((size_t)2, lookup.references(counted));
+
+    // Referenced resources are not evicted
+    Assert::IsFalse(lookup.release(counted));
+    lookup.evictUnused();
+    Assert::IsTrue(lookup.has(counted));
+
+    int evicted = 0;
+    Assert::IsTrue(lookup.release(counted));
+    Assert::AreEqual((size_t)1, lookup.evictUnused([&evicted](TestResource &r) { evicted = r.value; }));
+    Assert::AreEqual(4, evicted);
+    Assert::IsFalse(lookup.has(counted));
+
+    // Resources that are not reference counted are kept
+    Assert::IsTrue(lookup.has(fixed));
+  }
+};
+#endif /* DOXYGEN_SKIP */
+}
+}
+}
@@ -0,0 +1,89 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 2.
+ */
+
+#include "CppUnitTest.h"
+
+#include <Engine_Common/SceneObject.h>
+
+/**
+ * @def FP_ACC
+ * @brief Accuracy for floating point comparison.
+ */
+#define FP_ACC 0.0001f
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Engine::Maths;
+
+// clang-format off
+namespace Engine
+{
+namespace Common
+{
+namespace Test
+{
+#ifndef DOXYGEN_SKIP
+TEST_CLASS(SceneObjectTest)
+{
+public:
+  TEST_METHOD(SceneObject_WorldTransform)
+  {
+    SceneObject root("root");
+    SceneObject child("child", &root);
+
+    root.setModelMatrix(Matrix4::Translation(Vector3(1.0f, 0.0f, 0.0f)));
+    child.setModelMatrix(Matrix4::Translation(Vector3(0.0f, 2.0f, 0.0f)));
+    root.update(0.0f, Subsystem::GRAPHICS);
+
+    Vector3 p = child.worldTransform().positionVector();
+    Assert::AreEqual(1.0f, p.x(), FP_ACC);
+    Assert::AreEqual(2.0f, p.y(), FP_ACC);
+
+    // Parent changes propagate to children
+    root.setModelMatrix(Matrix4::Translation(Vector3(5.0f, 0.0f, 0.0f)));
+    root.update(0.0f, Subsystem::PHYSICS);
+
+    p = child.worldTransform().positionVector();
+    Assert::AreEqual(5.0f, p.x(), FP_ACC);
+    Assert::AreEqual(2.0f, p.y(), FP_ACC);
+  }
+
+  TEST_METHOD(SceneObject_TransformCaching)
+  {
+    SceneObject root("root");
+    SceneObject a("a", &root);
+    SceneObject b("b", &root);
+    SceneObject c("c", &b);
+
+    // Everything is computed on the first update
+    unsigned long start = SceneObject::TransformUpdates();
+    root.update(0.0f, Subsystem::GRAPHICS);
+    Assert::AreEqual(4ul, SceneObject::TransformUpdates() - start);
+
+    // Nothing has changed so nothing is recomputed for other subsystems
+    start = SceneObject::TransformUpdates();
+    root.update(0.0f, Subsystem::PHYSICS);
+    root.update(0.0f, Subsystem::AUDIO);
+    Assert::AreEqual(0ul, SceneObject::TransformUpdates() - start);
+
+    // Only the changed subtree is recomputed
+    start = SceneObject::TransformUpdates();
+    b.setModelMatrix(Matrix4::Scale(2.0f));
+    root.update(0.0f, Subsystem::GRAPHICS);
+    Assert::AreEqual(2ul, SceneObject::TransformUpdates() - start);
+
+    // Reparenting marks the object as changed
+    start = SceneObject::TransformUpdates();
+    b.removeChild(&c);
+    a.addChild(&c);
+    root.update(0.0f, Subsystem::GRAPHICS);
+    Assert::AreEqual(1ul, SceneObject::TransformUpdates() - start);
+  }
+};
+#endif /* DOXYGEN_SKIP */
+}
+}
+}
@@ -0,0 +1,182 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 2.
+ */
+
+#include "CppUnitTest.h"
+
+#include <Engine_Common/Scene.h>
+#include <Engine_Common/SceneObject.h>
+
+/**
+ * @def FP_ACC
+ * @brief Accuracy for floating point comparison.
+ */
+#define FP_ACC 0.0001f
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Engine::Maths;
+
+namespace
+{
+/**
+ * @brief SceneObject that records the order in which objects are updated.
+ */
+class OrderedObject : public Engine::Common::SceneObject
+{
+public:
+  OrderedObject(const std::string &name, std::string &order, SceneObject *parent = nullptr)
+      : SceneObject(name, parent)
+      , m_order(order)
+  {
+  }
+
+  virtual void update(float msec, Engine::Common::Subsystem sys)
+  {
+    m_order += m_name;
+    SceneObject::update(msec, sys);
+  }
+
+private:
+  std::string &m_order;
+};
+}
+
+// clang-format off
+namespace Engine
+{
+namespace Common
+{
+namespace Test
+{
+#ifndef DOXYGEN_SKIP
+TEST_CLASS(SceneTest)
+{
+public:
+  TEST_METHOD(Scene_Flattened_Transforms)
+  {
+    SceneObject *root = new SceneObject("root");
+    SceneObject *a = new SceneObject("a", root);
+    SceneObject *b = new SceneObject("b", a);
+    Scene s(root);
+    s.setFlattened(true);
+
+    root->setModelMatrix(Matrix4::Translation(Vector3(1.0f, 0.0f, 0.0f)));
+    a->setModelMatrix(Matrix4::Translation(Vector3(0.0f, 2.0f, 0.0f)));
+    b->setModelMatrix(Matrix4::Translation(Vector3(0.0f, 0.0f, 3.0f)));
+    s.update(0.0f, Subsystem::GRAPHICS);
+
+    Assert::AreEqual((size_t)3, s.flatGraph().size());
+    Assert::AreEqual(FlatSceneGraph::NO_PARENT, s.flatGraph().parent(0));
+    Assert::AreEqual((size_t)0, s.flatGraph().parent(1));
+    Assert::AreEqual((size_t)1, s.flatGraph().parent(2));
+
+    Vector3 p = b->worldTransform().positionVector();
+    Assert::AreEqual(1.0f, p.x(), FP_ACC);
+    Assert::AreEqual(2.0f, p.y(), FP_ACC);
+    Assert::AreEqual(3.0f, p.z(), FP_ACC);
+
+    p = s.flatGraph().worldMatrix(2).positionVector();
+    Assert::AreEqual(3.0f, p.z(), FP_ACC);
+
+    // Unchanged transforms are not recomputed
+    unsigned long start = SceneObject::TransformUpdates();
+    s.update(0.0f, Subsystem::PHYSICS);
+    Assert::AreEqual(0ul, SceneObject::TransformUpdates() - start);
+
+    // Changes propagate to descendants
+    a->setModelMatrix(Matrix4::Translation(Vector3(0.0f, -2.0f, 0.0f)));
+    s.update(0.0f, Subsystem::GRAPHICS);
+    Assert::AreEqual(2ul, SceneObject::TransformUpdates() - start);
+
+    p = b->worldTransform().positionVector();
+    Assert::AreEqual(-2.0f, p.y(), FP_ACC);
+  }
+
+  TEST_METHOD(Scene_Flattened_Inactive)
+  {
+    SceneObject *root = new SceneObject("root");
+    SceneObject *a = new SceneObject("a", root);
+    SceneObject *b = new SceneObject("b", a);
+    Scene s(root);
+    s.setFlattened(true);
+    s.update(0.0f, Subsystem::GRAPHICS);
+
+    // Inactive subtrees are not updated
+    a->setActive(false);
+    Assert::IsFalse(s.flatGraph().active(1));
+    Assert::IsFalse(s.flatGraph().active(2));
+
+    unsigned long start = SceneObject::TransformUpdates();
+    root->setModelMatrix(Matrix4::Translation(Vector3(4.0f, 0.0f, 0.0f)));
+    s.update(0.0f, Subsystem::GRAPHICS);
+    Assert::AreEqual(1ul, SceneObject::TransformUpdates() - start);
+    Assert::AreEqual(0.0f, b->worldTransform().positionVector().x(), FP_ACC);
+
+    // Until they are active again
+    a->setActive(true);
+    s.update(0.0f, Subsystem::GRAPHICS);
+    Assert::AreEqual(3ul, SceneObject::TransformUpdates() - start);
+    Assert::AreEqual(4.0f, b->worldTransform().positionVector().x(), FP_ACC);
+    Assert::AreEqual(4.0f, s.flatGraph().worldMatrix(2).positionVector().x(), FP_ACC);
+  }
+
+  TEST_METHOD(Scene_Flattened_Topology)
+  {
+    SceneObject *root = new SceneObject("root");
+    SceneObject *a = new SceneObject("a", root);
+    Scene s(root);
+    s.setFlattened(true);
+
+    s.update(0.0f, Subsystem::GRAPHICS);
+    Assert::IsTrue(s.flatGraph().valid());
+    Assert::AreEqual((size_t)2, s.flatGraph().size());
+
+    // Adding a child invalidates the graph
+    SceneObject *b = new SceneObject("b");
+    b->setModelMatrix(Matrix4::Translation(Vector3(5.0f, 0.0f, 0.0f)));
+    a->addChild(b);
+    Assert::IsFalse(s.flatGraph().valid());
+
+    s.update(0.0f, Subsystem::GRAPHICS);
+    Assert::AreEqual((size_t)3, s.flatGraph().size());
+    Assert::AreEqual(5.0f, b->worldTransform().positionVector().x(), FP_ACC);
+
+    // As does removing one
+    a->removeChild(b);
+    Assert::IsFalse(s.flatGraph().valid());
+
+    s.update(0.0f, Subsystem::GRAPHICS);
+    Assert::AreEqual((size_t)2, s.flatGraph().size());
+  }
+
+  TEST_METHOD(Scene_Flattened_UpdateOrder)
+  {
+    std::string recursiveOrder;
+    OrderedObject *root1 = new OrderedObject("r", recursiveOrder);
+    OrderedObject *a1 = new OrderedObject("a", recursiveOrder, root1);
+    new OrderedObject("b", recursiveOrder, a1);
+    new OrderedObject("c", recursiveOrder, root1);
+    Scene recursive(root1);
+    recursive.update(0.0f, Subsystem::GRAPHICS);
+
+    std::string flatOrder;
+    OrderedObject *root2 = new OrderedObject("r", flatOrder);
+    OrderedObject *a2 = new OrderedObject("a", flatOrder, root2);
+    new OrderedObject("b", flatOrder, a2);
+    new OrderedObject("c", flatOrder, root2);
+    Scene flat(root2);
+    flat.setFlattened(true);
+    flat.update(0.0f, Subsystem::GRAPHICS);
+
+    // Each object is updated exactly once, in the same order
+    Assert::AreEqual(std::string("rabc"), recursiveOrder);
+    Assert::AreEqual(recursiveOrder, flatOrder);
+  }
+};
+#endif /* DOXYGEN_SKIP */
+}
+}
+}
@@ -0,0 +1,103 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include "DirtyRanges.h"
+
+#include <algorithm>
+
+namespace Engine
+{
+namespace Graphics
+{
+  /**
+   * @brief Creates a new empty set of ranges.
+   */
+  DirtyRanges::DirtyRanges()
+      : m_numRanges(0)
+  {
+  }
+
+  /**
+   * @brief Marks a range of elements as modified.
+   * @param first Index of first modified element
+   * @param count Number of modified elements
+   */
+  void DirtyRanges::add(size_t first, size_t count)
+  {
+    if (count == 0)
+      return;
+
+    Range range = {first, first + count};
+
+    // Absorb all ranges that overlap or touch the new range
+    size_t insertAt = 0;
+    size_t n = 0;
+    for (size_t i = 0; i < m_numRanges; i++)
+    {
+      const Range &r = m_ranges[i];
+
+      if (r.end < range.begin)
+      {
+        m_ranges[n++] = r;
+        insertAt = n;
+      }
+      else if (r.begin > range.end)
+      {
+        m_ranges[n++] = r;
+      }
+      else
+      {
+        range.begin = std::min(range.begin, r.begin);
+        range.end = std::max(range.end, r.end);
+      }
+    }
+
+    // Insert in order
+    for (size_t i = n; i > insertAt; i--)
+      m_ranges[i] = m_ranges[i - 1];
+    m_ranges[insertAt] = range;
+    m_numRanges = n + 1;
+
+    // Merge the closest pair of ranges if too many are held
+    if (m_numRanges > MAX_RANGES)
+    {
+      size_t closest = 0;
+      for (size_t i = 1; i + 1 < m_numRanges; i++)
+      {
+        if (m_ranges[i + 1].begin - m_ranges[i].end < m_ranges[closest + 1].begin - m_ranges[closest].end)
+          closest = i;
+      }
+
+      m_ranges[closest].end = m_ranges[closest + 1].end;
+      for (size_t i = closest + 1; i + 1 < m_numRanges; i++)
+        m_ranges[i] = m_ranges[i + 1];
+      m_numRanges--;
+    }
+  }
+
+  /**
+   * @brief Removes all ranges.
+   */
+  void DirtyRanges::clear()
+  {
+    m_numRanges = 0;
+  }
+
+  /**
+   * @brief Gets the total number of elements covered by all ranges.
+   * @return Element count
+   */
+  size_t DirtyRanges::numElements() const
+  {
+    size_t count = 0;
+    for (size_t i = 0; i < m_numRanges; i++)
+      count += m_ranges[i].count();
+
+    return count;
+  }
+}
+}
@@ -0,0 +1,98 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#ifndef _ENGINE_GRAPHICS_DIRTYRANGES_H_
+#define _ENGINE_GRAPHICS_DIRTYRANGES_H_
+
+#include <cstddef>
+
+namespace Engine
+{
+namespace Graphics
+{
+  /**
+   * @class DirtyRanges
+   * @brief Tracks the ranges of elements of an array that have been modified
+   *        since it was last uploaded.
+   * @author Dan Nixon
+   *
+   * Ranges are kept sorted and overlapping or adjacent ranges are merged.
+   * At most MAX_RANGES ranges are held, once exceeded the two ranges with
+   * the smallest gap between them are merged, so uploading a few slightly
+   * larger ranges is preferred over many small uploads.
+   */
+  class DirtyRanges
+  {
+  public:
+    /**
+     * @var MAX_RANGES
+     * @brief Maximum number of separate ranges that are tracked.
+     */
+    static const size_t MAX_RANGES = 8;
+
+    /**
+     * @struct Range
+     * @brief A range of modified elements.
+     */
+    struct Range
+    {
+      size_t begin; //!< Index of first element
+      size_t end;   //!< Index one past the last element
+
+      /**
+       * @brief Gets the number of elements in the range.
+       * @return Element count
+       */
+      inline size_t count() const
+      {
+        return end - begin;
+      }
+    };
+
+    DirtyRanges();
+
+    void add(size_t first, size_t count);
+    void clear();
+
+    /**
+     * @brief Checks if there are no modified elements.
+     * @return True if no ranges are held
+     */
+    inline bool empty() const
+    {
+      return m_numRanges == 0;
+    }
+
+    /**
+     * @brief Gets the number of ranges held.
+     * @return Range count
+     */
+    inline size_t size() const
+    {
+      return m_numRanges;
+    }
+
+    /**
+     * @brief Gets a range.
+     * @param idx Index of range (ranges are in ascending order)
+     * @return Range
+     */
+    inline const Range &operator[](size_t idx) const
+    {
+      return m_ranges[idx];
+    }
+
+    size_t numElements() const;
+
+  private:
+    Range m_ranges[MAX_RANGES + 1]; //!< Modified ranges (with space for one more before merging)
+    size_t m_numRanges;             //!< Number of ranges held
+  };
+}
+}
+
+#endif
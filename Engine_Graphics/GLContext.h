@@ -0,0 +1,41 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#ifndef _ENGINE_GRAPHICS_GLCONTEXT_H_
+#define _ENGINE_GRAPHICS_GLCONTEXT_H_
+
+#include <GL/glew.h>
+
+namespace Engine
+{
+namespace Graphics
+{
+  /**
+   * @class GLContext
+   * @brief Utility for checking if GL functions can be used.
+   * @author Dan Nixon
+   *
+   * GL functions beyond 1.1 are loaded by GLEW once a context has been
+   * created, without a context (e.g. when running headless) they are null and
+   * graphics objects skip any calls to them.
+   */
+  class GLContext
+  {
+  public:
+    /**
+     * @brief Checks if a GL context has been created and GLEW initialised.
+     * @return True if GL functions are available
+     */
+    static inline bool Available()
+    {
+      return glGenVertexArrays != nullptr;
+    }
+  };
+}
+}
+
+#endif
@@ -0,0 +1,86 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include "GLState.h"
+
+namespace Engine
+{
+namespace Graphics
+{
+  GLuint GLState::s_program = GLState::UNKNOWN;
+  GLuint GLState::s_activeUnit = GLState::UNKNOWN;
+  GLuint GLState::s_textures[GLState::MAX_TEXTURE_UNITS] = {UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN,
+                                                            UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN};
+  uint64_t GLState::s_issued = 0;
+  uint64_t GLState::s_skipped = 0;
+
+  /**
+   * @brief Makes a shader program current, if it is not already.
+   * @param program GL shader program
+   */
+  void GLState::UseProgram(GLuint program)
+  {
+    const bool issue = (program != s_program);
+    CountCall(issue);
+
+    if (issue)
+    {
+      glUseProgram(program);
+      s_program = program;
+    }
+  }
+
+  /**
+   * @brief Binds a 2D texture to a texture unit, if it is not already.
+   * @param unit Texture unit index
+   * @param texture GL texture (0 to unbind)
+   *
+   * Units beyond MAX_TEXTURE_UNITS are always bound.
+   */
+  void GLState::BindTexture(GLuint unit, GLuint texture)
+  {
+    const bool tracked = (unit < MAX_TEXTURE_UNITS);
+    const bool issue = !tracked || (texture != s_textures[unit]);
+    CountCall(issue);
+
+    if (!issue)
+      return;
+
+    if (unit != s_activeUnit)
+    {
+      glActiveTexture(GL_TEXTURE0 + unit);
+      s_activeUnit = unit;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, texture);
+
+    if (tracked)
+      s_textures[unit] = texture;
+  }
+
+  /**
+   * @brief Forgets all cached state so the next binding of each kind is
+   *        always made.
+   */
+  void GLState::Invalidate()
+  {
+    s_program = UNKNOWN;
+    InvalidateTextures();
+  }
+
+  /**
+   * @brief Forgets cached texture bindings (e.g. after textures have been
+   *        created or deleted outside of GLState).
+   */
+  void GLState::InvalidateTextures()
+  {
+    s_activeUnit = UNKNOWN;
+    for (size_t i = 0; i < MAX_TEXTURE_UNITS; i++)
+      s_textures[i] = UNKNOWN;
+  }
+}
+}
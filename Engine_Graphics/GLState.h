@@ -0,0 +1,91 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#ifndef _ENGINE_GRAPHICS_GLSTATE_H_
+#define _ENGINE_GRAPHICS_GLSTATE_H_
+
+#include <cstdint>
+
+#include <GL/glew.h>
+
+namespace Engine
+{
+namespace Graphics
+{
+  /**
+   * @class GLState
+   * @brief Cache of GL binding state used to filter redundant state changes.
+   * @author Dan Nixon
+   *
+   * Only bindings made through GLState are tracked, code that binds programs
+   * or textures directly must call GLState::InvalidateTextures or
+   * GLState::Invalidate afterwards.
+   *
+   * Counts of calls issued and skipped (including uniform writes filtered by
+   * ShaderProgram) are kept for profiling.
+   */
+  class GLState
+  {
+  public:
+    /**
+     * @var MAX_TEXTURE_UNITS
+     * @brief Number of texture units bindings are tracked for.
+     */
+    static const size_t MAX_TEXTURE_UNITS = 8;
+
+    static void UseProgram(GLuint program);
+    static void BindTexture(GLuint unit, GLuint texture);
+
+    static void Invalidate();
+    static void InvalidateTextures();
+
+    /**
+     * @brief Records a GL call that was either made or filtered out.
+     * @param issued True if the call was made
+     */
+    static inline void CountCall(bool issued)
+    {
+      if (issued)
+        s_issued++;
+      else
+        s_skipped++;
+    }
+
+    /**
+     * @brief Gets the total number of state changing calls made.
+     * @return Calls issued
+     * @see Engine::Common::Profiler::addCounter
+     */
+    static inline uint64_t CallsIssued()
+    {
+      return s_issued;
+    }
+
+    /**
+     * @brief Gets the total number of state changing calls that were
+     *        redundant and not made.
+     * @return Calls skipped
+     * @see Engine::Common::Profiler::addCounter
+     */
+    static inline uint64_t CallsSkipped()
+    {
+      return s_skipped;
+    }
+
+  private:
+    static const GLuint UNKNOWN = 0xFFFFFFFF; //!< Value of a binding that is not known
+
+    static GLuint s_program;                     //!< Program in use
+    static GLuint s_activeUnit;                  //!< Active texture unit
+    static GLuint s_textures[MAX_TEXTURE_UNITS]; //!< Texture bound to GL_TEXTURE_2D of each unit
+    static uint64_t s_issued;                    //!< Number of calls made
+    static uint64_t s_skipped;                   //!< Number of redundant calls skipped
+  };
+}
+}
+
+#endif
@@ -7,6 +7,8 @@
 
 #include "GraphicalScene.h"
 
+#include <Engine_Maths/Matrix3.h>
+
 #include "RenderableObject.h"
 
 using namespace Engine::Common;
@@ -16,12 +18,19 @@ namespace Engine
 {
 namespace Graphics
 {
+  uint64_t GraphicalScene::s_nextPass = 1;
+
   /**
    * @copydoc Scene::Scene
    */
   GraphicalScene::GraphicalScene(SceneObject *root, Matrix4 view, Matrix4 projection)
       : Scene(root, view, projection)
+      , m_sorted(true)
+      , m_sortPass(false)
+      , m_pass(0)
   {
+    // Objects in the tree were added before this was a GraphicalScene
+    addRootToScene();
   }
 
   GraphicalScene::~GraphicalScene()
@@ -33,15 +42,96 @@ namespace Graphics
    */
   void GraphicalScene::update(float msec, Subsystem sys)
   {
+    if (sys == Subsystem::GRAPHICS)
+    {
+      m_pass = s_nextPass++;
+
+      Matrix3 rotation = Matrix3(m_viewMatrix);
+      m_cameraPosition = rotation * -m_viewMatrix.positionVector();
+
+      // Depth is the negated view space Z
+      m_depthAxis = -m_viewMatrix.row(2);
+
+      // The bottom row of a perspective projection is (0, 0, -1, 0), an
+      // orthographic projection (menus, HUD) has no depth test and keeps scene
+      // order
+      m_sortPass = m_sorted && m_projectionMatrix.row(3).w() == 0.0f;
+
+      m_renderQueue.clear();
+    }
+
     Scene::update(msec, sys);
 
     if (sys == Subsystem::GRAPHICS)
     {
-      for (auto it = m_transparent.begin(); it != m_transparent.end(); ++it)
-        (*it)->render();
+      m_renderQueue.sort();
+
+      render();
+    }
+  }
+
+  /**
+   * @brief Renders all objects in the render queue, batching runs of objects
+   *        that share an instanced draw.
+   */
+  void GraphicalScene::render()
+  {
+    const size_t n = m_renderQueue.size();
+
+    size_t i = 0;
+    while (i < n)
+    {
+      RenderableObject *obj = m_renderQueue[i++].object;
+
+      if (!obj->instanced())
+      {
+        obj->render();
+        continue;
+      }
+
+      m_instances.clear();
+      m_instances.add(obj->worldTransform(), obj->instanceColour());
+
+      while (i < n && obj->sharesInstancedDraw(*m_renderQueue[i].object))
+      {
+        RenderableObject *instance = m_renderQueue[i++].object;
+        m_instances.add(instance->worldTransform(), instance->instanceColour());
+      }
+
+      obj->renderInstances(m_instances);
+    }
+  }
+
+  /**
+   * @brief Adds an object to the render queue for the current pass.
+   * @param obj Object to render
+   */
+  void GraphicalScene::queue(RenderableObject *obj)
+  {
+    // Unsorted queues only order by pass, the stable sort keeps scene order
+    // within each pass
+    if (!m_sortPass)
+    {
+      const RenderQueue::Pass pass = obj->transparent() ? RenderQueue::TRANSPARENT_PASS : RenderQueue::OPAQUE_PASS;
+      m_renderQueue.push(RenderQueue::PassKey(pass), obj);
+      return;
+    }
+
+    const float depth = Vector4::dot(m_depthAxis, Vector4(obj->worldTransform().positionVector(), 1.0f));
 
-      m_transparent.clear();
+    uint64_t key;
+    if (obj->transparent())
+    {
+      key = RenderQueue::TransparentKey(depth);
+    }
+    else
+    {
+      key = RenderQueue::OpaqueKey(m_renderQueue.resourceID(RenderQueue::SHADER_RESOURCE, obj->shader()),
+                                   m_renderQueue.resourceID(RenderQueue::TEXTURE_RESOURCE, obj->texture()),
+                                   m_renderQueue.resourceID(RenderQueue::MESH_RESOURCE, obj->mesh()), depth);
     }
+
+    m_renderQueue.push(key, obj);
   }
 }
 }
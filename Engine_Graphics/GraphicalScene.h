@@ -10,12 +10,15 @@
 
 #include <Engine_Common/Scene.h>
 
+#include <cstdint>
 #include <vector>
 
 #include <Engine_Common/SceneObject.h>
 #include <Engine_Common/Subsystem.h>
 
+#include "InstanceBuffer.h"
 #include "Light.h"
+#include "RenderQueue.h"
 
 namespace Engine
 {
@@ -25,8 +28,20 @@ namespace Graphics
 
   /**
    * @class GraphicalScene
-   * @brief An extension to Scene that renders transparent objects last.
+   * @brief An extension to Scene that queues renderable objects and renders
+   *        them sorted by state and depth once the scene has been updated.
    * @author Dan Nixon
+   *
+   * Opaque objects are rendered first, grouped by shader, texture and mesh
+   * and front to back within each group. Transparent objects are rendered
+   * last, back to front.
+   *
+   * Scenes with an orthographic projection (menus and HUDs) are drawn without
+   * depth testing, so their objects are rendered in scene order instead (still
+   * opaque objects first, then transparent objects).
+   *
+   * Consecutive objects in the sorted queue that have the same mesh, instanced
+   * shader and texture are rendered with a single instanced draw.
    */
   class GraphicalScene : public Engine::Common::Scene
   {
@@ -44,13 +59,82 @@ namespace Graphics
       return m_lights;
     }
 
+    /**
+     * @brief Gets the unique ID of the current rendering pass.
+     * @return Pass ID
+     * @see ShaderProgram::beginPass
+     */
+    inline uint64_t pass() const
+    {
+      return m_pass;
+    }
+
+    /**
+     * @brief Gets the position of the camera in world space for the current
+     *        rendering pass.
+     * @return Camera position
+     */
+    inline const Engine::Maths::Vector3 &cameraPosition() const
+    {
+      return m_cameraPosition;
+    }
+
+    /**
+     * @brief Tests if objects are rendered sorted by state and depth.
+     * @return True if sorted
+     * @see GraphicalScene::setSorted
+     *
+     * Scenes with an orthographic projection are not sorted regardless of this
+     * setting.
+     */
+    inline bool sorted() const
+    {
+      return m_sorted;
+    }
+
+    /**
+     * @brief Sets if objects are rendered sorted by state and depth.
+     * @param sorted True to sort, false to render opaque then transparent
+     *               objects, each in scene order
+     *
+     * Scenes that rely on draw order rather than depth testing should not be
+     * sorted (this is already the case for orthographic projections).
+     * Consecutive objects that share an instanced draw are batched either way.
+     */
+    inline void setSorted(bool sorted)
+    {
+      m_sorted = sorted;
+    }
+
+    /**
+     * @brief Gets the queue of objects rendered in the last rendering pass.
+     * @return Render queue
+     */
+    inline const RenderQueue &renderQueue() const
+    {
+      return m_renderQueue;
+    }
+
     virtual void update(float msec, Engine::Common::Subsystem sys);
 
   protected:
     friend class RenderableObject;
 
-    std::vector<RenderableObject *> m_transparent; //!< Transparent objects to be rendered last
-    std::vector<Light *> m_lights;                 //!< List of all lights in a scene
+    void queue(RenderableObject *obj);
+    void render();
+
+    bool m_sorted;                 //!< Flag indicating if the render queue is sorted
+    bool m_sortPass;               //!< Flag indicating if the render queue is sorted in the current pass
+    RenderQueue m_renderQueue;     //!< Objects to be rendered in the current pass
+    InstanceBuffer m_instances;    //!< Instance data for instanced draws
+    std::vector<Light *> m_lights; //!< List of all lights in a scene
+
+    uint64_t m_pass;                         //!< ID of the current rendering pass
+    Engine::Maths::Vector3 m_cameraPosition; //!< Camera position for the current rendering pass
+    Engine::Maths::Vector4 m_depthAxis;      //!< Dot with a position to give its depth in the current pass
+
+  private:
+    static uint64_t s_nextPass; //!< ID of the next rendering pass (unique across all scenes)
   };
 }
 }
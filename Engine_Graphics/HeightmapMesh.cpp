@@ -120,15 +120,17 @@ namespace Graphics
    * @param row Row index
    * @param col Column index
    * @param height New height
-   * @param buffer Set to true to output VBOs
+   * @param buffer Set to true to upload modified vertices now (otherwise
+   *               they are uploaded on the next flush or draw)
    */
   void HeightmapMesh::setHeight(size_t row, size_t col, float height, bool buffer)
   {
     vertexPosition(row, col)[1] = height;
+    markDirty((col * m_depthSteps) + row, 1);
 
     // Update buffers
     if (buffer)
-      bufferData();
+      flush();
   }
 
   /**
@@ -136,7 +138,7 @@ namespace Graphics
    * @param height Pointer to array of height data (must be equal in length to
    *               vertex array)
    *
-   * Buffers are updated.
+   * Vertex buffer is updated (indices are not re-uploaded).
    */
   void HeightmapMesh::setHeight(float *height)
   {
@@ -145,7 +147,8 @@ namespace Graphics
       m_vertices[i][1] = height[i];
 
     // Update buffers
-    bufferData();
+    markDirty();
+    flush();
   }
 
   /**
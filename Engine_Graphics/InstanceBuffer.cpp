@@ -0,0 +1,80 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include "InstanceBuffer.h"
+
+#include <cstddef>
+#include <cstring>
+
+#include "GLContext.h"
+
+using namespace Engine::Maths;
+
+namespace Engine
+{
+namespace Graphics
+{
+  /**
+   * @brief Creates a new, empty instance buffer.
+   *
+   * The GL buffer is created when the buffer is first bound.
+   */
+  InstanceBuffer::InstanceBuffer()
+      : m_buffer(0)
+  {
+  }
+
+  InstanceBuffer::~InstanceBuffer()
+  {
+    if (m_buffer != 0 && GLContext::Available())
+      glDeleteBuffers(1, &m_buffer);
+  }
+
+  /**
+   * @brief Adds an instance.
+   * @param modelMatrix Model matrix of the instance
+   * @param colour Colour of the instance
+   */
+  void InstanceBuffer::add(const Matrix4 &modelMatrix, const Colour &colour)
+  {
+    Instance instance;
+    memcpy(instance.modelMatrix, &modelMatrix, sizeof(instance.modelMatrix));
+    for (size_t i = 0; i < 4; i++)
+      instance.colour[i] = colour[i];
+
+    m_instances.push_back(instance);
+  }
+
+  /**
+   * @brief Uploads the instance data and sets the instance attributes of the
+   *        currently bound vertex array object to read from it.
+   */
+  void InstanceBuffer::bind()
+  {
+    if (m_buffer == 0)
+      glGenBuffers(1, &m_buffer);
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+    glBufferData(GL_ARRAY_BUFFER, m_instances.size() * sizeof(Instance), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, m_instances.size() * sizeof(Instance), m_instances.data());
+
+    for (GLuint i = 0; i < 4; i++)
+    {
+      const GLuint attribute = MODEL_MATRIX_ATTRIBUTE + i;
+      glVertexAttribPointer(attribute, 4, GL_FLOAT, GL_FALSE, sizeof(Instance),
+                            (GLvoid *)(offsetof(Instance, modelMatrix) + (i * 4 * sizeof(float))));
+      glVertexAttribDivisor(attribute, 1);
+      glEnableVertexAttribArray(attribute);
+    }
+
+    glVertexAttribPointer(COLOUR_ATTRIBUTE, 4, GL_FLOAT, GL_FALSE, sizeof(Instance),
+                          (GLvoid *)offsetof(Instance, colour));
+    glVertexAttribDivisor(COLOUR_ATTRIBUTE, 1);
+    glEnableVertexAttribArray(COLOUR_ATTRIBUTE);
+  }
+}
+}
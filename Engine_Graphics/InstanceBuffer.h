@@ -0,0 +1,100 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#ifndef _ENGINE_GRAPHICS_INSTANCEBUFFER_H_
+#define _ENGINE_GRAPHICS_INSTANCEBUFFER_H_
+
+#include <vector>
+
+#include <GL/glew.h>
+
+#include <Engine_Maths/Matrix4.h>
+
+#include "Colour.h"
+
+namespace Engine
+{
+namespace Graphics
+{
+  /**
+   * @class InstanceBuffer
+   * @brief Holds the per instance data (model matrix and colour) used in an
+   *        instanced draw.
+   * @author Dan Nixon
+   *
+   * Instance data is streamed, the GL buffer is orphaned and refilled each
+   * time it is bound. Shaders read it through the "instanceModelMatrix" (mat4)
+   * and "instanceColour" (vec4) attributes.
+   */
+  class InstanceBuffer
+  {
+  public:
+    /**
+     * @var MODEL_MATRIX_ATTRIBUTE
+     * @brief Vertex attribute index of the first column of the instance model
+     *        matrix (uses four consecutive indices).
+     */
+    static const GLuint MODEL_MATRIX_ATTRIBUTE = 6;
+
+    /**
+     * @var COLOUR_ATTRIBUTE
+     * @brief Vertex attribute index of the instance colour.
+     */
+    static const GLuint COLOUR_ATTRIBUTE = 10;
+
+    InstanceBuffer();
+    ~InstanceBuffer();
+
+    /**
+     * @brief No copy constructor (the GL buffer is owned by one instance).
+     */
+    InstanceBuffer(const InstanceBuffer &) = delete;
+
+    /**
+     * @brief No assign copy constructor
+     */
+    InstanceBuffer &operator=(const InstanceBuffer &) = delete;
+
+    /**
+     * @brief Removes all instances.
+     */
+    inline void clear()
+    {
+      m_instances.clear();
+    }
+
+    /**
+     * @brief Gets the number of instances.
+     * @return Instance count
+     */
+    inline size_t size() const
+    {
+      return m_instances.size();
+    }
+
+    void add(const Engine::Maths::Matrix4 &modelMatrix, const Colour &colour);
+
+    void bind();
+
+  private:
+    /**
+     * @struct Instance
+     * @brief Layout of the data for a single instance.
+     */
+    struct Instance
+    {
+      float modelMatrix[16]; //!< Model matrix (column major)
+      float colour[4];       //!< Colour
+    };
+
+    std::vector<Instance> m_instances; //!< Instance data
+    GLuint m_buffer;                   //!< GL buffer holding instance data
+  };
+}
+}
+
+#endif
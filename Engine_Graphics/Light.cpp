@@ -42,12 +42,11 @@ namespace Graphics
    *
    * Shader is expected to have already been made active.
    */
-  void Light::use(GLuint program)
+  void Light::use(ShaderProgram *program)
   {
-    Vector3 position = m_worldTransform.positionVector();
-    glUniform3fv(glGetUniformLocation(program, m_shaderVarNamePosition.c_str()), 1, (float *)&position);
-    glUniform1f(glGetUniformLocation(program, m_shaderVarNameRadius.c_str()), m_radius);
-    glUniform1f(glGetUniformLocation(program, m_shaderVarNameIntensity.c_str()), m_intensity);
+    program->setUniform(program->uniformIndex(m_shaderVarNamePosition), m_worldTransform.positionVector());
+    program->setUniform(program->uniformIndex(m_shaderVarNameRadius), m_radius);
+    program->setUniform(program->uniformIndex(m_shaderVarNameIntensity), m_intensity);
   }
 }
 }
@@ -63,7 +63,7 @@ namespace Graphics
       m_intensity = intensity;
     }
 
-    void use(GLuint program);
+    void use(ShaderProgram *program);
 
   protected:
     std::string m_shaderVarNamePosition;  //!< Name of the shader variable for light position
@@ -8,6 +8,7 @@
 #include "LineMesh.h"
 
 #include <Engine_Maths/Vector3.h>
+#include <Engine_ResourceManagment/MemoryManager.h>
 
 using namespace Engine::Maths;
 
@@ -15,6 +16,37 @@ namespace Engine
 {
 namespace Graphics
 {
+  /**
+   * @brief Gets the pool LineMesh instances are allocated from.
+   * @return Object pool
+   */
+  Engine::ResourceManagment::ObjectPool &LineMesh::Pool()
+  {
+    static Engine::ResourceManagment::ObjectPool pool(sizeof(LineMesh));
+    return pool;
+  }
+
+  /**
+   * @brief Allocates memory for LineMesh from its pool (derived types of a
+   *        different size are allocated from the heap).
+   * @param size Size of object
+   * @return Pointer to memory
+   */
+  void *LineMesh::operator new(size_t size)
+  {
+    return Engine::ResourceManagment::MemoryManager::Instance().allocate(size, &Pool());
+  }
+
+  /**
+   * @brief Frees memory used by a LineMesh.
+   * @param ptr Pointer to memory
+   * @param size Size of object
+   */
+  void LineMesh::operator delete(void *ptr, size_t size)
+  {
+    Engine::ResourceManagment::MemoryManager::Instance().deallocate(ptr, size, &Pool());
+  }
+
   /**
    * @brief Create a new line mesh.
    * @param from Starting point
@@ -35,7 +67,11 @@ namespace Graphics
     m_colours[0] = Colour();
     m_colours[1] = Colour();
 
+    // End points are typically moved every frame
+    m_usage = STREAM_BUFFER;
+
     updateMesh(from, to);
+    bufferData();
   }
 
   LineMesh::~LineMesh()
@@ -64,6 +100,8 @@ namespace Graphics
    * @brief Updates the vertices of the mesh.
    * @param from Starting point
    * @param to Finishing point
+   *
+   * The vertex buffer is updated when the mesh is next drawn.
    */
   void LineMesh::updateMesh(const Vector3 &from, const Vector3 &to)
   {
@@ -74,7 +112,7 @@ namespace Graphics
     m_boundingBox.resizeByPoint(m_vertices[0]);
     m_boundingBox.resizeByPoint(m_vertices[1]);
 
-    bufferData();
+    markDirty(0, 2);
   }
 }
 }
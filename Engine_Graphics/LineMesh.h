@@ -22,6 +22,10 @@ namespace Graphics
   class LineMesh : public Mesh
   {
   public:
+    static Engine::ResourceManagment::ObjectPool &Pool();
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr, size_t size);
+
     LineMesh(const Engine::Maths::Vector3 &from, const Engine::Maths::Vector3 &to);
     virtual ~LineMesh();
 
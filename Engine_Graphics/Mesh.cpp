@@ -7,21 +7,124 @@
 
 #include "Mesh.h"
 
+#include <algorithm>
+#include <cstring>
+
+#include <Engine_Maths/TransformBatch.h>
 #include <Engine_Maths/VectorOperations.h>
 #include <Engine_Maths/math_common.h>
+#include <Engine_ResourceManagment/MemoryManager.h>
+#include <Engine_Utility/TraceProfiler.h>
+
+#include "GLContext.h"
+#include "MeshCache.h"
 
 using namespace Engine::Maths;
 
+namespace
+{
+/**
+ * @brief Copies a vertex stream into a new array.
+ * @param src Stream to copy (may be nullptr)
+ * @param n Number of elements
+ * @return New array, nullptr if src is nullptr
+ */
+template <typename T> T *CopyStream(const T *src, size_t n)
+{
+  if (src == nullptr)
+    return nullptr;
+
+  T *dest = new T[n];
+  memcpy(dest, src, n * sizeof(T));
+  return dest;
+}
+
+/**
+ * @brief Gets the GL usage hint for a buffer usage.
+ * @param usage Buffer usage
+ * @return GL usage hint
+ */
+GLenum UsageHint(Engine::Graphics::Mesh::BufferUsage usage)
+{
+  switch (usage)
+  {
+  case Engine::Graphics::Mesh::DYNAMIC_BUFFER:
+    return GL_DYNAMIC_DRAW;
+  case Engine::Graphics::Mesh::STREAM_BUFFER:
+    return GL_STREAM_DRAW;
+  default:
+    return GL_STATIC_DRAW;
+  }
+}
+
+/**
+ * @brief Gets the buffer vertices are packed into before being uploaded.
+ * @return Packing buffer
+ *
+ * Shared by all meshes as uploads are only made from the thread owning the
+ * GL context.
+ */
+std::vector<char> &PackBuffer()
+{
+  static std::vector<char> buffer;
+  return buffer;
+}
+}
+
 namespace Engine
 {
 namespace Graphics
 {
+  uint64_t Mesh::s_uploadedBytes = 0;
+  uint64_t Mesh::s_uploads = 0;
+  uint64_t Mesh::s_drawCalls = 0;
+
+  /**
+   * @brief Gets the pool Mesh instances are allocated from.
+   * @return Object pool
+   */
+  Engine::ResourceManagment::ObjectPool &Mesh::Pool()
+  {
+    static Engine::ResourceManagment::ObjectPool pool(sizeof(Mesh));
+    return pool;
+  }
+
+  /**
+   * @brief Allocates memory for Mesh from its pool (derived types of a
+   *        different size are allocated from the heap).
+   * @param size Size of object
+   * @return Pointer to memory
+   */
+  void *Mesh::operator new(size_t size)
+  {
+    return Engine::ResourceManagment::MemoryManager::Instance().allocate(size, &Pool());
+  }
+
+  /**
+   * @brief Frees memory used by a Mesh.
+   * @param ptr Pointer to memory
+   * @param size Size of object
+   */
+  void Mesh::operator delete(void *ptr, size_t size)
+  {
+    Engine::ResourceManagment::MemoryManager::Instance().deallocate(ptr, size, &Pool());
+  }
+
   /**
    * @brief Creates a new empty mesh.
    */
   Mesh::Mesh()
-      : m_numIndices(0)
-      , m_type(GL_TRIANGLES)
+      : m_type(GL_TRIANGLES)
+      , m_arrayObject(0)
+      , m_vertexBuffer(0)
+      , m_indexBuffer(0)
+      , m_numVertices(0)
+      , m_numIndices(0)
+      , m_indexType(GL_UNSIGNED_INT)
+      , m_encoding(VertexFormat::ENCODE_FULL)
+      , m_bufferedVertices(0)
+      , m_bufferedIndices(0)
+      , m_usage(STATIC_BUFFER)
       , m_vertices(nullptr)
       , m_colours(nullptr)
       , m_textureCoords(nullptr)
@@ -29,16 +132,18 @@ namespace Graphics
       , m_tangents(nullptr)
       , m_indices(nullptr)
   {
-    glGenVertexArrays(1, &m_arrayObject);
-
-    for (int i = 0; i < MAX_BUFFER; ++i)
-      m_bufferObject[i] = 0;
+    if (GLContext::Available())
+      glGenVertexArrays(1, &m_arrayObject);
   }
 
   Mesh::~Mesh(void)
   {
-    glDeleteVertexArrays(1, &m_arrayObject);
-    glDeleteBuffers(MAX_BUFFER, m_bufferObject);
+    if (GLContext::Available())
+    {
+      glDeleteVertexArrays(1, &m_arrayObject);
+      glDeleteBuffers(1, &m_vertexBuffer);
+      glDeleteBuffers(1, &m_indexBuffer);
+    }
 
     delete[] m_vertices;
     delete[] m_colours;
@@ -50,25 +155,62 @@ namespace Graphics
 
   /**
    * @brief Draws the mesh.
-   * @param program The shader program used to draw the mesh
+   * @param program The shader program used to draw the mesh (already in use)
    */
-  void Mesh::draw(GLuint program)
+  void Mesh::draw(ShaderProgram *program)
   {
-    glUniform4fv(glGetUniformLocation(program, "ambientColour"), 1, (float *)&m_ambientColour);
-    glUniform4fv(glGetUniformLocation(program, "diffuseColour"), 1, (float *)&m_diffuseColour);
-    glUniform4fv(glGetUniformLocation(program, "specularColour"), 1, (float *)&m_specularColour);
-    glUniform1f(glGetUniformLocation(program, "ambientStrength"), 0.2f);
-    glUniform1f(glGetUniformLocation(program, "shininess"), m_shininess);
-    glUniform1f(glGetUniformLocation(program, "shininessStrength"), m_shininessStrength);
+    useMaterial(program);
+    flush();
 
     glBindVertexArray(m_arrayObject);
 
-    if (m_bufferObject[INDEX_BUFFER])
-      glDrawElements(m_type, (GLsizei)m_numIndices, GL_UNSIGNED_INT, 0);
+    if (m_indexBuffer)
+      glDrawElements(m_type, (GLsizei)m_numIndices, m_indexType, 0);
     else
       glDrawArrays(m_type, 0, (GLsizei)m_numVertices);
 
     glBindVertexArray(0);
+    s_drawCalls++;
+  }
+
+  /**
+   * @brief Draws several instances of the mesh in a single draw call.
+   * @param program The shader program used to draw the mesh (already in use,
+   *                must read the instance attributes)
+   * @param instances Per instance data
+   */
+  void Mesh::drawInstanced(ShaderProgram *program, InstanceBuffer &instances)
+  {
+    if (instances.size() == 0)
+      return;
+
+    useMaterial(program);
+    flush();
+
+    glBindVertexArray(m_arrayObject);
+    instances.bind();
+
+    if (m_indexBuffer)
+      glDrawElementsInstanced(m_type, (GLsizei)m_numIndices, m_indexType, 0, (GLsizei)instances.size());
+    else
+      glDrawArraysInstanced(m_type, 0, (GLsizei)m_numVertices, (GLsizei)instances.size());
+
+    glBindVertexArray(0);
+    s_drawCalls++;
+  }
+
+  /**
+   * @brief Sets the material uniforms of a shader program.
+   * @param program Shader program (already in use)
+   */
+  void Mesh::useMaterial(ShaderProgram *program)
+  {
+    program->setUniform(ShaderProgram::AMBIENT_COLOUR, m_ambientColour);
+    program->setUniform(ShaderProgram::DIFFUSE_COLOUR, m_diffuseColour);
+    program->setUniform(ShaderProgram::SPECULAR_COLOUR, m_specularColour);
+    program->setUniform(ShaderProgram::AMBIENT_STRENGTH, 0.2f);
+    program->setUniform(ShaderProgram::SHININESS, m_shininess);
+    program->setUniform(ShaderProgram::SHININESS_STRENGTH, m_shininessStrength);
   }
 
   // CSC3224 NCODE Dan Nixon 120263697
@@ -76,16 +218,63 @@ namespace Graphics
   /**
    * @brief Sets all vertix colours in the mesh to a solid colour.
    * @param col Colour to set
+   *
+   * Only the range of vertices whose colour changed is marked as dirty.
    */
   void Mesh::setStaticColour(const Colour &col)
   {
-    if (m_colours != nullptr)
+    if (m_colours == nullptr)
+      return;
+
+    size_t first = m_numVertices;
+    size_t last = 0;
+
+    for (size_t i = 0; i < m_numVertices; i++)
     {
-      for (size_t i = 0; i < m_numVertices; i++)
+      if (m_colours[i] != col)
+      {
         m_colours[i] = col;
+        first = std::min(first, i);
+        last = i;
+      }
     }
 
-    bufferData();
+    if (first < m_numVertices)
+      markDirty(first, last - first + 1);
+  }
+
+  /**
+   * @brief Sets how often the vertex data is expected to change.
+   * @param usage Buffer usage
+   *
+   * The GL usage hint takes effect the next time the vertex buffer is
+   * allocated.
+   */
+  void Mesh::setBufferUsage(BufferUsage usage)
+  {
+    m_usage = usage;
+  }
+
+  /**
+   * @brief Marks a range of vertices as modified so that they are uploaded
+   *        on the next flush.
+   * @param first Index of first modified vertex
+   * @param count Number of modified vertices
+   */
+  void Mesh::markDirty(size_t first, size_t count)
+  {
+    if (first >= m_numVertices)
+      return;
+
+    m_dirtyVertices.add(first, std::min(count, m_numVertices - first));
+  }
+
+  /**
+   * @brief Marks all vertices as modified.
+   */
+  void Mesh::markDirty()
+  {
+    m_dirtyVertices.add(0, m_numVertices);
   }
 
   // CSC3224 NCODE BLOCK ENDS
@@ -93,64 +282,185 @@ namespace Graphics
   /**
    * @brief Buffers all VBO data into graphics memory.
    *
-   * Required before drawing.
+   * Required before drawing. Does nothing if there is no GL context (vertex
+   * data is still held in memory).
+   *
+   * Vertex attributes are packed into a single interleaved buffer using the
+   * format selected by setVertexEncoding(). Buffer objects are created on
+   * the first call and updated in place by later calls, only being
+   * reallocated if the number of vertices or indices (or the vertex format)
+   * has changed.
    */
   void Mesh::bufferData()
   {
-    glBindVertexArray(m_arrayObject);
+    if (!GLContext::Available())
+      return;
+
+    PROFILE_SCOPE("Mesh::bufferData");
+
+    bufferVertices();
+    bufferIndices();
+  }
+
+  /**
+   * @brief Uploads vertices that have been modified since they were last
+   *        buffered.
+   *
+   * Each dirty range is uploaded separately with glBufferSubData. If the
+   * vertex buffer must be reallocated, or the mesh uses STREAM_BUFFER, the
+   * whole vertex buffer is uploaded instead (orphaning the previous
+   * storage). Index data is not updated, use bufferData() if it changed.
+   */
+  void Mesh::flush()
+  {
+    if (m_dirtyVertices.empty() || !GLContext::Available())
+      return;
+
+    PROFILE_SCOPE("Mesh::flush");
 
-    glGenBuffers(1, &m_bufferObject[VERTEX_BUFFER]);
-    glBindBuffer(GL_ARRAY_BUFFER, m_bufferObject[VERTEX_BUFFER]);
-    glBufferData(GL_ARRAY_BUFFER, m_numVertices * sizeof(Vector3), m_vertices, GL_STATIC_DRAW);
-    glVertexAttribPointer(VERTEX_BUFFER, 3, GL_FLOAT, GL_FALSE, 0, 0);
-    glEnableVertexAttribArray(VERTEX_BUFFER);
+    VertexFormat format(m_colours != nullptr, m_textureCoords != nullptr, m_normals != nullptr, m_encoding);
 
-    /* Buffer texture data */
-    if (m_textureCoords)
+    if (m_vertexBuffer == 0 || m_usage == STREAM_BUFFER || format != m_format || m_numVertices != m_bufferedVertices)
     {
-      glGenBuffers(1, &m_bufferObject[TEXTURE_BUFFER]);
-      glBindBuffer(GL_ARRAY_BUFFER, m_bufferObject[TEXTURE_BUFFER]);
-      glBufferData(GL_ARRAY_BUFFER, m_numVertices * sizeof(Vector2), m_textureCoords, GL_STATIC_DRAW);
-      glVertexAttribPointer(TEXTURE_BUFFER, 2, GL_FLOAT, GL_FALSE, 0, 0);
-      glEnableVertexAttribArray(TEXTURE_BUFFER);
+      bufferVertices();
+      return;
     }
 
-    /* Buffer colour data */
-    if (m_colours)
+    std::vector<char> &packed = PackBuffer();
+    const size_t stride = m_format.stride();
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+
+    for (size_t i = 0; i < m_dirtyVertices.size(); i++)
     {
-      glGenBuffers(1, &m_bufferObject[COLOUR_BUFFER]);
-      glBindBuffer(GL_ARRAY_BUFFER, m_bufferObject[COLOUR_BUFFER]);
-      glBufferData(GL_ARRAY_BUFFER, m_numVertices * sizeof(Vector4), m_colours, GL_STATIC_DRAW);
-      glVertexAttribPointer(COLOUR_BUFFER, 4, GL_FLOAT, GL_FALSE, 0, 0);
-      glEnableVertexAttribArray(COLOUR_BUFFER);
+      const DirtyRanges::Range &range = m_dirtyVertices[i];
+
+      packed.resize(range.count() * stride);
+      m_format.pack(packed.data(), range.begin, range.count(), m_vertices, m_colours, m_textureCoords, m_normals);
+      glBufferSubData(GL_ARRAY_BUFFER, range.begin * stride, packed.size(), packed.data());
+
+      s_uploadedBytes += packed.size();
+      s_uploads++;
     }
 
-    /* Buffer index data */
-    if (m_indices)
+    m_dirtyVertices.clear();
+  }
+
+  /**
+   * @brief Uploads all vertices, reallocating the vertex buffer and setting
+   *        attribute pointers if the size or layout has changed.
+   */
+  void Mesh::bufferVertices()
+  {
+    VertexFormat format(m_colours != nullptr, m_textureCoords != nullptr, m_normals != nullptr, m_encoding);
+
+    std::vector<char> &packed = PackBuffer();
+    packed.resize(m_numVertices * format.stride());
+    format.pack(packed.data(), 0, m_numVertices, m_vertices, m_colours, m_textureCoords, m_normals);
+
+    const bool newVertexBuffer = (m_vertexBuffer == 0);
+    if (newVertexBuffer)
+      glGenBuffers(1, &m_vertexBuffer);
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+
+    if (newVertexBuffer || format != m_format || m_numVertices != m_bufferedVertices)
+    {
+      glBufferData(GL_ARRAY_BUFFER, packed.size(), packed.data(), UsageHint(m_usage));
+      m_format = format;
+      m_bufferedVertices = m_numVertices;
+
+      // Attribute pointers are held in the VAO so only change with the layout
+      glBindVertexArray(m_arrayObject);
+
+      for (int i = VERTEX_BUFFER; i < INDEX_BUFFER; i++)
+      {
+        const VertexAttribute &attr = m_format.attribute((MeshBuffer)i);
+        if (attr.enabled)
+        {
+          glVertexAttribPointer(i, attr.components, attr.type, attr.normalised, (GLsizei)m_format.stride(),
+                                (const GLvoid *)attr.offset);
+          glEnableVertexAttribArray(i);
+        }
+        else
+        {
+          glDisableVertexAttribArray(i);
+        }
+      }
+
+      glBindVertexArray(0);
+    }
+    else if (m_usage == STREAM_BUFFER)
+    {
+      // Orphan the old storage so the driver need not wait for draws using it
+      glBufferData(GL_ARRAY_BUFFER, packed.size(), packed.data(), UsageHint(m_usage));
+    }
+    else
     {
-      glGenBuffers(1, &m_bufferObject[INDEX_BUFFER]);
-      glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_bufferObject[INDEX_BUFFER]);
-      glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_numIndices * sizeof(GLuint), m_indices, GL_STATIC_DRAW);
+      glBufferSubData(GL_ARRAY_BUFFER, 0, packed.size(), packed.data());
     }
 
-    /* Buffer normals data */
-    if (m_normals)
+    s_uploadedBytes += packed.size();
+    s_uploads++;
+
+    m_dirtyVertices.clear();
+  }
+
+  /**
+   * @brief Uploads all indices (as 16 bit indices if all vertices can be
+   *        addressed), reallocating the index buffer if the size or index
+   *        type has changed.
+   */
+  void Mesh::bufferIndices()
+  {
+    if (!m_indices)
+      return;
+
+    const GLenum indexType = m_numVertices <= 0x10000 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+
+    std::vector<GLushort> shortIndices;
+    const GLvoid *indexData = m_indices;
+    size_t indexDataSize = m_numIndices * sizeof(GLuint);
+
+    if (indexType == GL_UNSIGNED_SHORT)
+    {
+      shortIndices.assign(m_indices, m_indices + m_numIndices);
+      indexData = shortIndices.data();
+      indexDataSize = m_numIndices * sizeof(GLushort);
+    }
+
+    // The element array binding is held in the VAO
+    glBindVertexArray(m_arrayObject);
+
+    const bool newIndexBuffer = (m_indexBuffer == 0);
+    if (newIndexBuffer)
+      glGenBuffers(1, &m_indexBuffer);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBuffer);
+
+    if (newIndexBuffer || indexType != m_indexType || m_numIndices != m_bufferedIndices)
+    {
+      glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexDataSize, indexData, GL_STATIC_DRAW);
+      m_indexType = indexType;
+      m_bufferedIndices = m_numIndices;
+    }
+    else
     {
-      glGenBuffers(1, &m_bufferObject[NORMAL_BUFFER]);
-      glBindBuffer(GL_ARRAY_BUFFER, m_bufferObject[NORMAL_BUFFER]);
-      glBufferData(GL_ARRAY_BUFFER, m_numVertices * sizeof(Vector3), m_normals, GL_STATIC_DRAW);
-      glVertexAttribPointer(NORMAL_BUFFER, 3, GL_FLOAT, GL_FALSE, 0, 0);
-      glEnableVertexAttribArray(NORMAL_BUFFER);
+      glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indexDataSize, indexData);
     }
 
     glBindVertexArray(0);
+
+    s_uploadedBytes += indexDataSize;
+    s_uploads++;
   }
 
   /**
    * @brief Generates normals for each vertex.
    * @return True if normals were generated
    *
-   * Requires that faces are triangles.
+   * Requires that faces are triangles. For indexed meshes the normal of each
+   * vertex is the area weighted average of the faces using it.
    */
   bool Mesh::generateNormals()
   {
@@ -160,6 +470,31 @@ namespace Graphics
     if (!m_normals)
       m_normals = new Vector3[m_numVertices];
 
+    if (m_indices)
+    {
+      for (size_t i = 0; i < m_numVertices; i++)
+        m_normals[i] = Vector3();
+
+      for (size_t i = 0; i + 2 < m_numIndices; i += 3)
+      {
+        const GLuint a = m_indices[i];
+        const GLuint b = m_indices[i + 1];
+        const GLuint c = m_indices[i + 2];
+
+        // Not normalised so that larger faces contribute more
+        Vector3 normal = Vector3::cross(m_vertices[b] - m_vertices[a], m_vertices[c] - m_vertices[a]);
+
+        m_normals[a] += normal;
+        m_normals[b] += normal;
+        m_normals[c] += normal;
+      }
+
+      for (size_t i = 0; i < m_numVertices; i++)
+        VectorOperations::Normalise(m_normals[i]);
+
+      return true;
+    }
+
     for (unsigned int i = 0; i < m_numVertices; i += 3)
     {
       Vector3 &a = m_vertices[i];
@@ -199,7 +534,6 @@ namespace Graphics
 
     // "Origin" vertex
     m->m_vertices[0] = Vector3(0.0f, 0.0f, 0.0f);
-    m->m_boundingBox.resizeByPoint(m->m_vertices[0]);
     m->m_colours[0] = Colour(1.0f, 1.0f, 1.0f, 1.0f);
     m->m_textureCoords[0] = Vector2(0.5f, 0.5f);
 
@@ -208,11 +542,11 @@ namespace Graphics
       const float a = i * deltaA;
 
       m->m_vertices[i] = Vector3(cos(a) * radius, sin(a) * radius, 0.0f);
-      m->m_boundingBox.resizeByPoint(m->m_vertices[i]);
       m->m_colours[i] = Colour(1.0f, 1.0f, 1.0f, 1.0f);
       m->m_textureCoords[i] = Vector2(abs(cos(a)), abs(sin(a)));
     }
 
+    m->m_boundingBox = TransformBatch::Bounds(m->m_numVertices, m->m_vertices);
     m->bufferData();
     return m;
   }
@@ -243,18 +577,17 @@ namespace Graphics
       const float a = i * deltaA;
 
       m->m_vertices[n] = Vector3(cos(a) * radiusOuter, sin(a) * radiusOuter, 0.0f);
-      m->m_boundingBox.resizeByPoint(m->m_vertices[n]);
       m->m_colours[n] = c;
       m->m_textureCoords[n] = Vector2(abs(cos(a)), abs(sin(a)));
       n++;
 
       m->m_vertices[n] = Vector3(cos(a) * radiusInner, sin(a) * radiusInner, 0.0f);
-      m->m_boundingBox.resizeByPoint(m->m_vertices[n]);
       m->m_colours[n] = c;
       m->m_textureCoords[n] = Vector2(abs(cos(a)), abs(sin(a)));
       n++;
     }
 
+    m->m_boundingBox = TransformBatch::Bounds(m->m_numVertices, m->m_vertices);
     m->bufferData();
     return m;
   }
@@ -267,82 +600,46 @@ namespace Graphics
    */
   Mesh *Mesh::LoadMesh(const struct aiMesh *mesh, const struct aiMaterial *material)
   {
-    Mesh *m = new Mesh();
-
-    // Check if this should be rendered as a wireframe
-    int wireFrame = 0;
-    bool lines = AI_SUCCESS == aiGetMaterialInteger(material, AI_MATKEY_ENABLE_WIREFRAME, &wireFrame) && wireFrame;
-    m->m_type = lines ? GL_LINES : GL_TRIANGLES;
-
-    aiVector3D *vertices = mesh->mVertices;
-
-    const bool hasColours = mesh->mColors[0] != nullptr;
-    const bool hasTexCoords = mesh->HasTextureCoords(0);
-    const bool hasNormals = mesh->HasNormals();
-
-    // Allocate storage
-    m->m_numVertices = mesh->mNumFaces * 3;
-    m->m_vertices = new Vector3[m->m_numVertices];
-    m->m_colours = new Colour[m->m_numVertices];
-    if (hasTexCoords)
-      m->m_textureCoords = new Vector2[m->m_numVertices];
-    if (hasNormals)
-      m->m_normals = new Vector3[m->m_numVertices];
-
-    // Get lighting data
-    aiColor4D c;
-
-    if (AI_SUCCESS == aiGetMaterialColor(material, AI_MATKEY_COLOR_AMBIENT, &c))
-      m->m_ambientColour = Colour(c);
-
-    if (AI_SUCCESS == aiGetMaterialColor(material, AI_MATKEY_COLOR_DIFFUSE, &c))
-      m->m_diffuseColour = Colour(c);
-
-    if (AI_SUCCESS == aiGetMaterialColor(material, AI_MATKEY_COLOR_SPECULAR, &c))
-      m->m_specularColour = Colour(c);
-
-    aiGetMaterialFloat(material, AI_MATKEY_SHININESS, &(m->m_shininess));
-    aiGetMaterialFloat(material, AI_MATKEY_SHININESS_STRENGTH, &(m->m_shininessStrength));
-
-    // Load vertices
-    size_t idx = 0;
-    for (size_t i = 0; i < mesh->mNumFaces; i++)
-    {
-      const aiFace &face = mesh->mFaces[i];
-
-      for (size_t j = 0; j < 3; j++)
-      {
-        int index = face.mIndices[j];
-
-        const aiVector3D &v = vertices[index];
+    MeshStreams streams;
+    MeshCache::ConvertMesh(mesh, material, streams);
+    return LoadMeshData(streams.view());
+  }
 
-        if (hasColours)
-          m->m_colours[idx] = Colour(mesh->mColors[0][index]);
-        else
-          m->m_colours[idx] = Colour(1.0f, 1.0f, 1.0f, 1.0f);
+  /**
+   * @brief Loads a mesh from vertex streams held elsewhere in memory.
+   * @param data Mesh data
+   * @return Mesh containing a copy of the data
+   *
+   * Each stream (and the index list) is copied in a single block,
+   * generating normals if none are given. The vertex buffer uses the compact
+   * vertex encodings.
+   */
+  Mesh *Mesh::LoadMeshData(const MeshData &data)
+  {
+    Mesh *m = new Mesh();
+    m->m_type = data.type;
+    m->m_numVertices = data.numVertices;
 
-        if (hasTexCoords)
-        {
-          const aiVector3D &tex = mesh->mTextureCoords[0][index];
-          m->m_textureCoords[idx] = Vector2(tex[0], tex[1]);
-        }
+    m->m_vertices = CopyStream(data.vertices, data.numVertices);
+    m->m_colours = CopyStream(data.colours, data.numVertices);
+    m->m_textureCoords = CopyStream(data.textureCoords, data.numVertices);
+    m->m_normals = CopyStream(data.normals, data.numVertices);
 
-        if (hasNormals)
-        {
-          const aiVector3D &norm = mesh->mNormals[index];
-          m->m_normals[idx] = Vector3(norm.x, norm.y, norm.z);
-        }
+    m->m_numIndices = data.numIndices;
+    m->m_indices = CopyStream(data.indices, data.numIndices);
 
-        Vector3 vtx(v[0], v[1], v[2]);
-        m->m_boundingBox.resizeByPoint(vtx);
-        m->m_vertices[idx++] = vtx;
-      }
-    }
+    m->m_ambientColour = data.ambientColour;
+    m->m_diffuseColour = data.diffuseColour;
+    m->m_specularColour = data.specularColour;
+    m->m_shininess = data.shininess;
+    m->m_shininessStrength = data.shininessStrength;
 
     // Calculate normals if the model does not have any
-    if (!hasNormals)
+    if (data.normals == nullptr)
       m->generateNormals();
 
+    m->m_boundingBox = data.boundingBox;
+    m->m_encoding = VertexFormat::ENCODE_COMPACT;
     m->bufferData();
 
     return m;
@@ -8,6 +8,7 @@
 #ifndef _ENGINE_GRAPHICS_MESH_H_
 #define _ENGINE_GRAPHICS_MESH_H_
 
+#include <cstdint>
 #include <fstream>
 #include <string>
 #include <vector>
@@ -17,6 +18,7 @@
 #include <assimp/scene.h>
 
 #include <Engine_ResourceManagment/IMemoryManaged.h>
+#include <Engine_ResourceManagment/ObjectPool.h>
 
 #include <Engine_Maths/BoundingBox.h>
 #include <Engine_Maths/Vector2.h>
@@ -24,6 +26,10 @@
 #include <Engine_Maths/Vector4.h>
 
 #include "Colour.h"
+#include "DirtyRanges.h"
+#include "InstanceBuffer.h"
+#include "ShaderProgram.h"
+#include "VertexFormat.h"
 
 using std::ifstream;
 using std::string;
@@ -33,18 +39,26 @@ namespace Engine
 namespace Graphics
 {
   /**
-   * @enum MeshBuffer
-   * @brief Describes the type of data held in a buffer.
+   * @struct MeshData
+   * @brief Describes the vertex streams and material of a mesh held
+   *        elsewhere in memory (e.g. in a MeshCache).
    */
-  enum MeshBuffer
+  struct MeshData
   {
-    VERTEX_BUFFER = 0,
-    COLOUR_BUFFER = 1,
-    TEXTURE_BUFFER,
-    NORMAL_BUFFER,
-    TANGENT_BUFFER,
-    INDEX_BUFFER,
-    MAX_BUFFER
+    GLuint type;                                 //!< Type of primitives used in mesh
+    size_t numVertices;                          //!< Number of vertices
+    const Engine::Maths::Vector3 *vertices;      //!< Vertex positions
+    const Colour *colours;                       //!< Vertex colours (may be nullptr)
+    const Engine::Maths::Vector2 *textureCoords; //!< Vertex texture coordinates (may be nullptr)
+    const Engine::Maths::Vector3 *normals;       //!< Vertex normals (may be nullptr)
+    size_t numIndices;                           //!< Number of indices
+    const GLuint *indices;                       //!< Vertex indices (may be nullptr)
+    Engine::Maths::BoundingBox3 boundingBox;     //!< Bounding box of all vertices
+    Colour ambientColour;                        //!< Colour of scattered ambient light
+    Colour diffuseColour;                        //!< Colour of diffuse scattered light
+    Colour specularColour;                       //!< Colour of specular reflected light
+    float shininess;                             //!< Shininess of the material (specular exponent)
+    float shininessStrength;                     //!< Coefficient of specular lighting contribution
   };
 
   /**
@@ -54,19 +68,71 @@ namespace Graphics
    * @author Rich Davison, Dan Nixon
    *
    * Modified from the nclgl library.
+   *
+   * Vertex data modified after it is first buffered should be marked with
+   * markDirty(); the modified ranges are uploaded by flush() (called
+   * automatically before the mesh is drawn).
    */
   class Mesh : public Engine::ResourceManagment::IMemoryManaged
   {
   public:
+    /**
+     * @enum BufferUsage
+     * @brief How often the vertex data of a mesh is expected to change.
+     */
+    enum BufferUsage
+    {
+      STATIC_BUFFER,  //!< Rarely modified, modified ranges are updated in place
+      DYNAMIC_BUFFER, //!< Modified often, modified ranges are updated in place
+      STREAM_BUFFER   //!< Modified most frames, buffer is orphaned and refilled on each update
+    };
+
+    /**
+     * @brief Gets the total number of bytes uploaded to vertex and index
+     *        buffers by all meshes.
+     * @return Uploaded bytes
+     * @see Engine::Common::Profiler::addCounter
+     */
+    static uint64_t UploadedBytes()
+    {
+      return s_uploadedBytes;
+    }
+
+    /**
+     * @brief Gets the total number of buffer uploads made by all meshes.
+     * @return Number of glBufferData/glBufferSubData calls with data
+     * @see Engine::Common::Profiler::addCounter
+     */
+    static uint64_t Uploads()
+    {
+      return s_uploads;
+    }
+
+    /**
+     * @brief Gets the total number of draw calls made by all meshes.
+     * @return Number of draw calls (an instanced draw counts as one)
+     * @see Engine::Common::Profiler::addCounter
+     */
+    static uint64_t DrawCalls()
+    {
+      return s_drawCalls;
+    }
+
     static Mesh *GenerateDisc2D(float radius, int resolution = 64);
     static Mesh *GenerateRing2D(float radiusOuter, float radiusInner, int resolution = 64);
 
     static Mesh *LoadMesh(const struct aiMesh *mesh, const struct aiMaterial *material = nullptr);
+    static Mesh *LoadMeshData(const MeshData &data);
+
+    static Engine::ResourceManagment::ObjectPool &Pool();
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr, size_t size);
 
     Mesh();
     virtual ~Mesh();
 
-    virtual void draw(GLuint program);
+    virtual void draw(ShaderProgram *program);
+    void drawInstanced(ShaderProgram *program, InstanceBuffer &instances);
 
     // CSC3224 NCODE Dan Nixon 120263697
 
@@ -99,20 +165,71 @@ namespace Graphics
       return m_vertices;
     }
 
+    /**
+     * @brief Gets the layout of the vertex buffer.
+     * @return Vertex format (as of the last call to bufferData())
+     */
+    const VertexFormat &vertexFormat() const
+    {
+      return m_format;
+    }
+
+    /**
+     * @brief Sets the compact encodings used when vertex data is next
+     *        buffered.
+     * @param encoding Combination of VertexFormat::Encoding flags
+     */
+    void setVertexEncoding(unsigned int encoding)
+    {
+      m_encoding = encoding;
+    }
+
+    /**
+     * @brief Gets the expected frequency of changes to the vertex data.
+     * @return Buffer usage
+     */
+    BufferUsage bufferUsage() const
+    {
+      return m_usage;
+    }
+
+    void setBufferUsage(BufferUsage usage);
+
+    void markDirty(size_t first, size_t count);
+    void markDirty();
+
+    /**
+     * @brief Checks if there is vertex data that has not been uploaded.
+     * @return True if flush() would upload data
+     */
+    bool dirty() const
+    {
+      return !m_dirtyVertices.empty();
+    }
+
     // CSC3224 NCODE BLOCK ENDS
 
     void bufferData();
+    void flush();
 
   protected:
     bool generateNormals();
 
-    GLuint m_type;                     //!< Type of primitives used in mesh
-    GLuint m_arrayObject;              //!< OGL array object for this mesh
-    GLuint m_bufferObject[MAX_BUFFER]; //!< OGL buffer objects for each buffer
-                                       //!  used in this mesh
+    GLuint m_type;         //!< Type of primitives used in mesh
+    GLuint m_arrayObject;  //!< OGL array object for this mesh
+    GLuint m_vertexBuffer; //!< OGL buffer object holding interleaved vertices
+    GLuint m_indexBuffer;  //!< OGL buffer object holding indices
 
     size_t m_numVertices; //!< Number of vertices for the mesh
     size_t m_numIndices;  //!< Number of indices for the mesh
+    GLenum m_indexType;   //!< Type of indices in the index buffer
+
+    VertexFormat m_format;       //!< Layout of the vertex buffer
+    unsigned int m_encoding;     //!< Compact encodings to use for the vertex buffer
+    size_t m_bufferedVertices;   //!< Number of vertices the vertex buffer was allocated for
+    size_t m_bufferedIndices;    //!< Number of indices the index buffer was allocated for
+    BufferUsage m_usage;         //!< Expected frequency of changes to vertex data
+    DirtyRanges m_dirtyVertices; //!< Ranges of vertices modified since last upload
 
     Engine::Maths::Vector3 *m_vertices;      //!< Pointer to vertex position data
     Colour *m_colours;                       //!< Pointer to vertex colour data
@@ -133,6 +250,15 @@ namespace Graphics
     float m_shininessStrength; //!< Coefficient of specular lighting contribution
 
     // CSC3224 NCODE BLOCK ENDS
+
+  private:
+    void useMaterial(ShaderProgram *program);
+    void bufferVertices();
+    void bufferIndices();
+
+    static uint64_t s_uploadedBytes; //!< Total number of bytes uploaded by all meshes
+    static uint64_t s_uploads;       //!< Total number of uploads made by all meshes
+    static uint64_t s_drawCalls;     //!< Total number of draw calls made by all meshes
   };
 }
 }
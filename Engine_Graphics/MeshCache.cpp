@@ -0,0 +1,705 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include "MeshCache.h"
+
+#include <cstring>
+#include <fstream>
+
+#include <Engine_IO/DiskUtils.h>
+#include <Engine_Maths/TransformBatch.h>
+#include <Engine_Maths/VertexCacheOptimiser.h>
+
+using namespace Engine::IO;
+using namespace Engine::Maths;
+
+static_assert(sizeof(Vector2) == 2 * sizeof(float), "Vector2 must be tightly packed to be cached");
+static_assert(sizeof(Vector3) == 3 * sizeof(float), "Vector3 must be tightly packed to be cached");
+static_assert(sizeof(GLuint) == sizeof(uint32_t), "GLuint must be 32 bit to be cached");
+static_assert(sizeof(Engine::Graphics::Colour) == 4 * sizeof(float), "Colour must be tightly packed to be cached");
+
+namespace
+{
+/**
+ * @brief Rounds an offset up to a multiple of an alignment.
+ * @param offset Offset
+ * @param alignment Alignment (power of two)
+ * @return Aligned offset
+ */
+uint64_t Align(uint64_t offset, uint64_t alignment)
+{
+  return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+/**
+ * @brief Computes the 64 bit FNV-1a hash of a block of memory.
+ * @param data Pointer to data
+ * @param size Size of data (bytes)
+ * @return Hash
+ */
+uint64_t HashFNV1a(const char *data, size_t size)
+{
+  uint64_t hash = 14695981039346656037ULL;
+
+  for (size_t i = 0; i < size; i++)
+  {
+    hash ^= (uint8_t)data[i];
+    hash *= 1099511628211ULL;
+  }
+
+  return hash;
+}
+
+/**
+ * @brief Adds a string to a string table.
+ * @param strings String table
+ * @param str String to add
+ * @return Offset of the string
+ */
+uint32_t AddString(std::vector<char> &strings, const std::string &str)
+{
+  uint32_t offset = (uint32_t)strings.size();
+  strings.insert(strings.end(), str.begin(), str.end());
+  strings.push_back('\0');
+  return offset;
+}
+
+/**
+ * @brief Appends a vertex stream to the data section.
+ * @param data Data section
+ * @param stream Stream to append
+ * @return Offset of the stream
+ */
+template <typename T> uint64_t AddStream(std::vector<char> &data, const std::vector<T> &stream)
+{
+  if (stream.empty())
+    return Engine::Graphics::MeshCache::NO_DATA;
+
+  uint64_t offset = Align(data.size(), 16);
+  data.resize(offset + stream.size() * sizeof(T));
+  memcpy(data.data() + offset, stream.data(), stream.size() * sizeof(T));
+
+  return offset;
+}
+
+/**
+ * @brief Reads the primitive type and lighting properties of a material.
+ * @param material Assimp material (may be nullptr)
+ * @param out Mesh data to populate
+ */
+void ReadMaterial(const struct aiMaterial *material, Engine::Graphics::MeshData &out)
+{
+  out.type = GL_TRIANGLES;
+  out.ambientColour = Engine::Graphics::Colour();
+  out.diffuseColour = Engine::Graphics::Colour();
+  out.specularColour = Engine::Graphics::Colour();
+  out.shininess = 0.0f;
+  out.shininessStrength = 1.0f;
+
+  if (material == nullptr)
+    return;
+
+  // Check if this should be rendered as a wireframe
+  int wireFrame = 0;
+  bool lines = AI_SUCCESS == aiGetMaterialInteger(material, AI_MATKEY_ENABLE_WIREFRAME, &wireFrame) && wireFrame;
+  out.type = lines ? GL_LINES : GL_TRIANGLES;
+
+  // Get lighting data
+  aiColor4D c;
+
+  if (AI_SUCCESS == aiGetMaterialColor(material, AI_MATKEY_COLOR_AMBIENT, &c))
+    out.ambientColour = Engine::Graphics::Colour(c);
+
+  if (AI_SUCCESS == aiGetMaterialColor(material, AI_MATKEY_COLOR_DIFFUSE, &c))
+    out.diffuseColour = Engine::Graphics::Colour(c);
+
+  if (AI_SUCCESS == aiGetMaterialColor(material, AI_MATKEY_COLOR_SPECULAR, &c))
+    out.specularColour = Engine::Graphics::Colour(c);
+
+  aiGetMaterialFloat(material, AI_MATKEY_SHININESS, &(out.shininess));
+  aiGetMaterialFloat(material, AI_MATKEY_SHININESS_STRENGTH, &(out.shininessStrength));
+}
+
+/**
+ * @brief Adds a node and its children to the node table in pre-order.
+ * @param node Assimp node
+ * @param parent Index of the parent node
+ * @param nodes Node table
+ * @param nodeMeshes Node mesh list
+ * @param strings String table
+ */
+void AddNodes(const struct aiNode *node, uint32_t parent, std::vector<Engine::Graphics::MeshCache::NodeRecord> &nodes,
+              std::vector<uint32_t> &nodeMeshes, std::vector<char> &strings)
+{
+  Engine::Graphics::MeshCache::NodeRecord record;
+  record.name = AddString(strings, node->mName.C_Str());
+  record.parent = parent;
+  record.firstMesh = (uint32_t)nodeMeshes.size();
+  record.numMeshes = node->mNumMeshes;
+
+  nodeMeshes.insert(nodeMeshes.end(), node->mMeshes, node->mMeshes + node->mNumMeshes);
+
+  uint32_t idx = (uint32_t)nodes.size();
+  nodes.push_back(record);
+
+  for (size_t i = 0; i < node->mNumChildren; i++)
+    AddNodes(node->mChildren[i], idx, nodes, nodeMeshes, strings);
+}
+
+/**
+ * @brief Copies the channels of a colour to an array.
+ * @param out Array of four floats
+ * @param c Colour
+ */
+void CopyColour(float *out, const Engine::Graphics::Colour &c)
+{
+  for (size_t i = 0; i < 4; i++)
+    out[i] = c[i];
+}
+}
+
+namespace Engine
+{
+namespace Graphics
+{
+  /**
+   * @brief Gets a view of the streams.
+   * @return Mesh data referring to the streams
+   */
+  MeshData MeshStreams::view() const
+  {
+    MeshData data = mesh;
+    data.numVertices = vertices.size();
+    data.vertices = vertices.empty() ? nullptr : vertices.data();
+    data.colours = colours.empty() ? nullptr : colours.data();
+    data.textureCoords = textureCoords.empty() ? nullptr : textureCoords.data();
+    data.normals = normals.empty() ? nullptr : normals.data();
+    data.numIndices = indices.size();
+    data.indices = indices.empty() ? nullptr : indices.data();
+    return data;
+  }
+
+  /**
+   * @var MeshCache::MAGIC
+   * @brief Value at the start of every cache file ("MSHC").
+   */
+  const uint32_t MeshCache::MAGIC = 0x4348534D;
+
+  /**
+   * @var MeshCache::NO_DATA
+   * @brief Offset of a vertex stream that is not present.
+   */
+  const uint64_t MeshCache::NO_DATA = 0xFFFFFFFFFFFFFFFFULL;
+
+  /**
+   * @brief Reads the key identifying the current version of a model file.
+   * @param filename Model file
+   * @param key Key to populate
+   * @return True if the file could be read
+   */
+  bool MeshCache::ReadSourceKey(const std::string &filename, SourceKey &key)
+  {
+    MappedFile file;
+    if (!file.open(filename))
+      return false;
+
+    key.hash = HashFNV1a(file.data(), file.size());
+    key.modifiedTime = DiskUtils::ModifiedTime(filename);
+    key.size = file.size();
+
+    return true;
+  }
+
+  /**
+   * @brief Converts an Assimp mesh into vertex streams and a triangle list
+   *        optimised for the vertex cache.
+   * @param mesh Assimp mesh to convert
+   * @param material Material used on mesh
+   * @param out Streams to populate
+   *
+   * Faces that are not triangles are ignored. Normals are not generated if
+   * the mesh does not have any.
+   */
+  void MeshCache::ConvertMesh(const struct aiMesh *mesh, const struct aiMaterial *material, MeshStreams &out)
+  {
+    ReadMaterial(material, out.mesh);
+
+    const bool hasColours = mesh->mColors[0] != nullptr;
+    const bool hasTexCoords = mesh->HasTextureCoords(0);
+    const bool hasNormals = mesh->HasNormals();
+
+    // Load vertices (already deduplicated by Assimp)
+    const size_t numVertices = mesh->mNumVertices;
+    out.vertices.resize(numVertices);
+    out.colours.resize(numVertices);
+    out.textureCoords.resize(hasTexCoords ? numVertices : 0);
+    out.normals.resize(hasNormals ? numVertices : 0);
+
+    for (size_t i = 0; i < numVertices; i++)
+    {
+      const aiVector3D &v = mesh->mVertices[i];
+      out.vertices[i] = Vector3(v[0], v[1], v[2]);
+
+      if (hasColours)
+        out.colours[i] = Colour(mesh->mColors[0][i]);
+      else
+        out.colours[i] = Colour(1.0f, 1.0f, 1.0f, 1.0f);
+
+      if (hasTexCoords)
+      {
+        const aiVector3D &tex = mesh->mTextureCoords[0][i];
+        out.textureCoords[i] = Vector2(tex[0], tex[1]);
+      }
+
+      if (hasNormals)
+      {
+        const aiVector3D &norm = mesh->mNormals[i];
+        out.normals[i] = Vector3(norm.x, norm.y, norm.z);
+      }
+    }
+
+    // Load indices
+    out.indices.clear();
+    out.indices.reserve(mesh->mNumFaces * 3);
+
+    for (size_t i = 0; i < mesh->mNumFaces; i++)
+    {
+      const aiFace &face = mesh->mFaces[i];
+      if (face.mNumIndices == 3)
+        out.indices.insert(out.indices.end(), face.mIndices, face.mIndices + 3);
+    }
+
+    // Reorder triangles for the post-transform cache, then vertices for fetch
+    VertexCacheOptimiser::OptimiseTriangles(out.indices, numVertices);
+
+    std::vector<uint32_t> remap;
+    const size_t numUsed = VertexCacheOptimiser::OptimiseFetch(out.indices, numVertices, remap);
+
+    VertexCacheOptimiser::RemapStream(out.vertices, remap, numUsed);
+    VertexCacheOptimiser::RemapStream(out.colours, remap, numUsed);
+    VertexCacheOptimiser::RemapStream(out.textureCoords, remap, numUsed);
+    VertexCacheOptimiser::RemapStream(out.normals, remap, numUsed);
+
+    out.mesh.boundingBox = TransformBatch::Bounds(out.vertices.size(), out.vertices.data());
+  }
+
+  MeshCache::MeshCache()
+      : m_data(nullptr)
+      , m_size(0)
+  {
+  }
+
+  MeshCache::~MeshCache()
+  {
+  }
+
+  /**
+   * @brief Creates a cache in memory from an imported model.
+   * @param scene Assimp scene
+   * @param source Key of the model file
+   *
+   * Does not create any GL or managed objects so may be called from any
+   * thread.
+   */
+  void MeshCache::create(const struct aiScene *scene, const SourceKey &source)
+  {
+    clear();
+
+    std::vector<char> strings;
+    std::vector<char> data;
+
+    // Materials
+    std::vector<MaterialRecord> materials(scene->mNumMaterials);
+    for (size_t i = 0; i < scene->mNumMaterials; i++)
+    {
+      const aiMaterial *material = scene->mMaterials[i];
+      MaterialRecord &record = materials[i];
+
+      MeshData properties;
+      ReadMaterial(material, properties);
+
+      CopyColour(record.ambient, properties.ambientColour);
+      CopyColour(record.diffuse, properties.diffuseColour);
+      CopyColour(record.specular, properties.specularColour);
+      record.shininess = properties.shininess;
+      record.shininessStrength = properties.shininessStrength;
+      record.lines = (properties.type == GL_LINES) ? 1 : 0;
+      record.texture = NONE;
+
+      aiString path;
+      if (material->GetTextureCount(aiTextureType_DIFFUSE) > 0 &&
+          material->GetTexture(aiTextureType_DIFFUSE, 0, &path, nullptr, nullptr, nullptr, nullptr, nullptr) ==
+              AI_SUCCESS)
+        record.texture = AddString(strings, path.data);
+    }
+
+    // Meshes
+    std::vector<MeshRecord> meshes(scene->mNumMeshes);
+    for (size_t i = 0; i < scene->mNumMeshes; i++)
+    {
+      const aiMesh *mesh = scene->mMeshes[i];
+      MeshRecord &record = meshes[i];
+
+      record.material = mesh->mMaterialIndex;
+      record.numVertices = 0;
+      record.numIndices = 0;
+      record.reserved = 0;
+      record.indices = NO_DATA;
+      record.vertices = NO_DATA;
+      record.colours = NO_DATA;
+      record.textureCoords = NO_DATA;
+      record.normals = NO_DATA;
+
+      for (size_t j = 0; j < 3; j++)
+      {
+        record.lower[j] = 0.0f;
+        record.upper[j] = 0.0f;
+      }
+
+      if (mesh->mNumVertices == 0)
+        continue;
+
+      MeshStreams streams;
+      ConvertMesh(mesh, scene->mMaterials[mesh->mMaterialIndex], streams);
+
+      record.numVertices = (uint32_t)streams.vertices.size();
+      record.numIndices = (uint32_t)streams.indices.size();
+      record.indices = AddStream(data, streams.indices);
+      record.vertices = AddStream(data, streams.vertices);
+      record.colours = AddStream(data, streams.colours);
+      record.textureCoords = AddStream(data, streams.textureCoords);
+      record.normals = AddStream(data, streams.normals);
+
+      for (size_t j = 0; j < 3; j++)
+      {
+        record.lower[j] = streams.mesh.boundingBox.lowerLeft()[j];
+        record.upper[j] = streams.mesh.boundingBox.upperRight()[j];
+      }
+    }
+
+    // Nodes
+    std::vector<NodeRecord> nodes;
+    std::vector<uint32_t> nodeMeshes;
+    AddNodes(scene->mRootNode, NONE, nodes, nodeMeshes, strings);
+
+    // Layout
+    Header h;
+    memset(&h, 0, sizeof(Header));
+    h.magic = MAGIC;
+    h.version = VERSION;
+    h.source = source;
+    h.numMaterials = (uint32_t)materials.size();
+    h.numMeshes = (uint32_t)meshes.size();
+    h.numNodes = (uint32_t)nodes.size();
+    h.numNodeMeshes = (uint32_t)nodeMeshes.size();
+    h.materialsOffset = Align(sizeof(Header), 8);
+    h.meshesOffset = Align(h.materialsOffset + materials.size() * sizeof(MaterialRecord), 8);
+    h.nodesOffset = Align(h.meshesOffset + meshes.size() * sizeof(MeshRecord), 8);
+    h.nodeMeshesOffset = Align(h.nodesOffset + nodes.size() * sizeof(NodeRecord), 8);
+    h.stringsOffset = Align(h.nodeMeshesOffset + nodeMeshes.size() * sizeof(uint32_t), 8);
+    h.stringsSize = strings.size();
+    h.dataOffset = Align(h.stringsOffset + strings.size(), 16);
+    h.dataSize = data.size();
+
+    m_size = (size_t)(h.dataOffset + h.dataSize);
+    m_buffer.assign((m_size + sizeof(uint64_t) - 1) / sizeof(uint64_t), 0);
+
+    char *out = reinterpret_cast<char *>(m_buffer.data());
+    auto write = [out](uint64_t offset, const void *ptr, size_t size) {
+      if (size > 0)
+        memcpy(out + offset, ptr, size);
+    };
+
+    write(0, &h, sizeof(Header));
+    write(h.materialsOffset, materials.data(), materials.size() * sizeof(MaterialRecord));
+    write(h.meshesOffset, meshes.data(), meshes.size() * sizeof(MeshRecord));
+    write(h.nodesOffset, nodes.data(), nodes.size() * sizeof(NodeRecord));
+    write(h.nodeMeshesOffset, nodeMeshes.data(), nodeMeshes.size() * sizeof(uint32_t));
+    write(h.stringsOffset, strings.data(), strings.size());
+    write(h.dataOffset, data.data(), data.size());
+
+    m_data = out;
+  }
+
+  /**
+   * @brief Opens and memory maps a cache file.
+   * @param filename Cache file
+   * @param source Key of the model file the cache must have been created from
+   * @return True if the cache is valid and up to date
+   */
+  bool MeshCache::open(const std::string &filename, const SourceKey &source)
+  {
+    clear();
+
+    if (!m_file.open(filename))
+      return false;
+
+    m_data = m_file.data();
+    m_size = m_file.size();
+
+    if (!validate(source))
+    {
+      clear();
+      return false;
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief Writes the cache to a file.
+   * @param filename File to write to
+   * @return True if the file was written
+   */
+  bool MeshCache::save(const std::string &filename) const
+  {
+    if (!valid())
+      return false;
+
+    std::ofstream file(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+      return false;
+
+    file.write(m_data, m_size);
+    return file.good();
+  }
+
+  /**
+   * @brief Discards the cache (unmapping it if opened from a file).
+   */
+  void MeshCache::clear()
+  {
+    m_file.close();
+    m_buffer.clear();
+    m_data = nullptr;
+    m_size = 0;
+  }
+
+  /**
+   * @brief Gets the number of materials.
+   * @return Number of materials
+   */
+  size_t MeshCache::numMaterials() const
+  {
+    return valid() ? header().numMaterials : 0;
+  }
+
+  /**
+   * @brief Gets a material.
+   * @param idx Index of material
+   * @return Material
+   */
+  const MeshCache::MaterialRecord &MeshCache::material(size_t idx) const
+  {
+    return table<MaterialRecord>(header().materialsOffset)[idx];
+  }
+
+  /**
+   * @brief Gets the number of meshes.
+   * @return Number of meshes
+   */
+  size_t MeshCache::numMeshes() const
+  {
+    return valid() ? header().numMeshes : 0;
+  }
+
+  /**
+   * @brief Gets a mesh.
+   * @param idx Index of mesh
+   * @return Mesh
+   */
+  const MeshCache::MeshRecord &MeshCache::mesh(size_t idx) const
+  {
+    return table<MeshRecord>(header().meshesOffset)[idx];
+  }
+
+  /**
+   * @brief Gets a view of the vertex streams and material of a mesh.
+   * @param idx Index of mesh
+   * @return Mesh data (referring to memory owned by the cache)
+   */
+  MeshData MeshCache::meshData(size_t idx) const
+  {
+    const MeshRecord &record = mesh(idx);
+    const MaterialRecord &mat = material(record.material);
+    const char *data = m_data + header().dataOffset;
+
+    MeshData out;
+    out.type = mat.lines ? GL_LINES : GL_TRIANGLES;
+    out.numVertices = record.numVertices;
+    out.vertices = (record.vertices == NO_DATA) ? nullptr : reinterpret_cast<const Vector3 *>(data + record.vertices);
+    out.colours = (record.colours == NO_DATA) ? nullptr : reinterpret_cast<const Colour *>(data + record.colours);
+    out.textureCoords = (record.textureCoords == NO_DATA)
+                            ? nullptr
+                            : reinterpret_cast<const Vector2 *>(data + record.textureCoords);
+    out.normals = (record.normals == NO_DATA) ? nullptr : reinterpret_cast<const Vector3 *>(data + record.normals);
+    out.numIndices = record.numIndices;
+    out.indices = (record.indices == NO_DATA) ? nullptr : reinterpret_cast<const GLuint *>(data + record.indices);
+    out.boundingBox = BoundingBox3(Vector3(record.lower[0], record.lower[1], record.lower[2]),
+                                   Vector3(record.upper[0], record.upper[1], record.upper[2]));
+    out.ambientColour = Colour(mat.ambient[0], mat.ambient[1], mat.ambient[2], mat.ambient[3]);
+    out.diffuseColour = Colour(mat.diffuse[0], mat.diffuse[1], mat.diffuse[2], mat.diffuse[3]);
+    out.specularColour = Colour(mat.specular[0], mat.specular[1], mat.specular[2], mat.specular[3]);
+    out.shininess = mat.shininess;
+    out.shininessStrength = mat.shininessStrength;
+
+    return out;
+  }
+
+  /**
+   * @brief Gets the number of nodes.
+   * @return Number of nodes
+   */
+  size_t MeshCache::numNodes() const
+  {
+    return valid() ? header().numNodes : 0;
+  }
+
+  /**
+   * @brief Gets a node (nodes are stored in pre-order, the root is node 0).
+   * @param idx Index of node
+   * @return Node
+   */
+  const MeshCache::NodeRecord &MeshCache::node(size_t idx) const
+  {
+    return table<NodeRecord>(header().nodesOffset)[idx];
+  }
+
+  /**
+   * @brief Gets an entry in the node mesh list.
+   * @param idx Index in list
+   * @return Index of mesh
+   */
+  uint32_t MeshCache::nodeMesh(size_t idx) const
+  {
+    return table<uint32_t>(header().nodeMeshesOffset)[idx];
+  }
+
+  /**
+   * @brief Gets a string from the string table.
+   * @param offset Offset of string
+   * @return String, nullptr if offset is NONE
+   */
+  const char *MeshCache::string(uint32_t offset) const
+  {
+    if (offset == NONE)
+      return nullptr;
+
+    return table<char>(header().stringsOffset) + offset;
+  }
+
+  /**
+   * @brief Checks that an opened cache matches a source key and that all
+   *        offsets and indices it contains are in range.
+   * @param source Key of the model file
+   * @return True if the cache may be used
+   */
+  bool MeshCache::validate(const SourceKey &source) const
+  {
+    if (m_size < sizeof(Header))
+      return false;
+
+    const Header &h = header();
+
+    if (h.magic != MAGIC || h.version != VERSION)
+      return false;
+
+    if (h.source.hash != source.hash || h.source.modifiedTime != source.modifiedTime || h.source.size != source.size)
+      return false;
+
+    auto inRange = [](uint64_t offset, uint64_t size, uint64_t limit) {
+      return offset <= limit && size <= limit - offset;
+    };
+
+    if (h.materialsOffset % 8 != 0 || h.meshesOffset % 8 != 0 || h.nodesOffset % 8 != 0 ||
+        h.nodeMeshesOffset % 8 != 0 || h.dataOffset % 8 != 0)
+      return false;
+
+    if (!inRange(h.materialsOffset, (uint64_t)h.numMaterials * sizeof(MaterialRecord), m_size) ||
+        !inRange(h.meshesOffset, (uint64_t)h.numMeshes * sizeof(MeshRecord), m_size) ||
+        !inRange(h.nodesOffset, (uint64_t)h.numNodes * sizeof(NodeRecord), m_size) ||
+        !inRange(h.nodeMeshesOffset, (uint64_t)h.numNodeMeshes * sizeof(uint32_t), m_size) ||
+        !inRange(h.stringsOffset, h.stringsSize, m_size) || !inRange(h.dataOffset, h.dataSize, m_size))
+      return false;
+
+    // Strings must be terminated
+    if (h.stringsSize == 0 || m_data[h.stringsOffset + h.stringsSize - 1] != '\0')
+      return false;
+
+    for (size_t i = 0; i < h.numMaterials; i++)
+    {
+      const MaterialRecord &mat = material(i);
+      if (mat.texture != NONE && mat.texture >= h.stringsSize)
+        return false;
+    }
+
+    for (size_t i = 0; i < h.numMeshes; i++)
+    {
+      const MeshRecord &record = mesh(i);
+
+      if (record.material >= h.numMaterials)
+        return false;
+
+      if (record.numVertices == 0)
+        continue;
+
+      if (record.vertices == NO_DATA || record.colours == NO_DATA)
+        return false;
+
+      // Every index must refer to a vertex
+      if (record.numIndices > 0)
+      {
+        if (record.indices == NO_DATA ||
+            !inRange(record.indices, (uint64_t)record.numIndices * sizeof(GLuint), h.dataSize))
+          return false;
+
+        const GLuint *indices = reinterpret_cast<const GLuint *>(m_data + h.dataOffset + record.indices);
+        for (size_t j = 0; j < record.numIndices; j++)
+        {
+          if (indices[j] >= record.numVertices)
+            return false;
+        }
+      }
+
+      const uint64_t streams[] = {record.vertices, record.colours, record.textureCoords, record.normals};
+      const uint64_t sizes[] = {sizeof(Vector3), sizeof(Colour), sizeof(Vector2), sizeof(Vector3)};
+
+      for (size_t j = 0; j < 4; j++)
+      {
+        if (streams[j] != NO_DATA && !inRange(streams[j], (uint64_t)record.numVertices * sizes[j], h.dataSize))
+          return false;
+      }
+    }
+
+    if (h.numNodes == 0)
+      return false;
+
+    for (size_t i = 0; i < h.numNodes; i++)
+    {
+      const NodeRecord &n = node(i);
+
+      if (n.name >= h.stringsSize)
+        return false;
+
+      // Only the root has no parent and parents precede their children
+      if ((i == 0) != (n.parent == NONE) || (i > 0 && n.parent >= i))
+        return false;
+
+      if (!inRange(n.firstMesh, n.numMeshes, h.numNodeMeshes))
+        return false;
+    }
+
+    for (size_t i = 0; i < h.numNodeMeshes; i++)
+    {
+      if (nodeMesh(i) >= h.numMeshes)
+        return false;
+    }
+
+    return true;
+  }
+}
+}
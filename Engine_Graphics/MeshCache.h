@@ -0,0 +1,246 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#ifndef _ENGINE_GRAPHICS_MESHCACHE_H_
+#define _ENGINE_GRAPHICS_MESHCACHE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <Engine_IO/MappedFile.h>
+
+#include "Mesh.h"
+
+namespace Engine
+{
+namespace Graphics
+{
+  /**
+   * @struct MeshStreams
+   * @brief Vertex streams and material of a mesh converted from Assimp.
+   */
+  struct MeshStreams
+  {
+    MeshData mesh;                                     //!< Primitive type and material (stream pointers are not set)
+    std::vector<Engine::Maths::Vector3> vertices;      //!< Vertex positions
+    std::vector<Colour> colours;                       //!< Vertex colours
+    std::vector<Engine::Maths::Vector2> textureCoords; //!< Vertex texture coordinates (empty if not present)
+    std::vector<Engine::Maths::Vector3> normals;       //!< Vertex normals (empty if not present)
+    std::vector<GLuint> indices;                       //!< Triangle list indices
+
+    MeshData view() const;
+  };
+
+  /**
+   * @class MeshCache
+   * @brief Compact binary form of an imported model, used to avoid running
+   *        Assimp each time a model is loaded.
+   * @author Dan Nixon
+   *
+   * A cache file holds a header identifying the source model, followed by
+   * tables of materials, meshes and scene nodes (in pre-order, so a parent
+   * always precedes its children), a string table and a data section holding
+   * the index list and vertex streams of each mesh in the layout expected by
+   * Mesh.
+   *
+   * A cache is either created from an Assimp scene (and held in memory until
+   * saved) or opened from a file, in which case it is memory mapped and the
+   * mesh data is read directly from the mapping.
+   */
+  class MeshCache
+  {
+  public:
+    /**
+     * @var NONE
+     * @brief Value of an index or string offset that is not set.
+     */
+    static const uint32_t NONE = 0xFFFFFFFF;
+
+    /**
+     * @var VERSION
+     * @brief Version of the cache format (must be changed if the format or
+     *        the way models are imported changes).
+     */
+    static const uint32_t VERSION = 2;
+
+    /**
+     * @struct SourceKey
+     * @brief Identifies the version of a model file a cache was created from.
+     */
+    struct SourceKey
+    {
+      uint64_t hash;         //!< FNV-1a hash of the file contents
+      uint64_t modifiedTime; //!< Time the file was last modified
+      uint64_t size;         //!< Size of the file (bytes)
+    };
+
+    /**
+     * @struct MaterialRecord
+     * @brief Material used by meshes.
+     */
+    struct MaterialRecord
+    {
+      float ambient[4];        //!< Ambient colour
+      float diffuse[4];        //!< Diffuse colour
+      float specular[4];       //!< Specular colour
+      float shininess;         //!< Specular exponent
+      float shininessStrength; //!< Coefficient of specular contribution
+      uint32_t texture;        //!< String offset of the diffuse texture path (relative to the model)
+      uint32_t lines;          //!< Non zero if meshes are drawn as wireframe
+    };
+
+    /**
+     * @struct MeshRecord
+     * @brief Mesh stored in the cache.
+     */
+    struct MeshRecord
+    {
+      uint32_t material;      //!< Index of material
+      uint32_t numVertices;   //!< Number of vertices
+      uint32_t numIndices;    //!< Number of indices
+      uint32_t reserved;      //!< Unused (pads the record)
+      float lower[3];         //!< Lower left of bounding box
+      float upper[3];         //!< Upper right of bounding box
+      uint64_t indices;       //!< Offset of indices in data section
+      uint64_t vertices;      //!< Offset of vertex positions in data section
+      uint64_t colours;       //!< Offset of vertex colours in data section
+      uint64_t textureCoords; //!< Offset of texture coordinates in data section (NO_DATA if not present)
+      uint64_t normals;       //!< Offset of normals in data section (NO_DATA if not present)
+    };
+
+    /**
+     * @struct NodeRecord
+     * @brief Node of the scene tree.
+     */
+    struct NodeRecord
+    {
+      uint32_t name;      //!< String offset of the node name
+      uint32_t parent;    //!< Index of the parent node (NONE for the root)
+      uint32_t firstMesh; //!< Index of the first entry in the node mesh list
+      uint32_t numMeshes; //!< Number of meshes in this node
+    };
+
+    static const uint64_t NO_DATA;
+
+    static bool ReadSourceKey(const std::string &filename, SourceKey &key);
+    static void ConvertMesh(const struct aiMesh *mesh, const struct aiMaterial *material, MeshStreams &out);
+
+    MeshCache();
+    virtual ~MeshCache();
+
+    /**
+     * @brief No copy constructor
+     */
+    MeshCache(MeshCache const &) = delete;
+
+    /**
+     * @brief No assign copy constructor
+     */
+    MeshCache &operator=(MeshCache const &) = delete;
+
+    void create(const struct aiScene *scene, const SourceKey &source);
+    bool open(const std::string &filename, const SourceKey &source);
+    bool save(const std::string &filename) const;
+    void clear();
+
+    /**
+     * @brief Checks if the cache holds a model.
+     * @return True if a model is held
+     */
+    inline bool valid() const
+    {
+      return m_data != nullptr;
+    }
+
+    /**
+     * @brief Checks if the cache is read from a memory mapped file.
+     * @return True if mapped
+     */
+    inline bool mapped() const
+    {
+      return m_file.isOpen();
+    }
+
+    /**
+     * @brief Gets the size of the cache.
+     * @return Size in bytes
+     */
+    inline size_t size() const
+    {
+      return m_size;
+    }
+
+    size_t numMaterials() const;
+    const MaterialRecord &material(size_t idx) const;
+
+    size_t numMeshes() const;
+    const MeshRecord &mesh(size_t idx) const;
+    MeshData meshData(size_t idx) const;
+
+    size_t numNodes() const;
+    const NodeRecord &node(size_t idx) const;
+    uint32_t nodeMesh(size_t idx) const;
+
+    const char *string(uint32_t offset) const;
+
+  private:
+    /**
+     * @struct Header
+     * @brief Header at the start of a cache file.
+     */
+    struct Header
+    {
+      uint32_t magic;            //!< Identifies the file as a mesh cache
+      uint32_t version;          //!< Format version
+      SourceKey source;          //!< Model file the cache was created from
+      uint32_t numMaterials;     //!< Number of materials
+      uint32_t numMeshes;        //!< Number of meshes
+      uint32_t numNodes;         //!< Number of nodes
+      uint32_t numNodeMeshes;    //!< Length of node mesh list
+      uint64_t materialsOffset;  //!< Offset of material table
+      uint64_t meshesOffset;     //!< Offset of mesh table
+      uint64_t nodesOffset;      //!< Offset of node table
+      uint64_t nodeMeshesOffset; //!< Offset of node mesh list
+      uint64_t stringsOffset;    //!< Offset of string table
+      uint64_t stringsSize;      //!< Size of string table (bytes)
+      uint64_t dataOffset;       //!< Offset of data section
+      uint64_t dataSize;         //!< Size of data section (bytes)
+    };
+
+    static const uint32_t MAGIC;
+
+    bool validate(const SourceKey &source) const;
+
+    /**
+     * @brief Gets the header of the cache.
+     * @return Header
+     */
+    inline const Header &header() const
+    {
+      return *reinterpret_cast<const Header *>(m_data);
+    }
+
+    /**
+     * @brief Gets a pointer to a table in the cache.
+     * @param offset Offset of the table from the start of the cache
+     * @return Pointer to the first entry
+     */
+    template <typename T> inline const T *table(uint64_t offset) const
+    {
+      return reinterpret_cast<const T *>(m_data + offset);
+    }
+
+    std::vector<uint64_t> m_buffer; //!< Storage of a cache created in memory
+    Engine::IO::MappedFile m_file;  //!< Mapping of a cache opened from file
+    const char *m_data;             //!< Pointer to start of cache
+    size_t m_size;                  //!< Size of cache (bytes)
+  };
+}
+}
+
+#endif
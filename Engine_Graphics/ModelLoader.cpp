@@ -11,6 +11,10 @@
 #include <assimp/cimport.h>
 #include <assimp/postprocess.h>
 
+#include <cstring>
+#include <functional>
+#include <sstream>
+
 #include <Engine_Logging/Logger.h>
 #include <Engine_Utility/StringUtils.h>
 
@@ -28,13 +32,74 @@ namespace Engine
 {
 namespace Graphics
 {
+  std::string ModelLoader::s_cacheDirectory;
+  std::mutex ModelLoader::s_cacheFileLocksMutex;
+  std::unordered_map<std::string, std::mutex> ModelLoader::s_cacheFileLocks;
+
+  /**
+   * @brief Sets the directory in which imported models are cached.
+   * @param directory Existing directory (empty to disable caching)
+   *
+   * Must not be called while models are being imported.
+   */
+  void ModelLoader::SetCacheDirectory(const std::string &directory)
+  {
+    s_cacheDirectory = directory;
+
+    if (!s_cacheDirectory.empty() && s_cacheDirectory.back() != '/' && s_cacheDirectory.back() != '\\')
+      s_cacheDirectory += '/';
+  }
+
+  /**
+   * @brief Gets the directory in which imported models are cached.
+   * @return Directory (empty if caching is disabled)
+   */
+  std::string ModelLoader::CacheDirectory()
+  {
+    return s_cacheDirectory;
+  }
+
+  /**
+   * @brief Gets the name of the cache file for a model.
+   * @param filename Model file
+   * @return Cache file (empty if caching is disabled)
+   *
+   * The name includes a hash of the full path so models of the same name in
+   * different directories do not share a cache.
+   */
+  std::string ModelLoader::CacheFilename(const std::string &filename)
+  {
+    if (s_cacheDirectory.empty())
+      return std::string();
+
+    std::stringstream str;
+    str << s_cacheDirectory << StringUtils::FilenameFromPath(filename) << "_" << std::hex
+        << std::hash<std::string>()(filename) << ".mcache";
+    return str.str();
+  }
+
+  /**
+   * @brief Gets the mutex that serialises imports using a cache file.
+   * @param cacheFile Cache file
+   * @return Mutex for the cache file
+   *
+   * One mutex is kept for each cache file used, they are never removed so
+   * references remain valid.
+   */
+  std::mutex &ModelLoader::CacheFileLock(const std::string &cacheFile)
+  {
+    std::lock_guard<std::mutex> lock(s_cacheFileLocksMutex);
+    return s_cacheFileLocks[cacheFile];
+  }
+
   ModelLoader::ModelLoader()
   {
   }
 
   ModelLoader::~ModelLoader()
   {
-    delete[] m_textures;
+    for (auto it = m_textureImages.begin(); it != m_textureImages.end(); ++it)
+      delete *it;
   }
 
   /**
@@ -45,94 +110,175 @@ namespace Graphics
    */
   RenderableObject *ModelLoader::load(const std::string &filename, ShaderProgram *sp)
   {
-    Assimp::Importer i;
-    const struct aiScene *scene =
-        i.ReadFile(filename.c_str(), aiProcess_CalcTangentSpace | aiProcess_Triangulate |
-                                         aiProcess_JoinIdenticalVertices | aiProcess_SortByPType |
-                                         aiProcess_GenUVCoords | aiProcess_TransformUVCoords | aiProcess_FlipUVs);
-
-    if (scene == nullptr)
+    if (!import(filename))
       return nullptr;
 
-    RenderableObject *obj = new RenderableObject(filename);
-    std::string directory = StringUtils::DirectoryFromPath(filename);
-
-    loadTextures(scene, directory);
-    loadRecursive(obj, scene, scene->mRootNode, sp);
-
-    return obj;
+    return build(sp);
   }
 
   /**
-   * @brief Loads textures for each material used in the model.
-   * @param scene Assimp scene being loaded
-   * @param directory DIrectory in which textures are stored
+   * @brief Reads a 3D model file (or its cache) and decodes the textures it
+   *        uses.
+   * @param filename File to load
+   * @return True if the model was read
+   *
+   * Does not create any GL or managed objects so may be called from any
+   * thread. Concurrent imports of the same model are serialised so that one
+   * writes the cache and the others read it.
    */
-  void ModelLoader::loadTextures(const struct aiScene *scene, const std::string &directory)
+  bool ModelLoader::import(const std::string &filename)
   {
-    m_textures = new Texture *[scene->mNumMaterials];
-    for (size_t i = 0; i < scene->mNumMaterials; i++)
+    m_filename = filename;
+
+    MeshCache::SourceKey key;
+    const std::string cacheFile = CacheFilename(filename);
+    const bool cacheable = !cacheFile.empty() && MeshCache::ReadSourceKey(filename, key);
+
+    std::unique_lock<std::mutex> cacheLock;
+    if (cacheable)
+      cacheLock = std::unique_lock<std::mutex>(CacheFileLock(cacheFile));
+
+    if (!cacheable || !m_cache.open(cacheFile, key))
     {
-      const aiMaterial *material = scene->mMaterials[i];
+      Assimp::Importer importer;
+      const struct aiScene *scene = importer.ReadFile(
+          filename.c_str(), aiProcess_CalcTangentSpace | aiProcess_Triangulate | aiProcess_JoinIdenticalVertices |
+                                aiProcess_SortByPType | aiProcess_GenUVCoords | aiProcess_TransformUVCoords |
+                                aiProcess_FlipUVs);
 
-      m_textures[i] = nullptr;
-      if (material->GetTextureCount(aiTextureType_DIFFUSE) > 0)
+      if (scene == nullptr)
       {
-        aiString path;
-
-        if (material->GetTexture(aiTextureType_DIFFUSE, 0, &path, nullptr, nullptr, nullptr, nullptr, nullptr) ==
-            AI_SUCCESS)
-        {
-          std::string filename = directory + "/" + path.data;
-          m_textures[i] = new Texture();
-          m_textures[i]->load(filename);
-
-          if (!m_textures[i]->valid())
-          {
-            g_log.error("Failed to load texture \"" + filename + "\"");
-            m_textures[i] = nullptr;
-          }
-        }
+        m_cache.clear();
+        return false;
       }
+
+      if (!cacheable)
+        memset(&key, 0, sizeof(key));
+
+      m_cache.create(scene, key);
+
+      if (cacheable && !m_cache.save(cacheFile))
+        g_log.warn("Failed to write model cache \"" + cacheFile + "\"");
     }
+
+    if (cacheLock)
+      cacheLock.unlock();
+
+    decodeTextures(StringUtils::DirectoryFromPath(filename));
+
+    return true;
   }
 
   /**
-   * @brief Load a node of the scene tree.
-   * @param sn RenderableObject node
-   * @param scene Assimp scene
-   * @param node Assimp scene node
+   * @brief Creates the RenderableObject tree for an imported model.
    * @param sp Shader to assign to new RenderableObject
+   * @return RenderableObject tree, nullptr if no model has been imported
+   *
+   * Must be called on the thread owning the GL context.
    */
-  void ModelLoader::loadRecursive(RenderableObject *sn, const struct aiScene *scene, const struct aiNode *node,
-                                  ShaderProgram *sp)
+  RenderableObject *ModelLoader::build(ShaderProgram *sp)
   {
-    const aiMatrix4x4 transform = node->mTransformation;
-    std::string nodeName(node->mName.C_Str());
+    if (!m_cache.valid())
+      return nullptr;
+
+    loadTextures();
 
-    // Meshes in this node
-    for (size_t i = 0; i < node->mNumMeshes; i++)
+    // Nodes are stored in pre-order so parents are always created first
+    const size_t numNodes = m_cache.numNodes();
+    std::vector<RenderableObject *> objects(numNodes, nullptr);
+    std::vector<size_t> numChildren(numNodes, 0);
+
+    for (size_t i = 0; i < numNodes; i++)
     {
-      const struct aiMesh *m = scene->mMeshes[node->mMeshes[i]];
+      const MeshCache::NodeRecord &node = m_cache.node(i);
+      std::string nodeName(m_cache.string(node.name));
+
+      RenderableObject *sn;
+      if (node.parent == MeshCache::NONE)
+        sn = new RenderableObject(m_filename);
+      else
+        sn = new RenderableObject("child_" + std::to_string(numChildren[node.parent]++));
+
+      objects[i] = sn;
+
+      // Meshes in this node
+      for (size_t j = 0; j < node.numMeshes; j++)
+      {
+        uint32_t meshIdx = m_cache.nodeMesh(node.firstMesh + j);
+        const MeshCache::MeshRecord &record = m_cache.mesh(meshIdx);
+
+        if (record.numVertices == 0)
+          continue;
 
-      if (m->mNumVertices == 0)
+        Mesh *mesh = Mesh::LoadMeshData(m_cache.meshData(meshIdx));
+        std::string objName = nodeName + "_" + std::to_string(j);
+        RenderableObject *obj = new RenderableObject(objName, mesh, sp, m_textures[record.material]);
+        sn->addChild(obj);
+      }
+
+      if (node.parent != MeshCache::NONE)
+        objects[node.parent]->addChild(sn);
+    }
+
+    return objects.empty() ? nullptr : objects[0];
+  }
+
+  /**
+   * @brief Decodes textures for each material used in the model.
+   * @param directory DIrectory in which textures are stored
+   */
+  void ModelLoader::decodeTextures(const std::string &directory)
+  {
+    for (auto it = m_textureImages.begin(); it != m_textureImages.end(); ++it)
+      delete *it;
+
+    const size_t numMaterials = m_cache.numMaterials();
+    m_textureFiles.assign(numMaterials, std::string());
+    m_textureImages.assign(numMaterials, nullptr);
+
+    for (size_t i = 0; i < numMaterials; i++)
+    {
+      const char *path = m_cache.string(m_cache.material(i).texture);
+      if (path == nullptr)
         continue;
 
-      size_t matIdx = m->mMaterialIndex;
-      const struct aiMaterial *mat = scene->mMaterials[matIdx];
+      m_textureFiles[i] = directory + "/" + path;
 
-      Mesh *mesh = Mesh::LoadMesh(m, mat);
-      std::string objName = nodeName + "_" + std::to_string(i);
-      RenderableObject *obj = new RenderableObject(objName, mesh, sp, m_textures[matIdx]);
-      sn->addChild(obj);
+      ImageData *image = new ImageData();
+      if (Texture::DecodeImage(m_textureFiles[i], *image))
+        m_textureImages[i] = image;
+      else
+        delete image;
     }
+  }
 
-    // Children in this node
-    for (size_t i = 0; i < node->mNumChildren; i++)
+  /**
+   * @brief Creates textures for each material from the decoded images (and
+   *        frees the images).
+   */
+  void ModelLoader::loadTextures()
+  {
+    m_textures.assign(m_textureFiles.size(), nullptr);
+
+    for (size_t i = 0; i < m_textureFiles.size(); i++)
     {
-      RenderableObject *child = new RenderableObject("child_" + std::to_string(i));
-      loadRecursive(child, scene, node->mChildren[i], sp);
-      sn->addChild(child);
+      if (m_textureFiles[i].empty())
+        continue;
+
+      Texture *texture = new Texture();
+      if (m_textureImages[i] != nullptr)
+      {
+        texture->upload(*m_textureImages[i]);
+
+        // Pixels are no longer needed once in GL
+        delete m_textureImages[i];
+        m_textureImages[i] = nullptr;
+      }
+
+      if (texture->valid())
+        m_textures[i] = texture;
+      else
+        g_log.error("Failed to load texture \"" + m_textureFiles[i] + "\"");
     }
   }
 }
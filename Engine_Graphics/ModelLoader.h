@@ -8,10 +8,14 @@
 #ifndef _ENGINE_GRAPHICS_MODELLOADER_H_
 #define _ENGINE_GRAPHICS_MODELLOADER_H_
 
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <assimp/scene.h>
 
+#include "MeshCache.h"
 #include "RenderableObject.h"
 #include "ShaderProgram.h"
 #include "Texture.h"
@@ -24,21 +28,56 @@ namespace Graphics
    * @class ModelLoader
    * @brief Loader for 3D models (supported by Assimp).
    * @author Dan Nixon
+   *
+   * Loading is split into ModelLoader::import, which reads the model file
+   * and decodes its textures without touching GL (so may be called from a
+   * worker thread), and ModelLoader::build, which creates the meshes,
+   * textures and scene tree on the thread owning the GL context.
+   *
+   * If a cache directory is set, imported models are stored there as a
+   * MeshCache and later imports of an unchanged model read the cache instead
+   * of running Assimp.
    */
   class ModelLoader
   {
   public:
+    static void SetCacheDirectory(const std::string &directory);
+    static std::string CacheDirectory();
+    static std::string CacheFilename(const std::string &filename);
+
     ModelLoader();
     virtual ~ModelLoader();
 
     Engine::Graphics::RenderableObject *load(const std::string &filename, ShaderProgram *sp);
 
+    bool import(const std::string &filename);
+    Engine::Graphics::RenderableObject *build(ShaderProgram *sp);
+
+    /**
+     * @brief Checks if the last imported model was read from the cache.
+     * @return True if read from cache
+     */
+    inline bool cacheHit() const
+    {
+      return m_cache.mapped();
+    }
+
   private:
-    void loadTextures(const struct aiScene *scene, const std::string &directory);
-    void loadRecursive(Engine::Graphics::RenderableObject *parent, const struct aiScene *scene,
-                       const struct aiNode *node, ShaderProgram *sp);
+    static std::mutex &CacheFileLock(const std::string &cacheFile);
+
+    static std::string s_cacheDirectory; //!< Directory holding cached models (empty if caching is disabled)
+
+    static std::mutex s_cacheFileLocksMutex;                             //!< Mutex protecting s_cacheFileLocks
+    static std::unordered_map<std::string, std::mutex> s_cacheFileLocks; //!< Lock for each cache file
+
+    void decodeTextures(const std::string &directory);
+    void loadTextures();
 
-    Texture **m_textures; //!< Textures for each material
+    std::string m_filename;                   //!< Name of the imported file
+    MeshCache m_cache;                        //!< Imported model
+    std::vector<std::string> m_textureFiles;  //!< Texture filename for each material (empty if untextured)
+    std::vector<ImageData *> m_textureImages; //!< Decoded texture for each material (nullptr if not decoded)
+    std::vector<Texture *> m_textures;        //!< Textures for each material
   };
 }
 }
@@ -0,0 +1,194 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include "RenderQueue.h"
+
+#include <cstring>
+
+namespace
+{
+/**
+ * @brief Creates a mask of the lower bits of a value.
+ * @param bits Number of bits
+ * @return Mask
+ */
+inline uint64_t Mask(unsigned bits)
+{
+  return (((uint64_t)1) << bits) - 1;
+}
+}
+
+namespace Engine
+{
+namespace Graphics
+{
+  /**
+   * @brief Quantises a view space depth for use in a key.
+   * @param depth Distance along the view direction
+   * @return Quantised depth (increases with depth, 0 for depths behind the
+   *         camera)
+   *
+   * The bit pattern of a positive float increases with its value, so the
+   * upper bits can be used directly without knowing the range of depths.
+   */
+  uint32_t RenderQueue::QuantiseDepth(float depth)
+  {
+    if (!(depth > 0.0f))
+      return 0;
+
+    uint32_t bits;
+    memcpy(&bits, &depth, sizeof(bits));
+
+    return bits >> (31 - DEPTH_BITS);
+  }
+
+  /**
+   * @brief Creates a key for an opaque draw.
+   * @param shader Shader ID
+   * @param texture Texture ID
+   * @param mesh Mesh ID
+   * @param depth Distance along the view direction
+   * @return Sort key
+   * @see RenderQueue::resourceID
+   */
+  uint64_t RenderQueue::OpaqueKey(uint32_t shader, uint32_t texture, uint32_t mesh, float depth)
+  {
+    uint64_t key = (uint64_t)OPAQUE_PASS << (64 - PASS_BITS);
+    key |= (shader & Mask(SHADER_BITS)) << (TEXTURE_BITS + MESH_BITS + DEPTH_BITS);
+    key |= (texture & Mask(TEXTURE_BITS)) << (MESH_BITS + DEPTH_BITS);
+    key |= (mesh & Mask(MESH_BITS)) << DEPTH_BITS;
+    key |= QuantiseDepth(depth);
+
+    return key;
+  }
+
+  /**
+   * @brief Creates a key for a transparent draw.
+   * @param depth Distance along the view direction
+   * @return Sort key
+   */
+  uint64_t RenderQueue::TransparentKey(float depth)
+  {
+    const uint64_t inverseDepth = ~(uint64_t)QuantiseDepth(depth) & Mask(DEPTH_BITS);
+
+    uint64_t key = (uint64_t)TRANSPARENT_PASS << (64 - PASS_BITS);
+    key |= inverseDepth << (64 - PASS_BITS - DEPTH_BITS);
+
+    return key;
+  }
+
+  /**
+   * @brief Creates a key that only orders a draw by pass.
+   * @param pass Pass
+   * @return Sort key
+   *
+   * Used in unsorted queues, where draws are kept in the order they were
+   * queued within each pass.
+   */
+  uint64_t RenderQueue::PassKey(Pass pass)
+  {
+    return (uint64_t)pass << (64 - PASS_BITS);
+  }
+
+  /**
+   * @brief Gets the number of IDs that fit in the bits a key has for a type of
+   *        resource.
+   * @param type Resource type
+   * @return ID limit
+   */
+  uint32_t RenderQueue::ResourceIDLimit(Resource type)
+  {
+    switch (type)
+    {
+    case SHADER_RESOURCE:
+      return 1u << SHADER_BITS;
+    case TEXTURE_RESOURCE:
+      return 1u << TEXTURE_BITS;
+    default:
+      return 1u << MESH_BITS;
+    }
+  }
+
+  /**
+   * @brief Creates a new, empty render queue.
+   */
+  RenderQueue::RenderQueue()
+  {
+  }
+
+  /**
+   * @brief Gets the ID of a resource for use in keys.
+   * @param type Resource type
+   * @param resource Pointer to resource (may be nullptr)
+   * @return Resource ID (0 for nullptr)
+   *
+   * IDs are small integers assigned in the order resources are first seen so
+   * that they fit in the bits available in a key. Once they no longer fit,
+   * IDs of that type are reassigned from 1 (this also bounds memory use when
+   * resources are frequently recreated).
+   */
+  uint32_t RenderQueue::resourceID(Resource type, const void *resource)
+  {
+    if (resource == nullptr)
+      return 0;
+
+    std::unordered_map<const void *, uint32_t> &ids = m_resourceIDs[type];
+
+    auto it = ids.find(resource);
+    if (it != ids.end())
+      return it->second;
+
+    if (ids.size() + 1 >= ResourceIDLimit(type))
+      ids.clear();
+
+    uint32_t id = (uint32_t)ids.size() + 1;
+    ids[resource] = id;
+    return id;
+  }
+
+  /**
+   * @brief Sorts the queued draws by key.
+   *
+   * Uses an LSD radix sort on each byte of the key, skipping bytes that are
+   * the same in every key (e.g. the unused bits of transparent keys).
+   */
+  void RenderQueue::sort()
+  {
+    const size_t n = m_packets.size();
+    if (n < 2)
+      return;
+
+    m_scratch.resize(n);
+
+    for (unsigned shift = 0; shift < 64; shift += 8)
+    {
+      size_t counts[256];
+      memset(counts, 0, sizeof(counts));
+
+      for (size_t i = 0; i < n; i++)
+        counts[(m_packets[i].key >> shift) & 0xFF]++;
+
+      // All keys have the same value for this byte
+      if (counts[(m_packets[0].key >> shift) & 0xFF] == n)
+        continue;
+
+      size_t offset = 0;
+      for (size_t i = 0; i < 256; i++)
+      {
+        size_t c = counts[i];
+        counts[i] = offset;
+        offset += c;
+      }
+
+      for (size_t i = 0; i < n; i++)
+        m_scratch[counts[(m_packets[i].key >> shift) & 0xFF]++] = m_packets[i];
+
+      m_packets.swap(m_scratch);
+    }
+  }
+}
+}
@@ -0,0 +1,146 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#ifndef _ENGINE_GRAPHICS_RENDERQUEUE_H_
+#define _ENGINE_GRAPHICS_RENDERQUEUE_H_
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine
+{
+namespace Graphics
+{
+  class RenderableObject;
+
+  /**
+   * @class RenderQueue
+   * @brief Queue of draws that are sorted by a key before being submitted.
+   * @author Dan Nixon
+   *
+   * Keys are laid out (most significant first) as:
+   *  - Opaque: pass (2 bits), shader (12), texture (12), mesh (14), depth (24)
+   *  - Transparent: pass (2 bits), inverted depth (24), unused (38)
+   *
+   * So opaque draws are grouped by state and drawn front to back within each
+   * group, transparent draws are drawn back to front. The sort is stable, so
+   * draws with equal keys keep the order they were queued in.
+   */
+  class RenderQueue
+  {
+  public:
+    /**
+     * @brief Passes draws are split into, in the order they are drawn.
+     */
+    enum Pass
+    {
+      OPAQUE_PASS = 0,
+      TRANSPARENT_PASS = 1
+    };
+
+    /**
+     * @brief Types of resource that are given IDs for use in keys.
+     */
+    enum Resource
+    {
+      SHADER_RESOURCE,
+      TEXTURE_RESOURCE,
+      MESH_RESOURCE,
+
+      NUM_RESOURCES
+    };
+
+    static const unsigned PASS_BITS = 2;     //!< Bits used for pass
+    static const unsigned SHADER_BITS = 12;  //!< Bits used for shader ID
+    static const unsigned TEXTURE_BITS = 12; //!< Bits used for texture ID
+    static const unsigned MESH_BITS = 14;    //!< Bits used for mesh ID
+    static const unsigned DEPTH_BITS = 24;   //!< Bits used for quantised depth
+
+    /**
+     * @struct Packet
+     * @brief A single queued draw.
+     */
+    struct Packet
+    {
+      uint64_t key;             //!< Sort key
+      RenderableObject *object; //!< Object to render
+    };
+
+    static uint32_t QuantiseDepth(float depth);
+    static uint64_t OpaqueKey(uint32_t shader, uint32_t texture, uint32_t mesh, float depth);
+    static uint64_t TransparentKey(float depth);
+    static uint64_t PassKey(Pass pass);
+
+    /**
+     * @brief Gets the pass a key is in.
+     * @param key Sort key
+     * @return Pass
+     */
+    static inline Pass KeyPass(uint64_t key)
+    {
+      return (Pass)(key >> (64 - PASS_BITS));
+    }
+
+    RenderQueue();
+
+    uint32_t resourceID(Resource type, const void *resource);
+
+    /**
+     * @brief Adds a draw to the queue.
+     * @param key Sort key
+     * @param object Object to render
+     */
+    inline void push(uint64_t key, RenderableObject *object)
+    {
+      Packet p;
+      p.key = key;
+      p.object = object;
+      m_packets.push_back(p);
+    }
+
+    /**
+     * @brief Removes all draws from the queue.
+     */
+    inline void clear()
+    {
+      m_packets.clear();
+    }
+
+    /**
+     * @brief Gets the number of queued draws.
+     * @return Draw count
+     */
+    inline size_t size() const
+    {
+      return m_packets.size();
+    }
+
+    /**
+     * @brief Gets a queued draw.
+     * @param idx Index of draw
+     * @return Draw packet
+     */
+    inline const Packet &operator[](size_t idx) const
+    {
+      return m_packets[idx];
+    }
+
+    void sort();
+
+  private:
+    static uint32_t ResourceIDLimit(Resource type);
+
+    std::vector<Packet> m_packets; //!< Queued draws
+    std::vector<Packet> m_scratch; //!< Buffer used when sorting
+
+    std::unordered_map<const void *, uint32_t> m_resourceIDs[NUM_RESOURCES]; //!< IDs assigned to resources
+  };
+}
+}
+
+#endif
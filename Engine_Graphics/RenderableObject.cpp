@@ -9,6 +9,9 @@
 
 #include <Engine_Common/Subsystem.h>
 #include <Engine_Maths/Matrix3.h>
+#include <Engine_ResourceManagment/MemoryManager.h>
+
+#include "GLState.h"
 
 using namespace Engine::Common;
 using namespace Engine::Maths;
@@ -17,6 +20,37 @@ namespace Engine
 {
 namespace Graphics
 {
+  /**
+   * @brief Gets the pool RenderableObject instances are allocated from.
+   * @return Object pool
+   */
+  Engine::ResourceManagment::ObjectPool &RenderableObject::Pool()
+  {
+    static Engine::ResourceManagment::ObjectPool pool(sizeof(RenderableObject));
+    return pool;
+  }
+
+  /**
+   * @brief Allocates memory for RenderableObject from its pool (derived types of a
+   *        different size are allocated from the heap).
+   * @param size Size of object
+   * @return Pointer to memory
+   */
+  void *RenderableObject::operator new(size_t size)
+  {
+    return Engine::ResourceManagment::MemoryManager::Instance().allocate(size, &Pool());
+  }
+
+  /**
+   * @brief Frees memory used by a RenderableObject.
+   * @param ptr Pointer to memory
+   * @param size Size of object
+   */
+  void RenderableObject::operator delete(void *ptr, size_t size)
+  {
+    Engine::ResourceManagment::MemoryManager::Instance().deallocate(ptr, size, &Pool());
+  }
+
   /**
    * @brief Creates a new renderable object with a given mesh, shader and
    * texture.
@@ -28,15 +62,18 @@ namespace Graphics
    */
   RenderableObject::RenderableObject(const std::string &name, Mesh *m, ShaderProgram *s, Texture *t, bool transparent)
       : SceneObject(name)
+      , m_graphicalScene(nullptr)
       , m_transparent(transparent)
       , m_mesh(m)
       , m_shaderProgram(s)
       , m_texture(t)
+      , m_instance(nullptr)
   {
   }
 
   RenderableObject::~RenderableObject()
   {
+    delete m_instance;
   }
 
   /**
@@ -67,8 +104,8 @@ namespace Graphics
   {
     if (sys == Subsystem::GRAPHICS && m_active && m_shaderProgram)
     {
-      if (m_transparent && m_graphicalScene)
-        m_graphicalScene->m_transparent.push_back(this);
+      if (m_graphicalScene)
+        m_graphicalScene->queue(this);
       else
         render();
     }
@@ -78,41 +115,92 @@ namespace Graphics
 
   /**
    * @brief Renders this object.
+   *
+   * Objects with an instanced shader are drawn as a single instance.
    */
   void RenderableObject::render()
   {
-    GLuint program = m_shaderProgram->program();
+    ShaderProgram *program = useRenderState();
 
-    glUseProgram(program);
-    glUniformMatrix4fv(glGetUniformLocation(program, "modelMatrix"), 1, false, (float *)&m_worldTransform);
-    glUniformMatrix4fv(glGetUniformLocation(program, "viewMatrix"), 1, false, (float *)&(m_scene->viewMatrix()));
-    glUniformMatrix4fv(glGetUniformLocation(program, "projMatrix"), 1, false, (float *)&(m_scene->projectionMatrix()));
+    if (instanced())
+    {
+      // Use the buffer of the scene if there is one
+      InstanceBuffer *instances = m_instance;
+      if (m_graphicalScene != nullptr)
+        instances = &m_graphicalScene->m_instances;
+      else if (instances == nullptr)
+        instances = m_instance = new InstanceBuffer();
 
-    Matrix3 rotation = Matrix3(m_scene->viewMatrix());
-    Vector3 invCamPos = m_scene->viewMatrix().positionVector();
-    Vector3 camPos = rotation * -invCamPos;
-    glUniform3fv(glGetUniformLocation(program, "cameraPos"), 1, (float *)&camPos);
+      instances->clear();
+      instances->add(m_worldTransform, m_instanceColour);
 
-    if (m_texture != nullptr)
-      m_texture->use(program, 0);
+      m_mesh->drawInstanced(program, *instances);
+    }
+    else
+    {
+      program->setUniform(ShaderProgram::MODEL_MATRIX, m_worldTransform);
+      draw(program);
+    }
+  }
+
+  /**
+   * @brief Renders several instances of this object's mesh in a single draw.
+   * @param instances Instance data (typically from this and other objects
+   *                  that share its mesh, shader and texture)
+   * @see RenderableObject::sharesInstancedDraw
+   */
+  void RenderableObject::renderInstances(InstanceBuffer &instances)
+  {
+    m_mesh->drawInstanced(useRenderState(), instances);
+  }
+
+  /**
+   * @brief Makes this object's shader program current and sets the uniforms
+   *        and textures used to render it (except the model matrix).
+   * @return Shader program
+   *
+   * Uniforms common to the whole scene (view, projection, camera and lights)
+   * are only set the first time a shader program is used in each pass of a
+   * GraphicalScene.
+   */
+  ShaderProgram *RenderableObject::useRenderState()
+  {
+    ShaderProgram *program = m_shaderProgram;
+    program->use();
 
-    // Update lights
-    if (m_graphicalScene != nullptr)
+    if (m_graphicalScene == nullptr || program->beginPass(m_graphicalScene->pass()))
     {
-      for (auto it = m_graphicalScene->lights().begin(); it != m_graphicalScene->lights().end(); ++it)
-        (*it)->use(program);
+      program->setUniform(ShaderProgram::VIEW_MATRIX, m_scene->viewMatrix());
+      program->setUniform(ShaderProgram::PROJECTION_MATRIX, m_scene->projectionMatrix());
+
+      if (m_graphicalScene != nullptr)
+      {
+        program->setUniform(ShaderProgram::CAMERA_POSITION, m_graphicalScene->cameraPosition());
+
+        for (auto it = m_graphicalScene->lights().begin(); it != m_graphicalScene->lights().end(); ++it)
+          (*it)->use(program);
+      }
+      else
+      {
+        Matrix3 rotation = Matrix3(m_scene->viewMatrix());
+        Vector3 invCamPos = m_scene->viewMatrix().positionVector();
+        program->setUniform(ShaderProgram::CAMERA_POSITION, rotation * -invCamPos);
+      }
     }
 
-    draw(program);
+    if (m_texture != nullptr)
+      m_texture->use(program, 0);
+    else
+      GLState::BindTexture(0, 0);
 
-    glBindTexture(GL_TEXTURE_2D, 0);
+    return program;
   }
 
   /**
    * @brief Draws the mesh.
-   * @param program GLshader program to use
+   * @param program Shader program to use (already in use)
    */
-  void RenderableObject::draw(GLuint program)
+  void RenderableObject::draw(ShaderProgram *program)
   {
     m_mesh->draw(program);
   }
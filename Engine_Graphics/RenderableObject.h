@@ -10,7 +10,9 @@
 
 #include <Engine_Common/SceneObject.h>
 
+#include "Colour.h"
 #include "GraphicalScene.h"
+#include "InstanceBuffer.h"
 #include "Mesh.h"
 #include "ShaderProgram.h"
 #include "Texture.h"
@@ -27,6 +29,10 @@ namespace Graphics
   class RenderableObject : public Engine::Common::SceneObject
   {
   public:
+    static Engine::ResourceManagment::ObjectPool &Pool();
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr, size_t size);
+
     RenderableObject(const std::string &name, Mesh *m = nullptr, ShaderProgram *s = nullptr, Texture *t = nullptr,
                      bool transparent = false);
     ~RenderableObject();
@@ -102,11 +108,54 @@ namespace Graphics
       return m_texture;
     }
 
+    /**
+     * @brief Sets the colour passed to instanced shaders for this object.
+     * @param colour Instance colour
+     * @see RenderableObject::instanceColour
+     */
+    inline void setInstanceColour(const Colour &colour)
+    {
+      m_instanceColour = colour;
+    }
+
+    /**
+     * @brief Gets the colour passed to instanced shaders for this object.
+     * @return Instance colour
+     * @see RenderableObject::setInstanceColour
+     */
+    inline const Colour &instanceColour() const
+    {
+      return m_instanceColour;
+    }
+
+    /**
+     * @brief Tests if this object is rendered using instanced draws.
+     * @return True if the shader is instanced
+     */
+    inline bool instanced() const
+    {
+      return m_mesh != nullptr && m_shaderProgram->instanced();
+    }
+
+    /**
+     * @brief Tests if another object can be drawn in the same instanced draw
+     *        as this object.
+     * @param other Other object
+     * @return True if both objects have the same mesh, shader and texture
+     */
+    inline bool sharesInstancedDraw(const RenderableObject &other) const
+    {
+      return other.m_mesh == m_mesh && other.m_shaderProgram == m_shaderProgram && other.m_texture == m_texture;
+    }
+
     virtual void update(float msec, Engine::Common::Subsystem sys);
     void render();
+    void renderInstances(InstanceBuffer &instances);
 
   protected:
-    virtual void draw(GLuint program);
+    ShaderProgram *useRenderState();
+
+    virtual void draw(ShaderProgram *program);
     virtual void addToScene(Engine::Common::Scene *scene);
 
   protected:
@@ -115,6 +164,8 @@ namespace Graphics
     Mesh *m_mesh;                     //!< Mesh represented by this object
     ShaderProgram *m_shaderProgram;   //!< Shader used to render m_mesh
     Texture *m_texture;               //!< Texture used on m_mesh
+    Colour m_instanceColour;          //!< Colour passed to instanced shaders
+    InstanceBuffer *m_instance;       //!< Instance data for drawing outside of a GraphicalScene (created when needed)
   };
 }
 }
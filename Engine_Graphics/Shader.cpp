@@ -6,6 +6,7 @@
  */
 
 #include "Shader.h"
+#include "GLContext.h"
 #include "Mesh.h"
 
 #include <Engine_Logging/Logger.h>
@@ -27,6 +28,7 @@ namespace Graphics
   Shader::Shader(std::string filename, GLuint stage)
       : m_valid(false)
       , m_stage(stage)
+      , m_shaderObject(0)
   {
     m_valid = compile(filename);
   }
@@ -36,7 +38,8 @@ namespace Graphics
    */
   Shader::~Shader(void)
   {
-    glDeleteShader(m_shaderObject);
+    if (m_shaderObject != 0)
+      glDeleteShader(m_shaderObject);
   }
 
   /**
@@ -67,10 +70,14 @@ namespace Graphics
   /**
    * @brief Compiles a shader.
    * @param filename GLSL source file
-   * @return True for successful compilation
+   * @return True for successful compilation (always false without a GL
+   *         context)
    */
   bool Shader::compile(std::string filename)
   {
+    if (!GLContext::Available())
+      return false;
+
     std::string load;
     if (!loadFile(filename, load))
       return false;
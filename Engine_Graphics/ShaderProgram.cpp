@@ -9,12 +9,50 @@
 
 #include <Engine_Logging/Logger.h>
 
+#include <cstring>
+
+#include "GLContext.h"
+#include "GLState.h"
 #include "Mesh.h"
 #include "Shader.h"
 
+using namespace Engine::Maths;
+
 namespace
 {
 Engine::Logging::Logger g_log(__FILE__);
+
+/**
+ * @brief Names of the uniforms in ShaderProgram::Uniform.
+ */
+const char *UNIFORM_NAMES[] = {"modelMatrix",   "viewMatrix",     "projMatrix",      "cameraPos", "ambientColour",
+                               "diffuseColour", "specularColour", "ambientStrength", "shininess", "shininessStrength"};
+
+/**
+ * @brief Gets the size of the value of a single uniform of a given type.
+ * @param type GL uniform type
+ * @return Size in bytes (0 for types that are not cached)
+ */
+size_t UniformSize(GLenum type)
+{
+  switch (type)
+  {
+  case GL_FLOAT:
+  case GL_INT:
+  case GL_BOOL:
+  case GL_SAMPLER_2D:
+  case GL_SAMPLER_CUBE:
+    return 4;
+  case GL_FLOAT_VEC3:
+    return 12;
+  case GL_FLOAT_VEC4:
+    return 16;
+  case GL_FLOAT_MAT4:
+    return 64;
+  default:
+    return 0;
+  }
+}
 }
 
 namespace Engine
@@ -25,12 +63,16 @@ namespace Graphics
    * @brief Creates a new, empty shader program.
    */
   ShaderProgram::ShaderProgram()
-      : m_valid(false)
+      : m_program(0)
+      , m_valid(false)
+      , m_instanced(false)
+      , m_pass(0)
   {
     for (size_t i = 0; i < NUM_SHADERS; i++)
       m_shaders[i] = nullptr;
 
-    m_program = glCreateProgram();
+    if (GLContext::Available())
+      m_program = glCreateProgram();
   }
 
   /**
@@ -39,6 +81,9 @@ namespace Graphics
    */
   ShaderProgram::~ShaderProgram()
   {
+    if (m_program == 0)
+      return;
+
     for (size_t i = 0; i < NUM_SHADERS; i++)
     {
       if (m_shaders[i] != nullptr)
@@ -46,6 +91,9 @@ namespace Graphics
     }
 
     glDeleteProgram(m_program);
+
+    // The GL name may be reused by a new program
+    GLState::Invalidate();
   }
 
   /**
@@ -69,10 +117,14 @@ namespace Graphics
 
   /**
    * @brief Links the shader program.
-   * @return True if the program was successfully linked
+   * @return True if the program was successfully linked (always false
+   *         without a GL context)
    */
   bool ShaderProgram::link()
   {
+    if (m_program == 0)
+      return false;
+
     if (m_valid)
     {
       g_log.error("Not all shaders are compiled, cannot link shader program");
@@ -84,6 +136,8 @@ namespace Graphics
     glBindAttribLocation(m_program, NORMAL_BUFFER, "normal");
     glBindAttribLocation(m_program, TANGENT_BUFFER, "tangent");
     glBindAttribLocation(m_program, TEXTURE_BUFFER, "texCoord");
+    glBindAttribLocation(m_program, InstanceBuffer::MODEL_MATRIX_ATTRIBUTE, "instanceModelMatrix");
+    glBindAttribLocation(m_program, InstanceBuffer::COLOUR_ATTRIBUTE, "instanceColour");
 
     for (size_t i = 0; i < NUM_SHADERS; i++)
     {
@@ -117,8 +171,185 @@ namespace Graphics
       glGetInfoLogARB(m_program, sizeof(errorMsg), nullptr, errorMsg);
       g_log.error("Shader program failed to link: " + std::string(errorMsg));
     }
+    else
+    {
+      buildUniformTable();
+      m_instanced = (glGetAttribLocation(m_program, "instanceModelMatrix") != -1);
+    }
 
     return m_valid;
   }
+
+  /**
+   * @brief Makes this the current shader program.
+   */
+  void ShaderProgram::use()
+  {
+    GLState::UseProgram(m_program);
+  }
+
+  /**
+   * @brief Gets the index of a uniform in the uniform table.
+   * @param name Name of the uniform
+   * @return Uniform index, -1 if the program has no such uniform
+   *
+   * Indices of uniforms in ShaderProgram::Uniform are always the enum value.
+   */
+  int ShaderProgram::uniformIndex(const std::string &name) const
+  {
+    auto it = m_uniformLookup.find(name);
+    if (it == m_uniformLookup.end())
+      return -1;
+
+    return it->second;
+  }
+
+  /**
+   * @brief Sets the value of an integer or sampler uniform.
+   * @param index Uniform index
+   * @param value Value
+   *
+   * The program must be in use. Does nothing if the value is unchanged or the
+   * program does not have the uniform.
+   */
+  void ShaderProgram::setUniform(int index, int value)
+  {
+    if (updateUniform(index, &value, sizeof(value)))
+      glUniform1i(m_uniforms[index].location, value);
+  }
+
+  /**
+   * @copydoc ShaderProgram::setUniform(int, int)
+   */
+  void ShaderProgram::setUniform(int index, float value)
+  {
+    if (updateUniform(index, &value, sizeof(value)))
+      glUniform1f(m_uniforms[index].location, value);
+  }
+
+  /**
+   * @copydoc ShaderProgram::setUniform(int, int)
+   */
+  void ShaderProgram::setUniform(int index, const Vector3 &value)
+  {
+    if (updateUniform(index, &value, sizeof(float) * 3))
+      glUniform3fv(m_uniforms[index].location, 1, (float *)&value);
+  }
+
+  /**
+   * @copydoc ShaderProgram::setUniform(int, int)
+   */
+  void ShaderProgram::setUniform(int index, const Vector4 &value)
+  {
+    if (updateUniform(index, &value, sizeof(float) * 4))
+      glUniform4fv(m_uniforms[index].location, 1, (float *)&value);
+  }
+
+  /**
+   * @copydoc ShaderProgram::setUniform(int, int)
+   */
+  void ShaderProgram::setUniform(int index, const Matrix4 &value)
+  {
+    if (updateUniform(index, &value, sizeof(float) * 16))
+      glUniformMatrix4fv(m_uniforms[index].location, 1, false, (float *)&value);
+  }
+
+  /**
+   * @brief Resolves the locations of all active uniforms and allocates the
+   *        value cache.
+   *
+   * Values are cached as zero as GL initialises all uniforms to zero when a
+   * program is linked.
+   */
+  void ShaderProgram::buildUniformTable()
+  {
+    m_uniforms.clear();
+    m_uniformLookup.clear();
+
+    UniformSlot unused;
+    unused.location = -1;
+    unused.type = GL_NONE;
+    unused.offset = 0;
+    unused.size = 0;
+
+    m_uniforms.resize(NUM_UNIFORMS, unused);
+    for (int i = 0; i < NUM_UNIFORMS; i++)
+      m_uniformLookup[UNIFORM_NAMES[i]] = i;
+
+    GLint numActive = 0;
+    glGetProgramiv(m_program, GL_ACTIVE_UNIFORMS, &numActive);
+
+    size_t valuesSize = 0;
+    for (GLint i = 0; i < numActive; i++)
+    {
+      char buffer[256];
+      GLsizei length = 0;
+      GLint arraySize = 0;
+      GLenum type = GL_NONE;
+      glGetActiveUniform(m_program, (GLuint)i, sizeof(buffer), &length, &arraySize, &type, buffer);
+
+      // Arrays are reported as "name[0]", only the first element is cached
+      std::string name(buffer, length);
+      if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0)
+        name.resize(name.size() - 3);
+
+      UniformSlot slot;
+      slot.location = glGetUniformLocation(m_program, name.c_str());
+      slot.type = type;
+      slot.offset = valuesSize;
+      slot.size = UniformSize(type);
+      valuesSize += slot.size;
+
+      // Uniforms in uniform blocks have no location
+      if (slot.location == -1)
+        continue;
+
+      auto it = m_uniformLookup.find(name);
+      if (it != m_uniformLookup.end())
+      {
+        m_uniforms[it->second] = slot;
+      }
+      else
+      {
+        m_uniformLookup[name] = (int)m_uniforms.size();
+        m_uniforms.push_back(slot);
+      }
+    }
+
+    m_uniformValues.assign(valuesSize, 0);
+    m_pass = 0;
+  }
+
+  /**
+   * @brief Updates the cached value of a uniform.
+   * @param index Uniform index
+   * @param value Pointer to new value
+   * @param size Size of value in bytes
+   * @return True if the uniform exists and the value changed (i.e. the GL
+   *         call must be made)
+   *
+   * Values whose size does not match the cached size are never filtered.
+   */
+  bool ShaderProgram::updateUniform(int index, const void *value, size_t size)
+  {
+    if (index < 0 || (size_t)index >= m_uniforms.size())
+      return false;
+
+    const UniformSlot &slot = m_uniforms[index];
+    if (slot.location == -1)
+      return false;
+
+    bool changed = true;
+    if (slot.size == size)
+    {
+      char *cached = &m_uniformValues[slot.offset];
+      changed = (memcmp(cached, value, size) != 0);
+      if (changed)
+        memcpy(cached, value, size);
+    }
+
+    GLState::CountCall(changed);
+    return changed;
+  }
 }
 }
@@ -8,8 +8,16 @@
 #ifndef _ENGINE_GRAPHICS_SHADERPROGRAM_H_
 #define _ENGINE_GRAPHICS_SHADERPROGRAM_H_
 
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include <GL/glew.h>
 
+#include <Engine_Maths/Matrix4.h>
+#include <Engine_Maths/Vector3.h>
+#include <Engine_Maths/Vector4.h>
 #include <Engine_ResourceManagment/IMemoryManaged.h>
 #include <Engine_ResourceManagment/ResourceLookup.h>
 
@@ -23,6 +31,10 @@ namespace Graphics
    * @class ShaderProgram
    * @brief Encapsulation for a GL shader program.
    * @author Dan Nixon
+   *
+   * Uniform locations are resolved once when the program is linked. The last
+   * value written to each uniform is cached and writes of an unchanged value
+   * are skipped, all uniform writes must therefore go through setUniform.
    */
   class ShaderProgram : public Engine::ResourceManagment::IMemoryManaged
   {
@@ -33,6 +45,26 @@ namespace Graphics
      */
     static const size_t NUM_SHADERS = 5;
 
+    /**
+     * @brief Uniforms used by the engine, these are always at the start of
+     *        the uniform table so can be used directly as uniform indices.
+     */
+    enum Uniform
+    {
+      MODEL_MATRIX,       //!< "modelMatrix"
+      VIEW_MATRIX,        //!< "viewMatrix"
+      PROJECTION_MATRIX,  //!< "projMatrix"
+      CAMERA_POSITION,    //!< "cameraPos"
+      AMBIENT_COLOUR,     //!< "ambientColour"
+      DIFFUSE_COLOUR,     //!< "diffuseColour"
+      SPECULAR_COLOUR,    //!< "specularColour"
+      AMBIENT_STRENGTH,   //!< "ambientStrength"
+      SHININESS,          //!< "shininess"
+      SHININESS_STRENGTH, //!< "shininessStrength"
+
+      NUM_UNIFORMS
+    };
+
     ShaderProgram();
     ~ShaderProgram();
 
@@ -48,6 +80,33 @@ namespace Graphics
 
     bool link();
 
+    void use();
+
+    /**
+     * @brief Marks the start of use of this program in a rendering pass.
+     * @param pass Unique ID of the pass
+     * @return True if this is the first use of the program in the pass
+     *
+     * Used to set uniforms that are constant over a pass (view, projection,
+     * lights, etc.) once per program rather than once per object.
+     */
+    inline bool beginPass(uint64_t pass)
+    {
+      if (pass == m_pass)
+        return false;
+
+      m_pass = pass;
+      return true;
+    }
+
+    int uniformIndex(const std::string &name) const;
+
+    void setUniform(int index, int value);
+    void setUniform(int index, float value);
+    void setUniform(int index, const Engine::Maths::Vector3 &value);
+    void setUniform(int index, const Engine::Maths::Vector4 &value);
+    void setUniform(int index, const Engine::Maths::Matrix4 &value);
+
     /**
      * @brief Gets the GL program.
      * @return GL shader program
@@ -69,10 +128,42 @@ namespace Graphics
       return m_valid;
     }
 
+    /**
+     * @brief Tests if the program reads per instance data and must be drawn
+     *        with instanced draws.
+     * @return True if instanced
+     * @see InstanceBuffer
+     */
+    inline bool instanced() const
+    {
+      return m_instanced;
+    }
+
   private:
+    /**
+     * @struct UniformSlot
+     * @brief Entry in the uniform table.
+     */
+    struct UniformSlot
+    {
+      GLint location; //!< Uniform location (-1 if not in the program)
+      GLenum type;    //!< GL type of the uniform
+      size_t offset;  //!< Offset of the cached value in m_uniformValues
+      size_t size;    //!< Size of the cached value in bytes
+    };
+
+    void buildUniformTable();
+    bool updateUniform(int index, const void *value, size_t size);
+
     GLuint m_program;               //!< GL shader program
     Shader *m_shaders[NUM_SHADERS]; //!< Array of Shaders in program
     bool m_valid;                   //!< Flag indicating validity of program
+    bool m_instanced;               //!< Flag indicating the program reads instance attributes
+    uint64_t m_pass;                //!< ID of the last pass the program was used in
+
+    std::vector<UniformSlot> m_uniforms;                  //!< Uniform table
+    std::unordered_map<std::string, int> m_uniformLookup; //!< Map of uniform name to index in m_uniforms
+    std::vector<char> m_uniformValues;                    //!< Last values written to each uniform
   };
 
   /**
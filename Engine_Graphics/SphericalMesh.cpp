@@ -7,6 +7,7 @@
 
 #include "SphericalMesh.h"
 
+#include <Engine_Maths/TransformBatch.h>
 #include <Engine_Maths/Vector3.h>
 
 using namespace Engine::Maths;
@@ -78,7 +79,6 @@ namespace Graphics
   void SphericalMesh::updateMesh(float radius)
   {
     m_radius = radius;
-    m_boundingBox.reset();
 
     // Generate vertex positions
     int n = 0;
@@ -93,16 +93,15 @@ namespace Graphics
 
         m_vertices[n] =
             Vector3(cos(theta1) * sin(phi) * m_radius, sin(theta1) * sin(phi) * m_radius, cos(phi) * m_radius);
-        m_boundingBox.resizeByPoint(m_vertices[n]);
         n++;
 
         m_vertices[n] =
             Vector3(cos(theta2) * sin(phi) * m_radius, sin(theta2) * sin(phi) * m_radius, cos(phi) * m_radius);
-        m_boundingBox.resizeByPoint(m_vertices[n]);
         n++;
       }
     }
 
+    m_boundingBox = TransformBatch::Bounds(m_numVertices, m_vertices);
     bufferData();
   }
 }
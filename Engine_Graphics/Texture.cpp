@@ -8,10 +8,15 @@
 #include "Texture.h"
 
 #include <algorithm>
+#include <memory>
 
 #include <Engine_Utility/StringUtils.h>
 
+#include "GLContext.h"
+#include "GLState.h"
+
 using namespace Engine::Maths;
+using namespace Engine::ResourceManagment;
 using namespace Engine::Utility;
 
 namespace Engine
@@ -27,6 +32,7 @@ namespace Graphics
   Texture::Texture(const std::string &name)
       : m_name(name)
       , m_texture(0)
+      , m_sdlSurface(nullptr)
       , m_size(0.0f, 0.0f)
   {
   }
@@ -34,22 +40,108 @@ namespace Graphics
   Texture::~Texture()
   {
     glDeleteTextures(1, &m_texture);
+    GLState::InvalidateTextures();
 
     if (m_sdlSurface)
       SDL_FreeSurface(m_sdlSurface);
   }
 
+  /**
+   * @brief Creates empty image data.
+   */
+  ImageData::ImageData()
+      : pixels(nullptr)
+      , width(0)
+      , height(0)
+      , channels(0)
+  {
+  }
+
+  ImageData::~ImageData()
+  {
+    if (pixels != nullptr)
+      SOIL_free_image_data(pixels);
+  }
+
+  /**
+   * @brief Decodes an image file into memory.
+   * @param filename Image file to load
+   * @param image Image data to populate
+   * @return True if the image was decoded
+   *
+   * Does not require a GL context so may be called from any thread.
+   */
+  bool Texture::DecodeImage(const std::string &filename, ImageData &image)
+  {
+    if (image.pixels != nullptr)
+      SOIL_free_image_data(image.pixels);
+
+    image.pixels = SOIL_load_image(filename.c_str(), &image.width, &image.height, &image.channels, SOIL_LOAD_AUTO);
+    return (image.pixels != nullptr);
+  }
+
   /**
    * @brief Loads an image file into a GL texture.
    * @param filename Image file to load
-   * @return GL texture, 0 if loading failed
+   * @return GL texture, 0 if loading failed (or there is no GL context)
    */
   bool Texture::load(const std::string &filename)
   {
-    m_texture = SOIL_load_OGL_texture(filename.c_str(), SOIL_LOAD_AUTO, SOIL_CREATE_NEW_ID, SOIL_FLAG_MIPMAPS);
+    // SOIL queries GL extensions, which requires a context
+    if (!GLContext::Available())
+      return false;
+
+    ImageData image;
+    if (!DecodeImage(filename, image))
+      return false;
+
+    return upload(image);
+  }
+
+  /**
+   * @brief Creates the GL texture from decoded image data.
+   * @param image Image data
+   * @return True if the texture was created (false if there is no GL
+   *         context)
+   */
+  bool Texture::upload(const ImageData &image)
+  {
+    if (!GLContext::Available() || image.pixels == nullptr)
+      return false;
+
+    if (m_texture != 0)
+      glDeleteTextures(1, &m_texture);
+
+    m_texture = SOIL_create_OGL_texture(image.pixels, image.width, image.height, image.channels, SOIL_CREATE_NEW_ID,
+                                        SOIL_FLAG_MIPMAPS);
+
+    // SOIL binds the texture directly
+    GLState::InvalidateTextures();
+
     return (m_texture != 0);
   }
 
+  /**
+   * @brief Queues an image file to be decoded on a worker thread and
+   *        uploaded into this texture.
+   * @param loader Loader to queue with
+   * @param filename Image file to load
+   * @param callback Function called once the load has completed (may be
+   *                 empty)
+   * @return Future holding the result of the load
+   *
+   * The texture must not be deleted before the load completes. Until then
+   * it is not valid and is not used in rendering.
+   */
+  std::shared_future<bool> Texture::queueLoad(ResourceLoader &loader, const std::string &filename,
+                                              ResourceLoader::CompletionCallback callback)
+  {
+    std::shared_ptr<ImageData> image = std::make_shared<ImageData>();
+
+    return loader.queue(filename, [filename, image]() { return DecodeImage(filename, *image); },
+                        [this, image]() { return upload(*image); }, callback);
+  }
+
   /**
    * @brief Generates a texture with text.
    * @param text Text to display
@@ -144,6 +236,7 @@ namespace Graphics
     m_size = Vector2((float)m_sdlSurface->w, (float)m_sdlSurface->h);
 
     glBindTexture(GL_TEXTURE_2D, 0);
+    GLState::InvalidateTextures();
 
     return subStrings.size();
   }
@@ -159,17 +252,16 @@ namespace Graphics
 
   /**
    * @brief Use the texture in rendering.
-   * @param shaderProgram Shader program used in rendering
+   * @param shaderProgram Shader program used in rendering (already in use)
    * @param idx Index of this testure in rendering
    */
-  void Texture::use(GLuint shaderProgram, int idx) const
+  void Texture::use(ShaderProgram *shaderProgram, int idx) const
   {
     if (m_texture == 0)
       return;
 
-    glUniform1i(glGetUniformLocation(shaderProgram, m_name.c_str()), idx);
-    glActiveTexture(GL_TEXTURE0 + idx);
-    glBindTexture(GL_TEXTURE_2D, m_texture);
+    shaderProgram->setUniform(shaderProgram->uniformIndex(m_name), idx);
+    GLState::BindTexture(idx, m_texture);
   }
 }
 }
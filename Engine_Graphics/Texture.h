@@ -8,6 +8,7 @@
 #ifndef _ENGINE_GRAPHICS_TEXTURE_H_
 #define _ENGINE_GRAPHICS_TEXTURE_H_
 
+#include <future>
 #include <string>
 
 #include <GL/glew.h>
@@ -17,9 +18,11 @@
 #include <Engine_Maths/Vector2.h>
 #include <Engine_Maths/Vector4.h>
 #include <Engine_ResourceManagment/IMemoryManaged.h>
+#include <Engine_ResourceManagment/ResourceLoader.h>
 #include <Engine_ResourceManagment/ResourceLookup.h>
 
 #include "Colour.h"
+#include "ShaderProgram.h"
 
 namespace Engine
 {
@@ -40,6 +43,31 @@ namespace Graphics
     SHADED
   };
 
+  /**
+   * @struct ImageData
+   * @brief Decoded image pixels, as produced by Texture::DecodeImage.
+   */
+  struct ImageData
+  {
+    ImageData();
+    ~ImageData();
+
+    /**
+     * @brief No copy constructor
+     */
+    ImageData(ImageData const &) = delete;
+
+    /**
+     * @brief No assign copy constructor
+     */
+    ImageData &operator=(ImageData const &) = delete;
+
+    unsigned char *pixels; //!< Pixel data
+    int width;             //!< Width in pixels
+    int height;            //!< Height in pixels
+    int channels;          //!< Number of channels per pixel
+  };
+
   /**
    * @class Texture
    * @brief Encapsulates a GL texture and image loading.
@@ -51,12 +79,19 @@ namespace Graphics
     Texture(const std::string &name = "tex");
     virtual ~Texture();
 
+    static bool DecodeImage(const std::string &filename, ImageData &image);
+
     bool load(const std::string &filename);
+    bool upload(const ImageData &image);
+    std::shared_future<bool> queueLoad(Engine::ResourceManagment::ResourceLoader &loader, const std::string &filename,
+                                       Engine::ResourceManagment::ResourceLoader::CompletionCallback callback =
+                                           nullptr);
+
     size_t text(const std::string &text, TTF_Font *font, const Colour &fgColour = Colour(),
                 TextMode mode = TextMode::BLENDED, const Colour &bgColour = Colour(0.0f, 0.0f, 0.0f, 1.0f));
 
     bool valid() const;
-    void use(GLuint shaderProgram, int idx) const;
+    void use(ShaderProgram *shaderProgram, int idx) const;
 
     /**
      * @brief Gets the GL texture for use in rendering.
@@ -0,0 +1,311 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include "VertexFormat.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace Engine::Maths;
+
+namespace
+{
+/**
+ * @brief Converts a float in the range [min, max] to a rounded integer
+ *        scaled by a given factor.
+ * @param value Value to convert (clamped to [min, max])
+ * @param min Lower bound
+ * @param max Upper bound
+ * @param scale Scale factor
+ * @return Scaled and rounded value
+ */
+int32_t Quantise(float value, float min, float max, float scale)
+{
+  if (!(value > min))
+    value = min;
+  else if (value > max)
+    value = max;
+
+  return (int32_t)std::floor(value * scale + 0.5f);
+}
+}
+
+namespace Engine
+{
+namespace Graphics
+{
+  /**
+   * @brief Converts a single precision float to a half float.
+   * @param value Value to convert
+   * @return Half float (rounded to nearest, overflowing to infinity)
+   */
+  uint16_t VertexFormat::FloatToHalf(float value)
+  {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    const uint16_t sign = (uint16_t)((bits >> 16) & 0x8000);
+    const uint32_t exponent = (bits >> 23) & 0xFF;
+    uint32_t mantissa = bits & 0x7FFFFF;
+
+    // Infinity and NaN
+    if (exponent == 0xFF)
+      return sign | 0x7C00 | (mantissa ? 0x200 : 0);
+
+    const int32_t halfExponent = (int32_t)exponent - 127 + 15;
+
+    // Overflow
+    if (halfExponent >= 0x1F)
+      return sign | 0x7C00;
+
+    // Subnormal or underflow
+    if (halfExponent <= 0)
+    {
+      if (halfExponent < -10)
+        return sign;
+
+      mantissa |= 0x800000;
+      const uint32_t shift = (uint32_t)(14 - halfExponent);
+      uint16_t half = (uint16_t)(mantissa >> shift);
+      if ((mantissa >> (shift - 1)) & 1)
+        half++;
+
+      return sign | half;
+    }
+
+    // Rounding may carry into the exponent, which gives the correct result
+    uint16_t half = (uint16_t)(sign | (halfExponent << 10) | (mantissa >> 13));
+    if (mantissa & 0x1000)
+      half++;
+
+    return half;
+  }
+
+  /**
+   * @brief Converts a half float to a single precision float.
+   * @param value Half float to convert
+   * @return Value as float
+   */
+  float VertexFormat::HalfToFloat(uint16_t value)
+  {
+    const uint32_t sign = (uint32_t)(value & 0x8000) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1F;
+    const uint32_t mantissa = value & 0x3FF;
+
+    uint32_t bits;
+
+    if (exponent == 0)
+    {
+      // Zero or subnormal
+      float f = std::ldexp((float)mantissa, -24);
+      return sign ? -f : f;
+    }
+    else if (exponent == 0x1F)
+    {
+      // Infinity or NaN
+      bits = sign | 0x7F800000 | (mantissa << 13);
+    }
+    else
+    {
+      bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+    }
+
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+  }
+
+  /**
+   * @brief Packs a normal into the GL_INT_2_10_10_10_REV format.
+   * @param normal Normal to pack (components are clamped to [-1, 1])
+   * @return Packed normal (w component is zero)
+   */
+  uint32_t VertexFormat::PackNormal(const Vector3 &normal)
+  {
+    uint32_t packed = 0;
+    for (size_t i = 0; i < 3; i++)
+      packed |= ((uint32_t)Quantise(normal[i], -1.0f, 1.0f, 511.0f) & 0x3FF) << (i * 10);
+
+    return packed;
+  }
+
+  /**
+   * @brief Unpacks a normal packed by PackNormal.
+   * @param value Packed normal
+   * @return Normal
+   */
+  Vector3 VertexFormat::UnpackNormal(uint32_t value)
+  {
+    Vector3 normal;
+    for (size_t i = 0; i < 3; i++)
+    {
+      int32_t component = (int32_t)((value >> (i * 10)) & 0x3FF);
+      if (component & 0x200)
+        component -= 0x400;
+
+      normal[i] = std::max((float)component / 511.0f, -1.0f);
+    }
+
+    return normal;
+  }
+
+  /**
+   * @brief Creates a format holding only vertex positions.
+   */
+  VertexFormat::VertexFormat()
+      : VertexFormat(false, false, false)
+  {
+  }
+
+  /**
+   * @brief Creates a new vertex format.
+   * @param colours If vertices have colours
+   * @param textureCoords If vertices have texture coordinates
+   * @param normals If vertices have normals
+   * @param encoding Compact encodings to use (combination of Encoding flags)
+   */
+  VertexFormat::VertexFormat(bool colours, bool textureCoords, bool normals, unsigned int encoding)
+      : m_stride(0)
+      , m_key(0)
+  {
+    for (size_t i = 0; i < INDEX_BUFFER; i++)
+    {
+      m_attributes[i].enabled = false;
+      m_attributes[i].components = 0;
+      m_attributes[i].type = GL_FLOAT;
+      m_attributes[i].normalised = GL_FALSE;
+      m_attributes[i].offset = 0;
+    }
+
+    addAttribute(VERTEX_BUFFER, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float));
+
+    if (colours)
+    {
+      if (encoding & ENCODE_COMPACT_COLOURS)
+        addAttribute(COLOUR_BUFFER, 4, GL_UNSIGNED_BYTE, GL_TRUE, 4 * sizeof(uint8_t));
+      else
+        addAttribute(COLOUR_BUFFER, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float));
+    }
+
+    if (textureCoords)
+    {
+      if (encoding & ENCODE_COMPACT_TEXTURE_COORDS)
+        addAttribute(TEXTURE_BUFFER, 2, GL_HALF_FLOAT, GL_FALSE, 2 * sizeof(uint16_t));
+      else
+        addAttribute(TEXTURE_BUFFER, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float));
+    }
+
+    if (normals)
+    {
+      if (encoding & ENCODE_COMPACT_NORMALS)
+        addAttribute(NORMAL_BUFFER, 4, GL_INT_2_10_10_10_REV, GL_TRUE, sizeof(uint32_t));
+      else
+        addAttribute(NORMAL_BUFFER, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float));
+    }
+  }
+
+  /**
+   * @brief Packs a range of vertices into interleaved form.
+   * @param out Output buffer (must hold count * stride() bytes)
+   * @param first Index of first vertex to pack
+   * @param count Number of vertices to pack
+   * @param vertices Vertex positions
+   * @param colours Vertex colours (required if the format has colours)
+   * @param textureCoords Texture coordinates (required if the format has
+   *                      texture coordinates)
+   * @param normals Normals (required if the format has normals)
+   */
+  void VertexFormat::pack(char *out, size_t first, size_t count, const Vector3 *vertices, const Colour *colours,
+                          const Vector2 *textureCoords, const Vector3 *normals) const
+  {
+    const VertexAttribute &colourAttr = m_attributes[COLOUR_BUFFER];
+    const VertexAttribute &textureAttr = m_attributes[TEXTURE_BUFFER];
+    const VertexAttribute &normalAttr = m_attributes[NORMAL_BUFFER];
+
+    for (size_t i = first; i < first + count; i++, out += m_stride)
+    {
+      float position[] = {vertices[i][0], vertices[i][1], vertices[i][2]};
+      memcpy(out, position, sizeof(position));
+
+      if (colourAttr.enabled)
+      {
+        const Colour &c = colours[i];
+
+        if (colourAttr.type == GL_UNSIGNED_BYTE)
+        {
+          for (size_t j = 0; j < 4; j++)
+            out[colourAttr.offset + j] = (char)(uint8_t)Quantise(c[j], 0.0f, 1.0f, 255.0f);
+        }
+        else
+        {
+          float colour[] = {c[0], c[1], c[2], c[3]};
+          memcpy(out + colourAttr.offset, colour, sizeof(colour));
+        }
+      }
+
+      if (textureAttr.enabled)
+      {
+        const Vector2 &t = textureCoords[i];
+
+        if (textureAttr.type == GL_HALF_FLOAT)
+        {
+          uint16_t coords[] = {FloatToHalf(t[0]), FloatToHalf(t[1])};
+          memcpy(out + textureAttr.offset, coords, sizeof(coords));
+        }
+        else
+        {
+          float coords[] = {t[0], t[1]};
+          memcpy(out + textureAttr.offset, coords, sizeof(coords));
+        }
+      }
+
+      if (normalAttr.enabled)
+      {
+        const Vector3 &n = normals[i];
+
+        if (normalAttr.type == GL_INT_2_10_10_10_REV)
+        {
+          uint32_t normal = PackNormal(n);
+          memcpy(out + normalAttr.offset, &normal, sizeof(normal));
+        }
+        else
+        {
+          float normal[] = {n[0], n[1], n[2]};
+          memcpy(out + normalAttr.offset, normal, sizeof(normal));
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Appends an attribute to the vertex layout.
+   * @param attribute Attribute
+   * @param components Number of components
+   * @param type Type of each component
+   * @param normalised If integer components are normalised
+   * @param size Size of the attribute (bytes)
+   */
+  void VertexFormat::addAttribute(MeshBuffer attribute, GLint components, GLenum type, GLboolean normalised,
+                                  size_t size)
+  {
+    VertexAttribute &attr = m_attributes[attribute];
+    attr.enabled = true;
+    attr.components = components;
+    attr.type = type;
+    attr.normalised = normalised;
+    attr.offset = m_stride;
+
+    m_stride += size;
+
+    // Record the attribute and whether it is compact
+    m_key |= 1 << (attribute * 2);
+    if (type != GL_FLOAT)
+      m_key |= 2 << (attribute * 2);
+  }
+}
+}
@@ -0,0 +1,145 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#ifndef _ENGINE_GRAPHICS_VERTEXFORMAT_H_
+#define _ENGINE_GRAPHICS_VERTEXFORMAT_H_
+
+#include <cstdint>
+
+#include <GL/glew.h>
+
+#include <Engine_Maths/Vector2.h>
+#include <Engine_Maths/Vector3.h>
+
+#include "Colour.h"
+
+namespace Engine
+{
+namespace Graphics
+{
+  /**
+   * @enum MeshBuffer
+   * @brief Describes the type of data held in a buffer (also used as the
+   *        vertex attribute index).
+   */
+  enum MeshBuffer
+  {
+    VERTEX_BUFFER = 0,
+    COLOUR_BUFFER = 1,
+    TEXTURE_BUFFER,
+    NORMAL_BUFFER,
+    TANGENT_BUFFER,
+    INDEX_BUFFER,
+    MAX_BUFFER
+  };
+
+  /**
+   * @struct VertexAttribute
+   * @brief Describes where and how a vertex attribute is stored in an
+   *        interleaved vertex.
+   */
+  struct VertexAttribute
+  {
+    bool enabled;         //!< Flag indicating the attribute is present
+    GLint components;     //!< Number of components
+    GLenum type;          //!< Type of each component
+    GLboolean normalised; //!< Flag indicating integer components are normalised
+    size_t offset;        //!< Offset from the start of the vertex (bytes)
+  };
+
+  /**
+   * @class VertexFormat
+   * @brief Describes the layout of vertices in a single interleaved vertex
+   *        buffer and packs vertex streams into it.
+   * @author Dan Nixon
+   *
+   * Positions are always stored as three floats. Colours, texture
+   * coordinates and normals are optional and can each be stored in a compact
+   * encoding:
+   *  - colours as four normalised unsigned bytes
+   *  - texture coordinates as two half floats
+   *  - normals as a signed normalised GL_INT_2_10_10_10_REV
+   *
+   * Packing does not use GL, so it may be done without a context.
+   */
+  class VertexFormat
+  {
+  public:
+    /**
+     * @enum Encoding
+     * @brief Flags selecting compact encodings of attributes.
+     */
+    enum Encoding
+    {
+      ENCODE_FULL = 0,                   //!< All attributes stored as floats
+      ENCODE_COMPACT_COLOURS = 1,        //!< Colours stored as normalised bytes
+      ENCODE_COMPACT_TEXTURE_COORDS = 2, //!< Texture coordinates stored as half floats
+      ENCODE_COMPACT_NORMALS = 4,        //!< Normals stored as packed 10 bit integers
+      ENCODE_COMPACT = 7                 //!< All compact encodings
+    };
+
+    static uint16_t FloatToHalf(float value);
+    static float HalfToFloat(uint16_t value);
+    static uint32_t PackNormal(const Engine::Maths::Vector3 &normal);
+    static Engine::Maths::Vector3 UnpackNormal(uint32_t value);
+
+    VertexFormat();
+    VertexFormat(bool colours, bool textureCoords, bool normals, unsigned int encoding = ENCODE_FULL);
+
+    /**
+     * @brief Checks if two formats have the same layout.
+     * @param other Format to compare to
+     * @return True if layouts are equal
+     */
+    inline bool operator==(const VertexFormat &other) const
+    {
+      return m_stride == other.m_stride && m_key == other.m_key;
+    }
+
+    /**
+     * @brief Checks if two formats have different layouts.
+     * @param other Format to compare to
+     * @return True if layouts differ
+     */
+    inline bool operator!=(const VertexFormat &other) const
+    {
+      return !(*this == other);
+    }
+
+    /**
+     * @brief Gets the size of a single vertex.
+     * @return Stride in bytes
+     */
+    inline size_t stride() const
+    {
+      return m_stride;
+    }
+
+    /**
+     * @brief Gets the description of an attribute.
+     * @param attribute Attribute
+     * @return Attribute description (not enabled for INDEX_BUFFER and above)
+     */
+    inline const VertexAttribute &attribute(MeshBuffer attribute) const
+    {
+      return m_attributes[attribute < INDEX_BUFFER ? attribute : TANGENT_BUFFER];
+    }
+
+    void pack(char *out, size_t first, size_t count, const Engine::Maths::Vector3 *vertices, const Colour *colours,
+              const Engine::Maths::Vector2 *textureCoords, const Engine::Maths::Vector3 *normals) const;
+
+  private:
+    void addAttribute(MeshBuffer attribute, GLint components, GLenum type, GLboolean normalised, size_t size);
+
+    VertexAttribute m_attributes[INDEX_BUFFER]; //!< Description of each attribute
+    size_t m_stride;                            //!< Size of a vertex (bytes)
+    unsigned int m_key;                         //!< Enabled attributes and encodings (used for comparison)
+  };
+}
+}
+
+#endif
@@ -0,0 +1,116 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include <CppUnitTest.h>
+
+#include <Engine_Graphics/DirtyRanges.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+/**
+ * @brief Checks that a range has the expected bounds.
+ * @param range Range to check
+ * @param begin Expected first element
+ * @param end Expected element past the end
+ */
+void CheckRange(const Engine::Graphics::DirtyRanges::Range &range, size_t begin, size_t end)
+{
+  Assert::AreEqual(begin, range.begin);
+  Assert::AreEqual(end, range.end);
+}
+}
+
+// clang-format off
+namespace Engine
+{
+namespace Graphics
+{
+namespace Test
+{
+#ifndef DOXYGEN_SKIP
+TEST_CLASS(DirtyRangesTest)
+{
+public:
+  TEST_METHOD(DirtyRanges_Empty)
+  {
+    DirtyRanges r;
+    Assert::IsTrue(r.empty());
+    Assert::AreEqual((size_t) 0, r.size());
+    Assert::AreEqual((size_t) 0, r.numElements());
+
+    r.add(10, 0);
+    Assert::IsTrue(r.empty());
+  }
+
+  TEST_METHOD(DirtyRanges_Add_Sorted)
+  {
+    DirtyRanges r;
+    r.add(20, 5);
+    r.add(0, 2);
+    r.add(10, 3);
+
+    Assert::AreEqual((size_t) 3, r.size());
+    CheckRange(r[0], 0, 2);
+    CheckRange(r[1], 10, 13);
+    CheckRange(r[2], 20, 25);
+    Assert::AreEqual((size_t) 10, r.numElements());
+
+    r.clear();
+    Assert::IsTrue(r.empty());
+  }
+
+  TEST_METHOD(DirtyRanges_Add_Merge)
+  {
+    DirtyRanges r;
+    r.add(0, 2);
+    r.add(10, 3);
+    r.add(20, 5);
+
+    // Adjacent
+    r.add(2, 1);
+    Assert::AreEqual((size_t) 3, r.size());
+    CheckRange(r[0], 0, 3);
+
+    // Overlapping
+    r.add(12, 2);
+    Assert::AreEqual((size_t) 3, r.size());
+    CheckRange(r[1], 10, 14);
+
+    // Contained
+    r.add(21, 2);
+    Assert::AreEqual((size_t) 3, r.size());
+    CheckRange(r[2], 20, 25);
+
+    // Spanning several ranges
+    r.add(1, 19);
+    Assert::AreEqual((size_t) 1, r.size());
+    CheckRange(r[0], 0, 25);
+  }
+
+  TEST_METHOD(DirtyRanges_Add_Limit)
+  {
+    DirtyRanges r;
+
+    // Gaps of 9 elements, except a gap of 2 between the third and fourth
+    for (size_t i = 0; i < DirtyRanges::MAX_RANGES; i++)
+      r.add(i * 10 + (i >= 3 ? 0 : 7), 1);
+
+    Assert::AreEqual((size_t) DirtyRanges::MAX_RANGES, r.size());
+
+    // Adding another range merges the closest pair
+    r.add(1000, 1);
+    Assert::AreEqual((size_t) DirtyRanges::MAX_RANGES, r.size());
+    CheckRange(r[2], 27, 31);
+    CheckRange(r[DirtyRanges::MAX_RANGES - 1], 1000, 1001);
+  }
+};
+#endif /* DOXYGEN_SKIP */
+}
+}
+}
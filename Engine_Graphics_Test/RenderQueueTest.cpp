@@ -0,0 +1,222 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include <CppUnitTest.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include <Engine_Graphics/RenderQueue.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+/**
+ * @brief Gets a distinct object pointer for use in packets (never
+ *        dereferenced).
+ * @param idx Object index
+ * @return Object pointer
+ */
+Engine::Graphics::RenderableObject *Object(size_t idx)
+{
+  static char objects[64];
+  return reinterpret_cast<Engine::Graphics::RenderableObject *>(&objects[idx]);
+}
+
+/**
+ * @brief Compares two packets by key.
+ * @param a First packet
+ * @param b Second packet
+ * @return True if a has a lower key than b
+ */
+bool KeyLess(const Engine::Graphics::RenderQueue::Packet &a, const Engine::Graphics::RenderQueue::Packet &b)
+{
+  return a.key < b.key;
+}
+}
+
+// clang-format off
+namespace Engine
+{
+namespace Graphics
+{
+namespace Test
+{
+#ifndef DOXYGEN_SKIP
+TEST_CLASS(RenderQueueTest)
+{
+public:
+  TEST_METHOD(RenderQueue_QuantiseDepth)
+  {
+    Assert::AreEqual((uint32_t) 0, RenderQueue::QuantiseDepth(-5.0f));
+    Assert::AreEqual((uint32_t) 0, RenderQueue::QuantiseDepth(0.0f));
+
+    uint32_t last = 0;
+    for (float d = 0.001f; d < 100000.0f; d *= 1.5f)
+    {
+      uint32_t q = RenderQueue::QuantiseDepth(d);
+      Assert::IsTrue(q > last);
+      Assert::IsTrue(q < (1u << RenderQueue::DEPTH_BITS));
+      last = q;
+    }
+  }
+
+  TEST_METHOD(RenderQueue_Keys_Opaque)
+  {
+    // Opaque before transparent
+    Assert::IsTrue(RenderQueue::OpaqueKey(4095, 4095, 16383, 1e30f) < RenderQueue::TransparentKey(0.0f));
+    Assert::AreEqual((int) RenderQueue::OPAQUE_PASS, (int) RenderQueue::KeyPass(RenderQueue::OpaqueKey(1, 2, 3, 4.0f)));
+
+    // State takes priority over depth
+    Assert::IsTrue(RenderQueue::OpaqueKey(1, 5, 5, 100.0f) < RenderQueue::OpaqueKey(2, 0, 0, 1.0f));
+    Assert::IsTrue(RenderQueue::OpaqueKey(1, 1, 5, 100.0f) < RenderQueue::OpaqueKey(1, 2, 0, 1.0f));
+    Assert::IsTrue(RenderQueue::OpaqueKey(1, 1, 1, 100.0f) < RenderQueue::OpaqueKey(1, 1, 2, 1.0f));
+
+    // Front to back within state
+    Assert::IsTrue(RenderQueue::OpaqueKey(1, 1, 1, 1.0f) < RenderQueue::OpaqueKey(1, 1, 1, 2.0f));
+  }
+
+  TEST_METHOD(RenderQueue_Keys_Transparent)
+  {
+    Assert::AreEqual((int) RenderQueue::TRANSPARENT_PASS, (int) RenderQueue::KeyPass(RenderQueue::TransparentKey(4.0f)));
+
+    // Back to front
+    Assert::IsTrue(RenderQueue::TransparentKey(10.0f) < RenderQueue::TransparentKey(1.0f));
+    Assert::IsTrue(RenderQueue::TransparentKey(1.0f) < RenderQueue::TransparentKey(-1.0f));
+    Assert::AreEqual(RenderQueue::TransparentKey(3.0f), RenderQueue::TransparentKey(3.0f));
+  }
+
+  TEST_METHOD(RenderQueue_ResourceID)
+  {
+    RenderQueue q;
+    int a, b;
+
+    Assert::AreEqual((uint32_t) 0, q.resourceID(RenderQueue::SHADER_RESOURCE, nullptr));
+
+    uint32_t idA = q.resourceID(RenderQueue::SHADER_RESOURCE, &a);
+    uint32_t idB = q.resourceID(RenderQueue::SHADER_RESOURCE, &b);
+    Assert::AreNotEqual((uint32_t) 0, idA);
+    Assert::AreNotEqual(idA, idB);
+    Assert::AreEqual(idA, q.resourceID(RenderQueue::SHADER_RESOURCE, &a));
+
+    // IDs are assigned separately for each resource type
+    Assert::AreEqual((uint32_t) 1, q.resourceID(RenderQueue::MESH_RESOURCE, &b));
+  }
+
+  TEST_METHOD(RenderQueue_ResourceID_Limit)
+  {
+    RenderQueue q;
+    static char resources[20000];
+
+    // IDs of each type fit in the bits the key has for them
+    for (size_t i = 0; i < 20000; i++)
+    {
+      uint32_t shader = q.resourceID(RenderQueue::SHADER_RESOURCE, &resources[i]);
+      uint32_t mesh = q.resourceID(RenderQueue::MESH_RESOURCE, &resources[i]);
+      Assert::IsTrue(shader > 0 && shader < (1u << RenderQueue::SHADER_BITS));
+      Assert::IsTrue(mesh > 0 && mesh < (1u << RenderQueue::MESH_BITS));
+    }
+
+    // IDs are reassigned from 1 once the limit is reached
+    RenderQueue r;
+    for (size_t i = 0; i < (1 << RenderQueue::TEXTURE_BITS) - 1; i++)
+      Assert::AreEqual((uint32_t) i + 1, r.resourceID(RenderQueue::TEXTURE_RESOURCE, &resources[i]));
+
+    Assert::AreEqual((uint32_t) 1, r.resourceID(RenderQueue::TEXTURE_RESOURCE, &resources[4095]));
+    Assert::AreEqual((uint32_t) 2, r.resourceID(RenderQueue::TEXTURE_RESOURCE, &resources[0]));
+  }
+
+  TEST_METHOD(RenderQueue_Sort)
+  {
+    RenderQueue q;
+    q.push(RenderQueue::TransparentKey(1.0f), Object(0));
+    q.push(RenderQueue::OpaqueKey(2, 1, 1, 5.0f), Object(1));
+    q.push(RenderQueue::TransparentKey(8.0f), Object(2));
+    q.push(RenderQueue::OpaqueKey(1, 1, 1, 9.0f), Object(3));
+    q.push(RenderQueue::OpaqueKey(1, 1, 1, 2.0f), Object(4));
+
+    q.sort();
+
+    Assert::AreEqual((size_t) 5, q.size());
+    Assert::IsTrue(Object(4) == q[0].object);
+    Assert::IsTrue(Object(3) == q[1].object);
+    Assert::IsTrue(Object(1) == q[2].object);
+    Assert::IsTrue(Object(2) == q[3].object);
+    Assert::IsTrue(Object(0) == q[4].object);
+
+    q.clear();
+    Assert::AreEqual((size_t) 0, q.size());
+  }
+
+  TEST_METHOD(RenderQueue_Sort_Stable)
+  {
+    RenderQueue q;
+    for (size_t i = 0; i < 10; i++)
+      q.push(RenderQueue::TransparentKey((float) (i % 2)), Object(i));
+
+    q.sort();
+
+    // Farther objects first, each in the order they were queued
+    for (size_t i = 0; i < 5; i++)
+    {
+      Assert::IsTrue(Object(i * 2 + 1) == q[i].object);
+      Assert::IsTrue(Object(i * 2) == q[i + 5].object);
+    }
+  }
+
+  TEST_METHOD(RenderQueue_Sort_PassOnly)
+  {
+    RenderQueue q;
+    for (size_t i = 0; i < 10; i++)
+      q.push(RenderQueue::PassKey(i % 3 == 0 ? RenderQueue::TRANSPARENT_PASS : RenderQueue::OPAQUE_PASS), Object(i));
+
+    q.sort();
+
+    // Opaque draws first, then transparent draws, each in the order they
+    // were queued
+    const size_t expected[] = {1, 2, 4, 5, 7, 8, 0, 3, 6, 9};
+    for (size_t i = 0; i < 10; i++)
+    {
+      Assert::IsTrue(Object(expected[i]) == q[i].object);
+      Assert::AreEqual((int) (i < 6 ? RenderQueue::OPAQUE_PASS : RenderQueue::TRANSPARENT_PASS),
+                       (int) RenderQueue::KeyPass(q[i].key));
+    }
+  }
+
+  TEST_METHOD(RenderQueue_Sort_Random)
+  {
+    RenderQueue q;
+    std::vector<RenderQueue::Packet> expected;
+
+    srand(42);
+    for (size_t i = 0; i < 1000; i++)
+    {
+      uint64_t key = ((uint64_t) rand() << 48) ^ ((uint64_t) rand() << 24) ^ (uint64_t) rand();
+      q.push(key, Object(i % 64));
+
+      RenderQueue::Packet p;
+      p.key = key;
+      p.object = Object(i % 64);
+      expected.push_back(p);
+    }
+
+    q.sort();
+    std::stable_sort(expected.begin(), expected.end(), KeyLess);
+
+    for (size_t i = 0; i < expected.size(); i++)
+    {
+      Assert::AreEqual(expected[i].key, q[i].key);
+      Assert::IsTrue(expected[i].object == q[i].object);
+    }
+  }
+};
+#endif /* DOXYGEN_SKIP */
+}
+}
+}
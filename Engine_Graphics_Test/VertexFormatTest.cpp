@@ -0,0 +1,223 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include <CppUnitTest.h>
+
+#include <cstring>
+#include <vector>
+
+#include <Engine_Graphics/VertexFormat.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Engine::Maths;
+
+namespace
+{
+/**
+ * @brief Reads a value from a packed vertex buffer.
+ * @param data Packed buffer
+ * @param offset Offset of value (bytes)
+ * @return Value
+ */
+template <typename T> T Read(const std::vector<char> &data, size_t offset)
+{
+  T value;
+  memcpy(&value, data.data() + offset, sizeof(T));
+  return value;
+}
+}
+
+// clang-format off
+namespace Engine
+{
+namespace Graphics
+{
+namespace Test
+{
+#ifndef DOXYGEN_SKIP
+TEST_CLASS(VertexFormatTest)
+{
+public:
+  TEST_METHOD(VertexFormat_Layout_Full)
+  {
+    VertexFormat format(true, true, true);
+
+    Assert::AreEqual((size_t) 48, format.stride());
+
+    Assert::IsTrue(format.attribute(VERTEX_BUFFER).enabled);
+    Assert::AreEqual((size_t) 0, format.attribute(VERTEX_BUFFER).offset);
+
+    Assert::IsTrue(format.attribute(COLOUR_BUFFER).enabled);
+    Assert::AreEqual((size_t) 12, format.attribute(COLOUR_BUFFER).offset);
+    Assert::AreEqual((GLenum) GL_FLOAT, format.attribute(COLOUR_BUFFER).type);
+
+    Assert::IsTrue(format.attribute(TEXTURE_BUFFER).enabled);
+    Assert::AreEqual((size_t) 28, format.attribute(TEXTURE_BUFFER).offset);
+
+    Assert::IsTrue(format.attribute(NORMAL_BUFFER).enabled);
+    Assert::AreEqual((size_t) 36, format.attribute(NORMAL_BUFFER).offset);
+    Assert::AreEqual(3, format.attribute(NORMAL_BUFFER).components);
+
+    Assert::IsFalse(format.attribute(TANGENT_BUFFER).enabled);
+    Assert::IsFalse(format.attribute(INDEX_BUFFER).enabled);
+  }
+
+  TEST_METHOD(VertexFormat_Layout_Compact)
+  {
+    VertexFormat format(true, true, true, VertexFormat::ENCODE_COMPACT);
+
+    Assert::AreEqual((size_t) 24, format.stride());
+
+    Assert::AreEqual((size_t) 12, format.attribute(COLOUR_BUFFER).offset);
+    Assert::AreEqual((GLenum) GL_UNSIGNED_BYTE, format.attribute(COLOUR_BUFFER).type);
+    Assert::IsTrue(format.attribute(COLOUR_BUFFER).normalised == GL_TRUE);
+
+    Assert::AreEqual((size_t) 16, format.attribute(TEXTURE_BUFFER).offset);
+    Assert::AreEqual((GLenum) GL_HALF_FLOAT, format.attribute(TEXTURE_BUFFER).type);
+
+    Assert::AreEqual((size_t) 20, format.attribute(NORMAL_BUFFER).offset);
+    Assert::AreEqual((GLenum) GL_INT_2_10_10_10_REV, format.attribute(NORMAL_BUFFER).type);
+    Assert::AreEqual(4, format.attribute(NORMAL_BUFFER).components);
+  }
+
+  TEST_METHOD(VertexFormat_Layout_Missing)
+  {
+    VertexFormat format(false, true, false, VertexFormat::ENCODE_COMPACT);
+
+    Assert::AreEqual((size_t) 16, format.stride());
+    Assert::IsFalse(format.attribute(COLOUR_BUFFER).enabled);
+    Assert::IsFalse(format.attribute(NORMAL_BUFFER).enabled);
+    Assert::AreEqual((size_t) 12, format.attribute(TEXTURE_BUFFER).offset);
+  }
+
+  TEST_METHOD(VertexFormat_Compare)
+  {
+    Assert::IsTrue(VertexFormat() == VertexFormat(false, false, false, VertexFormat::ENCODE_COMPACT));
+    Assert::IsTrue(VertexFormat(true, true, true) == VertexFormat(true, true, true));
+    Assert::IsTrue(VertexFormat(true, true, true) != VertexFormat(true, true, false));
+    Assert::IsTrue(VertexFormat(true, true, true) != VertexFormat(true, true, true, VertexFormat::ENCODE_COMPACT_NORMALS));
+
+    // Encodings of missing attributes do not change the layout
+    Assert::IsTrue(VertexFormat(true, false, false, VertexFormat::ENCODE_COMPACT_COLOURS) ==
+                   VertexFormat(true, false, false, VertexFormat::ENCODE_COMPACT));
+  }
+
+  TEST_METHOD(VertexFormat_HalfFloat)
+  {
+    const float values[] = {0.0f, 1.0f, -1.0f, 0.5f, 0.25f, 2.0f, 65504.0f, 0.000060975552f};
+    for (size_t i = 0; i < sizeof(values) / sizeof(float); i++)
+      Assert::AreEqual(values[i], VertexFormat::HalfToFloat(VertexFormat::FloatToHalf(values[i])));
+
+    Assert::AreEqual((uint16_t) 0x3C00, VertexFormat::FloatToHalf(1.0f));
+    Assert::AreEqual((uint16_t) 0xC000, VertexFormat::FloatToHalf(-2.0f));
+
+    // Overflow and underflow
+    Assert::AreEqual((uint16_t) 0x7C00, VertexFormat::FloatToHalf(100000.0f));
+    Assert::AreEqual((uint16_t) 0x0000, VertexFormat::FloatToHalf(1e-10f));
+
+    // Subnormal
+    Assert::AreEqual((uint16_t) 0x0001, VertexFormat::FloatToHalf(5.9604645e-8f));
+
+    // Precision of texture coordinates in [0, 1]
+    for (int i = 0; i <= 1000; i++)
+    {
+      float f = i / 1000.0f;
+      Assert::AreEqual(f, VertexFormat::HalfToFloat(VertexFormat::FloatToHalf(f)), 0.0005f);
+    }
+  }
+
+  TEST_METHOD(VertexFormat_PackNormal)
+  {
+    Assert::AreEqual((uint32_t) 0x000001FF, VertexFormat::PackNormal(Vector3(1.0f, 0.0f, 0.0f)));
+    Assert::AreEqual((uint32_t) 0x00080400, VertexFormat::PackNormal(Vector3(0.0f, -1.0f, 0.0f)) & 0x000FFC00);
+
+    const Vector3 normals[] = {Vector3(1.0f, 0.0f, 0.0f), Vector3(0.0f, -1.0f, 0.0f), Vector3(0.0f, 0.0f, 1.0f),
+                               Vector3(0.577f, -0.577f, 0.577f), Vector3(-0.6f, 0.8f, 0.0f)};
+    for (size_t i = 0; i < sizeof(normals) / sizeof(Vector3); i++)
+    {
+      Vector3 n = VertexFormat::UnpackNormal(VertexFormat::PackNormal(normals[i]));
+      for (size_t j = 0; j < 3; j++)
+        Assert::AreEqual(normals[i][j], n[j], 0.001f);
+    }
+
+    // Out of range components are clamped
+    Vector3 n = VertexFormat::UnpackNormal(VertexFormat::PackNormal(Vector3(2.0f, -3.0f, 0.0f)));
+    Assert::AreEqual(1.0f, n[0]);
+    Assert::AreEqual(-1.0f, n[1]);
+  }
+
+  TEST_METHOD(VertexFormat_Pack_Full)
+  {
+    const Vector3 vertices[] = {Vector3(1.0f, 2.0f, 3.0f), Vector3(4.0f, 5.0f, 6.0f)};
+    const Colour colours[] = {Colour(0.1f, 0.2f, 0.3f, 0.4f), Colour(0.5f, 0.6f, 0.7f, 0.8f)};
+    const Vector2 textureCoords[] = {Vector2(0.25f, 0.75f), Vector2(0.5f, 1.0f)};
+
+    VertexFormat format(true, true, false);
+    std::vector<char> data(2 * format.stride());
+    format.pack(data.data(), 0, 2, vertices, colours, textureCoords, nullptr);
+
+    for (size_t i = 0; i < 2; i++)
+    {
+      const size_t base = i * format.stride();
+
+      for (size_t j = 0; j < 3; j++)
+        Assert::AreEqual(vertices[i][j], Read<float>(data, base + j * sizeof(float)));
+
+      for (size_t j = 0; j < 4; j++)
+        Assert::AreEqual(colours[i][j],
+                         Read<float>(data, base + format.attribute(COLOUR_BUFFER).offset + j * sizeof(float)));
+
+      for (size_t j = 0; j < 2; j++)
+        Assert::AreEqual(textureCoords[i][j],
+                         Read<float>(data, base + format.attribute(TEXTURE_BUFFER).offset + j * sizeof(float)));
+    }
+  }
+
+  TEST_METHOD(VertexFormat_Pack_Compact)
+  {
+    const Vector3 vertices[] = {Vector3(1.0f, 2.0f, 3.0f), Vector3(4.0f, 5.0f, 6.0f), Vector3(7.0f, 8.0f, 9.0f)};
+    const Colour colours[] = {Colour(0.0f, 0.0f, 0.0f, 0.0f), Colour(1.0f, 0.5f, 0.0f, 1.0f),
+                              Colour(2.0f, -1.0f, 0.2f, 0.6f)};
+    const Vector2 textureCoords[] = {Vector2(0.0f, 0.0f), Vector2(0.25f, 0.75f), Vector2(1.0f, 0.5f)};
+    const Vector3 normals[] = {Vector3(1.0f, 0.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f), Vector3(0.0f, 0.0f, -1.0f)};
+
+    VertexFormat format(true, true, true, VertexFormat::ENCODE_COMPACT);
+
+    // Pack only the last two vertices
+    std::vector<char> data(2 * format.stride());
+    format.pack(data.data(), 1, 2, vertices, colours, textureCoords, normals);
+
+    const uint8_t expectedColours[][4] = {{255, 128, 0, 255}, {255, 0, 51, 153}};
+
+    for (size_t i = 0; i < 2; i++)
+    {
+      const size_t base = i * format.stride();
+      const size_t v = i + 1;
+
+      for (size_t j = 0; j < 3; j++)
+        Assert::AreEqual(vertices[v][j], Read<float>(data, base + j * sizeof(float)));
+
+      for (size_t j = 0; j < 4; j++)
+        Assert::AreEqual((int)expectedColours[i][j],
+                         (int)Read<uint8_t>(data, base + format.attribute(COLOUR_BUFFER).offset + j));
+
+      for (size_t j = 0; j < 2; j++)
+        Assert::AreEqual(textureCoords[v][j],
+                         VertexFormat::HalfToFloat(Read<uint16_t>(
+                             data, base + format.attribute(TEXTURE_BUFFER).offset + j * sizeof(uint16_t))));
+
+      Vector3 n =
+          VertexFormat::UnpackNormal(Read<uint32_t>(data, base + format.attribute(NORMAL_BUFFER).offset));
+      for (size_t j = 0; j < 3; j++)
+        Assert::AreEqual(normals[v][j], n[j]);
+    }
+  }
+};
+#endif /* DOXYGEN_SKIP */
+}
+}
+}
@@ -36,6 +36,21 @@ namespace IO
     return CreateDirectory(path.c_str(), NULL) == TRUE;
   }
 
+  /**
+   * @brief Gets the time an item was last modified.
+   * @param path Path to item
+   * @return Modification time (100ns intervals since 1601), 0 if the item
+   *         does not exist
+   */
+  uint64_t DiskUtils::ModifiedTime(const std::string &path)
+  {
+    WIN32_FILE_ATTRIBUTE_DATA data;
+    if (!GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &data))
+      return 0;
+
+    return ((uint64_t)data.ftLastWriteTime.dwHighDateTime << 32) | data.ftLastWriteTime.dwLowDateTime;
+  }
+
   /**
    * @brief Obtains a list of items in a directory.
    * @param path Path to directory to list
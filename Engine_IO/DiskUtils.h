@@ -8,6 +8,7 @@
 #ifndef _ENGINE_IO_DISKUTILS_H_
 #define _ENGINE_IO_DISKUTILS_H_
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -25,6 +26,7 @@ namespace IO
   public:
     static bool Exists(const std::string &path);
     static bool MakeDirectories(const std::string &path);
+    static uint64_t ModifiedTime(const std::string &path);
     static std::vector<std::string> ListDirectory(const std::string &path, bool files = true, bool directories = true,
                                                   bool listAll = false);
   };
@@ -0,0 +1,90 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include "MappedFile.h"
+
+#define NOMINMAX
+
+#include <Windows.h>
+
+namespace Engine
+{
+namespace IO
+{
+  MappedFile::MappedFile()
+      : m_file(INVALID_HANDLE_VALUE)
+      , m_mapping(NULL)
+      , m_data(nullptr)
+      , m_size(0)
+  {
+  }
+
+  MappedFile::~MappedFile()
+  {
+    close();
+  }
+
+  /**
+   * @brief Maps a file into memory, closing any previously mapped file.
+   * @param filename Path to file
+   * @return True if the file was mapped (empty files cannot be mapped)
+   */
+  bool MappedFile::open(const std::string &filename)
+  {
+    close();
+
+    m_file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                         FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (m_file == INVALID_HANDLE_VALUE)
+      return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0)
+    {
+      close();
+      return false;
+    }
+
+    m_mapping = CreateFileMappingA(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (m_mapping == NULL)
+    {
+      close();
+      return false;
+    }
+
+    m_data = static_cast<const char *>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    if (m_data == nullptr)
+    {
+      close();
+      return false;
+    }
+
+    m_size = (size_t)size.QuadPart;
+    return true;
+  }
+
+  /**
+   * @brief Unmaps and closes the file.
+   */
+  void MappedFile::close()
+  {
+    if (m_data != nullptr)
+      UnmapViewOfFile(m_data);
+
+    if (m_mapping != NULL)
+      CloseHandle(m_mapping);
+
+    if (m_file != INVALID_HANDLE_VALUE)
+      CloseHandle(m_file);
+
+    m_file = INVALID_HANDLE_VALUE;
+    m_mapping = NULL;
+    m_data = nullptr;
+    m_size = 0;
+  }
+}
+}
@@ -0,0 +1,80 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#ifndef _ENGINE_IO_MAPPEDFILE_H_
+#define _ENGINE_IO_MAPPEDFILE_H_
+
+#include <string>
+
+namespace Engine
+{
+namespace IO
+{
+  /**
+   * @class MappedFile
+   * @brief Read only memory mapping of an entire file.
+   * @author Dan Nixon
+   *
+   * The mapped data remains valid until the file is closed or the
+   * MappedFile is destroyed.
+   */
+  class MappedFile
+  {
+  public:
+    MappedFile();
+    virtual ~MappedFile();
+
+    /**
+     * @brief No copy constructor
+     */
+    MappedFile(MappedFile const &) = delete;
+
+    /**
+     * @brief No assign copy constructor
+     */
+    MappedFile &operator=(MappedFile const &) = delete;
+
+    bool open(const std::string &filename);
+    void close();
+
+    /**
+     * @brief Checks if a file is mapped.
+     * @return True if mapped
+     */
+    inline bool isOpen() const
+    {
+      return m_data != nullptr;
+    }
+
+    /**
+     * @brief Gets a pointer to the start of the mapped file.
+     * @return File data (nullptr if not mapped)
+     */
+    inline const char *data() const
+    {
+      return m_data;
+    }
+
+    /**
+     * @brief Gets the size of the mapped file.
+     * @return Size in bytes
+     */
+    inline size_t size() const
+    {
+      return m_size;
+    }
+
+  private:
+    void *m_file;       //!< Handle of the open file
+    void *m_mapping;    //!< Handle of the file mapping
+    const char *m_data; //!< Pointer to the mapped view
+    size_t m_size;      //!< Size of the mapped view
+  };
+}
+}
+
+#endif
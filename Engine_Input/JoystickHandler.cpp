@@ -114,6 +114,14 @@ namespace Input
     return SDL_JoystickGetAxis(m_joystick, axis);
   }
 
+  /**
+   * @copydoc IEventHandler::eventTypes
+   */
+  Engine::Common::IEventHandler::EventTypeList JoystickHandler::eventTypes() const
+  {
+    return {SDL_JOYAXISMOTION, SDL_JOYBUTTONDOWN, SDL_JOYBUTTONUP};
+  }
+
   /**
    * @copydoc IEventHandler::handleEvent
    */
@@ -37,6 +37,8 @@ namespace Input
     bool button(int button) const;
     Sint32 axis(int axis) const;
 
+    virtual EventTypeList eventTypes() const;
+
   protected:
     virtual void handleEvent(const SDL_Event &e);
 
@@ -35,6 +35,14 @@ namespace Input
   {
   }
 
+  /**
+   * @copydoc IEventHandler::eventTypes
+   */
+  IEventHandler::EventTypeList KeyboardHandler::eventTypes() const
+  {
+    return {SDL_KEYDOWN, SDL_KEYUP};
+  }
+
   /**
    * @copydoc IEventHandler::handleEvent
    */
@@ -27,6 +27,8 @@ namespace Input
     KeyboardHandler();
     virtual ~KeyboardHandler();
 
+    virtual EventTypeList eventTypes() const;
+
   protected:
     virtual void handleEvent(const SDL_Event &e);
 
@@ -58,6 +58,14 @@ namespace Input
   {
   }
 
+  /**
+   * @copydoc IEventHandler::eventTypes
+   */
+  Engine::Common::IEventHandler::EventTypeList MouseHandler::eventTypes() const
+  {
+    return {SDL_MOUSEMOTION, SDL_MOUSEBUTTONDOWN, SDL_MOUSEBUTTONUP};
+  }
+
   /**
    * @copydoc IEventHandler::handleEvent
    */
@@ -28,6 +28,8 @@ namespace Input
     MouseHandler();
     virtual ~MouseHandler();
 
+    virtual EventTypeList eventTypes() const;
+
   protected:
     virtual void handleEvent(const SDL_Event &e);
 
@@ -84,6 +84,14 @@ namespace Logging
    */
   void LoggingService::log(LogLevel level, const std::string &loggerName, const std::string &message)
   {
+    // Only format the message if at least one channel will output it
+    bool output = false;
+    for (auto it = m_outputs.begin(); it != m_outputs.end() && !output; ++it)
+      output = level >= (*it)->level();
+
+    if (!output)
+      return;
+
     std::string logMessage = LOG_LEVEL_NAMES.at(level) + " [" + loggerName + "] " + message;
 
     for (auto it = m_outputs.begin(); it != m_outputs.end(); ++it)
@@ -12,6 +12,7 @@
 
 #include <gl/glew.h>
 
+#include "SIMD.h"
 #include "Vector3.h"
 #include "Vector4.h"
 #include "math_common.h"
@@ -145,20 +146,8 @@ namespace Maths
      */
     inline Matrix4 operator*(const Matrix4 &a) const
     {
-      Matrix4 out;
-      // Students! You should be able to think up a really easy way of speeding
-      // this up...
-      for (size_t r = 0; r < 4; ++r)
-      {
-        for (size_t c = 0; c < 4; ++c)
-        {
-          out.m_values[c + (r * 4)] = 0.0f;
-          for (size_t i = 0; i < 4; ++i)
-          {
-            out.m_values[c + (r * 4)] += m_values[c + (i * 4)] * a.m_values[(r * 4) + i];
-          }
-        }
-      }
+      Matrix4 out(Uninitialised);
+      Kernels::Mat4Mul(m_values, a.m_values, out.m_values);
       return out;
     }
 
@@ -166,24 +155,17 @@ namespace Maths
      * @brief Multiplies this matrix with a Vector3.
      * @param v Vector3 to multiply with
      * @return Result Vector3
+     *
+     * The vector is treated as a point (w = 1) and the result is divided by
+     * the resulting w component.
      */
     inline Vector3 operator*(const Vector3 &v) const
     {
-      Vector3 vec;
-
-      float temp;
-
-      vec.m_x = v.m_x * m_values[0] + v.m_y * m_values[4] + v.m_z * m_values[8] + m_values[12];
-      vec.m_y = v.m_x * m_values[1] + v.m_y * m_values[5] + v.m_z * m_values[9] + m_values[13];
-      vec.m_z = v.m_x * m_values[2] + v.m_y * m_values[6] + v.m_z * m_values[10] + m_values[14];
+      const float in[4] = {v.m_x, v.m_y, v.m_z, 1.0f};
+      float out[4];
+      Kernels::Mat4MulVec4(m_values, in, out);
 
-      temp = v.m_x * m_values[3] + v.m_y * m_values[7] + v.m_z * m_values[11] + m_values[15];
-
-      vec.m_x = vec.m_x / temp;
-      vec.m_y = vec.m_y / temp;
-      vec.m_z = vec.m_z / temp;
-
-      return vec;
+      return Vector3(out[0] / out[3], out[1] / out[3], out[2] / out[3]);
     };
 
     // CSC3224 NCODE Dan Nixon 120263697
@@ -207,10 +189,9 @@ namespace Maths
      */
     inline Vector4 operator*(const Vector4 &v) const
     {
-      return Vector4(v.m_x * m_values[0] + v.m_y * m_values[4] + v.m_z * m_values[8] + v.m_w * m_values[12],
-                     v.m_x * m_values[1] + v.m_y * m_values[5] + v.m_z * m_values[9] + v.m_w * m_values[13],
-                     v.m_x * m_values[2] + v.m_y * m_values[6] + v.m_z * m_values[10] + v.m_w * m_values[14],
-                     v.m_x * m_values[3] + v.m_y * m_values[7] + v.m_z * m_values[11] + v.m_w * m_values[15]);
+      Vector4 out;
+      Kernels::Mat4MulVec4(m_values, &v.m_x, &out.m_x);
+      return out;
     };
 
     /**
@@ -232,6 +213,24 @@ namespace Maths
 
   private:
     friend class Matrix3;
+    friend class TransformBatch;
+
+    /**
+     * @brief Tag type used to select the non-initialising constructor.
+     */
+    enum UninitialisedTag
+    {
+      Uninitialised
+    };
+
+    /**
+     * @brief Creates a matrix without initialising its values.
+     *
+     * Used where every value is about to be overwritten.
+     */
+    explicit Matrix4(UninitialisedTag)
+    {
+    }
 
     float m_values[16]; //!< Matrix values
   };
@@ -0,0 +1,325 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#ifndef _ENGINE_MATHS_SIMD_H_
+#define _ENGINE_MATHS_SIMD_H_
+
+#include <cmath>
+
+/*
+ * Instruction set selection.
+ *
+ * SSE is used whenever the target guarantees it (always the case on x64 and
+ * on Win32 with /arch:SSE or higher), AVX is used in addition when building
+ * with /arch:AVX. Define ENGINE_MATHS_NO_SIMD to force the scalar kernels
+ * (e.g. on ARM/NEON targets, where the scalar kernels are written to be
+ * friendly to the auto-vectoriser).
+ */
+#ifndef ENGINE_MATHS_NO_SIMD
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define ENGINE_MATHS_SSE
+#endif
+#if defined(ENGINE_MATHS_SSE) && defined(__AVX__)
+#define ENGINE_MATHS_AVX
+#endif
+#endif
+
+#ifdef ENGINE_MATHS_SSE
+#include <xmmintrin.h>
+#endif
+
+#ifdef ENGINE_MATHS_AVX
+#include <immintrin.h>
+#endif
+
+namespace Engine
+{
+namespace Maths
+{
+  /**
+   * @class ScalarKernels
+   * @brief Portable implementations of the hot vector and matrix operations.
+   * @author Dan Nixon
+   *
+   * Matrices are 16 floats in column major (OpenGL) order, vectors are
+   * contiguous floats. These define the reference results that the SIMD
+   * kernels must reproduce.
+   */
+  class ScalarKernels
+  {
+  public:
+    /**
+     * @brief Multiplies two 4x4 matrices.
+     * @param a LHS matrix
+     * @param b RHS matrix
+     * @param out [out] Result (must not alias a or b)
+     */
+    static inline void Mat4Mul(const float *a, const float *b, float *out)
+    {
+      for (size_t r = 0; r < 4; ++r)
+      {
+        for (size_t c = 0; c < 4; ++c)
+        {
+          float v = 0.0f;
+          for (size_t i = 0; i < 4; ++i)
+            v += a[c + (i * 4)] * b[(r * 4) + i];
+          out[c + (r * 4)] = v;
+        }
+      }
+    }
+
+    /**
+     * @brief Multiplies a 4x4 matrix with a four component vector.
+     * @param m Matrix
+     * @param v Vector
+     * @param out [out] Result (must not alias v)
+     */
+    static inline void Mat4MulVec4(const float *m, const float *v, float *out)
+    {
+      for (size_t c = 0; c < 4; ++c)
+        out[c] = v[0] * m[c] + v[1] * m[c + 4] + v[2] * m[c + 8] + v[3] * m[c + 12];
+    }
+
+    /**
+     * @brief Calculates the dot product of two three component vectors.
+     * @param a LHS vector
+     * @param b RHS vector
+     * @return Dot product
+     */
+    static inline float Dot3(const float *a, const float *b)
+    {
+      return (a[0] * b[0]) + (a[1] * b[1]) + (a[2] * b[2]);
+    }
+
+    /**
+     * @brief Calculates the dot product of two four component vectors.
+     * @param a LHS vector
+     * @param b RHS vector
+     * @return Dot product
+     */
+    static inline float Dot4(const float *a, const float *b)
+    {
+      return (a[0] * b[0]) + (a[1] * b[1]) + (a[2] * b[2]) + (a[3] * b[3]);
+    }
+
+    /**
+     * @brief Calculates the cross product of two three component vectors.
+     * @param a LHS vector
+     * @param b RHS vector
+     * @param out [out] Result (must not alias a or b)
+     */
+    static inline void Cross3(const float *a, const float *b, float *out)
+    {
+      out[0] = (a[1] * b[2]) - (a[2] * b[1]);
+      out[1] = (a[2] * b[0]) - (a[0] * b[2]);
+      out[2] = (a[0] * b[1]) - (a[1] * b[0]);
+    }
+
+    /**
+     * @brief Normalises a three component vector in place.
+     * @param a Vector
+     *
+     * Zero length vectors are left unchanged.
+     */
+    static inline void Normalise3(float *a)
+    {
+      float len = std::sqrt(Dot3(a, a));
+
+      if (len != 0.0f)
+      {
+        a[0] /= len;
+        a[1] /= len;
+        a[2] /= len;
+      }
+    }
+  };
+
+#ifdef ENGINE_MATHS_SSE
+  /**
+   * @class SSEKernels
+   * @brief SSE implementations of the operations in ScalarKernels.
+   * @author Dan Nixon
+   *
+   * Operations are performed in the same order as the scalar kernels (and
+   * without fused multiply-add) so results are identical, with the exception
+   * of the sign of zero.
+   */
+  class SSEKernels
+  {
+  public:
+    /**
+     * @copydoc ScalarKernels::Mat4Mul
+     */
+    static inline void Mat4Mul(const float *a, const float *b, float *out)
+    {
+      const __m128 c0 = _mm_loadu_ps(a);
+      const __m128 c1 = _mm_loadu_ps(a + 4);
+      const __m128 c2 = _mm_loadu_ps(a + 8);
+      const __m128 c3 = _mm_loadu_ps(a + 12);
+
+      for (size_t r = 0; r < 4; ++r)
+      {
+        const float *col = b + (r * 4);
+        __m128 v = _mm_mul_ps(c0, _mm_set1_ps(col[0]));
+        v = _mm_add_ps(v, _mm_mul_ps(c1, _mm_set1_ps(col[1])));
+        v = _mm_add_ps(v, _mm_mul_ps(c2, _mm_set1_ps(col[2])));
+        v = _mm_add_ps(v, _mm_mul_ps(c3, _mm_set1_ps(col[3])));
+        _mm_storeu_ps(out + (r * 4), v);
+      }
+    }
+
+    /**
+     * @copydoc ScalarKernels::Mat4MulVec4
+     */
+    static inline void Mat4MulVec4(const float *m, const float *v, float *out)
+    {
+      __m128 r = _mm_mul_ps(_mm_loadu_ps(m), _mm_set1_ps(v[0]));
+      r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(m + 4), _mm_set1_ps(v[1])));
+      r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(m + 8), _mm_set1_ps(v[2])));
+      r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(m + 12), _mm_set1_ps(v[3])));
+      _mm_storeu_ps(out, r);
+    }
+
+    /**
+     * @copydoc ScalarKernels::Dot3
+     */
+    static inline float Dot3(const float *a, const float *b)
+    {
+      const __m128 p = _mm_mul_ps(Load3(a), Load3(b));
+      __m128 s = _mm_add_ss(p, _mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 1, 1, 1)));
+      s = _mm_add_ss(s, _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 2, 2)));
+      return _mm_cvtss_f32(s);
+    }
+
+    /**
+     * @copydoc ScalarKernels::Dot4
+     */
+    static inline float Dot4(const float *a, const float *b)
+    {
+      const __m128 p = _mm_mul_ps(_mm_loadu_ps(a), _mm_loadu_ps(b));
+      __m128 s = _mm_add_ss(p, _mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 1, 1, 1)));
+      s = _mm_add_ss(s, _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 2, 2)));
+      s = _mm_add_ss(s, _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 3, 3)));
+      return _mm_cvtss_f32(s);
+    }
+
+    /**
+     * @copydoc ScalarKernels::Cross3
+     *
+     * Uses the scalar kernel, the cost of packing and unpacking three
+     * component vectors outweighs the gain of the shuffle based version.
+     */
+    static inline void Cross3(const float *a, const float *b, float *out)
+    {
+      ScalarKernels::Cross3(a, b, out);
+    }
+
+    /**
+     * @copydoc ScalarKernels::Normalise3
+     */
+    static inline void Normalise3(float *a)
+    {
+      const __m128 v = Load3(a);
+      const __m128 len = _mm_sqrt_ss(_mm_set_ss(Dot3(a, a)));
+
+      if (_mm_cvtss_f32(len) != 0.0f)
+        Store3(a, _mm_div_ps(v, _mm_shuffle_ps(len, len, _MM_SHUFFLE(0, 0, 0, 0))));
+    }
+
+  private:
+    /**
+     * @brief Loads three floats into the lower lanes of a register (without
+     *        reading past the end of the array).
+     * @param a Array
+     * @return Register containing [a0, a1, a2, 0]
+     */
+    static inline __m128 Load3(const float *a)
+    {
+      return _mm_setr_ps(a[0], a[1], a[2], 0.0f);
+    }
+
+    /**
+     * @brief Stores the lower three lanes of a register.
+     * @param a [out] Array
+     * @param v Register
+     */
+    static inline void Store3(float *a, __m128 v)
+    {
+      _mm_store_ss(a, v);
+      _mm_store_ss(a + 1, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)));
+      _mm_store_ss(a + 2, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)));
+    }
+  };
+#endif
+
+#ifdef ENGINE_MATHS_AVX
+  /**
+   * @class AVXKernels
+   * @brief AVX implementations of the operations in ScalarKernels.
+   * @author Dan Nixon
+   *
+   * Only matrix multiplication benefits from the wider registers, all other
+   * operations use the SSE kernels.
+   */
+  class AVXKernels : public SSEKernels
+  {
+  public:
+    /**
+     * @copydoc ScalarKernels::Mat4Mul
+     *
+     * Computes two columns of the result per iteration.
+     */
+    static inline void Mat4Mul(const float *a, const float *b, float *out)
+    {
+      const __m256 c0 = _mm256_broadcast_ps((const __m128 *)a);
+      const __m256 c1 = _mm256_broadcast_ps((const __m128 *)(a + 4));
+      const __m256 c2 = _mm256_broadcast_ps((const __m128 *)(a + 8));
+      const __m256 c3 = _mm256_broadcast_ps((const __m128 *)(a + 12));
+
+      for (size_t r = 0; r < 4; r += 2)
+      {
+        const float *lo = b + (r * 4);
+        const float *hi = lo + 4;
+        __m256 v = _mm256_mul_ps(c0, Splat(lo[0], hi[0]));
+        v = _mm256_add_ps(v, _mm256_mul_ps(c1, Splat(lo[1], hi[1])));
+        v = _mm256_add_ps(v, _mm256_mul_ps(c2, Splat(lo[2], hi[2])));
+        v = _mm256_add_ps(v, _mm256_mul_ps(c3, Splat(lo[3], hi[3])));
+        _mm256_storeu_ps(out + (r * 4), v);
+      }
+    }
+
+  private:
+    /**
+     * @brief Creates a register with one value in the lower four lanes and
+     *        another in the upper four lanes.
+     * @param lo Lower value
+     * @param hi Upper value
+     * @return Register
+     */
+    static inline __m256 Splat(float lo, float hi)
+    {
+      return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(lo)), _mm_set1_ps(hi), 1);
+    }
+  };
+#endif
+
+  /**
+   * @typedef Kernels
+   * @brief The best kernel implementation available for the target, selected
+   *        at compile time.
+   */
+#if defined(ENGINE_MATHS_AVX)
+  typedef AVXKernels Kernels;
+#elif defined(ENGINE_MATHS_SSE)
+  typedef SSEKernels Kernels;
+#else
+  typedef ScalarKernels Kernels;
+#endif
+}
+}
+
+#endif
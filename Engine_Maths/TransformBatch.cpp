@@ -0,0 +1,409 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include "TransformBatch.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "SIMD.h"
+
+namespace
+{
+/**
+ * @brief Composes a single translation, rotation and scale into a column
+ *        major matrix (used for elements not covered by a full SIMD block).
+ * @param px Position X
+ * @param py Position Y
+ * @param pz Position Z
+ * @param w Rotation real component
+ * @param i Rotation i component
+ * @param j Rotation j component
+ * @param k Rotation k component
+ * @param sx Scale X
+ * @param sy Scale Y
+ * @param sz Scale Z
+ * @param m [out] Matrix values
+ */
+inline void ComposeOne(float px, float py, float pz, float w, float i, float j, float k, float sx, float sy, float sz,
+                       float *m)
+{
+  const float i2 = i * i;
+  const float j2 = j * j;
+  const float k2 = k * k;
+  const float ij = i * j;
+  const float ik = i * k;
+  const float jk = j * k;
+  const float wi = w * i;
+  const float wj = w * j;
+  const float wk = w * k;
+
+  m[0] = (1.0f - 2.0f * (j2 + k2)) * sx;
+  m[1] = (2.0f * (ij + wk)) * sx;
+  m[2] = (2.0f * (ik - wj)) * sx;
+  m[3] = 0.0f;
+
+  m[4] = (2.0f * (ij - wk)) * sy;
+  m[5] = (1.0f - 2.0f * (i2 + k2)) * sy;
+  m[6] = (2.0f * (jk + wi)) * sy;
+  m[7] = 0.0f;
+
+  m[8] = (2.0f * (ik + wj)) * sz;
+  m[9] = (2.0f * (jk - wi)) * sz;
+  m[10] = (1.0f - 2.0f * (i2 + j2)) * sz;
+  m[11] = 0.0f;
+
+  m[12] = px;
+  m[13] = py;
+  m[14] = pz;
+  m[15] = 1.0f;
+}
+}
+
+namespace Engine
+{
+namespace Maths
+{
+  const size_t TransformBatch::NO_PARENT = std::numeric_limits<size_t>::max();
+
+  /**
+   * @brief Composes translation, rotation and scale components into local
+   *        matrices (equivalent to Translation * Rotation * Scale).
+   * @param n Number of transforms
+   * @param px Position X components
+   * @param py Position Y components
+   * @param pz Position Z components
+   * @param qw Rotation real components
+   * @param qi Rotation i components
+   * @param qj Rotation j components
+   * @param qk Rotation k components
+   * @param sx Scale X components
+   * @param sy Scale Y components
+   * @param sz Scale Z components
+   * @param out [out] Array of n matrices
+   *
+   * Each component array holds n values. Four transforms are composed at a
+   * time when SSE is available.
+   */
+  void TransformBatch::Compose(size_t n, const float *px, const float *py, const float *pz, const float *qw,
+                               const float *qi, const float *qj, const float *qk, const float *sx, const float *sy,
+                               const float *sz, Matrix4 *out)
+  {
+    size_t idx = 0;
+
+#ifdef ENGINE_MATHS_SSE
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+    const __m128 zero = _mm_setzero_ps();
+
+    for (; idx + 4 <= n; idx += 4)
+    {
+      const __m128 w = _mm_loadu_ps(qw + idx);
+      const __m128 i = _mm_loadu_ps(qi + idx);
+      const __m128 j = _mm_loadu_ps(qj + idx);
+      const __m128 k = _mm_loadu_ps(qk + idx);
+
+      const __m128 i2 = _mm_mul_ps(i, i);
+      const __m128 j2 = _mm_mul_ps(j, j);
+      const __m128 k2 = _mm_mul_ps(k, k);
+      const __m128 ij = _mm_mul_ps(i, j);
+      const __m128 ik = _mm_mul_ps(i, k);
+      const __m128 jk = _mm_mul_ps(j, k);
+      const __m128 wi = _mm_mul_ps(w, i);
+      const __m128 wj = _mm_mul_ps(w, j);
+      const __m128 wk = _mm_mul_ps(w, k);
+
+      const __m128 x = _mm_loadu_ps(sx + idx);
+      const __m128 y = _mm_loadu_ps(sy + idx);
+      const __m128 z = _mm_loadu_ps(sz + idx);
+
+      // Each register holds one matrix element for four transforms
+      __m128 c00 = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(j2, k2))), x);
+      __m128 c01 = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(ij, wk)), x);
+      __m128 c02 = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(ik, wj)), x);
+      __m128 c03 = zero;
+
+      __m128 c10 = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(ij, wk)), y);
+      __m128 c11 = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(i2, k2))), y);
+      __m128 c12 = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(jk, wi)), y);
+      __m128 c13 = zero;
+
+      __m128 c20 = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(ik, wj)), z);
+      __m128 c21 = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(jk, wi)), z);
+      __m128 c22 = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(i2, j2))), z);
+      __m128 c23 = zero;
+
+      __m128 c30 = _mm_loadu_ps(px + idx);
+      __m128 c31 = _mm_loadu_ps(py + idx);
+      __m128 c32 = _mm_loadu_ps(pz + idx);
+      __m128 c33 = one;
+
+      // Transpose so that each register holds one column of one matrix
+      _MM_TRANSPOSE4_PS(c00, c01, c02, c03);
+      _MM_TRANSPOSE4_PS(c10, c11, c12, c13);
+      _MM_TRANSPOSE4_PS(c20, c21, c22, c23);
+      _MM_TRANSPOSE4_PS(c30, c31, c32, c33);
+
+      float *m = out[idx].m_values;
+      _mm_storeu_ps(m, c00);
+      _mm_storeu_ps(m + 4, c10);
+      _mm_storeu_ps(m + 8, c20);
+      _mm_storeu_ps(m + 12, c30);
+
+      m = out[idx + 1].m_values;
+      _mm_storeu_ps(m, c01);
+      _mm_storeu_ps(m + 4, c11);
+      _mm_storeu_ps(m + 8, c21);
+      _mm_storeu_ps(m + 12, c31);
+
+      m = out[idx + 2].m_values;
+      _mm_storeu_ps(m, c02);
+      _mm_storeu_ps(m + 4, c12);
+      _mm_storeu_ps(m + 8, c22);
+      _mm_storeu_ps(m + 12, c32);
+
+      m = out[idx + 3].m_values;
+      _mm_storeu_ps(m, c03);
+      _mm_storeu_ps(m + 4, c13);
+      _mm_storeu_ps(m + 8, c23);
+      _mm_storeu_ps(m + 12, c33);
+    }
+#endif
+
+    for (; idx < n; idx++)
+      ComposeOne(px[idx], py[idx], pz[idx], qw[idx], qi[idx], qj[idx], qk[idx], sx[idx], sy[idx], sz[idx],
+                 out[idx].m_values);
+  }
+
+  /**
+   * @brief Computes world matrices from local matrices and parent indices.
+   * @param n Number of transforms
+   * @param parents Index of the parent of each transform
+   *                (TransformBatch::NO_PARENT for root transforms)
+   * @param local Local matrices
+   * @param world [out] World matrices (must not alias local)
+   *
+   * The parent of a transform must appear before it in the arrays.
+   */
+  void TransformBatch::Concatenate(size_t n, const size_t *parents, const Matrix4 *local, Matrix4 *world)
+  {
+    for (size_t i = 0; i < n; i++)
+    {
+      if (parents[i] == NO_PARENT)
+        world[i] = local[i];
+      else
+        Kernels::Mat4Mul(world[parents[i]].m_values, local[i].m_values, world[i].m_values);
+    }
+  }
+
+  /**
+   * @brief Computes world matrices for transforms sharing a common parent.
+   * @param parent World matrix of the parent
+   * @param n Number of transforms
+   * @param local Local matrices
+   * @param world [out] World matrices (must not alias local or parent)
+   */
+  void TransformBatch::Concatenate(const Matrix4 &parent, size_t n, const Matrix4 *local, Matrix4 *world)
+  {
+    for (size_t i = 0; i < n; i++)
+      Kernels::Mat4Mul(parent.m_values, local[i].m_values, world[i].m_values);
+  }
+
+  /**
+   * @brief Transforms an array of points by an affine matrix.
+   * @param mat Transformation matrix
+   * @param n Number of points
+   * @param in Points to transform
+   * @param out [out] Transformed points (may alias in)
+   *
+   * Unlike Matrix4::operator*(const Vector3 &), no perspective division is
+   * performed.
+   */
+  void TransformBatch::TransformPoints(const Matrix4 &mat, size_t n, const Vector3 *in, Vector3 *out)
+  {
+    const float *m = mat.m_values;
+
+    for (size_t i = 0; i < n; i++)
+    {
+      const float x = in[i].x();
+      const float y = in[i].y();
+      const float z = in[i].z();
+
+      out[i] = Vector3(m[0] * x + m[4] * y + m[8] * z + m[12], m[1] * x + m[5] * y + m[9] * z + m[13],
+                       m[2] * x + m[6] * y + m[10] * z + m[14]);
+    }
+  }
+
+  /**
+   * @brief Computes the axis aligned bounding box of an array of points.
+   * @param n Number of points
+   * @param points Points
+   * @return Bounding box (reset if there are no points)
+   */
+  BoundingBox3 TransformBatch::Bounds(size_t n, const Vector3 *points)
+  {
+    if (n == 0)
+      return BoundingBox3();
+
+    float minX = points[0].x();
+    float minY = points[0].y();
+    float minZ = points[0].z();
+    float maxX = minX;
+    float maxY = minY;
+    float maxZ = minZ;
+
+    for (size_t i = 1; i < n; i++)
+    {
+      minX = std::min(minX, points[i].x());
+      minY = std::min(minY, points[i].y());
+      minZ = std::min(minZ, points[i].z());
+      maxX = std::max(maxX, points[i].x());
+      maxY = std::max(maxY, points[i].y());
+      maxZ = std::max(maxZ, points[i].z());
+    }
+
+    return BoundingBox3(Vector3(minX, minY, minZ), Vector3(maxX, maxY, maxZ));
+  }
+
+  /**
+   * @brief Creates a new, empty batch.
+   */
+  TransformBatch::TransformBatch()
+  {
+  }
+
+  TransformBatch::~TransformBatch()
+  {
+  }
+
+  /**
+   * @brief Reserves storage for a number of transforms.
+   * @param n Number of transforms
+   */
+  void TransformBatch::reserve(size_t n)
+  {
+    m_px.reserve(n);
+    m_py.reserve(n);
+    m_pz.reserve(n);
+    m_qw.reserve(n);
+    m_qi.reserve(n);
+    m_qj.reserve(n);
+    m_qk.reserve(n);
+    m_sx.reserve(n);
+    m_sy.reserve(n);
+    m_sz.reserve(n);
+    m_parents.reserve(n);
+    m_local.reserve(n);
+    m_world.reserve(n);
+  }
+
+  /**
+   * @brief Removes all transforms from the batch.
+   */
+  void TransformBatch::clear()
+  {
+    m_px.clear();
+    m_py.clear();
+    m_pz.clear();
+    m_qw.clear();
+    m_qi.clear();
+    m_qj.clear();
+    m_qk.clear();
+    m_sx.clear();
+    m_sy.clear();
+    m_sz.clear();
+    m_parents.clear();
+    m_local.clear();
+    m_world.clear();
+  }
+
+  /**
+   * @brief Adds a transform to the batch.
+   * @param position Position relative to parent
+   * @param rotation Rotation relative to parent
+   * @param scale Scale relative to parent
+   * @param parent Index of the parent transform (must already be in the batch)
+   * @return Index of the new transform
+   */
+  size_t TransformBatch::add(const Vector3 &position, const Quaternion &rotation, const Vector3 &scale,
+                             size_t parent)
+  {
+    const size_t idx = size();
+
+    if (parent != NO_PARENT && parent >= idx)
+      throw std::runtime_error("Transform parent must be added before its children");
+
+    m_px.push_back(position.x());
+    m_py.push_back(position.y());
+    m_pz.push_back(position.z());
+    m_qw.push_back(rotation.w());
+    m_qi.push_back(rotation.i());
+    m_qj.push_back(rotation.j());
+    m_qk.push_back(rotation.k());
+    m_sx.push_back(scale.x());
+    m_sy.push_back(scale.y());
+    m_sz.push_back(scale.z());
+    m_parents.push_back(parent);
+    m_local.push_back(Matrix4());
+    m_world.push_back(Matrix4());
+
+    return idx;
+  }
+
+  /**
+   * @brief Sets the position of a transform relative to its parent.
+   * @param idx Transform index
+   * @param position Position
+   */
+  void TransformBatch::setPosition(size_t idx, const Vector3 &position)
+  {
+    m_px[idx] = position.x();
+    m_py[idx] = position.y();
+    m_pz[idx] = position.z();
+  }
+
+  /**
+   * @brief Sets the rotation of a transform relative to its parent.
+   * @param idx Transform index
+   * @param rotation Rotation
+   */
+  void TransformBatch::setRotation(size_t idx, const Quaternion &rotation)
+  {
+    m_qw[idx] = rotation.w();
+    m_qi[idx] = rotation.i();
+    m_qj[idx] = rotation.j();
+    m_qk[idx] = rotation.k();
+  }
+
+  /**
+   * @brief Sets the scale of a transform relative to its parent.
+   * @param idx Transform index
+   * @param scale Scale
+   */
+  void TransformBatch::setScale(size_t idx, const Vector3 &scale)
+  {
+    m_sx[idx] = scale.x();
+    m_sy[idx] = scale.y();
+    m_sz[idx] = scale.z();
+  }
+
+  /**
+   * @brief Recomputes the local and world matrices of every transform.
+   */
+  void TransformBatch::update()
+  {
+    const size_t n = size();
+    if (n == 0)
+      return;
+
+    Compose(n, m_px.data(), m_py.data(), m_pz.data(), m_qw.data(), m_qi.data(), m_qj.data(), m_qk.data(),
+            m_sx.data(), m_sy.data(), m_sz.data(), m_local.data());
+    Concatenate(n, m_parents.data(), m_local.data(), m_world.data());
+  }
+}
+}
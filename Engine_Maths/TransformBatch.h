@@ -0,0 +1,129 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#ifndef _ENGINE_MATHS_TRANSFORMBATCH_H_
+#define _ENGINE_MATHS_TRANSFORMBATCH_H_
+
+#include <vector>
+
+#include "BoundingBox.h"
+#include "Matrix4.h"
+#include "Quaternion.h"
+#include "Vector3.h"
+
+namespace Engine
+{
+namespace Maths
+{
+  /**
+   * @class TransformBatch
+   * @brief Computes the world matrices of many transforms in a single pass.
+   * @author Dan Nixon
+   *
+   * Positions, rotations and scales are stored as a structure of arrays (one
+   * array per component) so that composing local matrices can be vectorised.
+   * Each transform has an optional parent, which must have been added before
+   * the transform itself so that world matrices can be computed in a single
+   * forward pass.
+   */
+  class TransformBatch
+  {
+  public:
+    static const size_t NO_PARENT; //!< Parent index of a transform with no parent
+
+    static void Compose(size_t n, const float *px, const float *py, const float *pz, const float *qw, const float *qi,
+                        const float *qj, const float *qk, const float *sx, const float *sy, const float *sz,
+                        Matrix4 *out);
+    static void Concatenate(size_t n, const size_t *parents, const Matrix4 *local, Matrix4 *world);
+    static void Concatenate(const Matrix4 &parent, size_t n, const Matrix4 *local, Matrix4 *world);
+    static void TransformPoints(const Matrix4 &mat, size_t n, const Vector3 *in, Vector3 *out);
+    static BoundingBox3 Bounds(size_t n, const Vector3 *points);
+
+    TransformBatch();
+    virtual ~TransformBatch();
+
+    void reserve(size_t n);
+    void clear();
+
+    /**
+     * @brief Gets the number of transforms in the batch.
+     * @return Number of transforms
+     */
+    inline size_t size() const
+    {
+      return m_parents.size();
+    }
+
+    size_t add(const Vector3 &position, const Quaternion &rotation = Quaternion(),
+               const Vector3 &scale = Vector3(1.0f, 1.0f, 1.0f), size_t parent = NO_PARENT);
+
+    void setPosition(size_t idx, const Vector3 &position);
+    void setRotation(size_t idx, const Quaternion &rotation);
+    void setScale(size_t idx, const Vector3 &scale);
+
+    /**
+     * @brief Gets the index of the parent of a transform.
+     * @param idx Transform index
+     * @return Parent index, TransformBatch::NO_PARENT if the transform has no
+     *         parent
+     */
+    inline size_t parent(size_t idx) const
+    {
+      return m_parents[idx];
+    }
+
+    void update();
+
+    /**
+     * @brief Gets the local matrix of a transform (as of the last update).
+     * @param idx Transform index
+     * @return Local matrix
+     */
+    inline const Matrix4 &localMatrix(size_t idx) const
+    {
+      return m_local[idx];
+    }
+
+    /**
+     * @brief Gets the world matrix of a transform (as of the last update).
+     * @param idx Transform index
+     * @return World matrix
+     */
+    inline const Matrix4 &worldMatrix(size_t idx) const
+    {
+      return m_world[idx];
+    }
+
+    /**
+     * @brief Gets the array of world matrices (as of the last update).
+     * @return World matrices
+     */
+    inline const Matrix4 *worldMatrices() const
+    {
+      return m_world.data();
+    }
+
+  private:
+    std::vector<float> m_px; //!< Position X components
+    std::vector<float> m_py; //!< Position Y components
+    std::vector<float> m_pz; //!< Position Z components
+    std::vector<float> m_qw; //!< Rotation real components
+    std::vector<float> m_qi; //!< Rotation i components
+    std::vector<float> m_qj; //!< Rotation j components
+    std::vector<float> m_qk; //!< Rotation k components
+    std::vector<float> m_sx; //!< Scale X components
+    std::vector<float> m_sy; //!< Scale Y components
+    std::vector<float> m_sz; //!< Scale Z components
+
+    std::vector<size_t> m_parents; //!< Parent indices
+    std::vector<Matrix4> m_local;  //!< Local matrices
+    std::vector<Matrix4> m_world;  //!< World matrices
+  };
+}
+}
+
+#endif
@@ -11,6 +11,7 @@
 #include <cmath>
 #include <iostream>
 
+#include "SIMD.h"
 #include "Vector2.h"
 
 namespace Engine
@@ -33,7 +34,7 @@ namespace Maths
      */
     static float dot(const Vector3 &a, const Vector3 &b)
     {
-      return (a.m_x * b.m_x) + (a.m_y * b.m_y) + (a.m_z * b.m_z);
+      return Kernels::Dot3(&a.m_x, &b.m_x);
     }
 
     /**
@@ -44,8 +45,9 @@ namespace Maths
      */
     static Vector3 cross(const Vector3 &a, const Vector3 &b)
     {
-      return Vector3((a.m_y * b.m_z) - (a.m_z * b.m_y), (a.m_z * b.m_x) - (a.m_x * b.m_z),
-                     (a.m_x * b.m_y) - (a.m_y * b.m_x));
+      Vector3 out;
+      Kernels::Cross3(&a.m_x, &b.m_x, &out.m_x);
+      return out;
     }
 
     /**
@@ -329,17 +331,7 @@ namespace Maths
      */
     inline float operator[](size_t i) const
     {
-      switch (i)
-      {
-      case 0:
-        return m_x;
-      case 1:
-        return m_y;
-      case 2:
-        return m_z;
-      default:
-        return 0.0;
-      }
+      return (i < 3) ? (&m_x)[i] : 0.0f;
     }
 
     /**
@@ -349,17 +341,10 @@ namespace Maths
      */
     inline float &operator[](size_t i)
     {
-      switch (i)
-      {
-      case 0:
-        return m_x;
-      case 1:
-        return m_y;
-      case 2:
-        return m_z;
-      default:
-        throw new std::runtime_error("Index out of range when selecting a reference to retrun");
-      }
+      if (i < 3)
+        return (&m_x)[i];
+
+      throw new std::runtime_error("Index out of range when selecting a reference to retrun");
     }
 
     /**
@@ -403,6 +388,7 @@ namespace Maths
     friend class Vector4;
     friend class Matrix3;
     friend class Matrix4;
+    friend class VectorOperations;
 
     float m_x; //!< X coordinate
     float m_y; //!< Y coordinate
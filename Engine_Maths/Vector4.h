@@ -10,6 +10,7 @@
 
 #include <iostream>
 
+#include "SIMD.h"
 #include "Vector3.h"
 
 namespace Engine
@@ -24,6 +25,17 @@ namespace Maths
   class Vector4
   {
   public:
+    /**
+     * @brief Calculates the dot product of two Vector4.
+     * @param a LHS vector
+     * @param b RHS vector
+     * @return Dot product
+     */
+    static float dot(const Vector4 &a, const Vector4 &b)
+    {
+      return Kernels::Dot4(&a.m_x, &b.m_x);
+    }
+
     /**
      * @brief Gets the number of dimensions.
      * @return Dimension count
@@ -118,7 +130,7 @@ namespace Maths
      */
     inline float length2() const
     {
-      return m_x * m_x + m_y * m_y + m_z * m_z + m_w * m_w;
+      return dot(*this, *this);
     }
 
     /**
@@ -322,19 +334,7 @@ namespace Maths
      */
     inline float operator[](size_t i) const
     {
-      switch (i)
-      {
-      case 0:
-        return m_x;
-      case 1:
-        return m_y;
-      case 2:
-        return m_z;
-      case 3:
-        return m_w;
-      default:
-        return 0.0;
-      }
+      return (i < 4) ? (&m_x)[i] : 0.0f;
     }
 
     /**
@@ -344,19 +344,10 @@ namespace Maths
      */
     inline float &operator[](size_t i)
     {
-      switch (i)
-      {
-      case 0:
-        return m_x;
-      case 1:
-        return m_y;
-      case 2:
-        return m_z;
-      case 3:
-        return m_w;
-      default:
-        throw new std::runtime_error("Index out of range when selecting a reference to retrun");
-      }
+      if (i < 4)
+        return (&m_x)[i];
+
+      throw new std::runtime_error("Index out of range when selecting a reference to retrun");
     }
 
     /**
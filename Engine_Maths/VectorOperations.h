@@ -8,6 +8,9 @@
 #ifndef _ENGINE_MATHS_VECTOROPERATIONS_H_
 #define _ENGINE_MATHS_VECTOROPERATIONS_H_
 
+#include "SIMD.h"
+#include "Vector3.h"
+
 namespace Engine
 {
 namespace Maths
@@ -73,6 +76,31 @@ namespace Maths
         a = a / len;
     }
 
+    /**
+     * @brief Normalises a Vector3 to a length of 1.0.
+     * @param a Vector
+     * @return Normalised vector
+     *
+     * Uses the kernel selected in SIMD.h.
+     */
+    inline static Vector3 GetNormalised(const Vector3 &a)
+    {
+      Vector3 out(a);
+      Kernels::Normalise3(&out.m_x);
+      return out;
+    }
+
+    /**
+     * @brief Normalises a Vector3 to a length of 1.0.
+     * @param a Vector
+     *
+     * Uses the kernel selected in SIMD.h.
+     */
+    inline static void Normalise(Vector3 &a)
+    {
+      Kernels::Normalise3(&a.m_x);
+    }
+
     /**
      * @brief Projects a vector onto another.
      * @param a Vector to project
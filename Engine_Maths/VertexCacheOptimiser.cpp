@@ -0,0 +1,264 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include "VertexCacheOptimiser.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+const float CACHE_DECAY_POWER = 1.5f;   //!< Falloff of score with position in the cache
+const float LAST_TRI_SCORE = 0.75f;     //!< Score of vertices used by the last triangle
+const float VALENCE_BOOST_SCALE = 2.0f; //!< Weight of the remaining triangle count
+const float VALENCE_BOOST_POWER = 0.5f; //!< Falloff of score with remaining triangle count
+
+/**
+ * @var NO_TRIANGLE
+ * @brief Index used when no triangle is selected.
+ */
+const uint32_t NO_TRIANGLE = 0xFFFFFFFF;
+
+/**
+ * @brief Scores a vertex based on its position in the cache and the number
+ *        of triangles that still use it.
+ * @param cachePos Position in the cache (-1 if not in the cache)
+ * @param numTris Number of triangles not yet output that use the vertex
+ * @param cacheSize Size of the cache
+ * @return Score (higher is better, -1 if no triangles remain)
+ */
+float VertexScore(int cachePos, uint32_t numTris, size_t cacheSize)
+{
+  if (numTris == 0)
+    return -1.0f;
+
+  float score = 0.0f;
+
+  if (cachePos >= 0)
+  {
+    // Vertices of the last triangle are given a fixed score so that the next
+    // triangle does not simply reuse the same edge
+    if (cachePos < 3)
+      score = LAST_TRI_SCORE;
+    else
+      score = std::pow(1.0f - (float)(cachePos - 3) / (float)(cacheSize - 3), CACHE_DECAY_POWER);
+  }
+
+  // Favour vertices with few triangles left to clear them out of the mesh
+  score += VALENCE_BOOST_SCALE * std::pow((float)numTris, -VALENCE_BOOST_POWER);
+
+  return score;
+}
+}
+
+namespace Engine
+{
+namespace Maths
+{
+  const uint32_t VertexCacheOptimiser::UNUSED = 0xFFFFFFFF;
+
+  /**
+   * @brief Reorders the triangles of a triangle list to reduce the number of
+   *        post-transform vertex cache misses.
+   * @param indices Triangle list indices
+   * @param numVertices Number of vertices referenced by the indices
+   * @param cacheSize Size of the modelled cache (must be greater than 3)
+   *
+   * The set of triangles and the winding of each is unchanged.
+   */
+  void VertexCacheOptimiser::OptimiseTriangles(std::vector<uint32_t> &indices, size_t numVertices, size_t cacheSize)
+  {
+    const size_t numTris = indices.size() / 3;
+    if (numTris == 0 || cacheSize <= 3)
+      return;
+
+    // Build the list of triangles using each vertex
+    std::vector<uint32_t> triCount(numVertices, 0);
+    for (auto it = indices.begin(); it != indices.end(); ++it)
+      triCount[*it]++;
+
+    std::vector<uint32_t> triStart(numVertices + 1, 0);
+    for (size_t i = 0; i < numVertices; i++)
+      triStart[i + 1] = triStart[i] + triCount[i];
+
+    std::vector<uint32_t> vertTris(indices.size());
+    {
+      std::vector<uint32_t> next(triStart.begin(), triStart.end() - 1);
+      for (size_t i = 0; i < indices.size(); i++)
+        vertTris[next[indices[i]]++] = (uint32_t)(i / 3);
+    }
+
+    // Initial scores
+    std::vector<int> cachePos(numVertices, -1);
+    std::vector<float> vertScore(numVertices);
+    for (size_t i = 0; i < numVertices; i++)
+      vertScore[i] = VertexScore(-1, triCount[i], cacheSize);
+
+    std::vector<float> triScore(numTris);
+    std::vector<bool> triAdded(numTris, false);
+
+    uint32_t bestTri = NO_TRIANGLE;
+    float bestScore = -1.0f;
+
+    for (size_t i = 0; i < numTris; i++)
+    {
+      triScore[i] = vertScore[indices[i * 3]] + vertScore[indices[i * 3 + 1]] + vertScore[indices[i * 3 + 2]];
+      if (triScore[i] > bestScore)
+      {
+        bestScore = triScore[i];
+        bestTri = (uint32_t)i;
+      }
+    }
+
+    std::vector<uint32_t> out;
+    out.reserve(indices.size());
+
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> newCache;
+    cache.reserve(cacheSize + 3);
+    newCache.reserve(cacheSize + 3);
+
+    size_t nextUnadded = 0;
+
+    for (size_t n = 0; n < numTris; n++)
+    {
+      // If no triangle in the cache can be used then start from the next
+      // triangle not yet output
+      if (bestTri == NO_TRIANGLE)
+      {
+        while (triAdded[nextUnadded])
+          nextUnadded++;
+
+        bestTri = (uint32_t)nextUnadded;
+      }
+
+      const uint32_t *tri = &indices[bestTri * 3];
+      triAdded[bestTri] = true;
+      out.insert(out.end(), tri, tri + 3);
+
+      // Remove the triangle from the lists of its vertices
+      for (size_t k = 0; k < 3; k++)
+      {
+        const uint32_t v = tri[k];
+        uint32_t *begin = &vertTris[triStart[v]];
+        uint32_t *end = begin + triCount[v];
+        uint32_t *pos = std::find(begin, end, bestTri);
+        std::swap(*pos, *(end - 1));
+        triCount[v]--;
+      }
+
+      // Move the triangle vertices to the front of the cache
+      newCache.clear();
+      for (size_t k = 0; k < 3; k++)
+      {
+        if (std::find(newCache.begin(), newCache.end(), tri[k]) == newCache.end())
+          newCache.push_back(tri[k]);
+      }
+
+      for (auto it = cache.begin(); it != cache.end(); ++it)
+      {
+        if (std::find(newCache.begin(), newCache.end(), *it) == newCache.end())
+          newCache.push_back(*it);
+      }
+
+      // Rescore vertices that were in the cache (including those evicted)
+      for (size_t i = 0; i < newCache.size(); i++)
+      {
+        const uint32_t v = newCache[i];
+        cachePos[v] = (i < cacheSize) ? (int)i : -1;
+        vertScore[v] = VertexScore(cachePos[v], triCount[v], cacheSize);
+      }
+
+      // Rescore their triangles and select the best
+      bestTri = NO_TRIANGLE;
+      bestScore = -1.0f;
+
+      for (auto it = newCache.begin(); it != newCache.end(); ++it)
+      {
+        const uint32_t *begin = &vertTris[triStart[*it]];
+        const uint32_t *end = begin + triCount[*it];
+
+        for (const uint32_t *t = begin; t != end; ++t)
+        {
+          const uint32_t *tv = &indices[*t * 3];
+          triScore[*t] = vertScore[tv[0]] + vertScore[tv[1]] + vertScore[tv[2]];
+
+          if (triScore[*t] > bestScore)
+          {
+            bestScore = triScore[*t];
+            bestTri = *t;
+          }
+        }
+      }
+
+      if (newCache.size() > cacheSize)
+        newCache.resize(cacheSize);
+
+      cache.swap(newCache);
+    }
+
+    indices.swap(out);
+  }
+
+  /**
+   * @brief Renumbers vertices in the order they are first used by a triangle
+   *        list.
+   * @param indices Triangle list indices
+   * @param numVertices Number of vertices referenced by the indices
+   * @param remap [out] New index of each vertex (UNUSED if not referenced)
+   * @return Number of vertices referenced
+   *
+   * Vertex streams should be reordered with RemapStream.
+   */
+  size_t VertexCacheOptimiser::OptimiseFetch(std::vector<uint32_t> &indices, size_t numVertices,
+                                             std::vector<uint32_t> &remap)
+  {
+    remap.assign(numVertices, UNUSED);
+    uint32_t next = 0;
+
+    for (auto it = indices.begin(); it != indices.end(); ++it)
+    {
+      if (remap[*it] == UNUSED)
+        remap[*it] = next++;
+
+      *it = remap[*it];
+    }
+
+    return next;
+  }
+
+  /**
+   * @brief Computes the average cache miss ratio (vertex transforms per
+   *        triangle) of a triangle list with a FIFO vertex cache.
+   * @param indices Triangle list indices
+   * @param cacheSize Size of the modelled cache
+   * @return ACMR (between 0.5 and 3 for typical meshes, lower is better)
+   */
+  float VertexCacheOptimiser::ACMR(const std::vector<uint32_t> &indices, size_t cacheSize)
+  {
+    const size_t numTris = indices.size() / 3;
+    if (numTris == 0 || cacheSize == 0)
+      return 0.0f;
+
+    std::vector<uint32_t> fifo(cacheSize, UNUSED);
+    size_t head = 0;
+    size_t misses = 0;
+
+    for (auto it = indices.begin(); it != indices.end(); ++it)
+    {
+      if (std::find(fifo.begin(), fifo.end(), *it) != fifo.end())
+        continue;
+
+      misses++;
+      fifo[head] = *it;
+      head = (head + 1) % cacheSize;
+    }
+
+    return (float)misses / (float)numTris;
+  }
+}
+}
@@ -0,0 +1,62 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#ifndef _ENGINE_MATHS_VERTEXCACHEOPTIMISER_H_
+#define _ENGINE_MATHS_VERTEXCACHEOPTIMISER_H_
+
+#include <cstdint>
+#include <vector>
+
+namespace Engine
+{
+namespace Maths
+{
+  /**
+   * @class VertexCacheOptimiser
+   * @brief Reorders indexed triangle lists to make better use of the GPU
+   *        post-transform vertex cache and of memory when fetching vertices.
+   * @author Dan Nixon
+   *
+   * Triangle order is optimised using Tom Forsyth's "Linear-Speed Vertex
+   * Cache Optimisation" algorithm. Vertex order is then optimised by
+   * renumbering vertices in the order in which they are first used.
+   */
+  class VertexCacheOptimiser
+  {
+  public:
+    static const uint32_t UNUSED; //!< Remapped index of a vertex not used by any triangle
+
+    static void OptimiseTriangles(std::vector<uint32_t> &indices, size_t numVertices, size_t cacheSize = 32);
+    static size_t OptimiseFetch(std::vector<uint32_t> &indices, size_t numVertices, std::vector<uint32_t> &remap);
+    static float ACMR(const std::vector<uint32_t> &indices, size_t cacheSize = 32);
+
+    /**
+     * @brief Reorders a vertex stream following OptimiseFetch.
+     * @param stream Stream to reorder
+     * @param remap New index of each vertex (as produced by OptimiseFetch)
+     * @param numVertices Number of vertices after reordering
+     */
+    template <typename T>
+    static void RemapStream(std::vector<T> &stream, const std::vector<uint32_t> &remap, size_t numVertices)
+    {
+      if (stream.empty())
+        return;
+
+      std::vector<T> out(numVertices);
+      for (size_t i = 0; i < remap.size(); i++)
+      {
+        if (remap[i] != UNUSED)
+          out[remap[i]] = stream[i];
+      }
+
+      stream.swap(out);
+    }
+  };
+}
+}
+
+#endif
@@ -0,0 +1,157 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include <CppUnitTest.h>
+
+#include <Engine_Maths/Matrix4.h>
+#include <Engine_Maths/SIMD.h>
+#include <Engine_Maths/Vector3.h>
+#include <Engine_Maths/Vector4.h>
+#include <Engine_Maths/VectorOperations.h>
+
+/**
+ * @def FP_ACC
+ * @brief Accuracy for floating point comparison.
+ */
+#define FP_ACC 0.0001f
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+/**
+ * @brief Fills an array with repeatable values in the range [-10, 10).
+ * @param data Array to fill
+ * @param n Number of values
+ * @param seed Seed value
+ */
+void fill(float *data, size_t n, unsigned int seed)
+{
+  for (size_t i = 0; i < n; i++)
+  {
+    seed = seed * 1103515245u + 12345u;
+    data[i] = (float)((seed >> 8) % 20000) / 1000.0f - 10.0f;
+  }
+}
+}
+
+// clang-format off
+namespace Engine
+{
+namespace Maths
+{
+namespace Test
+{
+#ifndef DOXYGEN_SKIP
+TEST_CLASS(SIMDTest)
+{
+public:
+  TEST_METHOD(SIMD_Mat4Mul)
+  {
+    for (unsigned int s = 0; s < 32; s++)
+    {
+      float a[16], b[16], expected[16], result[16];
+      fill(a, 16, s);
+      fill(b, 16, s + 100);
+
+      ScalarKernels::Mat4Mul(a, b, expected);
+      Kernels::Mat4Mul(a, b, result);
+
+      for (size_t i = 0; i < 16; i++)
+        Assert::AreEqual(expected[i], result[i], FP_ACC);
+    }
+  }
+
+  TEST_METHOD(SIMD_Mat4MulVec4)
+  {
+    for (unsigned int s = 0; s < 32; s++)
+    {
+      float m[16], v[4], expected[4], result[4];
+      fill(m, 16, s);
+      fill(v, 4, s + 100);
+
+      ScalarKernels::Mat4MulVec4(m, v, expected);
+      Kernels::Mat4MulVec4(m, v, result);
+
+      for (size_t i = 0; i < 4; i++)
+        Assert::AreEqual(expected[i], result[i], FP_ACC);
+    }
+  }
+
+  TEST_METHOD(SIMD_Dot)
+  {
+    for (unsigned int s = 0; s < 32; s++)
+    {
+      float a[4], b[4];
+      fill(a, 4, s);
+      fill(b, 4, s + 100);
+
+      Assert::AreEqual(ScalarKernels::Dot3(a, b), Kernels::Dot3(a, b), FP_ACC);
+      Assert::AreEqual(ScalarKernels::Dot4(a, b), Kernels::Dot4(a, b), FP_ACC);
+    }
+  }
+
+  TEST_METHOD(SIMD_Cross)
+  {
+    for (unsigned int s = 0; s < 32; s++)
+    {
+      float a[3], b[3], expected[3], result[3];
+      fill(a, 3, s);
+      fill(b, 3, s + 100);
+
+      ScalarKernels::Cross3(a, b, expected);
+      Kernels::Cross3(a, b, result);
+
+      for (size_t i = 0; i < 3; i++)
+        Assert::AreEqual(expected[i], result[i], FP_ACC);
+    }
+  }
+
+  TEST_METHOD(SIMD_Normalise)
+  {
+    for (unsigned int s = 0; s < 32; s++)
+    {
+      float expected[3], result[3];
+      fill(expected, 3, s);
+      memcpy(result, expected, sizeof(expected));
+
+      ScalarKernels::Normalise3(expected);
+      Kernels::Normalise3(result);
+
+      for (size_t i = 0; i < 3; i++)
+        Assert::AreEqual(expected[i], result[i], FP_ACC);
+    }
+
+    // Zero length vectors are unchanged
+    Vector3 zero;
+    VectorOperations::Normalise(zero);
+    Assert::IsTrue(Vector3() == zero);
+  }
+
+  TEST_METHOD(SIMD_Matrix4_Vector3)
+  {
+    Matrix4 m = Matrix4::Translation(Vector3(1.0f, 2.0f, 3.0f)) * Matrix4::Scale(2.0f);
+    Vector3 v = m * Vector3(1.0f, 1.0f, 1.0f);
+
+    Assert::AreEqual(3.0f, v.x(), FP_ACC);
+    Assert::AreEqual(4.0f, v.y(), FP_ACC);
+    Assert::AreEqual(5.0f, v.z(), FP_ACC);
+  }
+
+  TEST_METHOD(SIMD_Vector4_Dot)
+  {
+    Vector4 a(1.0f, 2.0f, 3.0f, 4.0f);
+    Vector4 b(5.0f, 6.0f, 7.0f, 8.0f);
+
+    Assert::AreEqual(70.0f, Vector4::dot(a, b), FP_ACC);
+    Assert::AreEqual(30.0f, a.length2(), FP_ACC);
+  }
+};
+#endif /* DOXYGEN_SKIP */
+}
+}
+}
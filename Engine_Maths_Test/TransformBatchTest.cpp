@@ -0,0 +1,144 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include <CppUnitTest.h>
+
+#include <Engine_Maths/TransformBatch.h>
+
+/**
+ * @def FP_ACC
+ * @brief Accuracy for floating point comparison.
+ */
+#define FP_ACC 0.0001f
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+/**
+ * @brief Asserts that two matrices are equal within FP_ACC.
+ * @param expected Expected matrix
+ * @param actual Actual matrix
+ */
+void assertMatrixEqual(Engine::Maths::Matrix4 expected, Engine::Maths::Matrix4 actual)
+{
+  for (size_t c = 0; c < 4; c++)
+  {
+    for (size_t r = 0; r < 4; r++)
+      Assert::AreEqual(expected.column(c)[r], actual.column(c)[r], FP_ACC);
+  }
+}
+}
+
+// clang-format off
+namespace Engine
+{
+namespace Maths
+{
+namespace Test
+{
+#ifndef DOXYGEN_SKIP
+TEST_CLASS(TransformBatchTest)
+{
+public:
+  TEST_METHOD(TransformBatch_Compose)
+  {
+    TransformBatch batch;
+
+    // Seven transforms covers both a full SIMD block and the remainder
+    for (size_t i = 0; i < 7; i++)
+    {
+      float f = (float)i;
+      batch.add(Vector3(f, -f, 2.0f * f), Quaternion(f * 20.0f, Vector3(1.0f, f, 0.5f)), Vector3(1.0f + f, 2.0f, 0.5f));
+    }
+
+    batch.update();
+
+    Assert::AreEqual((size_t)7, batch.size());
+
+    for (size_t i = 0; i < batch.size(); i++)
+    {
+      float f = (float)i;
+      Matrix4 expected = Matrix4::Translation(Vector3(f, -f, 2.0f * f)) *
+                         Quaternion(f * 20.0f, Vector3(1.0f, f, 0.5f)).rotationMatrix() *
+                         Matrix4::Scale(Vector3(1.0f + f, 2.0f, 0.5f));
+
+      assertMatrixEqual(expected, batch.localMatrix(i));
+      assertMatrixEqual(expected, batch.worldMatrix(i));
+    }
+  }
+
+  TEST_METHOD(TransformBatch_Hierarchy)
+  {
+    TransformBatch batch;
+    size_t root = batch.add(Vector3(1.0f, 0.0f, 0.0f));
+    size_t child = batch.add(Vector3(0.0f, 2.0f, 0.0f), Quaternion(), Vector3(2.0f, 2.0f, 2.0f), root);
+    size_t grandchild = batch.add(Vector3(0.0f, 0.0f, 3.0f), Quaternion(), Vector3(1.0f, 1.0f, 1.0f), child);
+
+    Assert::AreEqual(TransformBatch::NO_PARENT, batch.parent(root));
+    Assert::AreEqual(root, batch.parent(child));
+    Assert::AreEqual(child, batch.parent(grandchild));
+
+    batch.update();
+
+    Vector3 p = batch.worldMatrix(grandchild).positionVector();
+    Assert::AreEqual(1.0f, p.x(), FP_ACC);
+    Assert::AreEqual(2.0f, p.y(), FP_ACC);
+    Assert::AreEqual(6.0f, p.z(), FP_ACC);
+
+    // Changes are picked up on the next update
+    batch.setPosition(root, Vector3(-1.0f, 0.0f, 0.0f));
+    batch.update();
+
+    p = batch.worldMatrix(grandchild).positionVector();
+    Assert::AreEqual(-1.0f, p.x(), FP_ACC);
+  }
+
+  TEST_METHOD(TransformBatch_InvalidParent)
+  {
+    TransformBatch batch;
+    Assert::ExpectException<std::runtime_error>([&batch]() { batch.add(Vector3(), Quaternion(), Vector3(1.0f, 1.0f, 1.0f), 0); });
+  }
+
+  TEST_METHOD(TransformBatch_ConcatenateCommonParent)
+  {
+    Matrix4 parent = Matrix4::Translation(Vector3(0.0f, 10.0f, 0.0f));
+    Matrix4 local[2] = {Matrix4::Scale(2.0f), Matrix4::Rotation(90.0f, Vector3(0.0f, 0.0f, 1.0f))};
+    Matrix4 world[2];
+
+    TransformBatch::Concatenate(parent, 2, local, world);
+
+    assertMatrixEqual(parent * local[0], world[0]);
+    assertMatrixEqual(parent * local[1], world[1]);
+  }
+
+  TEST_METHOD(TransformBatch_TransformPoints)
+  {
+    Vector3 points[] = {Vector3(1.0f, 0.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f)};
+    TransformBatch::TransformPoints(Matrix4::Translation(Vector3(1.0f, 2.0f, 3.0f)) * Matrix4::Scale(2.0f), 2, points, points);
+
+    Assert::AreEqual(3.0f, points[0].x(), FP_ACC);
+    Assert::AreEqual(2.0f, points[0].y(), FP_ACC);
+    Assert::AreEqual(3.0f, points[0].z(), FP_ACC);
+    Assert::AreEqual(1.0f, points[1].x(), FP_ACC);
+    Assert::AreEqual(4.0f, points[1].y(), FP_ACC);
+    Assert::AreEqual(3.0f, points[1].z(), FP_ACC);
+  }
+
+  TEST_METHOD(TransformBatch_Bounds)
+  {
+    Vector3 points[] = {Vector3(1.0f, -2.0f, 0.5f), Vector3(-3.0f, 4.0f, 0.0f), Vector3(0.0f, 0.0f, 7.0f)};
+    BoundingBox3 box = TransformBatch::Bounds(3, points);
+
+    Assert::IsTrue(Vector3(-3.0f, -2.0f, 0.0f) == box.lowerLeft());
+    Assert::IsTrue(Vector3(1.0f, 4.0f, 7.0f) == box.upperRight());
+  }
+};
+#endif /* DOXYGEN_SKIP */
+}
+}
+}
@@ -0,0 +1,158 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include <CppUnitTest.h>
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+#include <Engine_Maths/VertexCacheOptimiser.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+/**
+ * @brief Generates a grid of quads (two triangles each) with the triangles
+ *        in a scrambled order.
+ * @param size Number of quads along each side
+ * @return Triangle list indices
+ */
+std::vector<uint32_t> ScrambledGrid(uint32_t size)
+{
+  std::vector<uint32_t> indices;
+
+  for (uint32_t y = 0; y < size; y++)
+  {
+    for (uint32_t x = 0; x < size; x++)
+    {
+      uint32_t a = y * (size + 1) + x;
+      uint32_t b = a + size + 1;
+
+      uint32_t quad[] = {a, b, a + 1, a + 1, b, b + 1};
+      indices.insert(indices.end(), quad, quad + 6);
+    }
+  }
+
+  // Deterministic shuffle of whole triangles
+  uint32_t seed = 12345;
+  for (size_t i = indices.size() / 3 - 1; i > 0; i--)
+  {
+    seed = seed * 1103515245 + 12345;
+    size_t j = (seed >> 8) % (i + 1);
+    std::swap_ranges(indices.begin() + i * 3, indices.begin() + i * 3 + 3, indices.begin() + j * 3);
+  }
+
+  return indices;
+}
+
+/**
+ * @brief Gets the triangles of a triangle list, each rotated so that its
+ *        smallest index is first (preserving winding), in sorted order.
+ * @param indices Triangle list indices
+ * @return Sorted triangles
+ */
+std::vector<std::vector<uint32_t>> CanonicalTriangles(const std::vector<uint32_t> &indices)
+{
+  std::vector<std::vector<uint32_t>> tris;
+
+  for (size_t i = 0; i < indices.size(); i += 3)
+  {
+    std::vector<uint32_t> tri(indices.begin() + i, indices.begin() + i + 3);
+    std::rotate(tri.begin(), std::min_element(tri.begin(), tri.end()), tri.end());
+    tris.push_back(tri);
+  }
+
+  std::sort(tris.begin(), tris.end());
+  return tris;
+}
+}
+
+// clang-format off
+namespace Engine
+{
+namespace Maths
+{
+namespace Test
+{
+#ifndef DOXYGEN_SKIP
+TEST_CLASS(VertexCacheOptimiserTest)
+{
+public:
+  TEST_METHOD(VertexCacheOptimiser_Triangles)
+  {
+    const uint32_t size = 32;
+    const size_t numVertices = (size + 1) * (size + 1);
+
+    std::vector<uint32_t> indices = ScrambledGrid(size);
+    std::vector<uint32_t> original = indices;
+
+    float before = VertexCacheOptimiser::ACMR(indices);
+    VertexCacheOptimiser::OptimiseTriangles(indices, numVertices);
+    float after = VertexCacheOptimiser::ACMR(indices);
+
+    std::stringstream str;
+    str << "ACMR before: " << before << ", after: " << after;
+    Logger::WriteMessage(str.str().c_str());
+
+    // Same triangles with the same winding
+    Assert::IsTrue(CanonicalTriangles(original) == CanonicalTriangles(indices));
+
+    // A grid approaches 0.5 misses per triangle when optimal
+    Assert::IsTrue(after < before);
+    Assert::IsTrue(after < 0.8f);
+  }
+
+  TEST_METHOD(VertexCacheOptimiser_Fetch)
+  {
+    uint32_t data[] = {5, 2, 7, 7, 2, 0};
+    std::vector<uint32_t> indices(data, data + 6);
+
+    std::vector<uint32_t> remap;
+    size_t numVertices = VertexCacheOptimiser::OptimiseFetch(indices, 8, remap);
+
+    Assert::AreEqual((size_t)4, numVertices);
+
+    uint32_t expected[] = {0, 1, 2, 2, 1, 3};
+    for (size_t i = 0; i < 6; i++)
+      Assert::AreEqual(expected[i], indices[i]);
+
+    Assert::IsTrue(remap[1] == VertexCacheOptimiser::UNUSED);
+
+    std::vector<int> stream;
+    for (int i = 0; i < 8; i++)
+      stream.push_back(i * 10);
+
+    VertexCacheOptimiser::RemapStream(stream, remap, numVertices);
+
+    Assert::AreEqual((size_t)4, stream.size());
+    Assert::AreEqual(50, stream[0]);
+    Assert::AreEqual(20, stream[1]);
+    Assert::AreEqual(70, stream[2]);
+    Assert::AreEqual(0, stream[3]);
+  }
+
+  TEST_METHOD(VertexCacheOptimiser_ACMR)
+  {
+    // Two triangles sharing an edge need four transforms
+    uint32_t data[] = {0, 1, 2, 2, 1, 3};
+    std::vector<uint32_t> indices(data, data + 6);
+
+    Assert::AreEqual(2.0f, VertexCacheOptimiser::ACMR(indices), 0.0001f);
+
+    // Triangles sharing no vertices need three transforms each
+    uint32_t separate[] = {0, 1, 2, 3, 4, 5};
+    indices.assign(separate, separate + 6);
+
+    Assert::AreEqual(3.0f, VertexCacheOptimiser::ACMR(indices), 0.0001f);
+  }
+};
+#endif /* DOXYGEN_SKIP */
+}
+}
+}
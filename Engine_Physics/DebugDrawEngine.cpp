@@ -88,7 +88,7 @@ namespace Physics
   /**
    * @copydoc RenderableObject::draw
    */
-  void DebugDrawEngine::draw(GLuint program)
+  void DebugDrawEngine::draw(Engine::Graphics::ShaderProgram *program)
   {
     for (auto it = m_meshes.begin(); it != m_meshes.end(); ++it)
     {
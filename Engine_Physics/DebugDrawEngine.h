@@ -56,7 +56,7 @@ namespace Physics
     }
 
   protected:
-    virtual void draw(GLuint program);
+    virtual void draw(Engine::Graphics::ShaderProgram *program);
 
   private:
     int m_debugMode;                                //!< Debug mode
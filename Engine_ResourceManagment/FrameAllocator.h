@@ -0,0 +1,161 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#ifndef _ENGINE_RESOURCEMANAGMENT_FRAMEALLOCATOR_H_
+#define _ENGINE_RESOURCEMANAGMENT_FRAMEALLOCATOR_H_
+
+#include <cstddef>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "FrameArena.h"
+
+namespace Engine
+{
+namespace ResourceManagment
+{
+  /**
+   * @class FrameAllocator
+   * @brief Standard library compatible allocator that allocates from a
+   *        FrameArena.
+   * @author Dan Nixon
+   *
+   * Containers using this allocator must be destroyed (or have their storage
+   * released) before the arena is reset.
+   */
+  template <typename T> class FrameAllocator
+  {
+  public:
+    typedef T value_type;              //!< Allocated type
+    typedef T *pointer;                //!< Pointer to allocated type
+    typedef const T *const_pointer;    //!< Const pointer to allocated type
+    typedef T &reference;              //!< Reference to allocated type
+    typedef const T &const_reference;  //!< Const reference to allocated type
+    typedef size_t size_type;          //!< Size type
+    typedef ptrdiff_t difference_type; //!< Pointer difference type
+
+    /**
+     * @struct rebind
+     * @brief Gets an equivalent allocator for another type.
+     */
+    template <typename U> struct rebind
+    {
+      typedef FrameAllocator<U> other; //!< Allocator for U
+    };
+
+    /**
+     * @brief Creates an allocator using the per-frame arena.
+     */
+    FrameAllocator()
+        : m_arena(&FrameArena::Instance())
+    {
+    }
+
+    /**
+     * @brief Creates an allocator using a given arena.
+     * @param arena Arena to allocate from
+     */
+    FrameAllocator(FrameArena &arena)
+        : m_arena(&arena)
+    {
+    }
+
+    /**
+     * @brief Creates an allocator using the same arena as an allocator of
+     *        another type.
+     * @param other Allocator to copy
+     */
+    template <typename U>
+    FrameAllocator(const FrameAllocator<U> &other)
+        : m_arena(other.arena())
+    {
+    }
+
+    /**
+     * @brief Gets the arena memory is allocated from.
+     * @return Arena
+     */
+    inline FrameArena *arena() const
+    {
+      return m_arena;
+    }
+
+    /**
+     * @brief Allocates storage for a number of objects.
+     * @param n Number of objects
+     * @return Pointer to storage
+     */
+    T *allocate(size_t n)
+    {
+      if (n > max_size())
+        throw std::bad_alloc();
+
+      return static_cast<T *>(m_arena->allocate(n * sizeof(T), std::alignment_of<T>::value));
+    }
+
+    /**
+     * @brief Frees storage.
+     * @param p Pointer to storage
+     * @param n Number of objects storage was allocated for
+     */
+    void deallocate(T *p, size_t n)
+    {
+      m_arena->deallocate(p, n * sizeof(T));
+    }
+
+    /**
+     * @brief Gets the maximum number of objects that can be allocated.
+     * @return Max object count
+     */
+    inline size_t max_size() const
+    {
+      return ((size_t)-1) / sizeof(T);
+    }
+
+  private:
+    FrameArena *m_arena; //!< Arena memory is allocated from
+  };
+
+  /**
+   * @brief Tests if two allocators allocate from the same arena.
+   * @param a First allocator
+   * @param b Second allocator
+   * @return True if equal
+   */
+  template <typename T, typename U> inline bool operator==(const FrameAllocator<T> &a, const FrameAllocator<U> &b)
+  {
+    return a.arena() == b.arena();
+  }
+
+  /**
+   * @brief Tests if two allocators allocate from different arenas.
+   * @param a First allocator
+   * @param b Second allocator
+   * @return True if not equal
+   */
+  template <typename T, typename U> inline bool operator!=(const FrameAllocator<T> &a, const FrameAllocator<U> &b)
+  {
+    return a.arena() != b.arena();
+  }
+
+  /**
+   * @typedef FrameVector
+   * @brief Vector allocated from the per-frame arena.
+   */
+  template <typename T> using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+  /**
+   * @typedef FrameString
+   * @brief String allocated from the per-frame arena.
+   */
+  typedef std::basic_string<char, std::char_traits<char>, FrameAllocator<char>> FrameString;
+}
+}
+
+#endif
@@ -0,0 +1,146 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+namespace Engine
+{
+namespace ResourceManagment
+{
+  /**
+   * @brief Creates a new arena.
+   * @param blockSize Size of the first block and minimum size of further
+   *                  blocks (bytes)
+   */
+  FrameArena::FrameArena(size_t blockSize)
+      : m_blockSize(blockSize)
+      , m_current(0)
+      , m_offset(0)
+      , m_used(0)
+      , m_peak(0)
+  {
+    if (m_blockSize == 0)
+      throw std::runtime_error("FrameArena block size must be non-zero");
+
+    addBlock(m_blockSize);
+  }
+
+  FrameArena::~FrameArena()
+  {
+    for (auto it = m_blocks.begin(); it != m_blocks.end(); ++it)
+      delete[] it->data;
+  }
+
+  /**
+   * @brief Allocates memory that remains valid until the next reset.
+   * @param size Number of bytes
+   * @param alignment Alignment (must be a power of two)
+   * @return Pointer to memory
+   */
+  void *FrameArena::allocate(size_t size, size_t alignment)
+  {
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+      throw std::runtime_error("FrameArena alignment must be a power of two");
+
+    while (true)
+    {
+      Block &block = m_blocks[m_current];
+      uintptr_t start = (uintptr_t)(block.data + m_offset);
+      size_t padding = (size_t)((alignment - (start & (alignment - 1))) & (alignment - 1));
+
+      if (m_offset + padding + size <= block.size)
+      {
+        void *ptr = block.data + m_offset + padding;
+        m_offset += padding + size;
+        m_used += padding + size;
+        m_peak = std::max(m_peak, m_used);
+        return ptr;
+      }
+
+      // Move to the next block, adding one if needed
+      if (m_current + 1 == m_blocks.size())
+        addBlock(std::max(m_blockSize, size + alignment));
+
+      m_current++;
+      m_offset = 0;
+    }
+  }
+
+  /**
+   * @brief Frees memory allocated from the arena.
+   * @param ptr Pointer to memory
+   * @param size Number of bytes that were allocated
+   *
+   * Only the most recent allocation is actually reclaimed (so short lived
+   * temporaries made outside of a timed loop do not accumulate), all other
+   * memory is reclaimed on reset.
+   */
+  void FrameArena::deallocate(void *ptr, size_t size)
+  {
+    Block &block = m_blocks[m_current];
+    char *p = static_cast<char *>(ptr);
+
+    if (p >= block.data && p + size == block.data + m_offset)
+    {
+      m_offset -= size;
+      m_used -= size;
+    }
+  }
+
+  /**
+   * @brief Reclaims all memory allocated from the arena.
+   *
+   * All pointers to memory from the arena are invalidated.
+   */
+  void FrameArena::reset()
+  {
+    // Merge blocks if the last frame overflowed the first
+    if (m_blocks.size() > 1)
+    {
+      size_t total = capacity();
+
+      for (auto it = m_blocks.begin(); it != m_blocks.end(); ++it)
+        delete[] it->data;
+      m_blocks.clear();
+
+      addBlock(total);
+    }
+
+    m_current = 0;
+    m_offset = 0;
+    m_used = 0;
+  }
+
+  /**
+   * @brief Gets the total size of all blocks held.
+   * @return Capacity (bytes)
+   */
+  size_t FrameArena::capacity() const
+  {
+    size_t total = 0;
+    for (auto it = m_blocks.begin(); it != m_blocks.end(); ++it)
+      total += it->size;
+    return total;
+  }
+
+  /**
+   * @brief Allocates a new block and adds it to the end of the block list.
+   * @param size Size of block (bytes)
+   */
+  void FrameArena::addBlock(size_t size)
+  {
+    Block block;
+    block.data = new char[size];
+    block.size = size;
+    m_blocks.push_back(block);
+  }
+}
+}
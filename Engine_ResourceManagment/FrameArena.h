@@ -0,0 +1,129 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#ifndef _ENGINE_RESOURCEMANAGMENT_FRAMEARENA_H_
+#define _ENGINE_RESOURCEMANAGMENT_FRAMEARENA_H_
+
+#include <vector>
+
+namespace Engine
+{
+namespace ResourceManagment
+{
+  /**
+   * @class FrameArena
+   * @brief Linear (bump) allocator for temporaries that live no longer than
+   *        a single tick of a timed loop.
+   * @author Dan Nixon
+   *
+   * Allocations are made by advancing an offset into a block of memory,
+   * freeing is a no-op (other than for the most recent allocation, which is
+   * rolled back) and all memory is reclaimed at once by reset(). If a frame
+   * overflows the first block further blocks are allocated, these are merged
+   * into a single larger block on the next reset so that following frames do
+   * not touch the heap.
+   *
+   * The instance returned by Instance() is reset by Game after each tick of a
+   * timed loop and must only be used from the main thread.
+   */
+  class FrameArena
+  {
+  public:
+    static const size_t DEFAULT_BLOCK_SIZE = 64 * 1024; //!< Default size of the first block (bytes)
+    static const size_t DEFAULT_ALIGNMENT = 16;         //!< Default alignment of allocations (bytes)
+
+    /**
+     * @brief Gets the arena used for per-frame temporaries.
+     * @return Arena instance
+     */
+    static FrameArena &Instance()
+    {
+      static FrameArena instance;
+      return instance;
+    }
+
+    FrameArena(size_t blockSize = DEFAULT_BLOCK_SIZE);
+    virtual ~FrameArena();
+
+    /**
+     * @brief No copy constructor
+     */
+    FrameArena(FrameArena const &) = delete;
+
+    /**
+     * @brief No move constructor
+     */
+    FrameArena(FrameArena &&) = delete;
+
+    /**
+     * @brief No assign copy constructor
+     */
+    FrameArena &operator=(FrameArena const &) = delete;
+
+    /**
+     * @brief No assign move constructor
+     */
+    FrameArena &operator=(FrameArena &&) = delete;
+
+    void *allocate(size_t size, size_t alignment = DEFAULT_ALIGNMENT);
+    void deallocate(void *ptr, size_t size);
+    void reset();
+
+    /**
+     * @brief Gets the number of bytes allocated since the last reset
+     *        (including alignment padding).
+     * @return Bytes used
+     */
+    inline size_t bytesUsed() const
+    {
+      return m_used;
+    }
+
+    /**
+     * @brief Gets the largest number of bytes used between two resets.
+     * @return Peak bytes used
+     */
+    inline size_t peakBytesUsed() const
+    {
+      return m_peak;
+    }
+
+    /**
+     * @brief Gets the number of blocks currently held.
+     * @return Number of blocks
+     */
+    inline size_t numBlocks() const
+    {
+      return m_blocks.size();
+    }
+
+    size_t capacity() const;
+
+  private:
+    /**
+     * @struct Block
+     * @brief A contiguous region of memory allocations are made from.
+     */
+    struct Block
+    {
+      char *data;  //!< Start of memory
+      size_t size; //!< Size of memory (bytes)
+    };
+
+    void addBlock(size_t size);
+
+    std::vector<Block> m_blocks; //!< Memory blocks
+    size_t m_blockSize;          //!< Minimum size of a new block
+    size_t m_current;            //!< Index of the block allocations are made from
+    size_t m_offset;             //!< Offset of the next allocation in the current block
+    size_t m_used;               //!< Bytes allocated since last reset
+    size_t m_peak;               //!< Max bytes allocated between resets
+  };
+}
+}
+
+#endif
@@ -13,13 +13,57 @@ namespace Engine
 {
 namespace ResourceManagment
 {
+  /**
+   * @brief Allocates memory for a managed item.
+   * @param size Size of item
+   * @return Pointer to memory
+   */
+  void *IMemoryManaged::operator new(size_t size)
+  {
+    return MemoryManager::Instance().allocate(size);
+  }
+
+  /**
+   * @brief Frees memory used by a managed item.
+   * @param ptr Pointer to memory
+   * @param size Size of item
+   */
+  void IMemoryManaged::operator delete(void *ptr, size_t size)
+  {
+    MemoryManager::Instance().deallocate(ptr, size);
+  }
+
   IMemoryManaged::IMemoryManaged()
   {
     MemoryManager::Instance().recordAllocation(this);
   }
 
+  /**
+   * @brief Creates a copy of a managed item, the copy is recorded as a new
+   *        allocation.
+   * @param other Item to copy
+   */
+  IMemoryManaged::IMemoryManaged(const IMemoryManaged &other)
+  {
+    (void)other;
+    MemoryManager::Instance().recordAllocation(this);
+  }
+
   IMemoryManaged::~IMemoryManaged()
   {
+    // Ensure an item deleted directly is not released again
+    MemoryManager::Instance().forget(this);
   }
+
+  /**
+   * @brief Assignment operator, does not change the record of this item.
+   * @param other Item to copy
+   * @return Reference to this item
+   */
+  IMemoryManaged &IMemoryManaged::operator=(const IMemoryManaged &other)
+  {
+    (void)other;
+    return *this;
+  }
+}
 }
-}
\ No newline at end of file
@@ -8,6 +8,8 @@
 #ifndef _ENGINE_RESOURCEMANAGMENT_IMEMORYMANAGED_H_
 #define _ENGINE_RESOURCEMANAGMENT_IMEMORYMANAGED_H_
 
+#include <cstddef>
+
 namespace Engine
 {
 namespace ResourceManagment
@@ -16,13 +18,24 @@ namespace ResourceManagment
    * @class IMemoryManaged
    * @brief Abstract class for classes that are deallocated at game exit.
    * @author Dan Nixon
+   *
+   * Each item stores its index in the MemoryManager list of allocations so
+   * that it can be released in constant time. Heap allocations are made via
+   * the MemoryManager and their size is stored in the item so that the number
+   * of bytes used by each type can be reported.
    */
   class IMemoryManaged
   {
   public:
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr, size_t size);
+
     IMemoryManaged();
+    IMemoryManaged(const IMemoryManaged &other);
     virtual ~IMemoryManaged();
 
+    IMemoryManaged &operator=(const IMemoryManaged &other);
+
     /**
      * @brief Determines the order in which deallocation occurs.
      * @return Order
@@ -33,6 +46,12 @@ namespace ResourceManagment
     {
       return 0;
     }
+
+  private:
+    friend class MemoryManager;
+
+    size_t m_managedIndex;   //!< Index of this item in the MemoryManager allocation list
+    size_t m_allocationSize; //!< Size of the heap allocation holding this item (0 if not on the heap)
   };
 }
 }
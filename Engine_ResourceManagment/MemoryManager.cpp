@@ -8,6 +8,8 @@
 #include "MemoryManager.h"
 
 #include <algorithm>
+#include <map>
+#include <typeinfo>
 
 #include <iostream>
 
@@ -32,7 +34,24 @@ namespace ResourceManagment
    */
   void MemoryManager::recordAllocation(IMemoryManaged *item)
   {
+    item->m_managedIndex = m_allocatedItems.size();
+    item->m_allocationSize = 0;
     m_allocatedItems.push_back(item);
+
+    // The item may be a base subobject of the allocation, so match by range.
+    // Pending allocations only nest as deep as constructors that allocate
+    // other items, so this is usually a single comparison.
+    const char *addr = reinterpret_cast<const char *>(item);
+    for (size_t i = m_pending.size(); i > 0; i--)
+    {
+      const PendingAllocation &p = m_pending[i - 1];
+      if (addr >= p.ptr && addr < p.ptr + p.size)
+      {
+        item->m_allocationSize = p.size;
+        m_pending.erase(m_pending.begin() + (i - 1));
+        break;
+      }
+    }
   }
 
   /**
@@ -41,12 +60,11 @@ namespace ResourceManagment
    */
   void MemoryManager::release(IMemoryManaged *item)
   {
-    auto it = std::find(m_allocatedItems.begin(), m_allocatedItems.end(), item);
-    if (it != m_allocatedItems.end())
-    {
-      delete *it;
-      m_allocatedItems.erase(it);
-    }
+    if (item->m_managedIndex >= m_allocatedItems.size() || m_allocatedItems[item->m_managedIndex] != item)
+      return;
+
+    forget(item);
+    delete item;
   }
 
   /**
@@ -54,14 +72,18 @@ namespace ResourceManagment
    */
   void MemoryManager::releaseAll()
   {
-    std::sort(m_allocatedItems.begin(), m_allocatedItems.end(), MemoryManager::CompareItems);
+    std::vector<IMemoryManaged *> items;
+    items.swap(m_allocatedItems);
 
-    for (auto it = m_allocatedItems.begin(); it != m_allocatedItems.end(); ++it)
+    for (auto it = items.begin(); it != items.end(); ++it)
+      (*it)->m_managedIndex = INVALID_INDEX;
+
+    std::stable_sort(items.begin(), items.end(), MemoryManager::CompareItems);
+
+    for (auto it = items.begin(); it != items.end(); ++it)
     {
       delete *it;
     }
-
-    m_allocatedItems.clear();
   }
 
   /**
@@ -72,5 +94,108 @@ namespace ResourceManagment
   {
     return m_allocatedItems.size();
   }
+
+  /**
+   * @brief Allocates memory for a managed item.
+   * @param size Size of item (bytes)
+   * @param pool Pool to allocate from (nullptr to allocate from the heap)
+   * @return Pointer to memory
+   */
+  void *MemoryManager::allocate(size_t size, ObjectPool *pool)
+  {
+    void *ptr = (pool != nullptr) ? pool->allocate(size) : ::operator new(size);
+
+    PendingAllocation p;
+    p.ptr = static_cast<const char *>(ptr);
+    p.size = size;
+    m_pending.push_back(p);
+
+    m_numBytes += size;
+
+    return ptr;
+  }
+
+  /**
+   * @brief Frees memory allocated with MemoryManager::allocate.
+   * @param ptr Pointer to memory
+   * @param size Size of item (bytes)
+   * @param pool Pool memory was allocated from (nullptr if allocated from
+   *             the heap)
+   */
+  void MemoryManager::deallocate(void *ptr, size_t size, ObjectPool *pool)
+  {
+    if (ptr == nullptr)
+      return;
+
+    m_numBytes -= size;
+
+    // Only left pending if the constructor of the item threw
+    for (size_t i = m_pending.size(); i > 0; i--)
+    {
+      if (m_pending[i - 1].ptr == ptr)
+      {
+        m_pending.erase(m_pending.begin() + (i - 1));
+        break;
+      }
+    }
+
+    if (pool != nullptr)
+      pool->deallocate(ptr, size);
+    else
+      ::operator delete(ptr);
+  }
+
+  /**
+   * @brief Gets the number of live managed items and bytes used by each
+   *        type.
+   * @param out Vector statistics are appended to (ordered by most bytes
+   *            used)
+   */
+  void MemoryManager::typeStats(std::vector<ManagedTypeStats> &out) const
+  {
+    std::map<std::string, ManagedTypeStats> types;
+
+    for (auto it = m_allocatedItems.begin(); it != m_allocatedItems.end(); ++it)
+    {
+      std::string name = typeid(**it).name();
+      auto type = types.find(name);
+      if (type == types.end())
+      {
+        ManagedTypeStats s = {name, 0, 0};
+        type = types.insert(std::make_pair(name, s)).first;
+      }
+
+      ManagedTypeStats &s = type->second;
+      s.count++;
+      s.bytes += (*it)->m_allocationSize;
+    }
+
+    size_t start = out.size();
+    for (auto it = types.begin(); it != types.end(); ++it)
+      out.push_back(it->second);
+
+    std::stable_sort(out.begin() + start, out.end(),
+                     [](const ManagedTypeStats &a, const ManagedTypeStats &b) { return a.bytes > b.bytes; });
+  }
+
+  /**
+   * @brief Removes the record of an item without deleting it.
+   * @param item Item to forget
+   *
+   * The last item in the list is moved into the slot of the removed item.
+   */
+  void MemoryManager::forget(IMemoryManaged *item)
+  {
+    size_t idx = item->m_managedIndex;
+    if (idx >= m_allocatedItems.size() || m_allocatedItems[idx] != item)
+      return;
+
+    IMemoryManaged *last = m_allocatedItems.back();
+    m_allocatedItems[idx] = last;
+    last->m_managedIndex = idx;
+    m_allocatedItems.pop_back();
+
+    item->m_managedIndex = INVALID_INDEX;
+  }
 }
 }
@@ -8,18 +8,34 @@
 #ifndef _ENGINE_RESOURCEMANAGMENT_MEMORYMANAGER_H_
 #define _ENGINE_RESOURCEMANAGMENT_MEMORYMANAGER_H_
 
+#include <string>
 #include <vector>
 
 #include "IMemoryManaged.h"
+#include "ObjectPool.h"
 
 namespace Engine
 {
 namespace ResourceManagment
 {
+  /**
+   * @struct ManagedTypeStats
+   * @brief Number of live managed items of a type and memory they use.
+   */
+  struct ManagedTypeStats
+  {
+    std::string name; //!< Type name
+    size_t count;     //!< Number of live items
+    size_t bytes;     //!< Bytes used by items allocated on the heap
+  };
+
   /**
    * @class MemoryManager
    * @brief Manager for deallocating memory on game exit.
    * @author Dan Nixon
+   *
+   * Items are recorded when constructed and forgotten when destroyed.
+   * Recording, forgetting and releasing an item are constant time.
    */
   class MemoryManager
   {
@@ -62,11 +78,49 @@ namespace ResourceManagment
 
     size_t numAllocations() const;
 
+    void *allocate(size_t size, ObjectPool *pool = nullptr);
+    void deallocate(void *ptr, size_t size, ObjectPool *pool = nullptr);
+
+    /**
+     * @brief Gets the number of bytes allocated for managed items.
+     * @return Bytes allocated
+     */
+    inline size_t numBytes() const
+    {
+      return m_numBytes;
+    }
+
+    void typeStats(std::vector<ManagedTypeStats> &out) const;
+
   private:
+    friend class IMemoryManaged;
+
+    /**
+     * @var INVALID_INDEX
+     * @brief Index of an item that is not recorded.
+     */
+    static const size_t INVALID_INDEX = (size_t)-1;
+
+    /**
+     * @struct PendingAllocation
+     * @brief Memory that has been allocated for an item that has not yet been
+     *        constructed.
+     */
+    struct PendingAllocation
+    {
+      const char *ptr; //!< Start of allocated memory
+      size_t size;     //!< Size of allocated memory (bytes)
+    };
+
+    void forget(IMemoryManaged *item);
+
     std::vector<IMemoryManaged *> m_allocatedItems; //!< Pointer to all allocated items
+    std::vector<PendingAllocation> m_pending;       //!< Allocations waiting for their item to be recorded
+    size_t m_numBytes;                              //!< Total size of heap allocated items
 
   private:
     MemoryManager()
+        : m_numBytes(0)
     {
     }
   };
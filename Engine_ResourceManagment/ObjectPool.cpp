@@ -0,0 +1,106 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include "ObjectPool.h"
+
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+
+namespace Engine
+{
+namespace ResourceManagment
+{
+  /**
+   * @brief Creates a new, empty pool.
+   * @param objectSize Size of objects (bytes)
+   * @param objectsPerSlab Number of objects to allocate memory for at once
+   */
+  ObjectPool::ObjectPool(size_t objectSize, size_t objectsPerSlab)
+      : m_objectSize(objectSize)
+      , m_slotSize((std::max(objectSize, sizeof(FreeNode)) + ALIGNMENT - 1) & ~(ALIGNMENT - 1))
+      , m_objectsPerSlab(objectsPerSlab)
+      , m_freeList(nullptr)
+      , m_live(0)
+  {
+    if (m_objectSize == 0 || m_objectsPerSlab == 0)
+      throw std::runtime_error("ObjectPool object size and slab size must be non-zero");
+  }
+
+  /**
+   * @brief Frees all slabs, provided no objects are still allocated (in
+   *        which case the slabs are leaked rather than freed under them).
+   */
+  ObjectPool::~ObjectPool()
+  {
+    if (m_live > 0)
+      return;
+
+    for (auto it = m_slabs.begin(); it != m_slabs.end(); ++it)
+      ::operator delete(*it);
+  }
+
+  /**
+   * @brief Allocates memory for an object.
+   * @param size Size of object (bytes)
+   * @return Pointer to memory
+   */
+  void *ObjectPool::allocate(size_t size)
+  {
+    if (size != m_objectSize)
+      return ::operator new(size);
+
+    if (m_freeList == nullptr)
+      addSlab();
+
+    FreeNode *node = m_freeList;
+    m_freeList = node->next;
+    m_live++;
+
+    return node;
+  }
+
+  /**
+   * @brief Returns memory for an object to the pool.
+   * @param ptr Pointer to memory
+   * @param size Size of object (bytes)
+   */
+  void ObjectPool::deallocate(void *ptr, size_t size)
+  {
+    if (ptr == nullptr)
+      return;
+
+    if (size != m_objectSize)
+    {
+      ::operator delete(ptr);
+      return;
+    }
+
+    FreeNode *node = static_cast<FreeNode *>(ptr);
+    node->next = m_freeList;
+    m_freeList = node;
+    m_live--;
+  }
+
+  /**
+   * @brief Allocates a new slab and adds its objects to the free list.
+   */
+  void ObjectPool::addSlab()
+  {
+    char *slab = static_cast<char *>(::operator new(m_slotSize * m_objectsPerSlab));
+    m_slabs.push_back(slab);
+
+    // Link in reverse so objects are handed out in address order
+    for (size_t i = m_objectsPerSlab; i > 0; i--)
+    {
+      FreeNode *node = reinterpret_cast<FreeNode *>(slab + (i - 1) * m_slotSize);
+      node->next = m_freeList;
+      m_freeList = node;
+    }
+  }
+}
+}
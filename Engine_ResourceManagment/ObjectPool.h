@@ -0,0 +1,102 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#ifndef _ENGINE_RESOURCEMANAGMENT_OBJECTPOOL_H_
+#define _ENGINE_RESOURCEMANAGMENT_OBJECTPOOL_H_
+
+#include <vector>
+
+namespace Engine
+{
+namespace ResourceManagment
+{
+  /**
+   * @class ObjectPool
+   * @brief Free list allocator for objects of a single size.
+   * @author Dan Nixon
+   *
+   * Memory is allocated in slabs of several objects, freed objects are kept
+   * on a free list for reuse and slabs are never returned to the heap while
+   * the pool exists. Allocations of any other size (e.g. of a derived type)
+   * are passed to the global operator new.
+   *
+   * Intended to be used from a class specific operator new/delete (via
+   * MemoryManager::allocate) for frequently created types.
+   */
+  class ObjectPool
+  {
+  public:
+    static const size_t DEFAULT_SLAB_OBJECTS = 64; //!< Default number of objects allocated at once
+    static const size_t ALIGNMENT = 16;            //!< Alignment of objects (bytes)
+
+    ObjectPool(size_t objectSize, size_t objectsPerSlab = DEFAULT_SLAB_OBJECTS);
+    virtual ~ObjectPool();
+
+    /**
+     * @brief No copy constructor
+     */
+    ObjectPool(ObjectPool const &) = delete;
+
+    /**
+     * @brief No assign copy constructor
+     */
+    ObjectPool &operator=(ObjectPool const &) = delete;
+
+    void *allocate(size_t size);
+    void deallocate(void *ptr, size_t size);
+
+    /**
+     * @brief Gets the size of objects allocated from the pool.
+     * @return Object size (bytes)
+     */
+    inline size_t objectSize() const
+    {
+      return m_objectSize;
+    }
+
+    /**
+     * @brief Gets the number of objects currently allocated from the pool.
+     * @return Number of live objects
+     */
+    inline size_t liveCount() const
+    {
+      return m_live;
+    }
+
+    /**
+     * @brief Gets the number of objects the pool can hold without allocating
+     *        a new slab.
+     * @return Capacity (objects)
+     */
+    inline size_t capacity() const
+    {
+      return m_slabs.size() * m_objectsPerSlab;
+    }
+
+  private:
+    /**
+     * @struct FreeNode
+     * @brief Link in the free list, stored in the memory of a free object.
+     */
+    struct FreeNode
+    {
+      FreeNode *next; //!< Next free object
+    };
+
+    void addSlab();
+
+    const size_t m_objectSize;     //!< Size of objects allocated from the pool
+    const size_t m_slotSize;       //!< Size of each object slot (aligned object size)
+    const size_t m_objectsPerSlab; //!< Number of objects in each slab
+    std::vector<char *> m_slabs;   //!< Allocated slabs
+    FreeNode *m_freeList;          //!< Head of the list of free objects
+    size_t m_live;                 //!< Number of allocated objects
+  };
+}
+}
+
+#endif
@@ -0,0 +1,298 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include "ResourceLoader.h"
+
+#include <exception>
+
+#include <Engine_Utility/TraceProfiler.h>
+
+using namespace Engine::Utility;
+
+namespace Engine
+{
+namespace ResourceManagment
+{
+  /**
+   * @brief Creates a new loader and starts its worker threads.
+   * @param numWorkers Number of worker threads (if zero, one less than the
+   *                   number of hardware threads is used)
+   *
+   * The thread creating the ResourceLoader is considered its owner and is
+   * the only thread that may call processUploads and finish.
+   */
+  ResourceLoader::ResourceLoader(size_t numWorkers)
+      : m_running(true)
+      , m_numRequested(0)
+      , m_numCompleted(0)
+  {
+    if (numWorkers == 0)
+    {
+      unsigned int hw = std::thread::hardware_concurrency();
+      numWorkers = hw > 1 ? hw - 1 : 1;
+    }
+
+    for (size_t i = 0; i < numWorkers; i++)
+      m_workers.push_back(std::thread(&ResourceLoader::workerMain, this, i));
+  }
+
+  /**
+   * @brief Stops and joins all worker threads.
+   *
+   * Requests that have not completed fail without their upload function or
+   * completion callback being called.
+   */
+  ResourceLoader::~ResourceLoader()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_running = false;
+    }
+    m_wake.notify_all();
+
+    for (auto it = m_workers.begin(); it != m_workers.end(); ++it)
+      it->join();
+
+    for (auto it = m_loadQueue.begin(); it != m_loadQueue.end(); ++it)
+    {
+      (*it)->result.set_value(false);
+      delete *it;
+    }
+
+    for (auto it = m_uploadQueue.begin(); it != m_uploadQueue.end(); ++it)
+    {
+      (*it)->result.set_value(false);
+      delete *it;
+    }
+  }
+
+  /**
+   * @brief Queues a resource to be loaded.
+   * @param name Name of the resource (used for trace profiling)
+   * @param load Function executed on a worker thread
+   * @param upload Function executed on the owning thread if the load
+   *               succeeds (may be empty)
+   * @param callback Function called on the owning thread once the request
+   *                 has completed (may be empty)
+   * @return Future holding the result of the request
+   *
+   * Queuing a request when none are pending starts a new batch for the
+   * purpose of reporting progress.
+   */
+  std::shared_future<bool> ResourceLoader::queue(const std::string &name, LoadFunction load, UploadFunction upload,
+                                                 CompletionCallback callback)
+  {
+    Request *request = new Request();
+    request->traceName = TraceProfiler::Intern(name);
+    request->load = load;
+    request->upload = upload;
+    request->callback = callback;
+    request->loaded = false;
+
+    std::shared_future<bool> result = request->result.get_future().share();
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      if (m_numCompleted == m_numRequested)
+      {
+        m_numRequested = 0;
+        m_numCompleted = 0;
+      }
+
+      m_numRequested++;
+      m_loadQueue.push_back(request);
+    }
+    m_wake.notify_all();
+
+    return result;
+  }
+
+  /**
+   * @brief Uploads resources that have finished loading and completes their
+   *        requests.
+   * @param maxTime Time after which no further uploads are started (0 for no
+   *                limit)
+   * @param maxCount Max number of requests to complete (0 for no limit)
+   * @return Number of requests completed
+   *
+   * Must be called regularly (e.g. once per frame) by the owning thread.
+   */
+  size_t ResourceLoader::processUploads(Clock::Nanoseconds maxTime, size_t maxCount)
+  {
+    const Clock::Nanoseconds start = (maxTime > 0) ? Clock::Now() : 0;
+
+    size_t completed = 0;
+    while (maxCount == 0 || completed < maxCount)
+    {
+      Request *request = nullptr;
+
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_uploadQueue.empty())
+          break;
+
+        request = m_uploadQueue.front();
+        m_uploadQueue.pop_front();
+      }
+
+      complete(request);
+      completed++;
+
+      if (maxTime > 0 && Clock::Now() - start >= maxTime)
+        break;
+    }
+
+    return completed;
+  }
+
+  /**
+   * @brief Waits for all pending requests to complete, uploading resources
+   *        as they finish loading.
+   *
+   * Must only be called by the owning thread.
+   */
+  void ResourceLoader::finish()
+  {
+    while (true)
+    {
+      processUploads();
+
+      std::unique_lock<std::mutex> lock(m_mutex);
+      if (m_numCompleted == m_numRequested)
+        break;
+
+      m_wake.wait(lock, [this]() { return !m_uploadQueue.empty() || m_numCompleted == m_numRequested; });
+    }
+  }
+
+  /**
+   * @brief Gets the number of requests that have not yet completed.
+   * @return Number of pending requests
+   */
+  size_t ResourceLoader::numPending() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_numRequested - m_numCompleted;
+  }
+
+  /**
+   * @brief Gets the number of requests in the current batch.
+   * @return Number of requests
+   */
+  size_t ResourceLoader::numRequested() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_numRequested;
+  }
+
+  /**
+   * @brief Gets the number of completed requests in the current batch.
+   * @return Number of completed requests
+   */
+  size_t ResourceLoader::numCompleted() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_numCompleted;
+  }
+
+  /**
+   * @brief Gets the progress of the current batch of requests.
+   * @return Fraction of requests completed (1 if none are pending)
+   */
+  float ResourceLoader::progress() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_numRequested == 0)
+      return 1.0f;
+
+    return (float)m_numCompleted / (float)m_numRequested;
+  }
+
+  /**
+   * @brief Main function of a worker thread.
+   * @param idx Index of the worker
+   */
+  void ResourceLoader::workerMain(size_t idx)
+  {
+    TraceProfiler::SetThreadName("Loader " + std::to_string(idx));
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+      m_wake.wait(lock, [this]() { return !m_running || !m_loadQueue.empty(); });
+      if (!m_running)
+        break;
+
+      Request *request = m_loadQueue.front();
+      m_loadQueue.pop_front();
+
+      lock.unlock();
+
+      {
+        PROFILE_SCOPE(request->traceName);
+
+        try
+        {
+          request->loaded = !request->load || request->load();
+        }
+        catch (std::exception &)
+        {
+          request->loaded = false;
+        }
+      }
+
+      lock.lock();
+      m_uploadQueue.push_back(request);
+      m_wake.notify_all();
+    }
+  }
+
+  /**
+   * @brief Uploads a loaded resource, notifies the requester and frees the
+   *        request.
+   * @param request Loaded request
+   */
+  void ResourceLoader::complete(Request *request)
+  {
+    bool result = request->loaded;
+
+    if (result && request->upload)
+    {
+      PROFILE_SCOPE(request->traceName);
+
+      try
+      {
+        result = request->upload();
+      }
+      catch (std::exception &)
+      {
+        result = false;
+      }
+    }
+
+    if (request->callback)
+    {
+      // The request must still be resolved and counted if the callback fails
+      try
+      {
+        request->callback(result);
+      }
+      catch (std::exception &)
+      {
+        result = false;
+      }
+    }
+
+    request->result.set_value(result);
+    delete request;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_numCompleted++;
+  }
+}
+}
@@ -0,0 +1,129 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#ifndef _ENGINE_RESOURCEMANAGMENT_RESOURCELOADER_H_
+#define _ENGINE_RESOURCEMANAGMENT_RESOURCELOADER_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <Engine_Utility/Clock.h>
+
+namespace Engine
+{
+namespace ResourceManagment
+{
+  /**
+   * @class ResourceLoader
+   * @brief Loads resources in two stages: file I/O and decoding on a pool of
+   *        worker threads, then upload (e.g. to GL or AL) on the thread that
+   *        owns the loader.
+   * @author Dan Nixon
+   *
+   * Each request has a load function, executed on a worker, and an upload
+   * function, executed by ResourceLoader::processUploads once the load has
+   * succeeded. Load functions must not create managed objects or touch any
+   * state that is not safe to use from another thread; they should only
+   * produce CPU side data to be consumed by the upload function.
+   *
+   * The result of each request is available through the returned future
+   * and an optional completion callback (called on the owning thread).
+   */
+  class ResourceLoader
+  {
+  public:
+    /**
+     * @typedef LoadFunction
+     * @brief Function executed on a worker thread, returns true on success.
+     */
+    typedef std::function<bool()> LoadFunction;
+
+    /**
+     * @typedef UploadFunction
+     * @brief Function executed on the owning thread after a successful load,
+     *        returns true on success.
+     */
+    typedef std::function<bool()> UploadFunction;
+
+    /**
+     * @typedef CompletionCallback
+     * @brief Function called on the owning thread when a request completes,
+     *        with the result of the request.
+     */
+    typedef std::function<void(bool)> CompletionCallback;
+
+    ResourceLoader(size_t numWorkers = 0);
+    virtual ~ResourceLoader();
+
+    /**
+     * @brief No copy constructor
+     */
+    ResourceLoader(ResourceLoader const &) = delete;
+
+    /**
+     * @brief No assign copy constructor
+     */
+    ResourceLoader &operator=(ResourceLoader const &) = delete;
+
+    /**
+     * @brief Gets the number of worker threads.
+     * @return Number of workers
+     */
+    inline size_t numWorkers() const
+    {
+      return m_workers.size();
+    }
+
+    std::shared_future<bool> queue(const std::string &name, LoadFunction load, UploadFunction upload,
+                                   CompletionCallback callback = nullptr);
+
+    size_t processUploads(Engine::Utility::Clock::Nanoseconds maxTime = 0, size_t maxCount = 0);
+    void finish();
+
+    size_t numPending() const;
+    size_t numRequested() const;
+    size_t numCompleted() const;
+    float progress() const;
+
+  private:
+    /**
+     * @struct Request
+     * @brief A queued resource load.
+     */
+    struct Request
+    {
+      const char *traceName;       //!< Name used for trace profiling
+      LoadFunction load;           //!< Function executed on a worker
+      UploadFunction upload;       //!< Function executed on the owning thread
+      CompletionCallback callback; //!< Function called on completion
+      std::promise<bool> result;   //!< Result of the request
+      bool loaded;                 //!< Flag indicating the load function succeeded
+    };
+
+    void workerMain(size_t idx);
+    void complete(Request *request);
+
+    std::vector<std::thread> m_workers; //!< Worker threads
+    bool m_running;                     //!< Flag indicating workers should keep running
+
+    mutable std::mutex m_mutex;          //!< Mutex protecting the queues and counters
+    std::condition_variable m_wake;      //!< Signalled when requests are queued or loaded
+    std::deque<Request *> m_loadQueue;   //!< Requests waiting to be loaded
+    std::deque<Request *> m_uploadQueue; //!< Requests waiting to be uploaded
+    size_t m_numRequested;               //!< Number of requests in the current batch
+    size_t m_numCompleted;               //!< Number of completed requests in the current batch
+  };
+}
+}
+
+#endif
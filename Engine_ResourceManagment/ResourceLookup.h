@@ -8,7 +8,12 @@
 #ifndef _ENGINE_RESOURCEMANAGMENT_RESOURCELOOKUP_H_
 #define _ENGINE_RESOURCEMANAGMENT_RESOURCELOOKUP_H_
 
-#include <map>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace Engine
 {
@@ -18,10 +23,29 @@ namespace ResourceManagment
    * @class ResourceLookup
    * @brief Singleton to hold a map of identifier string to object.
    * @author Dan Nixon
+   *
+   * Each name is given a handle when first added, which remains valid (and
+   * refers to the same name) for the lifetime of the lookup, so resources
+   * used frequently can be retrieved by handle without hashing a string.
+   *
+   * Resources may optionally be reference counted, in which case they are
+   * removed by evictUnused() once all references have been released.
    */
   template <typename T> class ResourceLookup
   {
   public:
+    /**
+     * @typedef Handle
+     * @brief Identifier of a named resource.
+     */
+    typedef uint32_t Handle;
+
+    /**
+     * @var INVALID_HANDLE
+     * @brief Handle that does not refer to any resource.
+     */
+    static const Handle INVALID_HANDLE = 0xFFFFFFFF;
+
     /**
      * @brief Gets an instance of the lookup.
      * @return Instance of this type of lookup
@@ -53,23 +77,117 @@ namespace ResourceManagment
     ResourceLookup &operator=(ResourceLookup &&) = delete;
 
     /**
-     * @brief Records a new entry in the lookup.
+     * @brief Records a new entry in the lookup, replacing any existing entry
+     *        of the same name.
      * @param name String identifier
      * @param item Resource
+     * @param refCounted If the resource may be evicted when unreferenced
+     * @return Handle of the resource
+     */
+    Handle add(const std::string &name, T item, bool refCounted = false)
+    {
+      Handle h = intern(name);
+      Entry &e = m_entries[h];
+      e.item = item;
+      e.present = true;
+      e.refCounted = refCounted;
+      e.references = 0;
+      return h;
+    }
+
+    /**
+     * @brief Removes an entry from the lookup (the handle remains reserved
+     *        for the name).
+     * @param name String identifier
+     * @return True if an entry was removed
+     */
+    bool remove(const std::string &name)
+    {
+      Handle h = handle(name);
+      if (h == INVALID_HANDLE || !m_entries[h].present)
+        return false;
+
+      m_entries[h].item = T();
+      m_entries[h].present = false;
+      return true;
+    }
+
+    /**
+     * @brief Gets the handle of a resource without adding it.
+     * @param name String identifier
+     * @return Handle, INVALID_HANDLE if the name has never been added
+     */
+    Handle handle(const std::string &name) const
+    {
+      auto it = m_handles.find(name);
+      if (it == m_handles.end())
+        return INVALID_HANDLE;
+
+      return it->second;
+    }
+
+    /**
+     * @brief Gets the name of a resource.
+     * @param h Handle
+     * @return String identifier
+     */
+    const std::string &name(Handle h) const
+    {
+      if (h >= m_entries.size())
+        throw std::runtime_error("Invalid resource handle");
+
+      return m_entries[h].name;
+    }
+
+    /**
+     * @brief Checks if a resource is present.
+     * @param h Handle
+     * @return True if present
      */
-    void add(const std::string &name, T item)
+    bool has(Handle h) const
     {
-      m_items[name] = item;
+      return h < m_entries.size() && m_entries[h].present;
+    }
+
+    /**
+     * @brief Gets a pointer to a resource given its identifier (does not add
+     *        an entry on a miss).
+     * @param name String identifier
+     * @return Pointer to resource, nullptr if not present
+     */
+    T *find(const std::string &name)
+    {
+      return find(handle(name));
+    }
+
+    /**
+     * @brief Gets a pointer to a resource given its handle.
+     * @param h Handle
+     * @return Pointer to resource, nullptr if not present
+     */
+    T *find(Handle h)
+    {
+      return has(h) ? &(m_entries[h].item) : nullptr;
     }
 
     /**
      * @brief Gets a resource given its identifier.
      * @param name String identifier
-     * @returns Resource
+     * @returns Resource (default value if not present)
      */
-    T get(const std::string &name)
+    T get(const std::string &name) const
     {
-      return m_items[name];
+      return get(handle(name));
+    }
+
+    /**
+     * @brief Gets a resource given its handle.
+     * @param h Handle
+     * @returns Resource (default value if not present)
+     */
+    T get(Handle h) const
+    {
+      return has(h) ? m_entries[h].item : T();
     }
 
     /**
@@ -79,11 +197,133 @@ namespace ResourceManagment
      */
     T &reference(const std::string &name)
     {
-      return m_items[name];
+      T *item = find(name);
+      if (item == nullptr)
+        throw std::runtime_error("No resource named " + name);
+
+      return *item;
+    }
+
+    /**
+     * @brief Gets the number of resources present.
+     * @return Number of resources
+     */
+    size_t size() const
+    {
+      size_t n = 0;
+      for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+      {
+        if (it->present)
+          n++;
+      }
+      return n;
+    }
+
+    /**
+     * @brief Adds a reference to a resource.
+     * @param h Handle
+     * @return Resource (default value if not present)
+     */
+    T acquire(Handle h)
+    {
+      if (!has(h))
+        return T();
+
+      m_entries[h].references++;
+      return m_entries[h].item;
+    }
+
+    /**
+     * @brief Removes a reference to a resource.
+     * @param h Handle
+     * @return True if the resource is no longer referenced
+     */
+    bool release(Handle h)
+    {
+      if (!has(h) || m_entries[h].references == 0)
+        return false;
+
+      return --m_entries[h].references == 0;
+    }
+
+    /**
+     * @brief Gets the number of references to a resource.
+     * @param h Handle
+     * @return Reference count
+     */
+    size_t references(Handle h) const
+    {
+      return has(h) ? m_entries[h].references : 0;
+    }
+
+    /**
+     * @brief Removes reference counted resources that are not referenced.
+     * @param evict Function called with each resource before it is removed
+     *              (e.g. to free it)
+     * @return Number of resources removed
+     */
+    size_t evictUnused(std::function<void(T &)> evict = nullptr)
+    {
+      size_t n = 0;
+
+      for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+      {
+        if (it->present && it->refCounted && it->references == 0)
+        {
+          if (evict)
+            evict(it->item);
+
+          it->item = T();
+          it->present = false;
+          n++;
+        }
+      }
+
+      return n;
     }
 
   private:
-    std::map<std::string, T> m_items; //!< Wrapped map
+    /**
+     * @struct Entry
+     * @brief Storage for a single named resource.
+     */
+    struct Entry
+    {
+      std::string name;  //!< String identifier
+      T item;            //!< Resource
+      bool present;      //!< If the resource is present
+      bool refCounted;   //!< If the resource is evicted when unreferenced
+      size_t references; //!< Reference count
+    };
+
+    /**
+     * @brief Gets the handle for a name, reserving one if it has not been
+     *        seen before.
+     * @param name String identifier
+     * @return Handle
+     */
+    Handle intern(const std::string &name)
+    {
+      auto it = m_handles.find(name);
+      if (it != m_handles.end())
+        return it->second;
+
+      Handle h = (Handle)m_entries.size();
+
+      Entry e;
+      e.name = name;
+      e.item = T();
+      e.present = false;
+      e.refCounted = false;
+      e.references = 0;
+      m_entries.push_back(e);
+
+      m_handles[name] = h;
+      return h;
+    }
+
+    std::vector<Entry> m_entries;                      //!< Resources indexed by handle
+    std::unordered_map<std::string, Handle> m_handles; //!< Handle of each name
 
   private:
     ResourceLookup()
@@ -0,0 +1,109 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include "Clock.h"
+
+#if defined(_MSC_VER) && _MSC_VER < 1900
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <chrono>
+#endif
+
+namespace Engine
+{
+namespace Utility
+{
+  /**
+   * @brief Gets the current time of the monotonic clock.
+   * @return Time in nanoseconds (from an unspecified epoch)
+   *
+   * Uses std::chrono::steady_clock, except on Visual Studio 2013 where
+   * steady_clock is not high resolution and the performance counter is used
+   * instead.
+   */
+  Clock::Nanoseconds Clock::Now()
+  {
+#if defined(_MSC_VER) && _MSC_VER < 1900
+    static LARGE_INTEGER freq = {};
+    if (freq.QuadPart == 0)
+      QueryPerformanceFrequency(&freq);
+
+    LARGE_INTEGER t;
+    QueryPerformanceCounter(&t);
+
+    // Split to avoid overflow of t * NS_PER_S
+    const Nanoseconds seconds = t.QuadPart / freq.QuadPart;
+    const Nanoseconds remainder = t.QuadPart % freq.QuadPart;
+    return seconds * NS_PER_S + (remainder * NS_PER_S) / freq.QuadPart;
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+  }
+
+  /**
+   * @brief Creates a new clock started at the current time.
+   */
+  Clock::Clock()
+      : m_start(Now())
+  {
+  }
+
+  Clock::~Clock()
+  {
+  }
+
+  /**
+   * @brief Restarts the clock at the current time.
+   */
+  void Clock::reset()
+  {
+    m_start = Now();
+  }
+
+  /**
+   * @brief Restarts the clock at a given time.
+   * @param start Start time (as returned by Clock::Now)
+   */
+  void Clock::reset(Nanoseconds start)
+  {
+    m_start = start;
+  }
+
+  /**
+   * @brief Gets the time since the clock was started.
+   * @return Elapsed time in nanoseconds
+   */
+  Clock::Nanoseconds Clock::elapsed() const
+  {
+    return Now() - m_start;
+  }
+
+  /**
+   * @brief Gets the time since the clock was started in milliseconds.
+   * @return Elapsed time in milliseconds
+   */
+  double Clock::elapsedMilliSec() const
+  {
+    return ToMilliSec(elapsed());
+  }
+
+  /**
+   * @brief Gets the time since the clock was started in milliseconds (single
+   *        precision).
+   * @return Elapsed time in milliseconds
+   *
+   * Precision degrades with uptime, use Clock::elapsed for computing
+   * durations.
+   */
+  float Clock::elapsedMilliSecF() const
+  {
+    return ToMilliSecF(elapsed());
+  }
+}
+}
@@ -0,0 +1,96 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#ifndef _ENGINE_UTILITY_CLOCK_H_
+#define _ENGINE_UTILITY_CLOCK_H_
+
+#include <cstdint>
+
+namespace Engine
+{
+namespace Utility
+{
+  /**
+   * @class Clock
+   * @brief Monotonic clock measuring time in integer nanoseconds.
+   * @author Dan Nixon
+   *
+   * Times are held as 64 bit nanosecond counts so that precision does not
+   * degrade with uptime (a float millisecond value has a resolution of 16ms
+   * after 72 hours). Floating point views should only be taken of differences
+   * between times.
+   */
+  class Clock
+  {
+  public:
+    /**
+     * @typedef Nanoseconds
+     * @brief Time or duration in nanoseconds.
+     */
+    typedef int64_t Nanoseconds;
+
+    static const Nanoseconds NS_PER_MS = 1000000LL;  //!< Nanoseconds per millisecond
+    static const Nanoseconds NS_PER_S = 1000000000LL; //!< Nanoseconds per second
+
+    static Nanoseconds Now();
+
+    /**
+     * @brief Converts a duration to milliseconds.
+     * @param ns Duration in nanoseconds
+     * @return Duration in milliseconds
+     */
+    static inline double ToMilliSec(Nanoseconds ns)
+    {
+      return (double)ns / (double)NS_PER_MS;
+    }
+
+    /**
+     * @brief Converts a duration to milliseconds (single precision).
+     * @param ns Duration in nanoseconds
+     * @return Duration in milliseconds
+     */
+    static inline float ToMilliSecF(Nanoseconds ns)
+    {
+      return (float)ToMilliSec(ns);
+    }
+
+    /**
+     * @brief Converts a duration in milliseconds to nanoseconds.
+     * @param milliSec Duration in milliseconds
+     * @return Duration in nanoseconds
+     */
+    static inline Nanoseconds FromMilliSec(double milliSec)
+    {
+      return (Nanoseconds)(milliSec * (double)NS_PER_MS + (milliSec < 0.0 ? -0.5 : 0.5));
+    }
+
+    Clock();
+    virtual ~Clock();
+
+    void reset();
+    void reset(Nanoseconds start);
+
+    /**
+     * @brief Gets the time at which the clock was started.
+     * @return Start time (as returned by Clock::Now)
+     */
+    inline Nanoseconds start() const
+    {
+      return m_start;
+    }
+
+    Nanoseconds elapsed() const;
+    double elapsedMilliSec() const;
+    float elapsedMilliSecF() const;
+
+  private:
+    Nanoseconds m_start; //!< Time at which the clock was started
+  };
+}
+}
+
+#endif
@@ -0,0 +1,176 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include "LatencyHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Engine
+{
+namespace Utility
+{
+  /**
+   * @brief Gets the index of the bucket a value is counted in.
+   * @param value Value
+   * @return Bucket index
+   */
+  size_t LatencyHistogram::BucketIndex(Clock::Nanoseconds value)
+  {
+    if (value < (Clock::Nanoseconds)SUB_BUCKETS)
+      return (size_t)std::max(value, (Clock::Nanoseconds)0);
+
+    if (value >= MAX_VALUE)
+      return NUM_BUCKETS - 1;
+
+    // Position of the most significant bit
+    size_t msb = SUB_BUCKET_BITS;
+    while ((value >> (msb + 1)) != 0)
+      msb++;
+
+    const size_t shift = msb - SUB_BUCKET_BITS;
+    const size_t sub = (size_t)(value >> shift) - SUB_BUCKETS;
+    return SUB_BUCKETS + shift * SUB_BUCKETS + sub;
+  }
+
+  /**
+   * @brief Gets the smallest value counted in a bucket.
+   * @param idx Bucket index
+   * @return Lower bound
+   */
+  Clock::Nanoseconds LatencyHistogram::BucketLowerBound(size_t idx)
+  {
+    if (idx < SUB_BUCKETS)
+      return (Clock::Nanoseconds)idx;
+
+    const size_t shift = (idx - SUB_BUCKETS) / SUB_BUCKETS;
+    const size_t sub = (idx - SUB_BUCKETS) % SUB_BUCKETS;
+    return (Clock::Nanoseconds)(SUB_BUCKETS + sub) << shift;
+  }
+
+  /**
+   * @brief Gets the range of values counted in a bucket.
+   * @param idx Bucket index
+   * @return Bucket width
+   */
+  Clock::Nanoseconds LatencyHistogram::BucketWidth(size_t idx)
+  {
+    if (idx < SUB_BUCKETS)
+      return 1;
+
+    return (Clock::Nanoseconds)1 << ((idx - SUB_BUCKETS) / SUB_BUCKETS);
+  }
+
+  /**
+   * @brief Creates a new, empty histogram.
+   */
+  LatencyHistogram::LatencyHistogram()
+  {
+    reset();
+  }
+
+  LatencyHistogram::~LatencyHistogram()
+  {
+  }
+
+  /**
+   * @brief Removes all recorded values.
+   */
+  void LatencyHistogram::reset()
+  {
+    std::memset(m_buckets, 0, sizeof(m_buckets));
+    m_count = 0;
+    m_sum = 0;
+    m_min = 0;
+    m_max = 0;
+  }
+
+  /**
+   * @brief Records a value.
+   * @param value Value (negative values are counted as zero)
+   */
+  void LatencyHistogram::record(Clock::Nanoseconds value)
+  {
+    value = std::max(value, (Clock::Nanoseconds)0);
+
+    m_buckets[BucketIndex(value)]++;
+
+    m_min = (m_count == 0) ? value : std::min(m_min, value);
+    m_max = std::max(m_max, value);
+    m_sum += value;
+    m_count++;
+  }
+
+  /**
+   * @brief Adds all values recorded in another histogram to this one.
+   * @param other Histogram to merge
+   */
+  void LatencyHistogram::merge(const LatencyHistogram &other)
+  {
+    if (other.m_count == 0)
+      return;
+
+    for (size_t i = 0; i < NUM_BUCKETS; i++)
+      m_buckets[i] += other.m_buckets[i];
+
+    m_min = (m_count == 0) ? other.m_min : std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+    m_sum += other.m_sum;
+    m_count += other.m_count;
+  }
+
+  /**
+   * @brief Gets the mean of the recorded values.
+   * @return Mean value (0 if empty)
+   */
+  Clock::Nanoseconds LatencyHistogram::mean() const
+  {
+    if (m_count == 0)
+      return 0;
+
+    return m_sum / (Clock::Nanoseconds)m_count;
+  }
+
+  /**
+   * @brief Gets the value below which a given percentage of recorded values
+   *        lie.
+   * @param percent Percentile (0-100)
+   * @return Value at percentile (0 if empty)
+   *
+   * The result is the midpoint of the bucket containing the percentile,
+   * clamped to the recorded range. The 0th and 100th percentiles are the
+   * exact min and max.
+   */
+  Clock::Nanoseconds LatencyHistogram::percentile(double percent) const
+  {
+    if (m_count == 0)
+      return 0;
+
+    if (percent <= 0.0)
+      return m_min;
+    if (percent >= 100.0)
+      return m_max;
+
+    uint64_t target = (uint64_t)std::ceil((percent / 100.0) * (double)m_count);
+    target = std::max(target, (uint64_t)1);
+
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < NUM_BUCKETS; i++)
+    {
+      cumulative += m_buckets[i];
+      if (cumulative >= target)
+      {
+        const Clock::Nanoseconds value = BucketLowerBound(i) + (BucketWidth(i) - 1) / 2;
+        return std::min(std::max(value, m_min), m_max);
+      }
+    }
+
+    return m_max;
+  }
+}
+}
@@ -0,0 +1,95 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#ifndef _ENGINE_UTILITY_LATENCYHISTOGRAM_H_
+#define _ENGINE_UTILITY_LATENCYHISTOGRAM_H_
+
+#include <cstdint>
+
+#include "Clock.h"
+
+namespace Engine
+{
+namespace Utility
+{
+  /**
+   * @class LatencyHistogram
+   * @brief Fixed memory histogram of durations with log-linear buckets.
+   * @author Dan Nixon
+   *
+   * Each power of two range of values is divided into SUB_BUCKETS linear
+   * buckets (as in HDR histograms), so recorded values are resolved to within
+   * 1/SUB_BUCKETS (~3%) of their value regardless of magnitude. Values of
+   * MAX_VALUE or more are counted in the last bucket. The minimum and maximum
+   * values are tracked exactly.
+   */
+  class LatencyHistogram
+  {
+  public:
+    static const size_t SUB_BUCKET_BITS = 5;                           //!< log2 of SUB_BUCKETS
+    static const size_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;            //!< Number of buckets per power of two
+    static const size_t MAX_VALUE_BITS = 40;                           //!< log2 of MAX_VALUE
+    static const Clock::Nanoseconds MAX_VALUE = 1LL << MAX_VALUE_BITS; //!< Max value resolved (~18 minutes)
+
+    /**
+     * @var NUM_BUCKETS
+     * @brief Total number of buckets.
+     */
+    static const size_t NUM_BUCKETS = SUB_BUCKETS * (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1);
+
+    static size_t BucketIndex(Clock::Nanoseconds value);
+    static Clock::Nanoseconds BucketLowerBound(size_t idx);
+    static Clock::Nanoseconds BucketWidth(size_t idx);
+
+    LatencyHistogram();
+    virtual ~LatencyHistogram();
+
+    void reset();
+    void record(Clock::Nanoseconds value);
+    void merge(const LatencyHistogram &other);
+
+    /**
+     * @brief Gets the number of recorded values.
+     * @return Number of values
+     */
+    inline uint64_t count() const
+    {
+      return m_count;
+    }
+
+    /**
+     * @brief Gets the smallest recorded value.
+     * @return Min value (0 if empty)
+     */
+    inline Clock::Nanoseconds min() const
+    {
+      return m_count > 0 ? m_min : 0;
+    }
+
+    /**
+     * @brief Gets the largest recorded value.
+     * @return Max value (0 if empty)
+     */
+    inline Clock::Nanoseconds max() const
+    {
+      return m_max;
+    }
+
+    Clock::Nanoseconds mean() const;
+    Clock::Nanoseconds percentile(double percent) const;
+
+  private:
+    uint32_t m_buckets[NUM_BUCKETS]; //!< Count of values in each bucket
+    uint64_t m_count;                //!< Total number of values
+    Clock::Nanoseconds m_sum;        //!< Sum of all values
+    Clock::Nanoseconds m_min;        //!< Smallest value
+    Clock::Nanoseconds m_max;        //!< Largest value
+  };
+}
+}
+
+#endif
@@ -0,0 +1,169 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#ifndef _ENGINE_UTILITY_MPSCRINGBUFFER_H_
+#define _ENGINE_UTILITY_MPSCRINGBUFFER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+namespace Engine
+{
+namespace Utility
+{
+  /**
+   * @class MPSCRingBuffer
+   * @brief Bounded FIFO queue that many threads may push to and a single
+   *        thread pops from, without locks.
+   * @author Dan Nixon
+   *
+   * Each cell has a sequence number that tells producers and the consumer
+   * whose turn it is to use the cell (D. Vyukov's bounded queue). Producers
+   * claim a cell with a single compare and swap and never allocate (other
+   * than any allocation made by assigning T). When full, push fails rather
+   * than blocking. A producer suspended between claiming and publishing a
+   * cell delays the consumer at that cell only until it resumes.
+   */
+  template <typename T> class MPSCRingBuffer
+  {
+  public:
+    /**
+     * @brief Creates a new, empty buffer.
+     * @param capacity Capacity (rounded up to a power of two, at least 2)
+     */
+    MPSCRingBuffer(size_t capacity)
+        : m_enqueuePos(0)
+        , m_dequeuePos(0)
+    {
+      size_t c = 2;
+      while (c < capacity)
+        c <<= 1;
+
+      m_mask = c - 1;
+      m_cells = new Cell[c];
+      for (size_t i = 0; i < c; i++)
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    virtual ~MPSCRingBuffer()
+    {
+      delete[] m_cells;
+    }
+
+    /**
+     * @brief No copy constructor
+     */
+    MPSCRingBuffer(MPSCRingBuffer const &) = delete;
+
+    /**
+     * @brief No assign copy constructor
+     */
+    MPSCRingBuffer &operator=(MPSCRingBuffer const &) = delete;
+
+    /**
+     * @brief Gets the number of items the buffer can hold.
+     * @return Capacity
+     */
+    inline size_t capacity() const
+    {
+      return m_mask + 1;
+    }
+
+    /**
+     * @brief Adds an item to the back of the queue (safe to call from any
+     *        thread).
+     * @param item Item to add
+     * @return False if the buffer is full
+     */
+    bool push(const T &item)
+    {
+      Cell *cell;
+      size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+
+      while (true)
+      {
+        cell = &m_cells[pos & m_mask];
+        size_t seq = cell->sequence.load(std::memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+        if (diff == 0)
+        {
+          // Cell is free, try to claim it
+          if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            break;
+        }
+        else if (diff < 0)
+        {
+          // Cell still holds an item from the previous lap
+          return false;
+        }
+        else
+        {
+          // Another producer claimed the cell
+          pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+      }
+
+      cell->data = item;
+      cell->sequence.store(pos + 1, std::memory_order_release);
+
+      return true;
+    }
+
+    /**
+     * @brief Removes the item at the front of the queue (must only be called
+     *        from the consuming thread).
+     * @param item Reference to store item in
+     * @return False if the buffer is empty
+     */
+    bool pop(T &item)
+    {
+      Cell *cell = &m_cells[m_dequeuePos & m_mask];
+      size_t seq = cell->sequence.load(std::memory_order_acquire);
+
+      // Not yet published by a producer
+      if ((intptr_t)seq - (intptr_t)(m_dequeuePos + 1) < 0)
+        return false;
+
+      item = std::move(cell->data);
+      cell->data = T();
+      cell->sequence.store(m_dequeuePos + m_mask + 1, std::memory_order_release);
+      m_dequeuePos++;
+
+      return true;
+    }
+
+  private:
+    /**
+     * @struct Cell
+     * @brief Storage of a single item.
+     */
+    struct Cell
+    {
+      std::atomic<size_t> sequence; //!< Position the cell is ready to be pushed (== pos) or popped (== pos + 1) at
+      T data;                       //!< Item
+    };
+
+    /**
+     * @var CACHE_LINE
+     * @brief Size of padding used to keep producer and consumer state on
+     *        separate cache lines.
+     */
+    static const size_t CACHE_LINE = 64;
+
+    Cell *m_cells;                    //!< Item storage
+    size_t m_mask;                    //!< Capacity - 1
+    char m_pad0[CACHE_LINE];          //!< Padding
+    std::atomic<size_t> m_enqueuePos; //!< Position of the next push
+    char m_pad1[CACHE_LINE];          //!< Padding
+    size_t m_dequeuePos;              //!< Position of the next pop (consumer only)
+  };
+}
+}
+
+#endif
@@ -0,0 +1,161 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#ifndef _ENGINE_UTILITY_RINGBUFFER_H_
+#define _ENGINE_UTILITY_RINGBUFFER_H_
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace Engine
+{
+namespace Utility
+{
+  /**
+   * @class RingBuffer
+   * @brief FIFO queue stored in a contiguous circular buffer.
+   * @author Dan Nixon
+   *
+   * Pushing and popping are O(1), the capacity is doubled when a push is made
+   * to a full buffer (so storage is only allocated while the queue grows).
+   * Capacity is always a power of two so that wrapping is a mask.
+   */
+  template <typename T> class RingBuffer
+  {
+  public:
+    /**
+     * @brief Creates a new, empty buffer.
+     * @param capacity Initial capacity (rounded up to a power of two)
+     */
+    RingBuffer(size_t capacity = 16)
+        : m_head(0)
+        , m_size(0)
+    {
+      size_t c = 1;
+      while (c < capacity)
+        c <<= 1;
+
+      m_buffer.resize(c);
+    }
+
+    virtual ~RingBuffer()
+    {
+    }
+
+    /**
+     * @brief Gets the number of items in the buffer.
+     * @return Number of items
+     */
+    inline size_t size() const
+    {
+      return m_size;
+    }
+
+    /**
+     * @brief Checks if the buffer is empty.
+     * @return True if empty
+     */
+    inline bool empty() const
+    {
+      return m_size == 0;
+    }
+
+    /**
+     * @brief Gets the number of items the buffer can hold without growing.
+     * @return Capacity
+     */
+    inline size_t capacity() const
+    {
+      return m_buffer.size();
+    }
+
+    /**
+     * @brief Adds an item to the back of the queue.
+     * @param item Item to add
+     */
+    void push(T item)
+    {
+      if (m_size == m_buffer.size())
+        grow();
+
+      m_buffer[(m_head + m_size) & (m_buffer.size() - 1)] = std::move(item);
+      m_size++;
+    }
+
+    /**
+     * @brief Gets the item at the front of the queue.
+     * @return Oldest item
+     */
+    T &front()
+    {
+      if (m_size == 0)
+        throw std::runtime_error("RingBuffer is empty");
+
+      return m_buffer[m_head];
+    }
+
+    /**
+     * @copydoc RingBuffer::front
+     */
+    const T &front() const
+    {
+      if (m_size == 0)
+        throw std::runtime_error("RingBuffer is empty");
+
+      return m_buffer[m_head];
+    }
+
+    /**
+     * @brief Removes the item at the front of the queue.
+     */
+    void pop()
+    {
+      if (m_size == 0)
+        throw std::runtime_error("RingBuffer is empty");
+
+      // Release any resources held by the item
+      m_buffer[m_head] = T();
+
+      m_head = (m_head + 1) & (m_buffer.size() - 1);
+      m_size--;
+    }
+
+    /**
+     * @brief Removes all items, keeping the current capacity.
+     */
+    void clear()
+    {
+      while (m_size > 0)
+        pop();
+
+      m_head = 0;
+    }
+
+  private:
+    /**
+     * @brief Doubles the capacity, moving items so that the front is at
+     *        index 0.
+     */
+    void grow()
+    {
+      std::vector<T> buffer(m_buffer.size() * 2);
+      for (size_t i = 0; i < m_size; i++)
+        buffer[i] = std::move(m_buffer[(m_head + i) & (m_buffer.size() - 1)]);
+
+      m_buffer.swap(buffer);
+      m_head = 0;
+    }
+
+    std::vector<T> m_buffer; //!< Item storage
+    size_t m_head;           //!< Index of the front item
+    size_t m_size;           //!< Number of items held
+  };
+}
+}
+
+#endif
@@ -177,6 +177,43 @@ namespace Utility
     return retVal;
   }
 
+  /**
+   * @brief Escapes a string for use inside a JSON string literal.
+   * @param str String to escape
+   * @return Escaped string (without surrounding quotes)
+   *
+   * Control characters other than newline and tab are removed.
+   */
+  std::string StringUtils::EscapeJSON(const std::string &str)
+  {
+    std::string retVal;
+    retVal.reserve(str.size());
+
+    for (auto it = str.begin(); it != str.end(); ++it)
+    {
+      switch (*it)
+      {
+      case '"':
+        retVal += "\\\"";
+        break;
+      case '\\':
+        retVal += "\\\\";
+        break;
+      case '\n':
+        retVal += "\\n";
+        break;
+      case '\t':
+        retVal += "\\t";
+        break;
+      default:
+        if ((unsigned char)*it >= 0x20)
+          retVal += *it;
+      }
+    }
+
+    return retVal;
+  }
+
   /**
    * @brief Searches a string for a directory delimiting slash.
    * @param str String to search in
@@ -36,6 +36,8 @@ namespace Utility
 
     static bool ToBool(std::string str, bool defaultVal = false);
 
+    static std::string EscapeJSON(const std::string &str);
+
   private:
     static size_t FindSlash(const std::string &str);
   };
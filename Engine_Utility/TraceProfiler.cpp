@@ -0,0 +1,363 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include "TraceProfiler.h"
+
+#include <algorithm>
+#include <fstream>
+
+#include "StringUtils.h"
+
+/**
+ * @def TRACE_THREAD_LOCAL
+ * @brief Thread local storage specifier (Visual Studio 2013 does not support
+ *        thread_local).
+ */
+#ifdef _MSC_VER
+#define TRACE_THREAD_LOCAL __declspec(thread)
+#else
+#define TRACE_THREAD_LOCAL thread_local
+#endif
+
+namespace
+{
+/**
+ * @brief Buffer of the calling thread, nullptr until it first records an
+ *        event.
+ */
+TRACE_THREAD_LOCAL Engine::Utility::TraceBuffer *g_threadBuffer = nullptr;
+
+/**
+ * @brief Outputs a string as a JSON string literal.
+ * @param o Stream
+ * @param str String to output
+ */
+void WriteJSONString(std::ostream &o, const std::string &str)
+{
+  o << '"' << Engine::Utility::StringUtils::EscapeJSON(str) << '"';
+}
+
+/**
+ * @brief Outputs a time as microseconds (the unit used by the trace event
+ *        format).
+ * @param o Stream
+ * @param ns Time in nanoseconds
+ */
+void WriteMicroSec(std::ostream &o, Engine::Utility::Clock::Nanoseconds ns)
+{
+  if (ns < 0)
+  {
+    o << '-';
+    ns = -ns;
+  }
+
+  const Engine::Utility::Clock::Nanoseconds fraction = ns % 1000;
+  o << (ns / 1000) << '.' << (char)('0' + fraction / 100) << (char)('0' + (fraction / 10) % 10)
+    << (char)('0' + fraction % 10);
+}
+}
+
+namespace Engine
+{
+namespace Utility
+{
+  /**
+   * @brief Creates a new buffer.
+   * @param id ID of the owning thread
+   * @param capacity Number of events held
+   */
+  TraceBuffer::TraceBuffer(size_t id, size_t capacity)
+      : m_id(id)
+      , m_ring(std::max(capacity, (size_t)1))
+      , m_next(0)
+      , m_count(0)
+      , m_overwritten(0)
+  {
+    m_lock.clear();
+  }
+
+  TraceBuffer::~TraceBuffer()
+  {
+  }
+
+  /**
+   * @brief Adds an event, overwriting the oldest event if the buffer is full.
+   * @param e Event
+   */
+  void TraceBuffer::push(const TraceEvent &e)
+  {
+    lock();
+
+    m_ring[m_next] = e;
+    m_next = (m_next + 1) % m_ring.size();
+
+    if (m_count < m_ring.size())
+      m_count++;
+    else
+      m_overwritten++;
+
+    unlock();
+  }
+
+  /**
+   * @brief Gets the number of events held.
+   * @return Number of events
+   */
+  size_t TraceBuffer::size()
+  {
+    lock();
+    const size_t count = m_count;
+    unlock();
+
+    return count;
+  }
+
+  /**
+   * @brief Copies all held events, oldest first.
+   * @param out Vector events are appended to
+   * @return Number of events lost to the buffer wrapping
+   */
+  size_t TraceBuffer::events(std::vector<TraceEvent> &out)
+  {
+    lock();
+
+    const size_t first = (m_next + m_ring.size() - m_count) % m_ring.size();
+    for (size_t i = 0; i < m_count; i++)
+      out.push_back(m_ring[(first + i) % m_ring.size()]);
+
+    const size_t overwritten = m_overwritten;
+
+    unlock();
+
+    return overwritten;
+  }
+
+  /**
+   * @brief Removes all events and sets the buffer capacity.
+   * @param capacity Number of events held
+   */
+  void TraceBuffer::reset(size_t capacity)
+  {
+    lock();
+
+    m_ring.assign(std::max(capacity, (size_t)1), TraceEvent());
+    m_next = 0;
+    m_count = 0;
+    m_overwritten = 0;
+
+    unlock();
+  }
+
+  /**
+   * @brief Acquires the buffer lock.
+   */
+  void TraceBuffer::lock()
+  {
+    while (m_lock.test_and_set(std::memory_order_acquire))
+    {
+    }
+  }
+
+  /**
+   * @brief Releases the buffer lock.
+   */
+  void TraceBuffer::unlock()
+  {
+    m_lock.clear(std::memory_order_release);
+  }
+
+  std::atomic<bool> TraceProfiler::s_enabled(false);
+
+  /**
+   * @brief Sets the name of the calling thread in traces.
+   * @param name Thread name
+   */
+  void TraceProfiler::SetThreadName(const std::string &name)
+  {
+    TraceProfiler &p = Instance();
+    TraceBuffer *buffer = p.threadBuffer();
+
+    std::lock_guard<std::mutex> lock(p.m_mutex);
+    buffer->setName(name);
+  }
+
+  /**
+   * @brief Gets a pointer to a copy of a string that remains valid for the
+   *        life of the profiler, for use as a scope name.
+   * @param name Name
+   * @return Stable name pointer
+   */
+  const char *TraceProfiler::Intern(const std::string &name)
+  {
+    TraceProfiler &p = Instance();
+    std::lock_guard<std::mutex> lock(p.m_mutex);
+    return p.m_names.insert(name).first->c_str();
+  }
+
+  TraceProfiler::TraceProfiler()
+      : m_capacity(DEFAULT_CAPACITY)
+      , m_epoch(Clock::Now())
+  {
+  }
+
+  TraceProfiler::~TraceProfiler()
+  {
+    s_enabled = false;
+
+    for (auto it = m_buffers.begin(); it != m_buffers.end(); ++it)
+      delete *it;
+  }
+
+  /**
+   * @brief Starts or stops recording scopes.
+   * @param enabled True to record
+   */
+  void TraceProfiler::setEnabled(bool enabled)
+  {
+    s_enabled = enabled;
+  }
+
+  /**
+   * @brief Sets the number of events held per thread, clearing all recorded
+   *        events.
+   * @param capacity Number of events
+   */
+  void TraceProfiler::setCapacity(size_t capacity)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_capacity = capacity;
+    for (auto it = m_buffers.begin(); it != m_buffers.end(); ++it)
+      (*it)->reset(m_capacity);
+  }
+
+  /**
+   * @brief Records a completed scope on the buffer of the calling thread.
+   * @param name Scope name (must outlive the profiler)
+   * @param start Time the scope was entered
+   * @param end Time the scope was exited
+   */
+  void TraceProfiler::record(const char *name, Clock::Nanoseconds start, Clock::Nanoseconds end)
+  {
+    TraceEvent e = {name, start, end - start};
+    threadBuffer()->push(e);
+  }
+
+  /**
+   * @brief Removes all recorded events and restarts the trace timeline.
+   */
+  void TraceProfiler::clear()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_epoch = Clock::Now();
+    for (auto it = m_buffers.begin(); it != m_buffers.end(); ++it)
+      (*it)->reset(m_capacity);
+  }
+
+  /**
+   * @brief Gets the number of events currently held across all threads.
+   * @return Number of events
+   */
+  size_t TraceProfiler::numEvents()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    size_t count = 0;
+    for (auto it = m_buffers.begin(); it != m_buffers.end(); ++it)
+      count += (*it)->size();
+
+    return count;
+  }
+
+  /**
+   * @brief Outputs all recorded events in the Chrome trace event (JSON)
+   *        format.
+   * @param o Stream
+   *
+   * Scopes are output as complete ("X") events with one track per thread.
+   */
+  void TraceProfiler::writeChromeTrace(std::ostream &o)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    o << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool first = true;
+    std::vector<TraceEvent> events;
+    for (auto it = m_buffers.begin(); it != m_buffers.end(); ++it)
+    {
+      const size_t tid = (*it)->id();
+
+      // Thread name metadata
+      if (!(*it)->name().empty())
+      {
+        o << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid
+          << ",\"args\":{\"name\":";
+        WriteJSONString(o, (*it)->name());
+        o << "}}";
+        first = false;
+      }
+
+      events.clear();
+      (*it)->events(events);
+
+      for (auto eIt = events.begin(); eIt != events.end(); ++eIt)
+      {
+        o << (first ? "" : ",") << "\n{\"name\":";
+        WriteJSONString(o, eIt->name);
+        o << ",\"cat\":\"engine\",\"ph\":\"X\",\"ts\":";
+        WriteMicroSec(o, eIt->start - m_epoch);
+        o << ",\"dur\":";
+        WriteMicroSec(o, eIt->duration);
+        o << ",\"pid\":1,\"tid\":" << tid << "}";
+        first = false;
+      }
+    }
+
+    o << "\n]}\n";
+  }
+
+  /**
+   * @brief Writes all recorded events to a file in the Chrome trace event
+   *        format.
+   * @param filename File to write
+   * @return True if the file was written
+   * @see TraceProfiler::writeChromeTrace(std::ostream &)
+   */
+  bool TraceProfiler::writeChromeTrace(const std::string &filename)
+  {
+    std::ofstream file;
+    file.open(filename);
+
+    if ((file.rdstate() & std::ofstream::failbit) != 0)
+      return false;
+
+    writeChromeTrace(file);
+    file.close();
+
+    return true;
+  }
+
+  /**
+   * @brief Gets the buffer of the calling thread, creating it if this is the
+   *        first event recorded on the thread.
+   * @return Thread buffer
+   */
+  TraceBuffer *TraceProfiler::threadBuffer()
+  {
+    if (g_threadBuffer == nullptr)
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      g_threadBuffer = new TraceBuffer(m_buffers.size(), m_capacity);
+      m_buffers.push_back(g_threadBuffer);
+    }
+
+    return g_threadBuffer;
+  }
+}
+}
@@ -0,0 +1,258 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#ifndef _ENGINE_UTILITY_TRACEPROFILER_H_
+#define _ENGINE_UTILITY_TRACEPROFILER_H_
+
+#include <atomic>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "Clock.h"
+
+namespace Engine
+{
+namespace Utility
+{
+  /**
+   * @struct TraceEvent
+   * @brief A single completed profiling scope.
+   */
+  struct TraceEvent
+  {
+    const char *name;            //!< Scope name (must outlive the profiler, see TraceProfiler::Intern)
+    Clock::Nanoseconds start;    //!< Time the scope was entered (from Clock::Now)
+    Clock::Nanoseconds duration; //!< Time spent in the scope
+  };
+
+  /**
+   * @class TraceBuffer
+   * @brief Fixed size ring buffer of trace events recorded by a single
+   *        thread.
+   * @author Dan Nixon
+   *
+   * When full the oldest events are overwritten. Only the owning thread
+   * writes to the buffer, the lock is only contended while the buffer is
+   * being read.
+   */
+  class TraceBuffer
+  {
+  public:
+    TraceBuffer(size_t id, size_t capacity);
+    virtual ~TraceBuffer();
+
+    /**
+     * @brief Gets the ID of the thread that owns this buffer.
+     * @return Thread ID
+     */
+    inline size_t id() const
+    {
+      return m_id;
+    }
+
+    /**
+     * @brief Gets the name of the thread that owns this buffer.
+     * @return Thread name
+     */
+    inline std::string name() const
+    {
+      return m_name;
+    }
+
+    /**
+     * @brief Sets the name of the thread that owns this buffer.
+     * @param name Thread name
+     */
+    inline void setName(const std::string &name)
+    {
+      m_name = name;
+    }
+
+    void push(const TraceEvent &e);
+    size_t size();
+    size_t events(std::vector<TraceEvent> &out);
+    void reset(size_t capacity);
+
+  private:
+    void lock();
+    void unlock();
+
+    const size_t m_id;              //!< Thread ID
+    std::string m_name;             //!< Thread name (as shown in trace viewers)
+    std::atomic_flag m_lock;        //!< Lock held while reading or writing events
+    std::vector<TraceEvent> m_ring; //!< Event storage
+    size_t m_next;                  //!< Index the next event will be written to
+    size_t m_count;                 //!< Number of valid events in m_ring
+    size_t m_overwritten;           //!< Number of events lost to the ring buffer wrapping
+  };
+
+  /**
+   * @class TraceProfiler
+   * @brief Records hierarchical profiling scopes from any thread and exports
+   *        them in the Chrome trace event format.
+   * @author Dan Nixon
+   *
+   * Scopes are recorded using ProfileScope (usually via the PROFILE_SCOPE
+   * macro), nesting is given by the scope timings. Each thread writes to its
+   * own TraceBuffer. When disabled a scope costs a single flag check.
+   *
+   * The output of TraceProfiler::writeChromeTrace can be opened in
+   * chrome://tracing or other trace viewers.
+   */
+  class TraceProfiler
+  {
+  public:
+    static const size_t DEFAULT_CAPACITY = 65536; //!< Default number of events held per thread
+
+    /**
+     * @brief Gets the instance of the profiler.
+     * @return Profiler instance
+     */
+    static TraceProfiler &Instance()
+    {
+      static TraceProfiler instance;
+      return instance;
+    }
+
+    /**
+     * @brief Checks if scopes are currently being recorded.
+     * @return True if enabled
+     */
+    static inline bool Enabled()
+    {
+      return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    static void SetThreadName(const std::string &name);
+    static const char *Intern(const std::string &name);
+
+    /**
+     * @brief No copy constructor
+     */
+    TraceProfiler(TraceProfiler const &) = delete;
+
+    /**
+     * @brief No move constructor
+     */
+    TraceProfiler(TraceProfiler &&) = delete;
+
+    /**
+     * @brief No assign copy constructor
+     */
+    TraceProfiler &operator=(TraceProfiler const &) = delete;
+
+    /**
+     * @brief No assign move constructor
+     */
+    TraceProfiler &operator=(TraceProfiler &&) = delete;
+
+    void setEnabled(bool enabled);
+    void setCapacity(size_t capacity);
+
+    /**
+     * @brief Gets the number of events held per thread.
+     * @return Capacity
+     */
+    inline size_t capacity() const
+    {
+      return m_capacity;
+    }
+
+    void record(const char *name, Clock::Nanoseconds start, Clock::Nanoseconds end);
+    void clear();
+
+    size_t numEvents();
+    void writeChromeTrace(std::ostream &o);
+    bool writeChromeTrace(const std::string &filename);
+
+  private:
+    TraceProfiler();
+    virtual ~TraceProfiler();
+
+    TraceBuffer *threadBuffer();
+
+    static std::atomic<bool> s_enabled; //!< Flag indicating scopes are recorded
+
+    std::mutex m_mutex;                   //!< Mutex guarding the buffer list and interned names
+    std::vector<TraceBuffer *> m_buffers; //!< Buffers of all threads that have recorded events
+    std::set<std::string> m_names;        //!< Interned scope names
+    size_t m_capacity;                    //!< Number of events held per thread
+    Clock::Nanoseconds m_epoch;           //!< Time trace timestamps are relative to
+  };
+
+  /**
+   * @class ProfileScope
+   * @brief Records the time between construction and destruction with the
+   *        TraceProfiler.
+   * @author Dan Nixon
+   */
+  class ProfileScope
+  {
+  public:
+    /**
+     * @brief Enters a scope.
+     * @param name Scope name (must outlive the profiler, e.g. a string
+     *             literal or the result of TraceProfiler::Intern)
+     */
+    ProfileScope(const char *name)
+        : m_name(TraceProfiler::Enabled() ? name : nullptr)
+    {
+      if (m_name != nullptr)
+        m_start = Clock::Now();
+    }
+
+    /**
+     * @brief Exits the scope.
+     */
+    ~ProfileScope()
+    {
+      if (m_name != nullptr)
+        TraceProfiler::Instance().record(m_name, m_start, Clock::Now());
+    }
+
+  private:
+    const char *m_name;         //!< Scope name, nullptr when not recording
+    Clock::Nanoseconds m_start; //!< Time the scope was entered
+  };
+}
+}
+
+/**
+ * @def PROFILE_SCOPE_CONCAT_INNER
+ * @brief Concatenates two tokens.
+ */
+#define PROFILE_SCOPE_CONCAT_INNER(a, b) a##b
+
+/**
+ * @def PROFILE_SCOPE_CONCAT
+ * @brief Concatenates two tokens after expansion.
+ */
+#define PROFILE_SCOPE_CONCAT(a, b) PROFILE_SCOPE_CONCAT_INNER(a, b)
+
+#ifdef DISABLE_TRACE_PROFILING
+#define PROFILE_SCOPE(name)
+#else
+/**
+ * @def PROFILE_SCOPE
+ * @brief Profiles the remainder of the enclosing scope.
+ *
+ * Compiled out when DISABLE_TRACE_PROFILING is defined.
+ */
+#define PROFILE_SCOPE(name) Engine::Utility::ProfileScope PROFILE_SCOPE_CONCAT(_profileScope, __LINE__)(name)
+#endif
+
+/**
+ * @def PROFILE_FUNCTION
+ * @brief Profiles the remainder of the enclosing function, named after the
+ *        function.
+ */
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
+
+#endif
@@ -0,0 +1,93 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include "CppUnitTest.h"
+
+#include <cmath>
+#include <thread>
+
+#include <Engine_Utility/Clock.h>
+
+/**
+ * @def FP_ACC
+ * @brief Accuracy for floating point comparison.
+ */
+#define FP_ACC 0.000001
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+// clang-format off
+namespace Engine
+{
+namespace Utility
+{
+namespace Test
+{
+#ifndef DOXYGEN_SKIP
+TEST_CLASS(ClockTest)
+{
+public:
+  TEST_METHOD(Clock_Conversion)
+  {
+    Assert::AreEqual(8330000LL, (long long)Clock::FromMilliSec(8.33));
+    Assert::AreEqual(-1500000LL, (long long)Clock::FromMilliSec(-1.5));
+    Assert::AreEqual(8.33, Clock::ToMilliSec(8330000), FP_ACC);
+    Assert::AreEqual(0.000001, Clock::ToMilliSec(1), FP_ACC);
+  }
+
+  TEST_METHOD(Clock_Monotonic)
+  {
+    Clock c;
+    Clock::Nanoseconds last = c.elapsed();
+    Assert::IsTrue(last >= 0);
+
+    for (int i = 0; i < 1000; i++)
+    {
+      Clock::Nanoseconds t = c.elapsed();
+      Assert::IsTrue(t >= last);
+      last = t;
+    }
+  }
+
+  TEST_METHOD(Clock_LongUptime_Delta)
+  {
+    // Clock started 72 hours ago
+    const Clock::Nanoseconds offset = 72LL * 60 * 60 * Clock::NS_PER_S;
+    Clock c;
+    c.reset(Clock::Now() - offset);
+
+    Clock::Nanoseconds t1 = c.elapsed();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    Clock::Nanoseconds t2 = c.elapsed();
+
+    Assert::IsTrue(t1 >= offset);
+
+    // Time step remains accurate to well under a millisecond resolution
+    double dt = Clock::ToMilliSec(t2 - t1);
+    Assert::IsTrue(dt >= 5.0);
+    Assert::IsTrue(dt < 100.0);
+
+    // A float millisecond time of the same uptime cannot represent it
+    float t1f = (float)Clock::ToMilliSec(t1);
+    float t2f = (float)Clock::ToMilliSec(t1 + Clock::FromMilliSec(5.0));
+    Assert::IsTrue(std::abs((t2f - t1f) - 5.0f) > 1.0f);
+  }
+
+  TEST_METHOD(Clock_LongUptime_FrameSteps)
+  {
+    // Simulated frame times 72 hours after startup
+    const Clock::Nanoseconds start = 72LL * 60 * 60 * Clock::NS_PER_S;
+    const Clock::Nanoseconds frame = Clock::FromMilliSec(16.66);
+
+    for (Clock::Nanoseconds t = start; t < start + 100 * frame; t += frame)
+      Assert::AreEqual(16.66f, Clock::ToMilliSecF((t + frame) - t), 0.00001f);
+  }
+};
+#endif /* DOXYGEN_SKIP */
+}
+}
+}
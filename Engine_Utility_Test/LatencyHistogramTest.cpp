@@ -0,0 +1,139 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include "CppUnitTest.h"
+
+#include <Engine_Utility/LatencyHistogram.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+// clang-format off
+namespace Engine
+{
+namespace Utility
+{
+namespace Test
+{
+#ifndef DOXYGEN_SKIP
+TEST_CLASS(LatencyHistogramTest)
+{
+public:
+  TEST_METHOD(LatencyHistogram_Empty)
+  {
+    LatencyHistogram h;
+
+    Assert::AreEqual((uint64_t)0, h.count());
+    Assert::AreEqual((Clock::Nanoseconds)0, h.min());
+    Assert::AreEqual((Clock::Nanoseconds)0, h.max());
+    Assert::AreEqual((Clock::Nanoseconds)0, h.mean());
+    Assert::AreEqual((Clock::Nanoseconds)0, h.percentile(50.0));
+  }
+
+  TEST_METHOD(LatencyHistogram_Buckets)
+  {
+    // Small values are exact
+    for (Clock::Nanoseconds v = 0; v < 64; v++)
+    {
+      const size_t idx = LatencyHistogram::BucketIndex(v);
+      Assert::AreEqual(v, LatencyHistogram::BucketLowerBound(idx));
+      Assert::AreEqual((Clock::Nanoseconds)1, LatencyHistogram::BucketWidth(idx));
+    }
+
+    // Larger values lie within a bucket no wider than ~3% of the value
+    for (Clock::Nanoseconds v = 64; v < ((Clock::Nanoseconds)1 << 39); v = v * 3 / 2 + 7)
+    {
+      const size_t idx = LatencyHistogram::BucketIndex(v);
+      const Clock::Nanoseconds lower = LatencyHistogram::BucketLowerBound(idx);
+      const Clock::Nanoseconds width = LatencyHistogram::BucketWidth(idx);
+
+      Assert::IsTrue(idx < (size_t)LatencyHistogram::NUM_BUCKETS);
+      Assert::IsTrue(v >= lower);
+      Assert::IsTrue(v < lower + width);
+      Assert::IsTrue(width * (Clock::Nanoseconds)LatencyHistogram::SUB_BUCKETS <= v);
+    }
+
+    // Buckets are contiguous
+    for (size_t i = 1; i < (size_t)LatencyHistogram::NUM_BUCKETS; i++)
+      Assert::AreEqual(LatencyHistogram::BucketLowerBound(i - 1) + LatencyHistogram::BucketWidth(i - 1),
+                       LatencyHistogram::BucketLowerBound(i));
+  }
+
+  TEST_METHOD(LatencyHistogram_Clamp)
+  {
+    LatencyHistogram h;
+    h.record(-5);
+    h.record((Clock::Nanoseconds)LatencyHistogram::MAX_VALUE * 4);
+
+    Assert::AreEqual((size_t)0, LatencyHistogram::BucketIndex(-5));
+    Assert::AreEqual((size_t)LatencyHistogram::NUM_BUCKETS - 1,
+                     LatencyHistogram::BucketIndex((Clock::Nanoseconds)LatencyHistogram::MAX_VALUE * 4));
+    Assert::AreEqual((Clock::Nanoseconds)0, h.min());
+    Assert::AreEqual((Clock::Nanoseconds)LatencyHistogram::MAX_VALUE * 4, h.max());
+    Assert::AreEqual(h.max(), h.percentile(100.0));
+  }
+
+  TEST_METHOD(LatencyHistogram_Percentiles)
+  {
+    // 1ms to 100ms in 1ms steps
+    LatencyHistogram h;
+    for (int i = 100; i > 0; i--)
+      h.record(Clock::FromMilliSec(i));
+
+    Assert::AreEqual((uint64_t)100, h.count());
+    Assert::AreEqual(Clock::FromMilliSec(1), h.min());
+    Assert::AreEqual(Clock::FromMilliSec(100), h.max());
+    Assert::AreEqual(Clock::FromMilliSec(50.5), h.mean());
+
+    Assert::AreEqual(50.0, Clock::ToMilliSec(h.percentile(50.0)), 50.0 * 0.035);
+    Assert::AreEqual(90.0, Clock::ToMilliSec(h.percentile(90.0)), 90.0 * 0.035);
+    Assert::AreEqual(99.0, Clock::ToMilliSec(h.percentile(99.0)), 99.0 * 0.035);
+    Assert::AreEqual(Clock::FromMilliSec(1), h.percentile(0.0));
+    Assert::AreEqual(Clock::FromMilliSec(100), h.percentile(100.0));
+  }
+
+  TEST_METHOD(LatencyHistogram_Outlier)
+  {
+    // A single slow frame shows in the max and p99 but not the median
+    LatencyHistogram h;
+    for (int i = 0; i < 99; i++)
+      h.record(Clock::FromMilliSec(2));
+    h.record(Clock::FromMilliSec(250));
+
+    Assert::AreEqual(2.0, Clock::ToMilliSec(h.percentile(50.0)), 2.0 * 0.035);
+    Assert::AreEqual(2.0, Clock::ToMilliSec(h.percentile(99.0)), 2.0 * 0.035);
+    Assert::AreEqual(250.0, Clock::ToMilliSec(h.percentile(99.9)), 250.0 * 0.035);
+    Assert::AreEqual(Clock::FromMilliSec(250), h.max());
+  }
+
+  TEST_METHOD(LatencyHistogram_MergeReset)
+  {
+    LatencyHistogram a;
+    LatencyHistogram b;
+    a.record(100);
+    a.record(200);
+    b.record(50);
+    b.record(5000);
+
+    a.merge(b);
+    Assert::AreEqual((uint64_t)4, a.count());
+    Assert::AreEqual((Clock::Nanoseconds)50, a.min());
+    Assert::AreEqual((Clock::Nanoseconds)5000, a.max());
+    Assert::AreEqual((Clock::Nanoseconds)1337, a.mean());
+
+    a.reset();
+    Assert::AreEqual((uint64_t)0, a.count());
+    Assert::AreEqual((Clock::Nanoseconds)0, a.max());
+
+    a.record(42);
+    Assert::AreEqual((Clock::Nanoseconds)42, a.min());
+    Assert::AreEqual((Clock::Nanoseconds)42, a.percentile(50.0));
+  }
+};
+#endif /* DOXYGEN_SKIP */
+}
+}
+}
@@ -0,0 +1,101 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include "CppUnitTest.h"
+
+#include <thread>
+#include <vector>
+
+#include <Engine_Utility/MPSCRingBuffer.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+// clang-format off
+namespace Engine
+{
+namespace Utility
+{
+namespace Test
+{
+#ifndef DOXYGEN_SKIP
+TEST_CLASS(MPSCRingBufferTest)
+{
+public:
+  TEST_METHOD(MPSCRingBuffer_Bounded)
+  {
+    MPSCRingBuffer<int> b(3);
+    Assert::AreEqual((size_t)4, b.capacity());
+
+    // Fills then rejects
+    for (int i = 0; i < 4; i++)
+      Assert::IsTrue(b.push(i));
+    Assert::IsFalse(b.push(4));
+
+    // FIFO, freeing cells for the next lap
+    int value;
+    for (int lap = 0; lap < 3; lap++)
+    {
+      for (int i = 0; i < 4; i++)
+      {
+        Assert::IsTrue(b.pop(value));
+        Assert::AreEqual(lap * 4 + i, value);
+        Assert::IsTrue(b.push((lap + 1) * 4 + i));
+      }
+    }
+
+    for (int i = 0; i < 4; i++)
+      Assert::IsTrue(b.pop(value));
+    Assert::IsFalse(b.pop(value));
+  }
+
+  TEST_METHOD(MPSCRingBuffer_Producers)
+  {
+    const int numProducers = 8;
+    const int numItems = 20000;
+
+    MPSCRingBuffer<int> b(64);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < numProducers; p++)
+    {
+      producers.push_back(std::thread([&b, p, numItems]() {
+        for (int i = 0; i < numItems; i++)
+        {
+          while (!b.push(p * numItems + i))
+            std::this_thread::yield();
+        }
+      }));
+    }
+
+    // Every item is received once and in order for each producer
+    std::vector<int> next(numProducers, 0);
+    int received = 0;
+    int value;
+    while (received < numProducers * numItems)
+    {
+      if (!b.pop(value))
+      {
+        std::this_thread::yield();
+        continue;
+      }
+
+      int p = value / numItems;
+      Assert::AreEqual(next[p], value % numItems);
+      next[p]++;
+      received++;
+    }
+
+    for (auto it = producers.begin(); it != producers.end(); ++it)
+      it->join();
+
+    Assert::IsFalse(b.pop(value));
+  }
+};
+#endif /* DOXYGEN_SKIP */
+}
+}
+}
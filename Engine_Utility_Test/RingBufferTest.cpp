@@ -0,0 +1,101 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include "CppUnitTest.h"
+
+#include <string>
+
+#include <Engine_Utility/RingBuffer.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+// clang-format off
+namespace Engine
+{
+namespace Utility
+{
+namespace Test
+{
+#ifndef DOXYGEN_SKIP
+TEST_CLASS(RingBufferTest)
+{
+public:
+  TEST_METHOD(RingBuffer_Capacity)
+  {
+    RingBuffer<int> b(5);
+
+    Assert::AreEqual((size_t)8, b.capacity());
+    Assert::AreEqual((size_t)0, b.size());
+    Assert::IsTrue(b.empty());
+  }
+
+  TEST_METHOD(RingBuffer_FIFO)
+  {
+    RingBuffer<int> b(4);
+
+    // Wrap around several times without growing
+    b.push(0);
+    for (int i = 1; i < 20; i++)
+    {
+      b.push(i);
+      b.push(i + 100);
+      Assert::AreEqual(i - 1, b.front());
+      b.pop();
+      Assert::AreEqual(i, b.front());
+      b.pop();
+      b.push(i);
+      Assert::AreEqual(i + 100, b.front());
+      b.pop();
+      Assert::AreEqual((size_t)1, b.size());
+    }
+
+    Assert::AreEqual(19, b.front());
+    b.pop();
+
+    Assert::IsTrue(b.empty());
+    Assert::AreEqual((size_t)4, b.capacity());
+  }
+
+  TEST_METHOD(RingBuffer_Grow)
+  {
+    RingBuffer<std::string> b(2);
+
+    // Offset the head so growing has to unwrap the items
+    b.push("x");
+    b.pop();
+
+    for (int i = 0; i < 10; i++)
+      b.push(std::string(1, (char)('a' + i)));
+
+    Assert::AreEqual((size_t)10, b.size());
+    Assert::AreEqual((size_t)16, b.capacity());
+
+    for (int i = 0; i < 10; i++)
+    {
+      Assert::AreEqual(std::string(1, (char)('a' + i)), b.front());
+      b.pop();
+    }
+
+    Assert::IsTrue(b.empty());
+  }
+
+  TEST_METHOD(RingBuffer_Empty)
+  {
+    RingBuffer<int> b;
+    b.push(1);
+    b.push(2);
+    b.clear();
+
+    Assert::IsTrue(b.empty());
+    Assert::ExpectException<std::runtime_error>([&b]() { b.front(); });
+    Assert::ExpectException<std::runtime_error>([&b]() { b.pop(); });
+  }
+};
+#endif /* DOXYGEN_SKIP */
+}
+}
+}
@@ -100,6 +100,14 @@ public:
     Assert::AreEqual(true, StringUtils::ToBool("enable"));
     Assert::AreEqual(false, StringUtils::ToBool("disable"));
   }
+
+  TEST_METHOD(StringUtils_EscapeJSON)
+  {
+    Assert::AreEqual(std::string("graphics"), StringUtils::EscapeJSON("graphics"));
+    Assert::AreEqual(std::string("a \\\"b\\\" c"), StringUtils::EscapeJSON("a \"b\" c"));
+    Assert::AreEqual(std::string("C:\\\\dir\\nx\\t"), StringUtils::EscapeJSON("C:\\dir\nx\t"));
+    Assert::AreEqual(std::string("ab"), StringUtils::EscapeJSON("a\rb"));
+  }
 };
 #endif /* DOXYGEN_SKIP */
 }
@@ -0,0 +1,166 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 1.
+ */
+
+#include "CppUnitTest.h"
+
+#include <sstream>
+#include <thread>
+
+#include <Engine_Utility/TraceProfiler.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+/**
+ * @brief Counts occurrences of a substring.
+ * @param str String to search
+ * @param sub Substring to count
+ * @return Number of occurrences
+ */
+size_t CountOccurrences(const std::string &str, const std::string &sub)
+{
+  size_t count = 0;
+  for (size_t pos = str.find(sub); pos != std::string::npos; pos = str.find(sub, pos + 1))
+    count++;
+  return count;
+}
+
+/**
+ * @brief Removes all events from the profiler and sets if it is enabled.
+ * @param enabled If scopes are recorded
+ * @param capacity Number of events held per thread
+ */
+void ResetProfiler(bool enabled, size_t capacity = Engine::Utility::TraceProfiler::DEFAULT_CAPACITY)
+{
+  Engine::Utility::TraceProfiler::Instance().setCapacity(capacity);
+  Engine::Utility::TraceProfiler::Instance().clear();
+  Engine::Utility::TraceProfiler::Instance().setEnabled(enabled);
+}
+}
+
+// clang-format off
+namespace Engine
+{
+namespace Utility
+{
+namespace Test
+{
+#ifndef DOXYGEN_SKIP
+TEST_CLASS(TraceProfilerTest)
+{
+public:
+  TEST_METHOD(TraceProfiler_Disabled)
+  {
+    ResetProfiler(false);
+
+    {
+      PROFILE_SCOPE("disabled");
+    }
+
+    Assert::AreEqual((size_t)0, TraceProfiler::Instance().numEvents());
+  }
+
+  TEST_METHOD(TraceProfiler_NestedScopes)
+  {
+    ResetProfiler(true);
+
+    {
+      PROFILE_SCOPE("outer");
+      {
+        PROFILE_SCOPE("inner");
+      }
+      {
+        PROFILE_SCOPE("inner");
+      }
+    }
+
+    Assert::AreEqual((size_t)3, TraceProfiler::Instance().numEvents());
+
+    std::stringstream str;
+    TraceProfiler::Instance().writeChromeTrace(str);
+    const std::string json = str.str();
+
+    Assert::AreEqual((size_t)1, CountOccurrences(json, "\"name\":\"outer\""));
+    Assert::AreEqual((size_t)2, CountOccurrences(json, "\"name\":\"inner\""));
+    Assert::AreEqual((size_t)3, CountOccurrences(json, "\"ph\":\"X\""));
+    Assert::AreEqual((size_t)0, json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+
+    // Inner scopes complete first and lie within the outer scope
+    Assert::IsTrue(json.find("\"name\":\"inner\"") < json.find("\"name\":\"outer\""));
+
+    ResetProfiler(false);
+  }
+
+  TEST_METHOD(TraceProfiler_RingBuffer)
+  {
+    ResetProfiler(true, 4);
+
+    const char *names[] = {"a", "b", "c", "d", "e", "f"};
+    for (size_t i = 0; i < 6; i++)
+    {
+      PROFILE_SCOPE(names[i]);
+    }
+
+    // Oldest events are overwritten
+    Assert::AreEqual((size_t)4, TraceProfiler::Instance().numEvents());
+
+    std::stringstream str;
+    TraceProfiler::Instance().writeChromeTrace(str);
+    const std::string json = str.str();
+
+    Assert::AreEqual(std::string::npos, json.find("\"name\":\"a\""));
+    Assert::AreEqual(std::string::npos, json.find("\"name\":\"b\""));
+    Assert::IsTrue(json.find("\"name\":\"c\"") < json.find("\"name\":\"f\""));
+
+    ResetProfiler(false);
+  }
+
+  TEST_METHOD(TraceProfiler_Threads)
+  {
+    ResetProfiler(true);
+
+    std::thread t([]() {
+      TraceProfiler::SetThreadName("worker \"1\"");
+      PROFILE_SCOPE("thread_scope");
+    });
+    t.join();
+
+    {
+      PROFILE_SCOPE("main_scope");
+    }
+
+    Assert::AreEqual((size_t)2, TraceProfiler::Instance().numEvents());
+
+    std::stringstream str;
+    TraceProfiler::Instance().writeChromeTrace(str);
+    const std::string json = str.str();
+
+    // Name is escaped and events are on separate tracks
+    Assert::AreNotEqual(std::string::npos, json.find("\"args\":{\"name\":\"worker \\\"1\\\"\"}"));
+    const size_t threadTid = json.find("\"tid\":", json.find("thread_scope"));
+    const size_t mainTid = json.find("\"tid\":", json.find("main_scope"));
+    Assert::AreNotEqual(json.substr(threadTid, 8), json.substr(mainTid, 8));
+
+    ResetProfiler(false);
+  }
+
+  TEST_METHOD(TraceProfiler_Intern)
+  {
+    std::string name = "dynamic";
+    const char *a = TraceProfiler::Intern(name);
+    name = "changed";
+    const char *b = TraceProfiler::Intern("dynamic");
+
+    Assert::IsTrue(a == b);
+    Assert::AreEqual(std::string("dynamic"), std::string(a));
+  }
+};
+#endif /* DOXYGEN_SKIP */
+}
+}
+}
@@ -13,6 +13,7 @@
 
 #include <Engine_Audio/WAVSource.h>
 #include <Engine_Common/Profiler.h>
+#include <Engine_Graphics/GLState.h>
 #include <Engine_Graphics/GraphicalScene.h>
 #include <Engine_Graphics/HeightmapMesh.h>
 #include <Engine_Graphics/Light.h>
@@ -266,13 +267,19 @@ namespace Demo
 
     // Timed loops
     m_graphicsLoop = addTimedLoop(16.66f, "graphics");
-    m_physicsLoop = addTimedLoop(8.33f, "physics");
+    m_physicsLoop = addTimedLoop(8.33f, "physics", 1);
+    setLoopFixedTimestep(m_physicsLoop, true, 4);
     m_audioLoop = addTimedLoop(16.66f, "audio");
     m_uiLoop = addTimedLoop(100.0f, "ui_updates");
     m_profileLoop = addTimedLoop(1000.0f, "profile");
 
     // Profiling
     m_profiler = new Profiler(this);
+    m_profiler->addCounter("Mesh upload bytes", &Mesh::UploadedBytes);
+    m_profiler->addCounter("Mesh uploads", &Mesh::Uploads);
+    m_profiler->addCounter("GL calls issued", &GLState::CallsIssued);
+    m_profiler->addCounter("GL calls skipped", &GLState::CallsSkipped);
+    m_profiler->addCounter("Draw calls", &Mesh::DrawCalls);
 
     return 0;
   }
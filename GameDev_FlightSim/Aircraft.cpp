@@ -7,6 +7,7 @@
 
 #include "Aircraft.h"
 
+#include <memory>
 #include <sstream>
 
 #include <Engine_Audio/WAVSource.h>
@@ -17,6 +18,7 @@
 #include <Engine_Physics/BoundingCylinderShape.h>
 #include <Engine_Physics/MathsConversions.h>
 #include <Engine_Physics/SceneObjectMotionState.h>
+#include <Engine_ResourceManagment/MemoryManager.h>
 #include <Engine_Utility/StringUtils.h>
 
 using namespace Engine::Common;
@@ -26,6 +28,7 @@ using namespace Engine::Utility;
 using namespace Engine::Maths;
 using namespace Engine::Physics;
 using namespace Engine::IO;
+using namespace Engine::ResourceManagment;
 
 namespace
 {
@@ -44,11 +47,18 @@ namespace FlightSim
   Aircraft::Aircraft(const std::string &name, const std::string &resourceRoot)
       : SceneObject(name)
       , m_resourceRoot(resourceRoot)
+      , m_pendingLoads(0)
+      , m_loadFailed(false)
       , m_mass(0.0f)
       , m_mainRotorThrust(0.0f)
       , m_axisRates()
       , m_failsafe(false)
       , m_batteryVolts(0.0f)
+      , m_subTreeAircraft(nullptr)
+      , m_subTreeMainRotor(nullptr)
+      , m_subTreeTailRotor(nullptr)
+      , m_subTreeSpinningMainRotor(nullptr)
+      , m_subTreeSpinningTailRotor(nullptr)
       , m_physicalBody(nullptr)
   {
     for (size_t i = 0; i < 4; i++)
@@ -168,55 +178,166 @@ namespace FlightSim
   }
 
   /**
-   * @brief Loads all meshes unsed by the aircraft.
+   * @brief Queues loading of all meshes and sounds used by the aircraft.
+   * @param loader Loader to queue with
+   * @param listener Listener used to output sound
+   * @return Future holding true once all resources have loaded, false if
+   *         any failed
+   *
+   * Loading is only queued once, subsequent calls return the same future. If
+   * loading fails then the next call queues the resources that did not load.
    */
-  void Aircraft::loadMeshes()
+  std::shared_future<bool> Aircraft::queueLoad(ResourceLoader &loader, Listener *listener)
   {
     // Do not load multiple times
-    if (m_subTreeAircraft != nullptr)
-      return;
+    if (m_loadResult.valid())
+      return m_loadResult;
+
+    m_loadResult = m_loadPromise.get_future().share();
+
+    // Models (the main model is lit, rotors are textured only)
+    RenderableObject *loadedModels[] = {m_subTreeAircraft, m_subTreeSpinningMainRotor, m_subTreeSpinningTailRotor};
+    for (size_t i = 0; i < 3; i++)
+    {
+      // Skip models loaded by a previous attempt
+      if (loadedModels[i] != nullptr)
+        continue;
+
+      AircraftModel model = static_cast<AircraftModel>(i);
+      std::string filename = modelFilename(model);
+      ShaderProgram *shader = ShaderProgramLookup::Instance().get(
+          (model == AircraftModel::BODY) ? "aircraft_shader_lit" : "aircraft_shader_tex");
+      std::shared_ptr<ModelLoader> modelLoader = std::make_shared<ModelLoader>();
+
+      m_pendingLoads++;
+      loader.queue(filename, [modelLoader, filename]() { return modelLoader->import(filename); },
+                   [this, modelLoader, model, shader]() {
+                     RenderableObject *tree = modelLoader->build(shader);
+                     if (tree == nullptr)
+                       return false;
+
+                     setupModel(model, tree);
+                     return true;
+                   },
+                   [this](bool result) { loadCompleted(result); });
+    }
+
+    // Sounds
+    //!< \todo change 3 -> 4 when crash sound is added
+    for (size_t i = 0; i < 3; i++)
+    {
+      if (m_sounds[i] != nullptr)
+        continue;
+
+      AircraftSound sound = static_cast<AircraftSound>(i);
+      std::string filename = audioFilename(sound);
+      std::string name = StringUtils::BasenameFromFilename(StringUtils::FilenameFromPath(filename));
+      WAVSource *source = new WAVSource(name, listener);
+
+      m_pendingLoads++;
+      source->queueLoad(loader, filename, [this, sound, source](bool result) {
+        if (result)
+          setupSound(sound, source);
+        else
+          MemoryManager::Instance().release(source);
+
+        loadCompleted(result);
+      });
+    }
+
+    return m_loadResult;
+  }
+
+  /**
+   * @brief Adds a loaded model to the aircraft.
+   * @param model Model type
+   * @param tree Scene tree of the model
+   */
+  void Aircraft::setupModel(AircraftModel model, RenderableObject *tree)
+  {
+    switch (model)
+    {
+    case AircraftModel::BODY:
+      // Main model
+      m_subTreeAircraft = tree;
+      m_subTreeAircraft->setModelMatrix(Matrix4::Scale(m_rootKVNode.child("graphics").keyFloat("body_scale")));
+      addChild(m_subTreeAircraft);
+
+      // Static main rotor
+      m_subTreeMainRotor = dynamic_cast<RenderableObject *>(
+          m_subTreeAircraft->find(m_rootKVNode.child("graphics").keyString("main_rotor_mesh")));
+      if (m_subTreeMainRotor == nullptr)
+        g_log.critical("Could not find main rotor mesh");
+
+      // Static tail rotor
+      m_subTreeTailRotor = dynamic_cast<RenderableObject *>(
+          m_subTreeAircraft->find(m_rootKVNode.child("graphics").keyString("tail_rotor_mesh")));
+      if (m_subTreeTailRotor == nullptr)
+        g_log.critical("Could not find tail rotor mesh");
+      break;
+
+    case AircraftModel::MAIN_ROTOR_SPIN:
+      // Spinning main rotor
+      m_subTreeSpinningMainRotor = tree;
+      m_subTreeSpinningMainRotor->setModelMatrix(
+          Matrix4::Translation(m_rootKVNode.child("graphics").keyVector3("main_rotor_offset")) *
+          Matrix4::Scale(m_rootKVNode.child("graphics").keyFloat("main_rotor_scale")));
+      m_subTreeSpinningMainRotor->setActive(false);
+      m_subTreeSpinningMainRotor->setTransparent(true, std::numeric_limits<size_t>::max());
+      addChild(m_subTreeSpinningMainRotor);
+      break;
+
+    case AircraftModel::TAIL_ROTOR_SPIN:
+      // Spinning tail rotor
+      m_subTreeSpinningTailRotor = tree;
+      m_subTreeSpinningTailRotor->setModelMatrix(
+          Matrix4::Translation(m_rootKVNode.child("graphics").keyVector3("tail_rotor_offset")) *
+          Matrix4::Rotation(90.0f, Vector3(1.0f, 0.0f, 0.0f)) *
+          Matrix4::Scale(m_rootKVNode.child("graphics").keyFloat("tail_rotor_scale")));
+      m_subTreeSpinningTailRotor->setActive(false);
+      m_subTreeSpinningTailRotor->setTransparent(true, std::numeric_limits<size_t>::max());
+      addChild(m_subTreeSpinningTailRotor);
+      break;
+    }
+  }
 
-    // Main model
-    ModelLoader bodyLoader;
-    m_subTreeAircraft =
-        bodyLoader.load(modelFilename(AircraftModel::BODY), ShaderProgramLookup::Instance().get("aircraft_shader_lit"));
-    m_subTreeAircraft->setModelMatrix(Matrix4::Scale(m_rootKVNode.child("graphics").keyFloat("body_scale")));
-    addChild(m_subTreeAircraft);
-
-    // Static main rotor
-    m_subTreeMainRotor = dynamic_cast<RenderableObject *>(
-        m_subTreeAircraft->find(m_rootKVNode.child("graphics").keyString("main_rotor_mesh")));
-    if (m_subTreeMainRotor == nullptr)
-      g_log.critical("Could not find main rotor mesh");
-
-    // Static tail rotor
-    m_subTreeTailRotor = dynamic_cast<RenderableObject *>(
-        m_subTreeAircraft->find(m_rootKVNode.child("graphics").keyString("tail_rotor_mesh")));
-    if (m_subTreeTailRotor == nullptr)
-      g_log.critical("Could not find tail rotor mesh");
-
-    // Spinning main rotor
-    ModelLoader mainRotorLoader;
-    m_subTreeSpinningMainRotor = mainRotorLoader.load(modelFilename(AircraftModel::MAIN_ROTOR_SPIN),
-                                                      ShaderProgramLookup::Instance().get("aircraft_shader_tex"));
-    m_subTreeSpinningMainRotor->setModelMatrix(
-        Matrix4::Translation(m_rootKVNode.child("graphics").keyVector3("main_rotor_offset")) *
-        Matrix4::Scale(m_rootKVNode.child("graphics").keyFloat("main_rotor_scale")));
-    m_subTreeSpinningMainRotor->setActive(false);
-    m_subTreeSpinningMainRotor->setTransparent(true, std::numeric_limits<size_t>::max());
-    addChild(m_subTreeSpinningMainRotor);
-
-    // Spinning tail rotor
-    ModelLoader tailRotorLoader;
-    m_subTreeSpinningTailRotor = tailRotorLoader.load(modelFilename(AircraftModel::TAIL_ROTOR_SPIN),
-                                                      ShaderProgramLookup::Instance().get("aircraft_shader_tex"));
-    m_subTreeSpinningTailRotor->setModelMatrix(
-        Matrix4::Translation(m_rootKVNode.child("graphics").keyVector3("tail_rotor_offset")) *
-        Matrix4::Rotation(90.0f, Vector3(1.0f, 0.0f, 0.0f)) *
-        Matrix4::Scale(m_rootKVNode.child("graphics").keyFloat("tail_rotor_scale")));
-    m_subTreeSpinningTailRotor->setActive(false);
-    m_subTreeSpinningTailRotor->setTransparent(true, std::numeric_limits<size_t>::max());
-    addChild(m_subTreeSpinningTailRotor);
+  /**
+   * @brief Adds a loaded sound to the aircraft.
+   * @param sound Sound type
+   * @param source Audio source
+   */
+  void Aircraft::setupSound(AircraftSound sound, Source *source)
+  {
+    source->setLooping(true);
+    m_sounds[sound] = source;
+    addChild(source);
+  }
+
+  /**
+   * @brief Records completion of loading a resource, resolving the load
+   *        result once all resources have completed.
+   * @param result If the resource was loaded
+   */
+  void Aircraft::loadCompleted(bool result)
+  {
+    if (!result)
+      m_loadFailed = true;
+
+    if (--m_pendingLoads == 0)
+    {
+      if (m_loadFailed)
+        g_log.error("Failed to load resources for aircraft " + m_name);
+
+      m_loadPromise.set_value(!m_loadFailed);
+
+      // Allow loading to be retried, existing futures keep the failed result
+      if (m_loadFailed)
+      {
+        m_loadFailed = false;
+        m_loadPromise = std::promise<bool>();
+        m_loadResult = std::shared_future<bool>();
+      }
+    }
   }
 
   /**
@@ -280,42 +401,6 @@ namespace FlightSim
     m_tailRotorBody->body()->setCollisionFlags(btCollisionObject::CF_NO_CONTACT_RESPONSE);
   }
 
-  /**
-   * @brief Loads audio files.
-   * @param listener Audio listener in use
-   * @return True if files were laoded successfully
-   */
-  bool Aircraft::loadAudio(Listener *listener)
-  {
-    bool result = true;
-
-    //!< \todo change 3 -> 4 when crash sound is added
-    for (size_t i = 0; i < 3; i++)
-    {
-      // Do not load multiple times
-      if (m_sounds[i] != nullptr)
-        continue;
-
-      std::string filename = audioFilename(static_cast<AircraftSound>(i));
-      std::string name = StringUtils::BasenameFromFilename(StringUtils::FilenameFromPath(filename));
-
-      WAVSource *s = new WAVSource(name, listener);
-
-      if (s->load(filename))
-      {
-        s->setLooping(true);
-        m_sounds[i] = s;
-        addChild(s);
-      }
-      else
-      {
-        result = false;
-      }
-    }
-
-    return result;
-  }
-
   /**
    * @brief Configures the first person view camera.
    * @param game Game in use
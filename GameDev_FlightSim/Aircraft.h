@@ -10,6 +10,8 @@
 
 #include <Engine_Common/SceneObject.h>
 
+#include <future>
+
 #include <Engine_Audio/Source.h>
 #include <Engine_Common/Game.h>
 #include <Engine_Graphics/Camera.h>
@@ -17,6 +19,7 @@
 #include <Engine_IO/INIKeyValueStore.h>
 #include <Engine_Maths/VectorOperations.h>
 #include <Engine_Physics/PhysicalSystem.h>
+#include <Engine_ResourceManagment/ResourceLoader.h>
 
 namespace GameDev
 {
@@ -61,9 +64,9 @@ namespace FlightSim
     std::string audioFilename(AircraftSound sound) const;
 
     void loadMetadata();
-    void loadMeshes();
+    std::shared_future<bool> queueLoad(Engine::ResourceManagment::ResourceLoader &loader,
+                                       Engine::Audio::Listener *listener);
     void initPhysics(const Engine::Maths::Vector3 &initialPosition, const Engine::Maths::Quaternion &initialRotation);
-    bool loadAudio(Engine::Audio::Listener *listener);
     void initCamera(Engine::Common::Game *game, float viewDepth = 10000.0f, float fieldOfVision = 45.0f);
 
     /**
@@ -206,8 +209,17 @@ namespace FlightSim
     virtual void update(float msec, Engine::Common::Subsystem sys);
 
   protected:
+    void setupModel(AircraftModel model, Engine::Graphics::RenderableObject *tree);
+    void setupSound(AircraftSound sound, Engine::Audio::Source *source);
+    void loadCompleted(bool result);
+
     std::string m_resourceRoot; //!< Path to the root of the resources directory
 
+    size_t m_pendingLoads;                 //!< Number of resources still loading
+    bool m_loadFailed;                     //!< Flag indicating a resource failed to load
+    std::promise<bool> m_loadPromise;      //!< Result of loading all resources
+    std::shared_future<bool> m_loadResult; //!< Future for m_loadPromise (invalid if loading has not started)
+
     std::string m_displayName;          //!< Displayed name of the aircraft
     float m_mass;                       //!< Mass in g
     float m_mainRotorThrust;            //!< Main rotor lifting force at maximum RPM and maximum throttle
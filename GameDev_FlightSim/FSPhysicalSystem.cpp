@@ -9,6 +9,8 @@
 
 #include <sstream>
 
+#include "FlightSimMessages.h"
+
 using namespace Engine::Common;
 using namespace Engine::Physics;
 using namespace Engine::Utility;
@@ -58,7 +60,7 @@ namespace FlightSim
           btManifoldPoint &pt = contactManifold->getContactPoint(j);
           if (pt.getDistance() < 0.0f)
           {
-            m_game->messageQueue().push(std::make_pair(Subsystem::GAME_LOGIC, "aircraft:reset"));
+            m_game->messageQueue().post(Message(Subsystem::GAME_LOGIC, Messages::AIRCRAFT_RESET));
             break;
           }
         }
@@ -13,7 +13,9 @@
 #include <sstream>
 
 #include <Engine_Audio/WAVSource.h>
+#include <Engine_Common/CSVProfilerOutput.h>
 #include <Engine_Common/Profiler.h>
+#include <Engine_Graphics/GLState.h>
 #include <Engine_Graphics/GraphicalScene.h>
 #include <Engine_Graphics/HeightmapMesh.h>
 #include <Engine_Graphics/Light.h>
@@ -33,6 +35,7 @@
 #include <Engine_ResourceManagment/MemoryManager.h>
 #include <Engine_Utility/StringUtils.h>
 
+#include "FlightSimMessages.h"
 #include "FrSkySPORTBridgeTelemetry.h"
 #include "KJSSimulatorControls.h"
 #include "KMSimulatorControls.h"
@@ -66,6 +69,8 @@ namespace FlightSim
   FlightSimGame::FlightSimGame()
       : Game("Flight Sim", std::make_pair(1024, 768))
       , m_physicalTelemetry(nullptr)
+      , m_activeAircraft(nullptr)
+      , m_pendingAircraft(nullptr)
   {
   }
 
@@ -89,6 +94,13 @@ namespace FlightSim
       g_log.info("This is the first time the game has been launched.");
     }
 
+    // Cache imported models in the save directory
+    const std::string meshCacheDir = gameSaveDirectory() + "mesh_cache";
+    if (DiskUtils::Exists(meshCacheDir) || DiskUtils::MakeDirectories(meshCacheDir))
+      ModelLoader::SetCacheDirectory(meshCacheDir);
+    else
+      g_log.warn("Cannot create model cache directory, models will not be cached");
+
     // Load fonts
     TTFFontLookup::Instance().add("main_font", TTF_OpenFont("../resources/open-sans/OpenSans-Regular.ttf", 20));
 
@@ -119,9 +131,9 @@ namespace FlightSim
     ShaderProgramLookup::Instance().add("menu_shader", menuShader);
     ShaderProgramLookup::Instance().add("aircraft_shader_tex", menuShader);
 
-    // Load textures
+    // Load textures (decoded in the background, uploaded by the main loop)
     Texture *terrainTex = new Texture();
-    terrainTex->load("../resources/terrain_height.png");
+    terrainTex->queueLoad(resourceLoader(), "../resources/terrain_height.png");
     TextureLookup::Instance().add("terrain_texture", terrainTex);
 
     // Create menu
@@ -162,6 +174,7 @@ namespace FlightSim
 
     // Scene
     m_s = new GraphicalScene(new SceneObject("root"));
+    m_s->setFlattened(true);
 
     // Light
     Light *sun = new Light("sun", 20000.0f);
@@ -171,7 +184,7 @@ namespace FlightSim
 
     // Sky
     Texture *skyTexture = new Texture();
-    skyTexture->load("../resources/sky.png");
+    skyTexture->queueLoad(resourceLoader(), "../resources/sky.png");
     RenderableObject *skyObject =
         new RenderableObject("sky", new RectangleMesh(Vector2(500000.0f, 500000.0f)), menuShader, skyTexture);
     float skyAltitude = m_rootKVNode.child("graphics").keyFloat("sky_altitude_m") * 100.0f;
@@ -181,7 +194,8 @@ namespace FlightSim
 
     // Audio
     m_audioContext = new Context();
-    m_audioContext->open();
+    if (!headless())
+      m_audioContext->open();
     m_audioListener = new Listener("audio_listener");
     m_s->root()->addChild(m_audioListener);
 
@@ -210,8 +224,16 @@ namespace FlightSim
 
     m_s->root()->addChild(m_aerialCamera);
 
-    // Initial aircraft
+    // Initial aircraft (wait for everything queued so far to load)
     selectAircraft(m_rootKVNode.child("aircraft").keyString("selected"), true);
+    resourceLoader().finish();
+    activatePendingAircraft();
+
+    if (m_activeAircraft == nullptr)
+    {
+      g_log.critical("No aircraft loaded");
+      return 40;
+    }
 
     // Initial terrain
     renewTerrain(m_rootKVNode.child("terrain").keyString("default_type"));
@@ -219,14 +241,18 @@ namespace FlightSim
     // Default camera mode
     setCameraMode(m_rootKVNode.children()["camera"].keys()["mode"]);
 
-    // GL setup
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glClearColor(0.0f, 0.3f, 0.5f, 1.0f);
-
-    // Max terrain height
-    glUniform1f(glGetUniformLocation(terrainShader->program(), "maxHeight"), 1.0f / 100000.0f);
+    if (!headless())
+    {
+      // GL setup
+      glEnable(GL_DEPTH_TEST);
+      glEnable(GL_BLEND);
+      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+      glClearColor(0.0f, 0.3f, 0.5f, 1.0f);
+
+      // Max terrain height
+      terrainShader->use();
+      terrainShader->setUniform(terrainShader->uniformIndex("maxHeight"), 1.0f / 100000.0f);
+    }
 
     // Input
     if (JoystickHandler::NumJoysticks() > 0 && m_rootKVNode.child("joystick").keyBool("enable"))
@@ -265,7 +291,9 @@ namespace FlightSim
 
     // Timed loops
     m_graphicsLoop = addTimedLoop(16.66f, "graphics");
-    m_physicsLoop = addTimedLoop(8.33f, "physics");
+    setLoopRunsHeadless(m_graphicsLoop, false);
+    m_physicsLoop = addTimedLoop(8.33f, "physics", 1);
+    setLoopFixedTimestep(m_physicsLoop, true, 4);
     m_audioLoop = addTimedLoop(16.66f, "audio");
     m_uiLoop = addTimedLoop(100.0f, "ui_updates");
     m_telemetryLoop = addTimedLoop(100.0f, "telemetry");
@@ -274,8 +302,20 @@ namespace FlightSim
     m_profileLoop = addTimedLoop(1000.0f, "profile");
 #endif
 
+    // Repeated resets (e.g. one per rotor contact point) are handled once
+    m_msgQueue.setCoalesce(Messages::AIRCRAFT_RESET, true);
+
     // Profiling
     m_profiler = new Profiler(this);
+    m_profiler->addCounter("Mesh upload bytes", &Mesh::UploadedBytes);
+    m_profiler->addCounter("Mesh uploads", &Mesh::Uploads);
+    m_profiler->addCounter("GL calls issued", &GLState::CallsIssued);
+    m_profiler->addCounter("GL calls skipped", &GLState::CallsSkipped);
+    m_profiler->addCounter("Draw calls", &Mesh::DrawCalls);
+#ifdef PROFILE
+    if (!m_profiler->addOutput(new CSVProfilerOutput(gameSaveDirectory() + "FlightSimProfile.csv")))
+      g_log.warn("Could not open profile statistics file");
+#endif
 
     return 0;
   }
@@ -320,6 +360,9 @@ namespace FlightSim
     }
     else if (id == m_uiLoop)
     {
+      // Switch to a newly selected aircraft once it has loaded
+      activatePendingAircraft();
+
       // Show menu if required
       if (m_simControls->state(S_OPENMENU))
       {
@@ -361,58 +404,9 @@ namespace FlightSim
     }
     else if (id == m_queueLoop)
     {
-      if (m_msgQueue.hasMessage(Subsystem::GAME_LOGIC))
-      {
-        const std::string msgStr(m_msgQueue.pop(Subsystem::GAME_LOGIC).second);
-
-        if (msgStr.find("aircraft:reset") != std::string::npos)
-        {
-          // Debounce the aircraft reset messages
-          // (stops odd cases where multiple resets are triggered)
-          float time = this->time();
-          if (time > m_lastAircraftReset + 500.0f)
-          {
-            m_activeAircraft->reset();
-            m_lastAircraftReset = time;
-          }
-        }
-        else if (msgStr.find("simulation:toggle") != std::string::npos)
-        {
-          bool running = !m_physicalSystem->simulationRunning();
-          m_physicalSystem->setSimulationState(running);
-
-          // Update menu text
-          std::string msg = "menu:pause:Resume";
-          if (running)
-            msg = "menu:pause:Pause";
-          m_msgQueue.push(MessageQueue::MessageType(Subsystem::UI_MENU, msg));
-        }
-        else if (msgStr.find("camera:mode:") != std::string::npos)
-        {
-          std::vector<std::string> options = StringUtils::Split(msgStr, ':');
-          setCameraMode(options[2]);
-        }
-        else if (msgStr.find("aircraft:select:") != std::string::npos)
-        {
-          std::vector<std::string> options = StringUtils::Split(msgStr, ':');
-          selectAircraft(options[2]);
-        }
-        else if (msgStr.find("terrain:renew:") != std::string::npos)
-        {
-          std::vector<std::string> options = StringUtils::Split(msgStr, ':');
-          renewTerrain(options[2]);
-        }
-        else if (msgStr.find("telemetry:toggle") != std::string::npos)
-        {
-          bool visible = StringUtils::ToBool(m_rootKVNode.children()["hud"].keys()["show_telemetry"]);
-          setTelemetryVisible(!visible);
-        }
-        else if (msgStr.find("sticks:toggle") != std::string::npos)
-        {
-          bool visible = StringUtils::ToBool(m_rootKVNode.children()["hud"].keys()["show_sticks"]);
-          setSticksVisible(!visible);
-        }
-      }
+      // Handle all pending messages (within a time budget)
+      m_msgQueue.drain(Subsystem::GAME_LOGIC, [this](const Message &msg) { handleMessage(msg); }, 0,
+                       Clock::FromMilliSec(2.0));
     }
     else if (id == m_profileLoop)
     {
@@ -426,7 +420,8 @@ namespace FlightSim
    */
   void FlightSimGame::gameShutdown()
   {
-    m_audioContext->close();
+    if (!headless())
+      m_audioContext->close();
   }
 
   /**
@@ -557,13 +552,11 @@ namespace FlightSim
   {
     g_log.info("Selected aircraft: " + name);
 
-    // No nothing if this is already the active aircraft
-    if (m_rootKVNode.child("aircraft").keyString("selected") == name && !force)
+    // No nothing if this is already the active or loading aircraft
+    Aircraft *current = (m_pendingAircraft != nullptr) ? m_pendingAircraft : m_activeAircraft;
+    if (current != nullptr && current->name() == name && !force)
       return;
 
-    // Record option
-    m_rootKVNode.children()["aircraft"].keys()["selected"] = name;
-
     // Find new aircraft
     auto it = std::find_if(m_aircraft.begin(), m_aircraft.end(), [name](Aircraft *a) { return a->name() == name; });
     if (it == m_aircraft.end())
@@ -572,6 +565,33 @@ namespace FlightSim
       return;
     }
 
+    // Load the aircraft in the background, it becomes active once loaded
+    m_pendingAircraft = *it;
+    m_pendingAircraftLoad = m_pendingAircraft->queueLoad(resourceLoader(), m_audioListener);
+    activatePendingAircraft();
+  }
+
+  /**
+   * @brief Makes the selected aircraft active if it has finished loading.
+   */
+  void FlightSimGame::activatePendingAircraft()
+  {
+    if (m_pendingAircraft == nullptr ||
+        m_pendingAircraftLoad.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+      return;
+
+    Aircraft *aircraft = m_pendingAircraft;
+    m_pendingAircraft = nullptr;
+
+    if (!m_pendingAircraftLoad.get())
+    {
+      g_log.error("Aircraft " + aircraft->name() + " could not be loaded");
+      return;
+    }
+
+    // Record option (only once the aircraft is known to load)
+    m_rootKVNode.children()["aircraft"].keys()["selected"] = aircraft->name();
+
     // Remove old aircraft
     if (m_activeAircraft != nullptr)
       m_s->root()->removeChild(m_activeAircraft);
@@ -580,13 +600,11 @@ namespace FlightSim
     float aircraftRotation = m_rootKVNode.child("aircraft").keyFloat("default_rotation");
     Vector3 aircraftPosition = m_rootKVNode.child("aircraft").keyVector3("default_position");
 
-    (*it)->loadMeshes();
-    (*it)->loadAudio(m_audioListener);
-    (*it)->initPhysics(aircraftPosition, Quaternion(aircraftRotation, 0.0f, 0.0f));
-    (*it)->initCamera(this);
+    aircraft->initPhysics(aircraftPosition, Quaternion(aircraftRotation, 0.0f, 0.0f));
+    aircraft->initCamera(this);
 
     // Set active aircraft
-    m_activeAircraft = *it;
+    m_activeAircraft = aircraft;
 
     // Add new aircraft
     m_s->root()->addChild(m_activeAircraft);
@@ -636,6 +654,55 @@ namespace FlightSim
     }
   }
 
+  /**
+   * @brief Handles a message sent to the game logic subsystem.
+   * @param msg Message
+   */
+  void FlightSimGame::handleMessage(const Message &msg)
+  {
+    if (msg.id == Messages::AIRCRAFT_RESET)
+    {
+      // Debounce the aircraft reset messages
+      // (stops odd cases where multiple resets are triggered)
+      float time = this->time();
+      if (time > m_lastAircraftReset + 500.0f)
+      {
+        m_activeAircraft->reset();
+        m_lastAircraftReset = time;
+      }
+    }
+    else if (msg.id == Messages::SIMULATION_TOGGLE)
+    {
+      bool running = !m_physicalSystem->simulationRunning();
+      m_physicalSystem->setSimulationState(running);
+
+      // Update menu text
+      m_msgQueue.push(Subsystem::UI_MENU, Messages::MENU_PAUSE, running ? "Pause" : "Resume");
+    }
+    else if (msg.id == Messages::CAMERA_MODE)
+    {
+      setCameraMode(msg.argument);
+    }
+    else if (msg.id == Messages::AIRCRAFT_SELECT)
+    {
+      selectAircraft(msg.argument);
+    }
+    else if (msg.id == Messages::TERRAIN_RENEW)
+    {
+      renewTerrain(msg.argument);
+    }
+    else if (msg.id == Messages::TELEMETRY_TOGGLE)
+    {
+      bool visible = StringUtils::ToBool(m_rootKVNode.children()["hud"].keys()["show_telemetry"]);
+      setTelemetryVisible(!visible);
+    }
+    else if (msg.id == Messages::STICKS_TOGGLE)
+    {
+      bool visible = StringUtils::ToBool(m_rootKVNode.children()["hud"].keys()["show_sticks"]);
+      setSticksVisible(!visible);
+    }
+  }
+
   /**
    * @brief Sets the camera mode.
    * @param mode Mode string
@@ -676,10 +743,7 @@ namespace FlightSim
     m_rootKVNode.children()["hud"].keys()["show_telemetry"] = visible ? "true" : "false";
 
     // Update menu option text
-    std::string msg = "menu:telemetry_option:Show Telemetry";
-    if (visible)
-      msg = "menu:telemetry_option:Hide Telemetry";
-    m_msgQueue.push(MessageQueue::MessageType(Subsystem::UI_MENU, msg));
+    m_msgQueue.push(Subsystem::UI_MENU, Messages::MENU_TELEMETRY_OPTION, visible ? "Hide Telemetry" : "Show Telemetry");
   }
 
   /**
@@ -696,10 +760,7 @@ namespace FlightSim
     m_rootKVNode.children()["hud"].keys()["show_sticks"] = visible ? "true" : "false";
 
     // Update menu option text
-    std::string msg = "menu:sticks_option:Show Sticks";
-    if (visible)
-      msg = "menu:sticks_option:Hide Sticks";
-    m_msgQueue.push(MessageQueue::MessageType(Subsystem::UI_MENU, msg));
+    m_msgQueue.push(Subsystem::UI_MENU, Messages::MENU_STICKS_OPTION, visible ? "Hide Sticks" : "Show Sticks");
   }
 }
 }
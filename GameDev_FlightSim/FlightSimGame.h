@@ -10,6 +10,8 @@
 
 #include <Engine_Common/Game.h>
 
+#include <future>
+
 #include <SDL_ttf.h>
 
 #include <Engine_Audio/Context.h>
@@ -58,8 +60,11 @@ namespace FlightSim
     void loadTerrainPresets();
 
     void selectAircraft(const std::string &name, bool force = false);
+    void activatePendingAircraft();
     void renewTerrain(const std::string &name);
 
+    void handleMessage(const Engine::Common::Message &msg);
+
     void setCameraMode(const std::string &mode);
     void setTelemetryVisible(bool visible);
     void setSticksVisible(bool visible);
@@ -99,6 +104,9 @@ namespace FlightSim
     std::vector<Aircraft *> m_aircraft; //!< All aircraft
     Aircraft *m_activeAircraft;         //!< Active aircraft
 
+    Aircraft *m_pendingAircraft;                    //!< Selected aircraft that is still loading
+    std::shared_future<bool> m_pendingAircraftLoad; //!< Result of loading the pending aircraft
+
     std::vector<TerrainBuilder *> m_terrainBuilders; //!< Terrain builders
     Terrain *m_terrain;                              //!< Active terrain
   };
@@ -0,0 +1,31 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 2.
+ */
+
+#include "FlightSimMessages.h"
+
+using namespace Engine::Common;
+
+namespace GameDev
+{
+namespace FlightSim
+{
+  namespace Messages
+  {
+    const MessageID AIRCRAFT_RESET = Message::Intern("aircraft:reset");
+    const MessageID AIRCRAFT_SELECT = Message::Intern("aircraft:select");
+    const MessageID SIMULATION_TOGGLE = Message::Intern("simulation:toggle");
+    const MessageID CAMERA_MODE = Message::Intern("camera:mode");
+    const MessageID TERRAIN_RENEW = Message::Intern("terrain:renew");
+    const MessageID TELEMETRY_TOGGLE = Message::Intern("telemetry:toggle");
+    const MessageID STICKS_TOGGLE = Message::Intern("sticks:toggle");
+
+    const MessageID MENU_PAUSE = Message::Intern("menu:pause");
+    const MessageID MENU_TELEMETRY_OPTION = Message::Intern("menu:telemetry_option");
+    const MessageID MENU_STICKS_OPTION = Message::Intern("menu:sticks_option");
+  }
+}
+}
@@ -0,0 +1,38 @@
+/**
+ * @file
+ * @author Dan Nixon (120263697)
+ *
+ * For CSC3224 Project 2.
+ */
+
+#ifndef _GAMEDEV_FLIGHTSIM_FLIGHTSIMMESSAGES_H_
+#define _GAMEDEV_FLIGHTSIM_FLIGHTSIMMESSAGES_H_
+
+#include <Engine_Common/Message.h>
+
+namespace GameDev
+{
+namespace FlightSim
+{
+  /**
+   * @brief IDs of the messages passed between subsystems of the flight
+   *        simulator.
+   */
+  namespace Messages
+  {
+    extern const Engine::Common::MessageID AIRCRAFT_RESET;    //!< Reset the active aircraft
+    extern const Engine::Common::MessageID AIRCRAFT_SELECT;   //!< Select aircraft (argument: aircraft name)
+    extern const Engine::Common::MessageID SIMULATION_TOGGLE; //!< Pause or resume the simulation
+    extern const Engine::Common::MessageID CAMERA_MODE;       //!< Set camera mode (argument: mode name)
+    extern const Engine::Common::MessageID TERRAIN_RENEW;     //!< Generate new terrain (argument: terrain name)
+    extern const Engine::Common::MessageID TELEMETRY_TOGGLE;  //!< Show or hide telemetry
+    extern const Engine::Common::MessageID STICKS_TOGGLE;     //!< Show or hide stick indicators
+
+    extern const Engine::Common::MessageID MENU_PAUSE;            //!< Set pause item text (argument: text)
+    extern const Engine::Common::MessageID MENU_TELEMETRY_OPTION; //!< Set telemetry item text (argument: text)
+    extern const Engine::Common::MessageID MENU_STICKS_OPTION;    //!< Set sticks item text (argument: text)
+  }
+}
+}
+
+#endif
@@ -7,7 +7,7 @@
 
 #include "OptionsMenu.h"
 
-#include <Engine_Utility/StringUtils.h>
+#include "FlightSimMessages.h"
 
 using namespace Engine::Common;
 using namespace Engine::Maths;
@@ -76,31 +76,31 @@ namespace FlightSim
     }
     else if (item->name() == "pause")
     {
-      m_game->messageQueue().push(std::make_pair(Subsystem::GAME_LOGIC, "simulation:toggle"));
+      m_game->messageQueue().push(Subsystem::GAME_LOGIC, Messages::SIMULATION_TOGGLE);
     }
     else if (item->name() == "reset")
     {
-      m_game->messageQueue().push(std::make_pair(Subsystem::GAME_LOGIC, "aircraft:reset"));
+      m_game->messageQueue().push(Subsystem::GAME_LOGIC, Messages::AIRCRAFT_RESET);
     }
     else if (item->parent()->name() == "camera")
     {
-      m_game->messageQueue().push(std::make_pair(Subsystem::GAME_LOGIC, "camera:mode:" + item->name()));
+      m_game->messageQueue().push(Subsystem::GAME_LOGIC, Messages::CAMERA_MODE, item->name());
     }
     else if (item->name() == "telemetry")
     {
-      m_game->messageQueue().push(std::make_pair(Subsystem::GAME_LOGIC, "telemetry:toggle"));
+      m_game->messageQueue().push(Subsystem::GAME_LOGIC, Messages::TELEMETRY_TOGGLE);
     }
     else if (item->name() == "sticks")
     {
-      m_game->messageQueue().push(std::make_pair(Subsystem::GAME_LOGIC, "sticks:toggle"));
+      m_game->messageQueue().push(Subsystem::GAME_LOGIC, Messages::STICKS_TOGGLE);
     }
     else if (item->parent()->name() == "aircraft")
     {
-      m_game->messageQueue().push(std::make_pair(Subsystem::GAME_LOGIC, "aircraft:select:" + item->name()));
+      m_game->messageQueue().push(Subsystem::GAME_LOGIC, Messages::AIRCRAFT_SELECT, item->name());
     }
     else if (item->parent()->name() == "terrain")
     {
-      m_game->messageQueue().push(std::make_pair(Subsystem::GAME_LOGIC, "terrain:renew:" + item->name()));
+      m_game->messageQueue().push(Subsystem::GAME_LOGIC, Messages::TERRAIN_RENEW, item->name());
     }
   }
 
@@ -122,29 +122,24 @@ namespace FlightSim
   {
     GraphicalScene::update(msec, sys);
 
-    if (sys == Subsystem::GRAPHICS && m_game->messageQueue().hasMessage(Subsystem::UI_MENU))
+    Message msg;
+    if (sys == Subsystem::GRAPHICS && m_game->messageQueue().popMessage(Subsystem::UI_MENU, msg))
     {
-      std::vector<std::string> messageOptions =
-          StringUtils::Split(m_game->messageQueue().pop(Subsystem::UI_MENU).second, ':');
-
       // Update the name of a menu item
-      if (messageOptions.size() == 3 && messageOptions[0] == "menu")
+      if (msg.id == Messages::MENU_TELEMETRY_OPTION)
+      {
+        m_telemetryOption->setText(msg.argument);
+        layout();
+      }
+      else if (msg.id == Messages::MENU_STICKS_OPTION)
+      {
+        m_sticksOption->setText(msg.argument);
+        layout();
+      }
+      else if (msg.id == Messages::MENU_PAUSE)
       {
-        if (messageOptions[1] == "telemetry_option")
-        {
-          m_telemetryOption->setText(messageOptions[2]);
-          layout();
-        }
-        else if (messageOptions[1] == "sticks_option")
-        {
-          m_sticksOption->setText(messageOptions[2]);
-          layout();
-        }
-        else if (messageOptions[1] == "pause")
-        {
-          m_pauseOption->setText(messageOptions[2]);
-          layout();
-        }
+        m_pauseOption->setText(msg.argument);
+        layout();
       }
     }
   }
@@ -13,6 +13,11 @@
 int main(int argc, char *args[])
 {
   GameDev::FlightSim::FlightSimGame g;
+
+  // Allows running headless (e.g. --headless --duration 60)
+  if (!g.parseArguments(argc, args))
+    return 1;
+
   return g.run();
   ;
 }
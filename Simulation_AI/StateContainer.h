@@ -71,7 +71,7 @@ namespace AI
      * @brief Gets a reference to the vector containing child states.
      * @return Reference to children vector
      */
-    inline std::vector<IState *> children()
+    inline const std::vector<IState *> &children() const
     {
       return m_children;
     }
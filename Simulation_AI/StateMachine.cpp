@@ -67,20 +67,26 @@ namespace AI
    */
   bool StateMachine::transfer()
   {
-    IStatePtrList branch = activeStateBranch();
-    IState *oldState = branch.back();
+    // Walk the active branch in place rather than copying it (this is called
+    // every tick)
+    IState *oldState = m_root.activeChild();
+    if (oldState == nullptr)
+      return false;
+    while (oldState->activeChild() != nullptr)
+      oldState = oldState->activeChild();
+
     bool stateChange = false;
 
-    for (IStatePtrListIter brIt = branch.begin(); brIt != branch.end(); ++brIt)
+    for (IState *node = m_root.activeChild(); node != nullptr; node = node->activeChild())
     {
-      IState *transferState = (*brIt)->testTransferFrom();
+      IState *transferState = node->testTransferFrom();
 
       if (transferState == nullptr)
       {
-        IStatePtrList siblings = (*brIt)->parent()->children();
-        for (IStatePtrListIter sibIt = siblings.begin(); sibIt != siblings.end(); ++sibIt)
+        const IStatePtrList &siblings = node->parent()->children();
+        for (IStatePtrListConstIter sibIt = siblings.begin(); sibIt != siblings.end(); ++sibIt)
         {
-          if ((*sibIt != *brIt) && (*sibIt)->testTransferTo())
+          if ((*sibIt != node) && (*sibIt)->testTransferTo())
           {
             transferState = *sibIt;
             break;
@@ -10,6 +10,7 @@
 #include <sstream>
 
 #include <Engine_Common/SceneObject.h>
+#include <Engine_Graphics/GraphicalScene.h>
 #include <Engine_Graphics/LineMesh.h>
 #include <Engine_Graphics/RenderableObject.h>
 #include <Engine_Graphics/ShaderProgram.h>
@@ -70,35 +71,47 @@ namespace GraphicalPathFinder
     const bool showClosedList(m_viewMode.test(ViewMode::CLOSED_LIST));
     const bool showPath(m_viewMode.test(ViewMode::PATH));
 
+    // Look up colours once rather than for every node and edge
+    ColourLookup &colours = ColourLookup::Instance();
+    const Colour nodeDefault = colours.get("node_default");
+    const Colour nodeOpenList = colours.get("node_open_list");
+    const Colour nodeClosedList = colours.get("node_closed_list");
+    const Colour nodePath = colours.get("node_path");
+    const Colour nodeStart = colours.get("node_start");
+    const Colour nodeEnd = colours.get("node_end");
+    const Colour nodeSelected = colours.get("node_selected");
+    const Colour edgeDefault = colours.get("edge_default");
+    const Colour edgePath = colours.get("edge_path");
+
     // Process nodes
     for (auto it = m_nodes.begin(); it != m_nodes.end(); ++it)
     {
       Node *node = it->first;
-      Colour nodeColour = ColourLookup::Instance().get("node_default");
+      Colour nodeColour = nodeDefault;
 
       const bool isStart(node == m_startNode->first);
       const bool isEnd(node == m_endNode->first);
       const bool isSelected(node == m_nodeSelection->selectedNode()->first);
 
       if (showOpenList && Utils::IsOnList(m_finder->openList(), node))
-        nodeColour = ColourLookup::Instance().get("node_open_list");
+        nodeColour = nodeOpenList;
 
       if (showClosedList && Utils::IsOnList(m_finder->closedList(), node))
-        nodeColour = ColourLookup::Instance().get("node_closed_list");
+        nodeColour = nodeClosedList;
 
       if (showPath && Utils::IsOnList(m_finder->path(), node))
-        nodeColour = ColourLookup::Instance().get("node_path");
+        nodeColour = nodePath;
 
       if (isStart)
-        nodeColour = ColourLookup::Instance().get("node_start");
+        nodeColour = nodeStart;
 
       if (isEnd)
-        nodeColour = ColourLookup::Instance().get("node_end");
+        nodeColour = nodeEnd;
 
       if (isSelected)
-        nodeColour = ColourLookup::Instance().get("node_selected");
+        nodeColour = nodeSelected;
 
-      it->second->mesh()->setStaticColour(nodeColour);
+      it->second->setInstanceColour(nodeColour);
 
       // Check this node has traversable connections, set to invisible if all
       // edges are not traversable, unless it is the start, end or selected node
@@ -135,7 +148,7 @@ namespace GraphicalPathFinder
     for (auto it = m_edges.begin(); it != m_edges.end(); ++it)
     {
       Edge *edge = it->first;
-      Colour edgeColour = ColourLookup::Instance().get("edge_default");
+      Colour edgeColour = edgeDefault;
 
       const bool isSelected(edge == m_edgeSelection->selectedEdge()->first);
 
@@ -158,10 +171,10 @@ namespace GraphicalPathFinder
       }
 
       if (showPath && Utils::IsOnPath(m_finder->path(), edge))
-        edgeColour = ColourLookup::Instance().get("edge_path");
+        edgeColour = edgePath;
 
       if (isSelected)
-        edgeColour = ColourLookup::Instance().get("node_selected");
+        edgeColour = nodeSelected;
 
       it->second->mesh()->setStaticColour(edgeColour);
 
@@ -220,6 +233,12 @@ namespace GraphicalPathFinder
     colShader->link();
     ShaderProgramLookup::Instance().add("col_shader", colShader);
 
+    ShaderProgram *instancedColShader = new ShaderProgram();
+    instancedColShader->addShader(new VertexShader("../resources/shader/vert_instanced.glsl"));
+    instancedColShader->addShader(new FragmentShader("../resources/shader/frag_col.glsl"));
+    instancedColShader->link();
+    ShaderProgramLookup::Instance().add("instanced_col_shader", instancedColShader);
+
     ShaderProgram *menuShader = new ShaderProgram();
     menuShader = new ShaderProgram();
     menuShader->addShader(new VertexShader("../resources/shader/vert_simple.glsl"));
@@ -230,7 +249,7 @@ namespace GraphicalPathFinder
     // Scene
     Matrix4 view = Matrix4::BuildViewMatrix(Vector3(0, 0, -15), Vector3(0, 0, 0));
     Matrix4 proj = Matrix4::Perspective(1, 100, 1.33f, 45.0f);
-    m_scene = new Scene(new SceneObject("root"), view, proj);
+    m_scene = new GraphicalScene(new SceneObject("root"), view, proj);
 
     // Menu
     m_menu = new OptionsMenu(this, m_fontMedium, 0.05f);
@@ -258,11 +277,12 @@ namespace GraphicalPathFinder
       return 1;
     }
 
-    // Create graphical nodes
+    // Create graphical nodes (sharing a mesh so they are drawn with a single
+    // instanced draw)
+    SphericalMesh *nodeMesh = new SphericalMesh(0.1f);
     for (auto it = nodes.begin(); it != nodes.end(); ++it)
     {
-      SphericalMesh *mesh = new SphericalMesh(0.1f);
-      RenderableObject *obj = new RenderableObject((*it)->id(), mesh, colShader);
+      RenderableObject *obj = new RenderableObject((*it)->id(), nodeMesh, instancedColShader);
       obj->setModelMatrix(Matrix4::Translation((*it)->position()));
       m_scene->root()->addChild(obj);
 
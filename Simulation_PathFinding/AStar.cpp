@@ -8,6 +8,7 @@
 #include "AStar.h"
 
 #include <Engine_Logging/Logger.h>
+#include <Engine_Utility/TraceProfiler.h>
 
 #include "Edge.h"
 #include "Utils.h"
@@ -66,6 +67,8 @@ namespace PathFinding
    */
   bool AStar::findPath(Node *start, Node *end)
   {
+    PROFILE_SCOPE("AStar::findPath");
+
     // Clear caches
     reset();
 
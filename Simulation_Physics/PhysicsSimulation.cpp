@@ -11,12 +11,15 @@
 
 #include <Engine_Maths/BoundingBox.h>
 #include <Engine_Maths/Vector3.h>
+#include <Engine_ResourceManagment/FrameAllocator.h>
+#include <Engine_Utility/TraceProfiler.h>
 
 #include "Integration.h"
 #include "InterfaceDetection.h"
 #include "InterfaceResolution.h"
 
 using namespace Engine::Maths;
+using namespace Engine::ResourceManagment;
 
 namespace Simulation
 {
@@ -77,11 +80,14 @@ namespace Physics
    */
   void PhysicsSimulation::detectInterfaces()
   {
+    PROFILE_SCOPE("PhysicsSimulation::detectInterfaces");
+
     // Sort entities along x-axis
     std::sort(m_entities.begin(), m_entities.end(),
               [](Entity *a, Entity *b) { return a->boundingBox().lowerLeft()[0] < b->boundingBox().lowerLeft()[0]; });
 
-    std::vector<InterfaceDef> interfaces;
+    // Candidate interfaces only live for this step
+    FrameVector<InterfaceDef> interfaces;
 
     // Create a list of possible interfaces (broadphase)
     for (EntityPtrListIter it = m_entities.begin(); it != m_entities.end(); ++it)
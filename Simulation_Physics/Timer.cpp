@@ -7,6 +7,8 @@
 
 #include "Timer.h"
 
+using namespace Engine::Utility;
+
 namespace Simulation
 {
 namespace Physics
@@ -14,10 +16,12 @@ namespace Physics
   /**
    * @brief Initialises the timer, must be called before an instance of Timer is
    *        created.
+   *
+   * No longer required (Engine::Utility::Clock needs no initialisation), kept
+   * for compatibility.
    */
   void Timer::Init()
   {
-    QueryPerformanceFrequency(&s_freq);
   }
 
   /**
@@ -25,6 +29,7 @@ namespace Physics
    */
   Timer::Timer()
       : m_running(false)
+      , m_lastFrameTime(0)
   {
   }
 
@@ -40,7 +45,8 @@ namespace Physics
   void Timer::start()
   {
     m_running = true;
-    QueryPerformanceCounter(&m_start);
+    m_clock.reset();
+    m_lastFrameTime = 0;
   }
 
   /**
@@ -53,13 +59,14 @@ namespace Physics
 
   /**
    * @brief Gets the time since the timer was started.
-   * @return Time since start
+   * @return Time since start (in milliseconds)
+   *
+   * Precision degrades with uptime, use Timer::frameTime for computing time
+   * steps.
    */
   float Timer::absoluteTime() const
   {
-    LARGE_INTEGER t;
-    QueryPerformanceCounter(&t);
-    return (float)((t.QuadPart - m_start.QuadPart) * 1000.0f / s_freq.QuadPart);
+    return m_clock.elapsedMilliSecF();
   }
 
   /**
@@ -69,7 +76,7 @@ namespace Physics
    */
   float Timer::timeSinceLastFrame() const
   {
-    return absoluteTime() - m_lastFrameTime;
+    return Clock::ToMilliSecF(m_clock.elapsed() - m_lastFrameTime);
   }
 
   /**
@@ -79,10 +86,10 @@ namespace Physics
    */
   float Timer::frameTime()
   {
-    float t = absoluteTime();
-    float dt = t - m_lastFrameTime;
-    m_lastFrameTime = absoluteTime();
-    return dt;
+    Clock::Nanoseconds t = m_clock.elapsed();
+    Clock::Nanoseconds dt = t - m_lastFrameTime;
+    m_lastFrameTime = t;
+    return Clock::ToMilliSecF(dt);
   }
 }
 }
@@ -8,7 +8,7 @@
 #ifndef _SIMULATION_PHYSICS_TIMER_H_
 #define _SIMULATION_PHYSICS_TIMER_H_
 
-#include <Windows.h>
+#include <Engine_Utility/Clock.h>
 
 namespace Simulation
 {
@@ -24,10 +24,6 @@ namespace Physics
   public:
     static void Init();
 
-  private:
-    static LARGE_INTEGER s_freq; //!< Performance counter frequency
-
-  public:
     Timer();
     ~Timer();
 
@@ -39,9 +35,9 @@ namespace Physics
     float frameTime();
 
   private:
-    bool m_running;        //!< Flag to indicate if the timer is running
-    LARGE_INTEGER m_start; //!< Time at which timer was started
-    float m_lastFrameTime; //!< Time of last recorded update frame
+    bool m_running;                                      //!< Flag to indicate if the timer is running
+    Engine::Utility::Clock m_clock;                      //!< Clock started when the timer is started
+    Engine::Utility::Clock::Nanoseconds m_lastFrameTime; //!< Time of last recorded update frame
   };
 }
 }
@@ -58,27 +58,52 @@ namespace Snooker
     }
   }
 
+  /**
+   * @brief Gets the mesh shared by all balls.
+   * @return Disc mesh
+   */
+  Mesh *Ball::SharedMesh()
+  {
+    static Mesh *mesh = Mesh::GenerateDisc2D(RADIUS);
+    return mesh;
+  }
+
+  /**
+   * @brief Gets the instanced shader program shared by all balls.
+   * @return Shader program
+   */
+  ShaderProgram *Ball::SharedShader()
+  {
+    static ShaderProgram *sp = nullptr;
+
+    if (sp == nullptr)
+    {
+      sp = new ShaderProgram();
+      sp->addShader(new VertexShader("../resources/shader/vert_instanced.glsl"));
+      sp->addShader(new FragmentShader("../resources/shader/frag_col.glsl"));
+      sp->link();
+    }
+
+    return sp;
+  }
+
   /**
    * @copydoc SphericalEntity::SphericalEntity(const Vector2 &)
    * @param pos Position of the ball
    * @param points Number of points awarded for potting this ball (-1 for cue
    *               ball)
+   *
+   * All balls share a mesh and shader so are drawn with a single instanced
+   * draw, the colour of each ball is its instance colour.
    */
   Ball::Ball(const Vector2 &pos, int points)
       : SphericalEntity(pos, MASS, RADIUS, false, 0.99f, 0.005f)
-      , RenderableObject(Info(points).first, Mesh::GenerateDisc2D(RADIUS), nullptr)
+      , RenderableObject(Info(points).first, SharedMesh(), SharedShader())
       , m_points(points)
       , m_defaultPosition(pos)
   {
-    // Load shaders
-    ShaderProgram *sp = new ShaderProgram();
-    sp->addShader(new VertexShader("../resources/shader/vert_simple.glsl"));
-    sp->addShader(new FragmentShader("../resources/shader/frag_col.glsl"));
-    sp->link();
-    setShader(sp);
-
     // Set correct ball colour
-    mesh()->setStaticColour(colour());
+    setInstanceColour(colour());
 
     // Set initial position
     setPosition(pos);
@@ -50,6 +50,10 @@ namespace Snooker
 
     virtual void setPosition(const Engine::Maths::Vector2 &pos);
 
+  private:
+    static Engine::Graphics::Mesh *SharedMesh();
+    static Engine::Graphics::ShaderProgram *SharedShader();
+
   private:
     int m_points;                             //!< Number of points potting this ball gets
     Engine::Maths::Vector2 m_defaultPosition; //!< Default position of this ball on the table
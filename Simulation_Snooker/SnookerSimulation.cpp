@@ -12,6 +12,8 @@
 #include <SDL_ttf.h>
 
 #include <Engine_Common/Profiler.h>
+#include <Engine_Graphics/GLState.h>
+#include <Engine_Graphics/GraphicalScene.h>
 #include <Engine_Graphics/LineMesh.h>
 #include <Engine_Graphics/Shaders.h>
 #include <Engine_Maths/VectorOperations.h>
@@ -69,7 +71,9 @@ namespace Snooker
     // Scene
     Matrix4 view = Matrix4::BuildViewMatrix(Vector3(0, 0, 0), Vector3(0, 0, -10));
     Matrix4 proj = Matrix4::Perspective(1, 100000, 1.33f, 45.0f);
-    m_scene = new Scene(m_table, view, proj);
+    GraphicalScene *scene = new GraphicalScene(m_table, view, proj);
+    scene->setSorted(false); // No depth test, relies on scene order
+    m_scene = scene;
 
     // UI
     Matrix4 orth = Matrix4::Orthographic(0.0f, 1.0f, 1.0f, -1.0f, 1.0f, -1.0f);
@@ -83,7 +87,7 @@ namespace Snooker
     m_profileText = new TextPane("profile_info", 0.05f, m_uiShader, m_fontMedium);
     m_profileText->setActive(false);
     m_profileText->setModelMatrix(Matrix4::Translation(Vector3(-0.5f, 0.8f, 0.0f)));
-    m_profileText->setText("Graphics: -\nPhysics: -");
+    m_profileText->setText("Graphics: -\nPhysics: -\nTransforms: -");
     m_ui->root()->addChild(m_profileText);
 
     // Alignments
@@ -164,7 +168,9 @@ namespace Snooker
 
     // Timed loops
     m_graphicsLoop = addTimedLoop(16.66f, "graphics");
-    m_physicsLoop = addTimedLoop(8.33f, "physics");
+    setLoopRunsHeadless(m_graphicsLoop, false);
+    m_physicsLoop = addTimedLoop(8.33f, "physics", 1);
+    setLoopFixedTimestep(m_physicsLoop, true, 4);
     m_controlLoop = addTimedLoop(25.0f, "control");
     m_profileLoop = addTimedLoop(1000.0f, "profile");
 
@@ -181,6 +187,10 @@ namespace Snooker
     controls = new SnookerControls(this);
 
     m_profiler = new Profiler(this);
+    m_profiler->addCounter("Mesh upload bytes", &Mesh::UploadedBytes);
+    m_profiler->addCounter("GL calls issued", &GLState::CallsIssued);
+    m_profiler->addCounter("GL calls skipped", &GLState::CallsSkipped);
+    m_profiler->addCounter("Draw calls", &Mesh::DrawCalls);
 
     return 0;
   }
@@ -239,7 +249,13 @@ namespace Snooker
         profileStr << "Graphics: " << m_profiler->frameRate(m_graphicsLoop) << " FPS"
                    << " (" << m_profiler->averageDuration(m_graphicsLoop) << "ms)" << '\n'
                    << "Physics: " << m_profiler->frameRate(m_physicsLoop) << " FPS"
-                   << " (" << m_profiler->averageDuration(m_physicsLoop) << "ms)";
+                   << " (" << m_profiler->averageDuration(m_physicsLoop) << "ms)" << '\n'
+                   << "Transforms: " << m_profiler->transformUpdatesPerFrame(m_graphicsLoop) << " per frame" << '\n'
+                   << "Mesh uploads: " << m_profiler->counterPerFrame("Mesh upload bytes", m_graphicsLoop)
+                   << " bytes per frame" << '\n'
+                   << "GL calls: " << m_profiler->counterPerFrame("GL calls issued", m_graphicsLoop) << " issued, "
+                   << m_profiler->counterPerFrame("GL calls skipped", m_graphicsLoop) << " skipped per frame" << '\n'
+                   << "Draw calls: " << m_profiler->counterPerFrame("Draw calls", m_graphicsLoop) << " per frame";
 
         m_profileText->setText(profileStr.str());
       }
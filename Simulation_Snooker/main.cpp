@@ -15,5 +15,10 @@
 int main(int argc, char *argv[])
 {
   Simulation::Snooker::SnookerSimulation s;
+
+  // Allows running headless (e.g. --headless --duration 60)
+  if (!s.parseArguments(argc, argv))
+    return 1;
+
   return s.run();
 }
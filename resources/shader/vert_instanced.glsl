@@ -0,0 +1,25 @@
+#version 330 core
+
+uniform mat4 viewMatrix;
+uniform mat4 projMatrix;
+
+in vec3 position;
+in vec2 texCoord;
+in vec4 colour;
+
+in mat4 instanceModelMatrix;
+in vec4 instanceColour;
+
+out Vertex
+{
+  vec2 texCoord;
+  vec4 colour;
+} OUT;
+
+void main(void)
+{
+  gl_Position = (projMatrix * viewMatrix * instanceModelMatrix) * vec4(position, 1.0);
+
+  OUT.texCoord = texCoord;
+  OUT.colour = colour * instanceColour;
+}